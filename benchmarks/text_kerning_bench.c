@@ -0,0 +1,145 @@
+// Text throughput with kerning on vs off: render_text glyph emission and
+// uncached layout measurement.
+//
+// Build and run with:  make bench-text [FONT=path/to/font.ttf]
+// Needs a GL 3.3 context, so it opens a hidden GLFW window.
+
+#define _POSIX_C_SOURCE 199309L
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include "platform/window.h"
+#include "render/renderer.h"
+#include "render/text.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_LINES 1000
+#define BENCH_RUNS 10
+#define BENCH_FONT_SIZE 16.0f
+#define BENCH_DEFAULT_FONT "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf"
+
+// The UI layer asks the Lua bindings for the active window; there is none here
+Window* pudim_get_active_window(void) {
+    return NULL;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Lines rich in kerning pairs (AV, To, Wa, Ye...), made unique so no two hit
+// the same layout cache entry
+static void make_lines(char lines[][96], size_t* glyphs) {
+    static const char* samples[] = {
+        "AVAV To Wa Ye LT P. Yo Tr Av \"Typography\"",
+        "WAVE: Tomorrow, Yvonne favours LAVA over AWAY.",
+        "The quick brown fox jumps over the lazy dog",
+        "VA Te Vo Ya F, P, T. L' Ty We Kj 0123456789",
+    };
+    *glyphs = 0;
+    for (int i = 0; i < BENCH_LINES; i++) {
+        snprintf(lines[i], 96, "%s %04d", samples[i % 4], i);
+        *glyphs += strlen(lines[i]);
+    }
+}
+
+// Best-of-N seconds to emit every line through render_text
+static double time_render(Font* font, char lines[][96]) {
+    Color white = {1.0f, 1.0f, 1.0f, 1.0f};
+    double best = 1e30;
+    for (int run = 0; run < BENCH_RUNS; run++) {
+        renderer_begin(1280, 720);
+        double start = now_seconds();
+        for (int i = 0; i < BENCH_LINES; i++) {
+            render_text(font, lines[i], 0.0f, (float)(i % 40) * 18.0f, white);
+        }
+        text_renderer_flush();
+        double elapsed = now_seconds() - start;
+        renderer_end();
+        if (elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+// Best-of-N seconds to measure every line with an empty layout cache
+static double time_measure(Font* font, char lines[][96]) {
+    double best = 1e30;
+    float sink = 0.0f;
+    for (int run = 0; run < BENCH_RUNS; run++) {
+        text_layout_clear();
+        double start = now_seconds();
+        for (int i = 0; i < BENCH_LINES; i++) {
+            float w, h;
+            text_measure(font, lines[i], &w, &h);
+            sink += w;
+        }
+        double elapsed = now_seconds() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    if (sink < 0.0f) printf("%f\n", sink);  // keep the loop
+    return best;
+}
+
+int main(int argc, char** argv) {
+    const char* font_path = argc > 1 ? argv[1] : BENCH_DEFAULT_FONT;
+
+    if (!glfwInit()) {
+        fprintf(stderr, "glfwInit failed\n");
+        return 1;
+    }
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    GLFWwindow* window = glfwCreateWindow(1280, 720, "text_kerning_bench", NULL, NULL);
+    if (!window) {
+        fprintf(stderr, "could not create a GL 3.3 context\n");
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    gladLoadGL((GLADloadfunc)glfwGetProcAddress);
+    renderer_init();
+
+    Font* font = font_load(font_path, BENCH_FONT_SIZE);
+    if (!font) {
+        fprintf(stderr, "could not load %s (pass a .ttf path)\n", font_path);
+        glfwTerminate();
+        return 1;
+    }
+
+    static char lines[BENCH_LINES][96];
+    size_t glyphs;
+    make_lines(lines, &glyphs);
+    for (int i = 0; i < 4; i++) font_preload(font, lines[i], BENCH_FONT_SIZE);
+
+    printf("Text kerning benchmark: %s, %d lines / %zu glyphs, best of %d runs\n",
+           font_path, BENCH_LINES, glyphs, BENCH_RUNS);
+    printf("%-10s %-8s %10s %12s\n", "path", "kerning", "ms", "Mglyphs/s");
+
+    double results[2][2];
+    for (int enabled = 1; enabled >= 0; enabled--) {
+        font_set_kerning(font, enabled);
+        results[enabled][0] = time_render(font, lines);
+        results[enabled][1] = time_measure(font, lines);
+    }
+    static const char* paths[2] = {"render", "measure"};
+    for (int p = 0; p < 2; p++) {
+        for (int enabled = 0; enabled <= 1; enabled++) {
+            double seconds = results[enabled][p];
+            printf("%-10s %-8s %10.3f %12.2f\n", paths[p], enabled ? "on" : "off",
+                   seconds * 1000.0, (double)glyphs / seconds * 1e-6);
+        }
+        printf("%-10s kerning costs %+.1f%%\n", paths[p],
+               (results[1][p] / results[0][p] - 1.0) * 100.0);
+    }
+
+    font_destroy(font);
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
@@ -61,10 +61,12 @@
 
     pb.texture
     ----------
-    pb.texture.load(filepath)                 -> Texture | nil, error
+    pb.texture.load(filepath, opts?)          -> Texture | nil, error  -- opts: {mipmaps, filter, wrap, lod_bias, format}
     pb.texture.load_with_colorkey(filepath, r, g, b) -> Texture | nil, error
-    pb.texture.create(w, h, data?)            -> Texture | nil, error
+    pb.texture.create(w, h, data?)            -> Texture | nil, error  -- data: string, byte buffer or table
     pb.texture.flush()                        -- Flush pending texture draws
+    pb.texture.set_memory_budget(bytes|nil)   -- evict least-recently-drawn file textures above it
+    pb.texture.memory_stats()                 -> {texture_bytes, font_bytes, total_bytes, evicted, ...}
     -- Texture methods:
     texture:draw(x, y, w?, h?)
     texture:draw_tinted(x, y, w, h, r, g, b, a?)
@@ -72,6 +74,14 @@
     texture:draw_ex(x, y, w, h, angle, ox, oy, r, g, b, a?)
     texture:draw_region(x, y, w, h, sx, sy, sw, sh)
     texture:draw_region_ex(x,y,w,h, sx,sy,sw,sh, angle,ox,oy, r,g,b,a?)
+    texture:draw_nine_slice(x,y,w,h, left,right,top,bottom, opts?)  -- opts: {r,g,b,a, tile, src_x,src_y,src_w,src_h}
+    texture:update_from(data, x?, y?, w?, h?) -> true | false, error
+    texture:set_filter("nearest"|"linear")
+    texture:set_wrap(s, t?)                   -- "clamp" | "repeat" | "mirror"
+    texture:set_lod_bias(bias)
+    texture:generate_mipmaps()                -> levels
+    texture:get_mip_count()                   -> number
+    texture:get_format()                      -> "rgba8"|"r8"|"rg8"|"rgb565"|"rgba4"
     texture:get_size()                        -> width, height
     texture:get_width()                       -> number
     texture:get_height()                      -> number
@@ -111,14 +121,55 @@
 
     pb.text
     -------
-    pb.text.load(filepath, size?)             -> Font | nil, error
+    pb.text.load(filepath, size?, opts?)      -> Font | nil, error  -- opts: {sdf}
+    pb.text.load_async(filepath, size?, opts?) -> FontLoad | nil, error  -- worker thread rasterizes
+    pb.text.load_bmfont(filepath, size?, opts?) -> Font | nil, error  -- BMFont .fnt; opts: {filter}
+    -- FontLoad methods:
+    load:is_done()                            -> boolean
+    load:get()                                -> Font | nil, error  -- waits; uploads the atlas
+    pb.text.grid(cols, rows, font)            -> TextGrid | nil, error  -- console-style character grid
+    -- TextGrid methods (0-based cells; colors are tables, fg default white, bg transparent):
+    grid:set(col, row, char, fg?, bg?)        -- char: string or code point
+    grid:print(col, row, text, fg?, bg?)      -> cells written
+    grid:fill(col, row, w, h, char, fg?, bg?)
+    grid:clear(bg?) / grid:scroll(lines, bg?) -- scroll > 0 moves the contents up
+    grid:get(col, row)                        -> codepoint, fg, bg
+    grid:draw(x, y)                           -> rows rebuilt  -- one draw call; only changed rows upload
+    grid:get_size()                           -> cols, rows
+    grid:get_cell_size()                      -> width, height
+    grid:get_dirty_rows()                     -> number
+    grid:set_font(font) / grid:destroy()
     pb.text.flush()                           -- Flush pending text draws
+    pb.text.set_cache_dir(dir|nil)            -> boolean  -- persistent atlas cache (keyed by font, size)
+    pb.text.get_cache_dir()                   -> string | nil
+    pb.text.disk_cache_stats()                -> {hits, misses, writes, cold_loads, cold_ms, warm_loads, warm_ms}
+    pb.text.reset_disk_cache_stats()
+    pb.text.cache_stats()                     -> {frame_misses, current_misses, hits, misses, evictions, glyphs, pages, sizes, layouts,
+                                              --    layout_frame_hits, layout_frame_misses, layout_entries}
     -- Font methods:
     font:draw(text, x, y, color)
-    font:measure(text)                        -> width, height
+    font:draw(text, x, y, size, color?)       -- another size; the 4 most recent sizes stay cached
+    font:draw_layout(text, x, y, opts, color?) -- opts: {width, size, wrap="word"|"char"|"none",
+                                              --   align="left"|"center"|"right"|"justify", line_spacing}
+    font:measure(text, size?)                 -> width, height   -- cached per label
+    font:measure_layout(text, opts)           -> width, height, lines
     font:set_size(size)
     font:get_size()                           -> number
-    font:get_line_height()                    -> number
+    font:get_line_height(size?)               -> number
+    font:preload(text, size?)                 -> number   -- rasterize UTF-8 characters ahead of time
+    font:get_glyph_count()                    -> number
+    font:set_effects(fx?)                     -- SDF only; fx: {outline, outline_color, glow, glow_color,
+                                              --   shadow_x, shadow_y, shadow_softness, shadow_color}
+    font:is_sdf()                             -> boolean
+    font:set_kerning(enabled) / font:get_kerning() -- on by default
+    font:create_text(text, opts?)             -> Text   -- retained; opts: layout opts + {gpu}
+    -- Text methods:
+    text:draw(x, y, color?)                   -- copies cached quads; no re-layout
+    text:set_text(str) / text:get_text()      -- re-layout only when the string changes
+    text:set_font(font, size?) / text:set_font_size(size) / text:get_font_size()
+    text:set_layout(opts)                     -- width, wrap, align, line_spacing
+    text:get_size()                           -> width, height
+    text:destroy()
     font:destroy()
 
     pb.time
@@ -193,6 +244,69 @@
     pb.ui.panel(title, x, y, w, h)            -- Draw a panel with title bar
     pb.ui.button(id, label, x, y, w, h, r?, g?, b?) -> boolean (clicked)
     pb.ui.slider(id, label, x, y, w, h, val, min, max) -> number (value)
+    pb.ui.list(id, x, y, w, h, rows, opts?)    -> selected?, clicked?, first, last (rows: strings or count)
+    pb.ui.table(id, x, y, w, h, cols, rows, opts?) -> selected?, clicked?, first, last
+        -- opts: row_height (number|fn(row)), revision, text = fn(row, col), draw = fn(row, [col,] x, y, w, h, sel)
+    pb.ui.stats()                              -> {draw_calls, vertices, rows, widgets, collected, collisions}
+    pb.ui.get_state(id, i?)                    -> number, created (per-widget slot i = 1..8)
+    pb.ui.set_state(id, i, value)              -- Store a number in a widget's state slot
+
+    pb.sprite
+    ---------
+    pb.sprite.grid(texture, fw, fh, opts?)     -> SpriteSheet | nil, error  -- opts: {count, margin, spacing}
+    pb.sprite.load_atlas(json_path, texture?)  -> SpriteSheet | nil, error  -- Aseprite / TexturePacker JSON
+    pb.sprite.new_set(sheet, capacity?)        -> SpriteSet
+    -- SpriteSheet methods:
+    sheet:add_clip(name, frames, opts?)        -> true | false, error  -- opts: {fps, mode = "loop"|"once"|"pingpong"}
+    sheet:has_clip(name)                       -> boolean
+    sheet:get_clip_names()                     -> string[]
+    sheet:get_frame_count()                    -> number
+    sheet:find_frame(name)                     -> index | nil
+    sheet:get_frame(index)                     -> x, y, w, h
+    sheet:draw_frame(index, x, y, sx?, sy?)
+    -- SpriteSet methods:
+    sprites:add(x, y, opts?)                   -> id  -- opts: {clip, frame, scale, angle, flip_x, r, g, b, a, ...}
+    sprites:set(id, opts)
+    sprites:remove(id) / sprites:clear() / sprites:count()
+    sprites:set_position(id, x, y) / sprites:get_position(id)
+    sprites:play(id, clip, restart?) / sprites:stop(id) / sprites:is_playing(id)
+    sprites:get_frame(id)                      -> sheet frame index
+    sprites:update(dt?)                        -- dt defaults to pb.time.delta()
+    sprites:draw_all(dt?)                      -- advance + draw every sprite in one batch
+
+    pb.tilemap
+    ----------
+    pb.tilemap.new(w, h, tw, th, texture, opts?) -> Tilemap | nil, error  -- opts: {layers, margin, spacing}
+    pb.tilemap.load_tiled(path, texture?)      -> Tilemap | nil, error  -- Tiled JSON (.tmj)
+    pb.tilemap.load_csv(path, texture, tw, th, opts?) -> Tilemap | nil, error  -- opts: {one_based}
+    -- Tilemap methods (layers 1-based, tiles 0-based, tile id 0 = empty):
+    map:set(layer, x, y, tile) / map:get(layer, x, y) / map:fill(layer, x, y, w, h, tile)
+    map:add_layer(name?) -> index / map:find_layer(name) / map:get_layer_count()
+    map:set_layer_visible(layer, bool) / map:set_layer_opacity(layer, a)
+    map:set_animation(tile, frames, duration?) -> true | false, error
+    map:draw(x?, y?, layer?)                   -> chunks drawn (off-screen chunks culled)
+    map:get_size() / map:get_tile_size() / map:world_to_tile(wx, wy)
+    map:stats()                                -> {chunks_drawn, chunk_rebuilds, chunks, animations}
+
+    pb.particles
+    ------------
+    pb.particles.new(opts?)                    -> ParticleEmitter  -- opts: {capacity, texture, x, y, rate, shape, radius,
+                                               --   width, height, radial, angle, spread, speed, life, spin,
+                                               --   gravity_x, gravity_y, drag, size, sizes, colors, additive}
+    -- ParticleEmitter methods:
+    emitter:set(opts) / emitter:set_texture(texture?)
+    emitter:set_position(x, y) / emitter:get_position()
+    emitter:emit(n)                            -> spawned
+    emitter:start() / emitter:stop() / emitter:is_emitting()
+    emitter:update(dt?)                        -- dt defaults to pb.time.delta()
+    emitter:draw()                             -- one instanced draw call
+    emitter:count() / emitter:get_capacity() / emitter:clear()
+    pb.particles.new_gpu(opts?)                -> GpuParticles  -- same opts plus {count, prewarm}; simulated on the GPU
+    -- GpuParticles methods:
+    system:set(opts) / system:set_texture(texture?) / system:set_position(x, y)
+    system:start() / system:stop() / system:is_emitting()
+    system:update(dt?) / system:prewarm(seconds) / system:reset()
+    system:draw() / system:get_count()
 ]]
 
 -- Example: Color cycling demo with gradient and UI overlay
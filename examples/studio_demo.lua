@@ -43,7 +43,6 @@ local env = {
     -- File browser
     dir_atual  = "./",
     arquivos   = nil,  -- carregado sob demanda
-    scroll_y   = 0,
 
     -- Log de mensagens
     log = {},
@@ -255,7 +254,6 @@ while not pb.window.should_close(window) do
             if env.dir_atual ~= "/" then
                 env.dir_atual = env.dir_atual:match("(.+)/") or "/"
                 carregar_arquivos()
-                env.scroll_y = 0
                 log_msg("Dir: " .. env.dir_atual)
             end
         end
@@ -266,63 +264,31 @@ while not pb.window.should_close(window) do
             log_msg("Recarregado: " .. env.dir_atual)
         end
 
-        -- Lista de arquivos
-        local ly = MAIN_Y + 100
-        local max_visible = math.floor((MAIN_H - 110) / 24)
+        -- Lista de arquivos (virtualizada: so as linhas visiveis sao lidas)
         if env.arquivos then
             local total = #env.arquivos
             pb.ui.label(string.format("%d itens", total), MAIN_X + 314, MAIN_Y + 68,
                 COR_TEXTO_DIM[1], COR_TEXTO_DIM[2], COR_TEXTO_DIM[3], 1.0)
 
-            local start_i = env.scroll_y + 1
-            local end_i = math.min(start_i + max_visible - 1, total)
-
-            for i = start_i, end_i do
-                local nome = env.arquivos[i]
-                local is_dir = nome:sub(-1) == "/"
-                local cor = is_dir and { 0.4, 0.6, 0.9 } or COR_TEXTO_DIM
-
-                -- Fundo alternado
-                if (i % 2) == 0 then
-                    pb.renderer.rect_filled(MAIN_X + 10, ly - 2, MAIN_W - 20, 22,
-                        1.0, 1.0, 1.0, 0.03)
-                end
-
-                if is_dir then
-                    if pb.ui.button("file_" .. i, nome, MAIN_X + 14, ly, MAIN_W - 28, 20,
-                            0.18, 0.22, 0.30) then
-                        env.dir_atual = env.dir_atual .. "/" .. nome:sub(1, -2)
-                        carregar_arquivos()
-                        env.scroll_y = 0
-                        log_msg("Dir: " .. env.dir_atual)
-                    end
-                else
-                    pb.ui.label(nome, MAIN_X + 20, ly + 2, cor[1], cor[2], cor[3], 1.0)
-                    -- Mostra horário de modificação
-                    local mtime = pb.studio.get_file_modified_time(env.dir_atual .. "/" .. nome)
-                    if mtime and font_small then
-                        font_small:draw(
-                            string.format("%.0f", mtime),
-                            MAIN_X + MAIN_W - 140, ly + 3,
-                            0.35, 0.35, 0.40, 1.0)
-                    end
-                end
-                ly = ly + 24
-            end
-
-            -- Scroll com setas
-            if total > max_visible then
-                if pb.input.is_key_pressed(pb.input.KEY_DOWN) then
-                    env.scroll_y = math.min(env.scroll_y + 1, total - max_visible)
-                end
-                if pb.input.is_key_pressed(pb.input.KEY_UP) then
-                    env.scroll_y = math.max(env.scroll_y - 1, 0)
-                end
-                pb.ui.label(
-                    string.format("Scroll: %d/%d (setas UP/DOWN)",
-                        env.scroll_y + 1, total - max_visible + 1),
-                    MAIN_X + 14, MAIN_Y + MAIN_H - 20,
-                    COR_TEXTO_DIM[1], COR_TEXTO_DIM[2], COR_TEXTO_DIM[3], 1.0)
+            -- Um id por diretorio: a rolagem volta ao topo ao trocar de pasta
+            local colunas = { "Nome", { title = "Modificado", width = 140 } }
+            local _, clicado = pb.ui.table("arquivos:" .. env.dir_atual,
+                MAIN_X + 10, MAIN_Y + 100, MAIN_W - 20, MAIN_H - 110, colunas, total, {
+                    text = function(i, coluna)
+                        local nome = env.arquivos[i]
+                        if coluna == 1 then return nome end
+                        if nome:sub(-1) == "/" then return "" end
+                        local mtime = pb.studio.get_file_modified_time(env.dir_atual .. "/" .. nome)
+                        return mtime and string.format("%.0f", mtime) or ""
+                    end,
+                })
+
+            -- Clique em uma pasta entra nela
+            local nome = clicado and env.arquivos[clicado]
+            if nome and nome:sub(-1) == "/" then
+                env.dir_atual = env.dir_atual .. "/" .. nome:sub(1, -2)
+                carregar_arquivos()
+                log_msg("Dir: " .. env.dir_atual)
             end
         end
 
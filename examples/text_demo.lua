@@ -35,12 +35,22 @@ local font_medium = pb.text.load(font_path, 28)
 local font_large = pb.text.load(font_path, 48)
 local font_title = pb.text.load(font_path, 64)
 
+-- SDF font: one atlas for every size, with an outline and a soft shadow
+local font_sdf = pb.text.load(font_path, 32, { sdf = true })
+font_sdf:set_effects({
+    outline = 2, outline_color = { r = 0.1, g = 0.05, b = 0.2, a = 1 },
+    shadow_x = 3, shadow_y = 3, shadow_softness = 3,
+})
+
 print("Font sizes loaded: " .. font_small:get_size() .. ", " ..
       font_medium:get_size() .. ", " ..
       font_large:get_size() .. ", " ..
       font_title:get_size())
 
 -- Colors
+-- Retained label: laid out once, re-laid out only when the string changes
+local fps_label = font_small:create_text("FPS: 0")
+
 local white = pb.renderer.color(1, 1, 1)
 local red = pb.renderer.color(1, 0.2, 0.2)
 local green = pb.renderer.color(0.2, 1, 0.2)
@@ -81,10 +91,22 @@ while not pb.window.should_close(window) do
     -- Multi-line text
     font_medium:draw("Line 1: Multi-line\nLine 2: text support\nLine 3: works great!", 20, 410, green)
 
+    -- Wrapped, justified paragraph (laid out once, then served from the layout cache)
+    font_small:draw_layout("Text is wrapped at word boundaries to fit the given width and "
+        .. "each line is stretched to both edges, without measuring words from Lua.",
+        480, 300, { width = 290, align = "justify", line_spacing = 1.2 }, white)
+
+    -- SDF text pulsing in size stays sharp without re-rasterizing
+    local pulse = 40 + 12 * math.sin(pb.time.get() * 2)
+    font_sdf:draw("SDF", 560, 200, pulse, { r = 1, g = 0.6, b = 0.2, a = 1 })
+
+    -- UTF-8: accented and non-Latin characters are rasterized on first use
+    font_small:draw("Olá! Ação, coração, pão de queijo — Ελληνικά, Русский", 20, 520, white)
+
     -- FPS counter
-    local fps_text = string.format("FPS: %.0f", pb.time.fps())
-    local fps_w = font_small:measure(fps_text)
-    font_small:draw(fps_text, WIDTH - fps_w - 10, 10, yellow)
+    fps_label:set_text(string.format("FPS: %.0f", pb.time.fps()))
+    local fps_w = fps_label:get_size()
+    fps_label:draw(WIDTH - fps_w - 10, 10, yellow)
 
     -- Flush text before finishing
     pb.text.flush()
@@ -95,8 +117,10 @@ while not pb.window.should_close(window) do
 end
 
 -- Cleanup
+fps_label:destroy()
 font_small:destroy()
 font_medium:destroy()
 font_large:destroy()
 font_title:destroy()
+font_sdf:destroy()
 pb.window.destroy(window)
@@ -17,6 +17,9 @@
 ---@field math PudimBasicsGl.math Vector math and utility functions
 ---@field studio PudimBasicsGl.studio Tools for building editors, studios, and exporters
 ---@field ui PudimBasicsGl.ui Immediate-mode GUI module (panels, buttons, sliders)
+---@field sprite PudimBasicsGl.sprite Sprite sheets and animated sprite sets
+---@field tilemap PudimBasicsGl.tilemap Chunked tilemaps (Tiled JSON / CSV import)
+---@field particles PudimBasicsGl.particles Pooled CPU particle emitters and GPU particle systems
 local PudimBasicsGl = {}
 
 --------------------------------------------------------------------------------
@@ -464,10 +467,30 @@ function PudimBasicsGl.renderer.enable_depth_test(enable) end
 
 ---Enable or disable **alpha blending**.
 ---
----Blending is enabled by default with `SRC_ALPHA, ONE_MINUS_SRC_ALPHA`.
+---Blending is enabled by default with `SRC_ALPHA, ONE_MINUS_SRC_ALPHA`
+---(`ONE, ONE_MINUS_SRC_ALPHA` in premultiplied-alpha mode).
 ---@param enable boolean `true` to enable, `false` to disable
 function PudimBasicsGl.renderer.enable_blend(enable) end
 
+---Enable or disable **premultiplied-alpha** mode (off by default).
+---
+---When enabled, textures, text and primitives blend with `ONE, ONE_MINUS_SRC_ALPHA`:
+---colors are premultiplied in the shaders and textures loaded afterwards are
+---premultiplied on the CPU (SIMD accelerated). This removes dark fringes around
+---linearly filtered sprites. Textures loaded before the switch still draw correctly.
+---
+---### Example
+---```lua
+---pb.renderer.set_premultiplied_alpha(true)
+---local sprite = pb.texture.load("assets/smoke.png")  -- premultiplied on load
+---```
+---@param enable boolean
+function PudimBasicsGl.renderer.set_premultiplied_alpha(enable) end
+
+---Check whether premultiplied-alpha mode is enabled.
+---@return boolean enabled
+function PudimBasicsGl.renderer.get_premultiplied_alpha() end
+
 ---Set the OpenGL **viewport** rectangle.
 ---@param x integer Viewport X offset
 ---@param y integer Viewport Y offset
@@ -483,7 +506,7 @@ function PudimBasicsGl.renderer.set_viewport(x, y, width, height) end
 ---print(info.version)   -- e.g. "4.6 (Core Profile) Mesa 26.0.1"
 ---print(info.renderer)  -- e.g. "AMD Radeon RX 6600"
 ---```
----@return table info Table with fields: `version`, `renderer`, `vendor`, `glsl_version`
+---@return table info Table with fields: `version`, `renderer`, `vendor`, `glsl_version`, `simd` (CPU pixel path: `"scalar"`, `"sse2"`, `"avx2"` or `"neon"`)
 function PudimBasicsGl.renderer.get_info() end
 
 ---Start **UI rendering mode** (screen-space, ignores camera).
@@ -561,6 +584,14 @@ PudimBasicsGl.texture = {}
 ---@field draw_ex fun(self: Texture, x: integer, y: integer, width: integer, height: integer, angle: number, origin_x?: number, origin_y?: number, r?: number, g?: number, b?: number, a?: number) Draw with full options
 ---@field draw_region fun(self: Texture, x: integer, y: integer, width: integer, height: integer, src_x: integer, src_y: integer, src_width: integer, src_height: integer) Draw a portion of texture (sprite sheet)
 ---@field draw_region_ex fun(self: Texture, x: integer, y: integer, width: integer, height: integer, src_x: integer, src_y: integer, src_width: integer, src_height: integer, angle?: number, origin_x?: number, origin_y?: number, r?: number, g?: number, b?: number, a?: number) Draw region with full options
+---@field draw_nine_slice fun(self: Texture, x: integer, y: integer, width: integer, height: integer, left: integer, right: integer, top: integer, bottom: integer, options?: NineSliceOptions) Draw a nine-slice panel in one call (borders in source pixels; corners keep their size)
+---@field set_filter fun(self: Texture, filter: TextureFilter) Set the sampling filter (shared by all handles of a loaded file)
+---@field set_wrap fun(self: Texture, wrap_s: TextureWrap, wrap_t?: TextureWrap) Set wrap modes (`wrap_t` defaults to `wrap_s`)
+---@field set_lod_bias fun(self: Texture, bias: number) Bias mip selection; positive values sample smaller levels when zoomed out
+---@field generate_mipmaps fun(self: Texture): integer Build mip levels on the GPU (for created/streamed textures); returns the level count
+---@field get_mip_count fun(self: Texture): integer Number of mip levels (1 = none)
+---@field get_format fun(self: Texture): TextureFormat GPU storage format
+---@field update_from fun(self: Texture, data: string|userdata|table, x?: integer, y?: integer, width?: integer, height?: integer): boolean, string? Upload new RGBA pixels into the whole texture (or a region) — for streaming procedural or video frames
 ---@field get_size fun(self: Texture): integer, integer Get texture dimensions
 ---@field get_width fun(self: Texture): integer Get texture width
 ---@field get_height fun(self: Texture): integer Get texture height
@@ -570,18 +601,60 @@ PudimBasicsGl.texture = {}
 ---
 ---Supports **PNG**, **JPG**, **BMP**, **TGA** and other formats via `stb_image`.
 ---
+---Loads are **shared**: loading the same file (same canonical path and options,
+---including `filter`, `wrap` and `lod_bias`) again returns a handle to the
+---already-loaded GL texture; a load with different sampling options gets its
+---own texture. Methods like `:set_filter()` still change every handle of a
+---shared texture. Each handle holds a
+---reference that is dropped by `:destroy()` or garbage collection; textures with
+---no references stay cached until `pb.texture.purge_unused()`.
+---
 ---Returns `nil, error_string` on failure (does **not** throw).
 ---
 ---### Example
 ---```lua
 ---local tex, err = pb.texture.load("assets/player.png")
 ---if not tex then print("Error: " .. err) end
+---
+----- Large sheet seen through a zoomed-out camera: mipmapped + trilinear
+---local sheet = pb.texture.load("assets/world.png", { mipmaps = true, filter = "linear" })
+---
+----- Alpha mask stored in 1 byte per pixel (samples as white with alpha)
+---local mask = pb.texture.load("assets/light_mask.png", { format = "r8" })
 ---```
----@overload fun(self: PudimBasicsGl.texture, filepath: string): Texture?
+---@overload fun(self: PudimBasicsGl.texture, filepath: string, options?: TextureLoadOptions): Texture?
 ---@param filepath string Path to the image file
+---@param options? TextureLoadOptions Mipmap and sampler options
 ---@return Texture? texture The loaded texture, or `nil` on failure
 ---@return string? error Error message if loading failed
-function PudimBasicsGl.texture.load(filepath) end
+function PudimBasicsGl.texture.load(filepath, options) end
+
+---@alias TextureFilter "nearest"|"linear"
+---@alias TextureWrap "clamp"|"repeat"|"mirror"
+
+---GPU storage format. Reduced formats trade precision for memory:
+---`r8` (1 byte: images with alpha sample as white with that alpha, opaque
+---images as their gray level), `rg8` (2 bytes, gray + alpha), `rgb565` (2 bytes, opaque),
+---`rgba4` (2 bytes). `"auto"` picks from the source channel count.
+---@alias TextureFormat "rgba8"|"r8"|"rg8"|"rgb565"|"rgba4"
+
+---@class NineSliceOptions
+---@field r? number Tint red (`0`–`1`)
+---@field g? number Tint green (`0`–`1`)
+---@field b? number Tint blue (`0`–`1`)
+---@field a? number Tint alpha (`0`–`1`)
+---@field tile? boolean Repeat the center and edges instead of stretching them
+---@field src_x? integer Source rect inside the texture (default: whole texture)
+---@field src_y? integer
+---@field src_w? integer
+---@field src_h? integer
+
+---@class TextureLoadOptions
+---@field mipmaps? boolean Build a gamma-correct mip chain on load (stored in the disk cache too)
+---@field filter? TextureFilter Sampling filter (default `"nearest"`; `"linear"` is trilinear with mipmaps)
+---@field wrap? TextureWrap Wrap mode for both axes (default `"clamp"`)
+---@field lod_bias? number Mip LOD bias; positive values sample smaller levels
+---@field format? TextureFormat|"auto" Storage format (default `"rgba8"`)
 
 ---Load a texture with **chroma key** transparency.
 ---
@@ -612,11 +685,16 @@ function PudimBasicsGl.texture.load_with_colorkey(filepath, r, g, b) end
 ---    0,0,255,255,   255,0,0,255,
 ---}
 ---local tex = pb.texture.create(2, 2, data)
+---
+----- Binary strings (or byte buffer userdata) are uploaded without a copy,
+----- which is much faster than a table for large images
+---local pixels = string.rep("\255\0\0\255", 256 * 256)
+---local big = pb.texture.create(256, 256, pixels)
 ---```
----@overload fun(self: PudimBasicsGl.texture, width: integer, height: integer, data?: table): Texture?
+---@overload fun(self: PudimBasicsGl.texture, width: integer, height: integer, data?: string|userdata|table): Texture?
 ---@param width integer Texture width in pixels
 ---@param height integer Texture height in pixels
----@param data? table Optional array of RGBA bytes (`width * height * 4` values, each `0`–`255`)
+---@param data? string|userdata|table Optional RGBA bytes (`width * height * 4`): a binary string, a byte buffer userdata, or an array of values `0`–`255`
 ---@return Texture? texture The created texture, or `nil` on failure
 ---@return string? error Error message if creation failed
 function PudimBasicsGl.texture.create(width, height, data) end
@@ -626,6 +704,122 @@ function PudimBasicsGl.texture.create(width, height, data) end
 ---Normally handled automatically by batch switching.
 function PudimBasicsGl.texture.flush() end
 
+---Enable the **pre-decoded texture cache** in `dir` (created if missing).
+---
+---The first load of an image writes its decoded pixels (after colorkey) to
+---`dir`; later loads of the same path and options map that file and upload it
+---directly, skipping image decoding. Entries are invalidated automatically when
+---the source file's modification time or size changes. Pass `nil` to disable.
+---
+---### Example
+---```lua
+---pb.texture.set_cache_dir(".cache/textures")
+---local tex = pb.texture.load("assets/tiles.png") -- decoded once, cached
+---```
+---@overload fun(self: PudimBasicsGl.texture, dir?: string): boolean, string?
+---@param dir? string Cache directory, or `nil` to disable caching
+---@return boolean ok `true` if the cache directory is usable
+---@return string? error Error message on failure
+function PudimBasicsGl.texture.set_cache_dir(dir) end
+
+---Get the current texture cache directory (`nil` when disabled).
+---@return string? dir
+function PudimBasicsGl.texture.get_cache_dir() end
+
+---Enable **LZ4 compression** for newly written cache files.
+---
+---Compressed entries are smaller on disk but must be decompressed on load;
+---uncompressed entries are uploaded straight from the memory mapping.
+---@overload fun(self: PudimBasicsGl.texture, enabled: boolean)
+---@param enabled boolean
+function PudimBasicsGl.texture.set_cache_compression(enabled) end
+
+---@class TextureDiskCacheStats
+---@field hits integer Loads served from a valid cache file
+---@field misses integer Lookups with no (or a stale) cache file
+---@field writes integer Cache files written
+---@field cold_loads integer Loads that decoded the source image
+---@field cold_ms number Total time spent in cold loads (milliseconds)
+---@field warm_loads integer Loads served from the cache
+---@field warm_ms number Total time spent in warm loads (milliseconds)
+
+---Get **disk cache statistics**, including cold vs warm load timings.
+---
+---### Example
+---```lua
+---local s = pb.texture.disk_cache_stats()
+---print(("cold %.2f ms avg, warm %.2f ms avg"):format(
+---    s.cold_ms / math.max(s.cold_loads, 1), s.warm_ms / math.max(s.warm_loads, 1)))
+---```
+---@return TextureDiskCacheStats stats
+function PudimBasicsGl.texture.disk_cache_stats() end
+
+---Reset the counters returned by `disk_cache_stats()`.
+function PudimBasicsGl.texture.reset_disk_cache_stats() end
+
+---@class TextureCacheStats
+---@field entries integer Textures held by the path registry
+---@field referenced integer Entries with at least one live handle
+---@field unreferenced integer Entries kept only by the registry (purgeable)
+---@field hits integer Loads that reused an existing texture
+---@field misses integer Loads that created a new texture
+
+---Get statistics for the **shared texture registry** used by `load()`.
+---@return TextureCacheStats stats
+function PudimBasicsGl.texture.cache_stats() end
+
+---Destroy every cached texture that no handle references anymore.
+---
+---### Example
+---```lua
+----- after unloading a level
+---collectgarbage()
+---print("freed", pb.texture.purge_unused(), "textures")
+---```
+---@return integer purged Number of textures destroyed
+function PudimBasicsGl.texture.purge_unused() end
+
+---Set a **GPU memory budget** in bytes for textures and font atlases.
+---
+---When usage goes over the budget, textures loaded from files are evicted,
+---least recently drawn first. Textures drawn in the current frame are never
+---evicted. Evicted textures keep their handles and are reloaded transparently
+---(from the disk cache when enabled, otherwise from the source file) the next
+---time they are drawn. Textures from `create()` and font atlases are counted
+---but never evicted. Pass `nil` or `0` to remove the limit.
+---
+---### Example
+---```lua
+---pb.texture.set_memory_budget(256 * 1024 * 1024)  -- 256 MB
+---```
+---@param bytes integer? Budget in bytes, or `nil` for unlimited
+function PudimBasicsGl.texture.set_memory_budget(bytes) end
+
+---Get the current memory budget in bytes (`nil` when unlimited).
+---@return integer? bytes
+function PudimBasicsGl.texture.get_memory_budget() end
+
+---@class TextureMemoryStats
+---@field texture_bytes integer GPU bytes used by resident textures (including mip levels)
+---@field font_bytes integer GPU bytes used by font atlases
+---@field total_bytes integer `texture_bytes + font_bytes`
+---@field budget integer? Budget in bytes (absent when unlimited)
+---@field textures integer Resident textures
+---@field font_atlases integer Font atlases
+---@field evicted integer Textures currently evicted
+---@field evictions integer Total evictions
+---@field reloads integer Total reloads of evicted textures
+
+---Get **GPU memory usage** for textures and font atlases.
+---
+---### Example
+---```lua
+---local m = pb.texture.memory_stats()
+---print(string.format("%.1f MB (%d evicted)", m.total_bytes / 1048576, m.evicted))
+---```
+---@return TextureMemoryStats stats
+function PudimBasicsGl.texture.memory_stats() end
+
 --------------------------------------------------------------------------------
 -- Time Module
 --------------------------------------------------------------------------------
@@ -883,6 +1077,22 @@ function PudimBasicsGl.audio.shutdown() end
 ---@class Font
 ---Opaque font handle (userdata). Loaded via `pb.text.load()`.
 ---
+---Text is **UTF-8**. Glyphs are rasterized the first time a character is drawn
+---or measured and kept in a per-font cache (printable ASCII is ready at load).
+---Invalid byte sequences draw as U+FFFD; characters missing from the font draw
+---as its "missing glyph" box.
+---
+---Each pixel size has its own glyph cache and a font keeps the 4 most recently
+---used sizes, so drawing one font at several sizes in a frame (or switching
+---back with `set_size`) does not rasterize again.
+---
+---Text is **kerned** (pairs like "AV" or "To" move closer) when the font has
+---kerning data; `font:set_kerning(false)` turns it off.
+---
+---Fonts loaded with `{ sdf = true }` store **signed distance fields** instead:
+---one small atlas stays sharp at every size and camera zoom, and supports
+---outline, glow and shadow effects (`font:set_effects()`).
+---
 ---Automatically freed by **garbage collection**, or manually via `:destroy()`.
 ---
 ---### Example
@@ -890,37 +1100,285 @@ function PudimBasicsGl.audio.shutdown() end
 ---local font = pb.text.load("fonts/NotoSans.ttf", 24)
 ---font:draw("Hello!", 10, 10, 1.0, 1.0, 1.0, 1.0)
 ---local w, h = font:measure("Hello!")
+---font:draw("Ação, coração!", 10, 40, 1.0, 1.0, 1.0)
+---font:draw("Título", 10, 80, 48, { r = 1, g = 0.8, b = 0.2 }) -- same font at 48px
 ---```
----@field draw fun(self: Font, text: string, x: number, y: number, r: number|Color, g?: number, b?: number, a?: number) Draw text at position with color
----@field measure fun(self: Font, text: string): number, number Measure text width and height without drawing
----@field set_size fun(self: Font, size: number) Change font size (re-rasterizes the glyph atlas)
+---@field draw fun(self: Font, text: string, x: number, y: number, r: number|Color, g?: number, b?: number, a?: number) Draw text at position with color. `font:draw(text, x, y, size, color?)` draws at another pixel size without changing the current one
+---@field draw_layout fun(self: Font, text: string, x: number, y: number, options: TextLayoutOptions, r?: number|Color, g?: number, b?: number, a?: number) Draw wrapped / aligned text with its top-left corner at `x, y` (default color: white)
+---@field measure fun(self: Font, text: string, size?: number): number, number Measure text width and height without drawing (at `size`, default: current size)
+---@field measure_layout fun(self: Font, text: string, options: TextLayoutOptions): number, number, integer Width of the widest line, total height and line count of wrapped text
+---@field set_size fun(self: Font, size: number) Change the current font size (reuses cached glyphs for recently used sizes)
 ---@field get_size fun(self: Font): number Get current font size in pixels
----@field get_line_height fun(self: Font): number Get line height in pixels
+---@field get_line_height fun(self: Font, size?: number): number Get line height in pixels (at `size`, default: current size)
+---@field preload fun(self: Font, text: string, size?: number): integer Rasterize every character of `text` now (e.g. on a loading screen); returns how many were missing
+---@field get_glyph_count fun(self: Font): integer Number of glyphs currently cached (all sizes)
+---@field set_effects fun(self: Font, effects?: TextEffects) Set outline / glow / shadow for an SDF font (`nil` clears them); errors on bitmap fonts
+---@field is_sdf fun(self: Font): boolean Whether the font renders from signed distance fields
+---@field set_kerning fun(self: Font, enabled: boolean) Turn kerning on or off (default: on)
+---@field get_kerning fun(self: Font): boolean Whether kerning is on
+---@field create_text fun(self: Font, text: string, options?: TextObjectOptions): Text?, string? Create a retained text object (see `Text`)
 ---@field destroy fun(self: Font) Destroy font and free resources
 
+---@class TextLayoutOptions
+---Line breaking and alignment for `font:draw_layout()`, `font:measure_layout()`
+---and text objects. Layouts are cached by font, options and string, so drawing
+---or measuring the same text every frame lays it out once
+---(see `layout_frame_hits` in `pb.text.cache_stats()`).
+---
+---### Example
+---```lua
+---local opts = { width = 300, align = "justify", line_spacing = 1.2 }
+---local w, h, lines = font:measure_layout(dialog, opts)
+---font:draw_layout(dialog, 20, 400, opts, { r = 1, g = 1, b = 1 })
+---```
+---@field width? number Wrap and align within this many pixels (default: no wrapping)
+---@field size? number Pixel size (default: the font's current size)
+---@field wrap? "word"|"char"|"none" Break at spaces (long words still break), before any character, or only at `\n` (default: `"word"`)
+---@field align? "left"|"center"|"right"|"justify" Alignment inside `width`, or the widest line without it; justify stretches spaces on wrapped lines (default: `"left"`)
+---@field line_spacing? number Multiple of the line height (default: `1`)
+
+---@class TextObjectOptions: TextLayoutOptions
+---@field gpu? boolean Keep the quads in a static GPU buffer and draw them with one call per atlas page
+
+---@class Text
+---Retained text created by `font:create_text()`. The string is laid out once;
+---drawing copies the cached glyph quads (or, with `gpu = true`, issues one
+---draw call from a static buffer) at any position and color. The layout is
+---rebuilt only when the text, font or size changes.
+---
+---Use it for labels that rarely change (HUDs, menus); `font:draw()` remains
+---best for text that changes every frame.
+---
+---### Example
+---```lua
+---local label = font:create_text("Pontuação")
+---local score = font:create_text("0")
+----- every frame:
+---label:draw(10, 10)
+---score:set_text(tostring(points))  -- lays out again only when points changed
+---score:draw(10, 40, 1, 0.8, 0.2)
+---```
+---@field draw fun(self: Text, x: number, y: number, r?: number|Color, g?: number, b?: number, a?: number) Draw at position with color (default: white)
+---@field set_text fun(self: Text, text: string) Replace the string (no-op when unchanged)
+---@field get_text fun(self: Text): string
+---@field set_font fun(self: Text, font: Font, size?: number) Use another font (and size)
+---@field set_font_size fun(self: Text, size: number) Change the pixel size
+---@field get_font_size fun(self: Text): number
+---@field set_layout fun(self: Text, options: TextLayoutOptions) Change wrapping and alignment (the size is kept unless given)
+---@field get_size fun(self: Text): number, number Laid-out width and height in pixels
+---@field destroy fun(self: Text) Free the text object (also done by garbage collection)
+
+---@class TextGrid
+---Character grid created by `pb.text.grid()` for consoles, logs and other
+---terminal-style views. Each cell holds one character with a foreground and a
+---background color; columns and rows are 0-based and cells are as wide as the
+---font's "M" (use a monospace font).
+---
+---The whole grid is one draw call. Only rows changed since the last draw are
+---rebuilt and uploaded, and `scroll()` moves rows without touching the others.
+---SDF fonts are drawn without effects.
+---
+---### Example
+---```lua
+---local console = pb.text.grid(80, 25, mono)
+---console:clear({ r = 0, g = 0, b = 0.2, a = 1 })
+---console:print(0, 0, "> ready", { r = 0.4, g = 1, b = 0.4, a = 1 })
+----- new log line:
+---console:scroll(1)
+---console:print(0, 24, message)
+----- every frame:
+---console:draw(10, 10)
+---```
+---@field set fun(self: TextGrid, col: integer, row: integer, char: string|integer, fg?: Color, bg?: Color) Set one cell (`char` is a character or code point; default fg: white, bg: transparent)
+---@field print fun(self: TextGrid, col: integer, row: integer, text: string, fg?: Color, bg?: Color): integer Write UTF-8 text clipped to the grid (`\n` continues at `col` on the next row); returns the cells written
+---@field fill fun(self: TextGrid, col: integer, row: integer, w: integer, h: integer, char: string|integer, fg?: Color, bg?: Color) Fill a rectangle of cells
+---@field clear fun(self: TextGrid, bg?: Color) Empty every cell
+---@field scroll fun(self: TextGrid, lines: integer, bg?: Color) Move the contents up by `lines` (down when negative); rows scrolled in are empty
+---@field get fun(self: TextGrid, col: integer, row: integer): integer?, Color?, Color? Code point (`0` = empty) and colors of a cell, or `nil` outside the grid
+---@field draw fun(self: TextGrid, x: number, y: number): integer Draw with the top-left corner at `x, y`; returns the rows rebuilt
+---@field get_size fun(self: TextGrid): integer, integer Columns and rows
+---@field get_cell_size fun(self: TextGrid): number, number Cell width and height in pixels (from the font's current size)
+---@field get_dirty_rows fun(self: TextGrid): integer Rows the next draw will rebuild
+---@field set_font fun(self: TextGrid, font: Font) Draw with another font
+---@field destroy fun(self: TextGrid) Free the grid (also done by garbage collection)
+
+---@class FontLoad
+---Pending font load returned by `pb.text.load_async()`. The font is parsed and
+---its ASCII glyphs rasterized on a worker thread; `get()` packs them into the
+---atlas on the calling thread.
+---@field is_done fun(self: FontLoad): boolean True once `get()` will not block
+---@field get fun(self: FontLoad): Font?, string? Wait if needed and return the font (the same Font on later calls), or `nil, error`
+
+---@class TextEffects
+---Effects for SDF fonts. Widths and offsets are in screen pixels; they reach at
+---most about `size / 5` pixels (the distance field's margin).
+---@field outline? number Outline width (default: `0`)
+---@field outline_color? Color Outline color (default: black)
+---@field glow? number Glow radius outside the outline (default: `0`)
+---@field glow_color? Color Glow color (default: white)
+---@field shadow_x? number Shadow offset to the right
+---@field shadow_y? number Shadow offset downwards
+---@field shadow_softness? number Shadow edge blur (default: `1`)
+---@field shadow_color? Color Shadow color (default: black at 50% when any shadow field is set)
+
+---@class TextLoadOptions
+---@field sdf? boolean Render from signed distance fields (one atlas for every size, supports effects)
+
 ---@class PudimBasicsGl.text
 PudimBasicsGl.text = {}
 
 ---Load a **TrueType** font file (`.ttf`) at a given pixel size.
 ---
+---Font files are memory-mapped; fonts loaded from the same file share one mapping.
+---
 ---Returns `nil, error_string` on failure (does **not** throw).
 ---
 ---### Example
 ---```lua
 ---local font = pb.text.load("/usr/share/fonts/noto/NotoSans-Regular.ttf", 20)
+---
+----- SDF font with an outline, drawn at any size
+---local title = pb.text.load("fonts/NotoSans.ttf", 32, { sdf = true })
+---title:set_effects({ outline = 2, outline_color = { r = 0, g = 0, b = 0, a = 1 } })
+---title:draw("Game Over", 100, 100, 96)
 ---```
----@overload fun(self: PudimBasicsGl.text, filepath: string, size?: number): Font?, string?
+---@overload fun(self: PudimBasicsGl.text, filepath: string, size?: number, options?: TextLoadOptions): Font?, string?
 ---@param filepath string Path to the `.ttf` font file
 ---@param size? number Font size in pixels (default: `24`)
+---@param options? TextLoadOptions
+---@return Font? font The loaded font, or `nil` on failure
+---@return string? error Error message if loading failed
+function PudimBasicsGl.text.load(filepath, size, options) end
+
+---@class BmFontLoadOptions
+---@field filter? "nearest"|"linear" Page sampling (default: `"nearest"`, crisp pixel fonts when scaled)
+
+---Load an **AngelCode BMFont** (`.fnt`, text or binary format) and its page images.
+---
+---Glyphs come straight from the pages: nothing is rasterized, so loading costs
+---little more than decoding the images. The font draws, measures, lays out and
+---kerns like a TrueType font; other sizes scale the one prebaked size. Glyphs
+---are tinted by the draw color (coverage comes from the page's alpha channel,
+---or red when it has none). Missing characters draw the font's "invalid char"
+---glyph (`id=-1`) when it has one.
+---
+---Returns `nil, error_string` on failure (does **not** throw).
+---
+---### Example
+---```lua
+---local pixel = pb.text.load_bmfont("fonts/pixel.fnt")       -- size it was made at
+---pixel:draw("SCORE 100", 8, 8, 2 * pixel:get_size())         -- 2x, still crisp
+---```
+---@param filepath string Path to the `.fnt` descriptor (pages are resolved next to it)
+---@param size? number Pixel size (default: the size the font was generated at)
+---@param options? BmFontLoadOptions
 ---@return Font? font The loaded font, or `nil` on failure
 ---@return string? error Error message if loading failed
-function PudimBasicsGl.text.load(filepath, size) end
+function PudimBasicsGl.text.load_bmfont(filepath, size, options) end
+
+---Create a **character grid** of `cols` x `rows` cells drawn with `font` (see `TextGrid`).
+---
+---Returns `nil, error_string` on failure (does **not** throw).
+---@param cols integer Columns (1-4096)
+---@param rows integer Rows (1-4096)
+---@param font Font Font to draw with, at its current size
+---@return TextGrid? grid
+---@return string? error
+function PudimBasicsGl.text.grid(cols, rows, font) end
+
+---Start loading a font on a worker thread, so large sizes do not stall the frame.
+---
+---Returns `nil, error_string` if the file cannot be opened.
+---
+---### Example
+---```lua
+---local pending = pb.text.load_async("fonts/NotoSans.ttf", 96)
+----- every frame:
+---if pending and pending:is_done() then
+---    title_font = pending:get()
+---    pending = nil
+---end
+---```
+---@param filepath string Path to the `.ttf` font file
+---@param size? number Font size in pixels (default: `24`)
+---@param options? TextLoadOptions
+---@return FontLoad? load Handle to poll, or `nil` on failure
+---@return string? error Error message if the file could not be opened
+function PudimBasicsGl.text.load_async(filepath, size, options) end
+
+---Enable the **persistent font atlas cache** in `dir` (created if missing).
+---
+---The first load of a font at a size writes its rasterized atlas, glyph metrics
+---and kerning table to `dir`; later loads of the same file and size map that
+---entry and upload it directly, skipping rasterization. Entries are invalidated
+---automatically when the font file's modification time or size changes.
+---Pass `nil` to disable.
+---
+---### Example
+---```lua
+---pb.text.set_cache_dir(".cache/fonts")
+---local font = pb.text.load("fonts/NotoSans.ttf", 48) -- rasterized once, cached
+---```
+---@overload fun(self: PudimBasicsGl.text, dir?: string): boolean, string?
+---@param dir? string Cache directory, or `nil` to disable caching
+---@return boolean ok `true` if the cache directory is usable
+---@return string? error Error message on failure
+function PudimBasicsGl.text.set_cache_dir(dir) end
+
+---Get the current font cache directory (`nil` when disabled).
+---@return string? dir
+function PudimBasicsGl.text.get_cache_dir() end
+
+---@class FontDiskCacheStats
+---@field hits integer Loads served from a valid cache file
+---@field misses integer Lookups with no (or a stale) cache file
+---@field writes integer Cache files written
+---@field cold_loads integer Loads that rasterized the font
+---@field cold_ms number Total time spent in cold loads (milliseconds)
+---@field warm_loads integer Loads served from the cache
+---@field warm_ms number Total time spent in warm loads (milliseconds)
+
+---Get **font disk cache statistics**, including cold vs warm load timings.
+---@return FontDiskCacheStats stats
+function PudimBasicsGl.text.disk_cache_stats() end
+
+---Reset the counters returned by `disk_cache_stats()`.
+function PudimBasicsGl.text.reset_disk_cache_stats() end
 
 ---Flush pending text draws to the GPU.
 ---
 ---Normally handled automatically by batch switching.
 function PudimBasicsGl.text.flush() end
 
+---@class TextCacheStats
+---@field frame_misses integer Glyphs rasterized during the last finished frame
+---@field current_misses integer Glyphs rasterized so far in the current frame
+---@field hits integer Total glyph cache hits
+---@field misses integer Total glyphs rasterized on demand
+---@field evictions integer Atlas pages cleared to make room (least recently drawn first)
+---@field glyphs integer Glyphs cached across all fonts
+---@field pages integer Atlas pages across all fonts
+---@field sizes integer Rasterized font sizes across all fonts
+---@field layouts integer Retained text layouts built (creation, changes, and glyph cache moves)
+---@field layout_frame_hits integer Measures and layouts served from the layout cache during the last finished frame
+---@field layout_frame_misses integer Layouts computed during the last finished frame
+---@field layout_entries integer Layouts currently cached
+
+---Get **glyph cache** statistics for all fonts.
+---
+---Glyphs missing from the cache are rasterized while drawing; a steady
+---`frame_misses` above zero means text keeps evicting pages, and a spike on
+---the first frame of a screen can be moved to a loading screen with
+---`font:preload()`.
+---
+---### Example
+---```lua
+---local s = pb.text.cache_stats()
+---print(s.frame_misses, s.glyphs, s.pages)
+---```
+---@return TextCacheStats stats
+function PudimBasicsGl.text.cache_stats() end
+
 --------------------------------------------------------------------------------
 -- Camera Module
 --------------------------------------------------------------------------------
@@ -1277,6 +1735,14 @@ function PudimBasicsGl.studio.copy_file(src, dest) end
 ---@class PudimBasicsGl.ui
 PudimBasicsGl.ui = {}
 
+---@class UiStats
+---@field draw_calls integer Draw calls issued by the UI draw list since `begin_frame()`
+---@field vertices integer Vertices submitted since `begin_frame()`
+---@field rows integer List and table rows drawn since `begin_frame()`
+---@field widgets integer Widgets with a state slot
+---@field collected integer State slots freed by the last `end_frame()` (widgets not drawn that frame)
+---@field collisions integer Distinct ids found sharing a hash (only detected in builds without `NDEBUG`)
+
 ---Set the font used by **all** UI widgets (labels, buttons, sliders).
 ---
 ---Must be called **before** `begin_frame()` (or at any time to switch fonts).
@@ -1309,6 +1775,47 @@ function PudimBasicsGl.ui.begin_frame() end
 ---Call **once per frame** after all UI widgets.
 function PudimBasicsGl.ui.end_frame() end
 
+---Draw counters for the current **UI frame**.
+---
+---Widgets append shapes and glyphs to one draw list in submission order, so a
+---whole frame is usually a single draw call. Extra calls come from drawing
+---something else between widgets, more than 4 font atlas pages in one batch,
+---or SDF fonts with outline/shadow effects (drawn by the text renderer).
+---
+---### Example
+---```lua
+---pb.ui.end_frame()
+---local s = pb.ui.stats()
+---print(s.draw_calls, s.vertices)
+---```
+---@return UiStats stats
+function PudimBasicsGl.ui.stats() end
+
+---Read a number from a widget's **persistent state**.
+---
+---Every id gets 8 numeric slots that live across frames as long as the id is
+---used (by a widget or `get_state`/`set_state`) every frame; slots of ids not
+---seen during a frame are freed by `end_frame()`. New slots start at `0`.
+---
+---### Example
+---```lua
+---local open, created = pb.ui.get_state("inventory")
+---if pb.ui.button("inventory", open == 1 and "Close" or "Open", 10, 10, 80, 24) then
+---    pb.ui.set_state("inventory", 1, 1 - open)
+---end
+---```
+---@param id string Widget id
+---@param index? integer Slot `1`–`8` (default `1`)
+---@return number value
+---@return boolean created `true` if the state was created by this call
+function PudimBasicsGl.ui.get_state(id, index) end
+
+---Store a number in a widget's **persistent state** (see `get_state`).
+---@param id string Widget id
+---@param index integer Slot `1`–`8`
+---@param value number
+function PudimBasicsGl.ui.set_state(id, index, value) end
+
 ---Draw a **text label** at the given position.
 ---
 ---### Example
@@ -1381,4 +1888,418 @@ function PudimBasicsGl.ui.button(id, label, x, y, w, h, r, g, b) end
 ---@return number value The (possibly updated) value
 function PudimBasicsGl.ui.slider(id, label, x, y, w, h, value, min, max) end
 
+---@class UiListOptions
+---@field row_height? number|fun(row: integer): number Fixed height, or a function measuring each row (default: from the UI font)
+---@field revision? integer Change it to measure rows again with a `row_height` function
+---@field text? fun(row: integer, column: integer): string? Text of a cell, instead of reading the `rows` table
+---@field draw? function Draw a row yourself: `(row, x, y, w, h, selected)` for lists, `(row, column, x, y, w, h, selected)` for tables. Anything drawn (`pb.renderer`, `pb.texture`, fonts) is scissored to the list's rows, and `pb.ui` drawing to the cell; batches carry across cells
+
+---Draw a **scrolling list** that only touches the rows in view.
+---
+---The visible range is computed from the scroll offset, so a frame costs the
+---same with 100 or 100 000 rows: only visible rows are read from `rows`,
+---passed to `text`/`draw` callbacks or drawn, clipped to the list.
+---
+---- Click a row to select it; the mouse wheel scrolls with momentum; drag or
+---  click the scrollbar.
+---- The list clicked last takes the keyboard: **Up**/**Down**, **Page Up**/
+---  **Page Down**, **Home**/**End** move the selection.
+---- A `row_height` function is only called for rows coming into view, once
+---  each; rows not seen yet count as the default height, so the scrollbar
+---  settles as you scroll. Bump `revision` if heights change.
+---- An error in a callback stops further callbacks for the frame and is
+---  raised once the list is drawn.
+---
+---Scroll and selection are kept per `id` (see `get_state`).
+---
+---### Example
+---```lua
+---local sel, clicked = pb.ui.list("log", 10, 10, 400, 300, log_lines)
+---
+----- 100k rows without a table: text comes from a callback
+---pb.ui.list("assets", 420, 10, 300, 300, #assets, {
+---    text = function(i) return assets[i].name end,
+---})
+---```
+---@param id string Unique identifier for this list
+---@param x number X position
+---@param y number Y position
+---@param w number Width
+---@param h number Height
+---@param rows string[]|integer Row texts, or a row count
+---@param options? UiListOptions
+---@return integer? selected Selected row (`nil` = none)
+---@return integer? clicked Row clicked this frame
+---@return integer first First visible row
+---@return integer last Last visible row (`last < first` when empty)
+function PudimBasicsGl.ui.list(id, x, y, w, h, rows, options) end
+
+---Draw a **scrolling table**: a list with a header and columns. Each cell is
+---clipped to its column.
+---
+---### Example
+---```lua
+---pb.ui.table("files", 10, 10, 500, 300,
+---    { { title = "Name" }, { title = "Size", width = 80 } },
+---    { { "a.png", "12 KB" }, { "b.png", "3 KB" } })
+---```
+---@param id string Unique identifier for this table
+---@param x number X position
+---@param y number Y position
+---@param w number Width
+---@param h number Height
+---@param columns (string|number|{title: (string|number)?, width: number?})[] Column titles; columns without `width` share the free space
+---@param rows string[][]|integer Rows of cell texts, or a row count
+---@param options? UiListOptions
+---@return integer? selected Selected row (`nil` = none)
+---@return integer? clicked Row clicked this frame
+---@return integer first First visible row
+---@return integer last Last visible row (`last < first` when empty)
+function PudimBasicsGl.ui.table(id, x, y, w, h, columns, rows, options) end
+
+--------------------------------------------------------------------------------
+-- Sprite Module
+--------------------------------------------------------------------------------
+
+---@alias SpriteLoopMode "loop"|"once"|"pingpong"
+
+---@class SpriteClipOptions
+---@field fps? number Frames per second (default `10`)
+---@field mode? SpriteLoopMode Playback mode (default `"loop"`)
+
+---@class SpriteOptions
+---@field x? number X position (top-left of the untrimmed frame)
+---@field y? number Y position
+---@field clip? string Clip to play
+---@field frame? integer|string Fixed frame (1-based index or atlas frame name); stops the clip
+---@field scale? number Uniform scale (default `1`)
+---@field scale_x? number Horizontal scale
+---@field scale_y? number Vertical scale
+---@field width? number Draw width in pixels (overrides `scale_x`)
+---@field height? number Draw height in pixels (overrides `scale_y`)
+---@field angle? number Rotation in degrees
+---@field origin_x? number Rotation origin, normalized (default `0.5`)
+---@field origin_y? number Rotation origin, normalized (default `0.5`)
+---@field r? number Tint red (`0`–`1`)
+---@field g? number Tint green (`0`–`1`)
+---@field b? number Tint blue (`0`–`1`)
+---@field a? number Tint alpha (`0`–`1`)
+---@field speed? number Playback rate multiplier (default `1`)
+---@field flip_x? boolean Mirror horizontally
+---@field flip_y? boolean Mirror vertically
+---@field visible? boolean Draw this sprite (default `true`)
+
+---@class SpriteSheet
+---A texture sliced into frames with precomputed UVs, plus named clips.
+---@field add_clip fun(self: SpriteSheet, name: string, frames: (integer|string)[], options?: SpriteClipOptions): boolean, string? Define (or replace) a clip over frame indices or atlas frame names
+---@field has_clip fun(self: SpriteSheet, name: string): boolean Check if a clip exists
+---@field get_clip_names fun(self: SpriteSheet): string[] Names of every clip (Aseprite tags included)
+---@field get_frame_count fun(self: SpriteSheet): integer Number of frames
+---@field find_frame fun(self: SpriteSheet, name: string): integer? 1-based index of an atlas frame
+---@field get_frame fun(self: SpriteSheet, frame: integer|string): integer?, integer?, integer?, integer? Packed rect `x, y, w, h` in pixels
+---@field draw_frame fun(self: SpriteSheet, frame: integer|string, x: number, y: number, scale_x?: number, scale_y?: number) Draw a single frame
+---@field destroy fun(self: SpriteSheet) Release the sheet (sets using it keep it alive)
+
+---@class SpriteSet
+---Many sprites sharing one sheet, animated and drawn entirely in C.
+---Sprite ids are integers returned by `:add()`.
+---
+---### Example
+---```lua
+---local sheet = pb.sprite.grid(tex, 32, 32)
+---sheet:add_clip("walk", {1, 2, 3, 4}, { fps = 8 })
+---local enemies = pb.sprite.new_set(sheet)
+---for i = 1, 500 do
+---    enemies:add(math.random(0, 800), math.random(0, 600), { clip = "walk" })
+---end
+---
+---while running do
+---    pb.time.update()
+---    pb.renderer.begin(800, 600)
+---    enemies:draw_all()   -- advances every clip by pb.time.delta() and draws them
+---    pb.renderer.finish()
+---end
+---```
+---@field add fun(self: SpriteSet, x: number, y: number, options?: SpriteOptions): integer Add a sprite; returns its id
+---@field set fun(self: SpriteSet, id: integer, options: SpriteOptions) Change sprite properties
+---@field remove fun(self: SpriteSet, id: integer) Remove a sprite (its id may be reused)
+---@field clear fun(self: SpriteSet) Remove every sprite
+---@field count fun(self: SpriteSet): integer Number of live sprites
+---@field set_position fun(self: SpriteSet, id: integer, x: number, y: number) Move a sprite
+---@field get_position fun(self: SpriteSet, id: integer): number, number Sprite position
+---@field play fun(self: SpriteSet, id: integer, clip: string, restart?: boolean) Play a clip (keeps its position if already playing unless `restart`)
+---@field stop fun(self: SpriteSet, id: integer) Freeze on the current frame
+---@field is_playing fun(self: SpriteSet, id: integer): boolean `false` once stopped or a `"once"` clip has ended
+---@field get_frame fun(self: SpriteSet, id: integer): integer 1-based sheet frame currently shown
+---@field update fun(self: SpriteSet, dt?: number) Advance every clip (default `pb.time.delta()`)
+---@field draw_all fun(self: SpriteSet, dt?: number) Advance (unless `:update()` ran since the last draw) and draw every visible sprite in one batch; pass `0` to draw without advancing
+---@field destroy fun(self: SpriteSet) Free the set
+
+---@class PudimBasicsGl.sprite
+PudimBasicsGl.sprite = {}
+
+---Slice a texture into a **grid** of equally sized frames (row by row).
+---
+---### Example
+---```lua
+---local sheet = pb.sprite.grid(tex, 16, 16, { spacing = 1, count = 10 })
+---```
+---@overload fun(self: PudimBasicsGl.sprite, texture: Texture, frame_w: integer, frame_h: integer, options?: { count?: integer, margin?: integer, spacing?: integer }): SpriteSheet?, string?
+---@param texture Texture Source texture
+---@param frame_w integer Frame width in pixels
+---@param frame_h integer Frame height in pixels
+---@param options? { count?: integer, margin?: integer, spacing?: integer } Frame limit, outer margin and gap between cells
+---@return SpriteSheet? sheet
+---@return string? error
+function PudimBasicsGl.sprite.grid(texture, frame_w, frame_h, options) end
+
+---Load an **Aseprite** or **TexturePacker** JSON atlas (hash or array export).
+---
+---Aseprite frame tags become clips timed by the per-frame durations
+---(`forward`, `reverse` and `pingpong` directions). Trimmed frames keep their
+---original size and offset. Without `texture`, `meta.image` is loaded relative
+---to the JSON file.
+---
+---### Example
+---```lua
+---local sheet, err = pb.sprite.load_atlas("assets/hero.json")
+---local hero = pb.sprite.new_set(sheet)
+---local id = hero:add(100, 100, { clip = "idle" })
+---```
+---@overload fun(self: PudimBasicsGl.sprite, json_path: string, texture?: Texture): SpriteSheet?, string?
+---@param json_path string Path to the JSON atlas
+---@param texture? Texture Texture to use instead of `meta.image`
+---@return SpriteSheet? sheet
+---@return string? error
+function PudimBasicsGl.sprite.load_atlas(json_path, texture) end
+
+---Create a **sprite set** drawing from `sheet`.
+---@overload fun(self: PudimBasicsGl.sprite, sheet: SpriteSheet, capacity?: integer): SpriteSet
+---@param sheet SpriteSheet
+---@param capacity? integer Initial capacity (grows as needed, default `64`)
+---@return SpriteSet set
+function PudimBasicsGl.sprite.new_set(sheet, capacity) end
+
+--------------------------------------------------------------------------------
+-- Tilemap Module
+--------------------------------------------------------------------------------
+
+---@class TilemapStats
+---@field chunks_drawn integer Chunks drawn by the last `:draw()`
+---@field chunk_rebuilds integer Chunk vertex buffers rebuilt so far
+---@field chunks integer Total chunks over all layers
+---@field animations integer Animated tiles
+
+---@class Tilemap
+---A tile grid drawn from a tileset texture. Layers are split into 32x32-tile
+---chunks with static GPU buffers that are rebuilt only when one of their tiles
+---changes; chunks outside the camera view are skipped.
+---
+---Layers are 1-based, tile coordinates are 0-based and tile ids count tileset
+---cells from `1` row by row (`0` = empty).
+---
+---### Example
+---```lua
+---local tiles = pb.texture.load("assets/tiles.png")
+---local map = pb.tilemap.new(256, 256, 16, 16, tiles, { layers = 2 })
+---map:fill(1, 0, 0, 256, 256, 1)           -- grass everywhere
+---map:set_animation(5, {5, 6, 7, 8}, 0.15)  -- water
+---
+---while running do
+---    pb.renderer.begin(800, 600)
+---    map:draw()                            -- only the chunks on screen
+---    pb.renderer.finish()
+---end
+---```
+---@field set fun(self: Tilemap, layer: integer, x: integer, y: integer, tile: integer) Set a tile (`0` clears it)
+---@field get fun(self: Tilemap, layer: integer, x: integer, y: integer): integer Tile id (`0` if empty or out of range)
+---@field fill fun(self: Tilemap, layer: integer, x: integer, y: integer, w: integer, h: integer, tile: integer) Fill a rectangle of tiles
+---@field add_layer fun(self: Tilemap, name?: string): integer Add an empty layer on top; returns its index
+---@field find_layer fun(self: Tilemap, name: string): integer? Index of a layer by name
+---@field get_layer_count fun(self: Tilemap): integer Number of layers
+---@field set_layer_visible fun(self: Tilemap, layer: integer, visible: boolean) Show or hide a layer in `:draw()`
+---@field set_layer_opacity fun(self: Tilemap, layer: integer, opacity: number) Layer alpha (`0`–`1`)
+---@field set_animation fun(self: Tilemap, tile: integer, frames: integer[], duration?: number|number[]): boolean, string? Cycle every cell showing `tile` through `frames` (seconds per frame, default `0.1`)
+---@field draw fun(self: Tilemap, x?: number, y?: number, layer?: integer): integer Draw every visible layer (or one layer) with the map's top-left at `x, y`; returns chunks drawn
+---@field get_size fun(self: Tilemap): integer, integer Map size in tiles
+---@field get_tile_size fun(self: Tilemap): integer, integer Tile size in pixels
+---@field world_to_tile fun(self: Tilemap, wx: number, wy: number, map_x?: number, map_y?: number): integer, integer Tile under a world position
+---@field stats fun(self: Tilemap): TilemapStats Culling and rebuild counters
+---@field destroy fun(self: Tilemap) Free the map and its GPU buffers
+
+---@class PudimBasicsGl.tilemap
+PudimBasicsGl.tilemap = {}
+
+---Create an empty **tilemap** using `texture` as a grid tileset.
+---@overload fun(self: PudimBasicsGl.tilemap, width: integer, height: integer, tile_w: integer, tile_h: integer, texture: Texture, options?: { layers?: integer, margin?: integer, spacing?: integer }): Tilemap?, string?
+---@param width integer Width in tiles
+---@param height integer Height in tiles
+---@param tile_w integer Tile width in pixels
+---@param tile_h integer Tile height in pixels
+---@param texture Texture Tileset texture
+---@param options? { layers?: integer, margin?: integer, spacing?: integer } Layer count (default `1`), tileset outer margin and gap between cells
+---@return Tilemap? map
+---@return string? error
+function PudimBasicsGl.tilemap.new(width, height, tile_w, tile_h, texture, options) end
+
+---Load a **Tiled** JSON map (`.tmj` / `.json`).
+---
+---Tile layers must use the default CSV (array) encoding; flip flags are
+---ignored. Only the first tileset is used, embedded or external (`.tsj`), and
+---its tile animations are imported. Without `texture`, the tileset image is
+---loaded relative to the file.
+---
+---### Example
+---```lua
+---local map, err = pb.tilemap.load_tiled("assets/level1.tmj")
+---local walls = map:find_layer("walls")
+---```
+---@overload fun(self: PudimBasicsGl.tilemap, path: string, texture?: Texture): Tilemap?, string?
+---@param path string Path to the map
+---@param texture? Texture Texture to use instead of the tileset image
+---@return Tilemap? map
+---@return string? error
+function PudimBasicsGl.tilemap.load_tiled(path, texture) end
+
+---Load a single-layer map from a **CSV** file (one row of tiles per line).
+---
+---Values are 0-based tileset indices with negatives as empty, as exported by
+---Tiled. With `one_based`, values are tile ids and `0` is empty. Flip flags
+---are ignored; values out of range are empty.
+---@overload fun(self: PudimBasicsGl.tilemap, path: string, texture: Texture, tile_w: integer, tile_h: integer, options?: { one_based?: boolean }): Tilemap?, string?
+---@param path string Path to the CSV file
+---@param texture Texture Tileset texture
+---@param tile_w integer Tile width in pixels
+---@param tile_h integer Tile height in pixels
+---@param options? { one_based?: boolean }
+---@return Tilemap? map
+---@return string? error
+function PudimBasicsGl.tilemap.load_csv(path, texture, tile_w, tile_h, options) end
+
+--------------------------------------------------------------------------------
+-- Particles Module
+--------------------------------------------------------------------------------
+
+---@alias ParticleShape "point"|"circle"|"ring"|"rect"|"line"
+
+---@class ParticleOptions
+---@field x? number Emitter X position
+---@field y? number Emitter Y position
+---@field rate? number Particles per second while emitting (default `50`, `0` = bursts only)
+---@field shape? ParticleShape Spawn area (default `"point"`)
+---@field radius? number Radius for `"circle"` and `"ring"`
+---@field width? number Width for `"rect"` and `"line"`
+---@field height? number Height for `"rect"`
+---@field radial? boolean Launch away from the shape's center instead of along `angle`
+---@field angle? number Launch direction in degrees (default `-90`, up; screen Y points down)
+---@field spread? number Random cone around `angle` in degrees (default `30`)
+---@field speed? number|number[] Launch speed in px/s, or `{min, max}` (default `{50, 100}`)
+---@field life? number|number[] Lifetime in seconds, or `{min, max}` (default `1`)
+---@field spin? number|number[] Rotation speed in degrees/s, or `{min, max}` (default `0`)
+---@field gravity_x? number Constant acceleration in px/s²
+---@field gravity_y? number Constant acceleration in px/s²
+---@field drag? number Velocity damping per second (default `0`)
+---@field size? number Constant size in pixels (default `8`)
+---@field sizes? number[] Size over life (up to 8 evenly spaced keys)
+---@field colors? number[][] Color over life: up to 8 evenly spaced `{r, g, b, a}` keys (default white fading out)
+---@field additive? boolean Additive blending (fire, sparks)
+---@field texture? Texture Particle image (default soft round dots)
+
+---@class ParticleEmitterOptions: ParticleOptions
+---@field capacity? integer Maximum live particles (default `10000`)
+
+---@class ParticleEmitter
+---A pooled particle emitter. Particles are simulated in C with SIMD and drawn
+---with a single instanced draw call per emitter.
+---
+---### Example
+---```lua
+---local sparks = pb.particles.new({
+---    capacity = 20000, rate = 2000, shape = "circle", radius = 8,
+---    speed = {80, 240}, spread = 360, life = {0.4, 1.0},
+---    gravity_y = 300, drag = 1.5, additive = true,
+---    sizes = {6, 2}, colors = { {1, 0.9, 0.4, 1}, {1, 0.3, 0.1, 0} },
+---})
+---
+---while running do
+---    pb.time.update()
+---    sparks:set_position(pb.input.get_mouse_position())
+---    sparks:update()
+---    pb.renderer.begin(800, 600)
+---    sparks:draw()
+---    pb.renderer.finish()
+---end
+---```
+---@field set fun(self: ParticleEmitter, options: ParticleOptions) Change emitter parameters (live particles keep their motion)
+---@field set_texture fun(self: ParticleEmitter, texture?: Texture) Particle image (`nil` = soft round dots)
+---@field set_position fun(self: ParticleEmitter, x: number, y: number) Move the emitter
+---@field get_position fun(self: ParticleEmitter): number, number Emitter position
+---@field emit fun(self: ParticleEmitter, count: integer): integer Spawn a burst; returns how many fit in the pool
+---@field start fun(self: ParticleEmitter) Resume emission by `rate`
+---@field stop fun(self: ParticleEmitter) Pause emission (live particles keep going)
+---@field is_emitting fun(self: ParticleEmitter): boolean Whether `rate` emission is active
+---@field update fun(self: ParticleEmitter, dt?: number) Emit, integrate and retire particles (default `pb.time.delta()`)
+---@field draw fun(self: ParticleEmitter) Draw every live particle in one call
+---@field count fun(self: ParticleEmitter): integer Live particles
+---@field get_capacity fun(self: ParticleEmitter): integer Pool size
+---@field clear fun(self: ParticleEmitter) Remove every particle
+---@field destroy fun(self: ParticleEmitter) Free the emitter
+
+---@class GpuParticleOptions: ParticleOptions
+---@field count? integer Number of particles (default `100000`)
+---@field prewarm? number Seconds to simulate right away, so the effect starts fully developed
+
+---@class GpuParticles
+---A particle system that lives on the GPU: a vertex shader simulates every
+---particle with transform feedback and the result is drawn without a CPU
+---round-trip. Particles respawn when they die, so `count` and `life` set the
+---density (`rate` is not used). Per frame the CPU only uploads uniforms.
+---
+---### Example
+---```lua
+---local rain = pb.particles.new_gpu({
+---    count = 200000, shape = "line", x = 400, y = -20, width = 900,
+---    angle = 100, spread = 4, speed = {600, 900}, life = {0.8, 1.2},
+---    sizes = {3}, colors = { {0.6, 0.7, 1, 0.5} }, prewarm = 1.2,
+---})
+---
+---while running do
+---    pb.time.update()
+---    rain:update()
+---    pb.renderer.begin(800, 600)
+---    rain:draw()
+---    pb.renderer.finish()
+---end
+---```
+---@field set fun(self: GpuParticles, options: ParticleOptions) Change parameters (applied to particles as they respawn)
+---@field set_texture fun(self: GpuParticles, texture?: Texture) Particle image (`nil` = soft round dots)
+---@field set_position fun(self: GpuParticles, x: number, y: number) Move the emitter
+---@field get_position fun(self: GpuParticles): number, number Emitter position
+---@field start fun(self: GpuParticles) Respawn particles as they die
+---@field stop fun(self: GpuParticles) Let live particles finish without respawning
+---@field is_emitting fun(self: GpuParticles): boolean Whether dead particles respawn
+---@field update fun(self: GpuParticles, dt?: number) Simulate one step on the GPU (default `pb.time.delta()`)
+---@field prewarm fun(self: GpuParticles, seconds: number) Simulate `seconds` in fixed steps
+---@field reset fun(self: GpuParticles) Kill every particle and restart the staggered spawn
+---@field draw fun(self: GpuParticles) Draw every live particle in one call
+---@field get_count fun(self: GpuParticles): integer Number of particles in the system
+---@field destroy fun(self: GpuParticles) Free the GPU buffers
+
+---@class PudimBasicsGl.particles
+PudimBasicsGl.particles = {}
+
+---Create a **particle emitter**. Emission starts immediately at `rate`.
+---@overload fun(self: PudimBasicsGl.particles, options?: ParticleEmitterOptions): ParticleEmitter?, string?
+---@param options? ParticleEmitterOptions
+---@return ParticleEmitter? emitter
+---@return string? error
+function PudimBasicsGl.particles.new(options) end
+
+---Create a **GPU particle system** simulated with transform feedback.
+---@overload fun(self: PudimBasicsGl.particles, options?: GpuParticleOptions): GpuParticles?, string?
+---@param options? GpuParticleOptions
+---@return GpuParticles? system
+---@return string? error
+function PudimBasicsGl.particles.new_gpu(options) end
+
 return PudimBasicsGl
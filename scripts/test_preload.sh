@@ -252,9 +252,10 @@ local font_paths = {
     "/usr/share/fonts/truetype/freefont/FreeSans.ttf",
 }
 local font = nil
+local font_path = nil
 for _, fp in ipairs(font_paths) do
     font = pb.text.load(fp, 24)
-    if font then break end
+    if font then font_path = fp break end
 end
 
 if font then
@@ -280,21 +281,211 @@ if font then
     local ew, eh = font:measure("")
     check("empty measure width == 0", ew == 0)
 
+    -- UTF-8: accented characters are rasterized on first use
+    check("cache_stats is a function", type(pb.text.cache_stats) == "function")
+    local glyphs_before = font:get_glyph_count()
+    local misses_before = pb.text.cache_stats().misses
+    local aw = font:measure("a\u{E7}\u{E3}o")
+    local pw = font:measure("aao")
+    check("UTF-8 characters have width", aw > pw)
+    check("new glyphs cached", font:get_glyph_count() == glyphs_before + 2)
+    check("misses counted", pb.text.cache_stats().misses == misses_before + 2)
+    check("cached glyphs do not miss again", font:preload("\u{E7}\u{E3}") == 0)
+    check("preload counts new glyphs", font:preload("\u{F5}\u{E9}\u{C1}") == 3)
+    local bw = font:measure("a\xff")
+    check("invalid UTF-8 still measures", bw > font:measure("a"))
+    local cs = pb.text.cache_stats()
+    check("cache_stats fields", type(cs.frame_misses) == "number" and cs.glyphs > 0 and cs.pages > 0)
+
     -- set_size
     local ok_ss = pcall(font.set_size, font, 32)
     check("set_size runs", ok_ss)
     local new_sz = font:get_size()
     check("new size == 32", math.abs(new_sz - 32) < 0.01)
 
+    -- sizes are cached: switching back does not rasterize again
+    local m0 = pb.text.cache_stats().misses
+    font:set_size(24)
+    font:set_size(32)
+    check("cached sizes reused", pb.text.cache_stats().misses == m0)
+    local w32 = font:measure("Hello")
+    local w16 = font:measure("Hello", 16)
+    check("measure at another size", w16 < w32 and font:get_size() == 32)
+    check("line height at another size", font:get_line_height(64) > font:get_line_height())
+    for s = 10, 40, 6 do font:measure("x", s) end
+    check("sizes bounded per font", pb.text.cache_stats().sizes <= 4)
+    check("current size kept", font:get_size() == 32 and font:measure("Hello") == w32)
+
     -- draw should not error (needs renderer begin)
     pb.renderer.init()
     pb.renderer.begin(1, 1)
     pb.renderer.flush()
     local ok_draw = pcall(font.draw, font, "Test", 0, 0, 1, 1, 1)
     check("draw runs", ok_draw)
+    local ok_utf8 = pcall(font.draw, font, "Cora\u{E7}\u{E3}o \u{2603}", 0, 0, 1, 1, 1)
+    check("draw UTF-8 runs", ok_utf8)
+    local ok_sized = pcall(font.draw, font, "Sized", 0, 0, 48)
+    check("draw at size runs", ok_sized)
+    local ok_sized_c = pcall(font.draw, font, "Sized", 0, 0, 12, { r = 1, g = 0, b = 0 })
+    check("draw at size with color runs", ok_sized_c)
+    check("draw rejects bad size", not pcall(font.draw, font, "x", 0, 0, -1))
     pb.text.flush()
     pb.renderer.finish()
 
+    -- SDF fonts: one strike scaled to every size, effects only on SDF
+    check("bitmap font is not sdf", font:is_sdf() == false)
+    check("effects need sdf", not pcall(font.set_effects, font, { outline = 1 }))
+    local sdf = pb.text.load(font_path, 24, { sdf = true })
+    check("sdf font loaded", sdf ~= nil and sdf:is_sdf())
+    if sdf then
+        local sizes_before = pb.text.cache_stats().sizes
+        local s24 = sdf:measure("Hello")
+        local s48 = sdf:measure("Hello", 48)
+        check("sdf measure scales", math.abs(s48 - 2 * s24) < 0.01)
+        check("sdf uses one strike", pb.text.cache_stats().sizes == sizes_before)
+        sdf:set_size(36)
+        check("sdf set_size", sdf:get_size() == 36 and math.abs(sdf:get_line_height() - 1.5 * sdf:get_line_height(24)) < 0.01)
+        local ok_fx = pcall(sdf.set_effects, sdf, {
+            outline = 2, outline_color = { r = 0, g = 0, b = 0 },
+            glow = 4, shadow_x = 2, shadow_y = 2,
+        })
+        check("set_effects runs", ok_fx)
+        pb.renderer.begin(1, 1)
+        check("sdf draw runs", pcall(sdf.draw, sdf, "SDF \u{E7}", 0, 0, 64, { r = 1, g = 1, b = 1 }))
+        pb.text.flush()
+        pb.renderer.finish()
+        check("clear effects", pcall(sdf.set_effects, sdf, nil))
+        sdf:destroy()
+    end
+
+    -- retained text objects: laid out once, redrawn anywhere
+    local label = font:create_text("Score: 10")
+    check("create_text", label ~= nil and label:get_text() == "Score: 10")
+    local lw, lh = label:get_size()
+    check("text size matches measure", math.abs(lw - font:measure("Score: 10")) < 0.01 and lh > 0)
+    pb.renderer.begin(1, 1)
+    check("text draw runs", pcall(label.draw, label, 10, 10))
+    check("text draw with color", pcall(label.draw, label, 20, 30, { r = 1, g = 0, b = 0 }))
+    local layouts = pb.text.cache_stats().layouts
+    label:set_text("Score: 10")
+    label:draw(40, 40, 1, 1, 0)
+    check("same text keeps layout", pb.text.cache_stats().layouts == layouts)
+    label:set_text("Score: 20")
+    label:draw(40, 40)
+    check("new text lays out", pb.text.cache_stats().layouts == layouts + 1)
+    local gpu_label = font:create_text("GPU \u{E7}", { size = 18, gpu = true })
+    check("gpu text draw runs", gpu_label ~= nil and pcall(gpu_label.draw, gpu_label, 0, 0))
+    check("text font size option", gpu_label:get_font_size() == 18)
+    pb.text.flush()
+    pb.renderer.finish()
+    label:set_font_size(48)
+    check("text set_font_size", math.abs(label:get_size() - font:measure("Score: 20", 48)) < 0.01)
+    gpu_label:destroy()
+    check("destroyed text errors", not pcall(gpu_label.get_text, gpu_label))
+
+    -- layout engine: wrapping, alignment, memoized measurements
+    local para = "The quick brown fox jumps over the lazy dog"
+    local pw, ph, plines = font:measure_layout(para, { width = 120 })
+    check("layout wraps", plines > 1 and pw <= 120 and ph > font:get_line_height())
+    local cw = font:measure_layout(para, { width = 120, wrap = "char" })
+    check("char wrap fits", cw <= 120)
+    local nw, _, nlines = font:measure_layout(para, { width = 120, wrap = "none" })
+    check("no wrap is one line", nlines == 1 and math.abs(nw - font:measure(para)) < 0.01)
+    local _, sh = font:measure_layout("a\nb", { line_spacing = 2 })
+    check("line spacing", math.abs(sh - 3 * font:get_line_height()) < 0.01)
+    check("bad align rejected", not pcall(font.measure_layout, font, "x", { align = "middle" }))
+    pb.renderer.begin(1, 1)
+    check("draw_layout runs", pcall(font.draw_layout, font, para, 0, 0, { width = 120, align = "justify" }, 1, 1, 1))
+    for _ = 1, 10 do font:measure("Cached label") end
+    pb.renderer.finish()
+    pb.renderer.begin(1, 1)
+    local ls = pb.text.cache_stats()
+    check("measure hits layout cache", ls.layout_frame_hits >= 9 and ls.layout_entries > 0)
+    pb.renderer.finish()
+    local box = font:create_text(para, { width = 120, align = "center" })
+    local bw, bh = box:get_size()
+    check("text object wraps", math.abs(bw - pw) < 0.01 and math.abs(bh - ph) < 0.01)
+    box:set_layout({ wrap = "none" })
+    check("text set_layout", math.abs(box:get_size() - font:measure(para)) < 0.01)
+    box:destroy()
+
+    -- kerning: on by default. Every test font kerns "AV" and "To" (DejaVu
+    -- Sans: -131 and -348 units), so turning it off must widen the text.
+    check("kerning on by default", font:get_kerning() == true)
+    local kw = font:measure("AVAV To")
+    local pair_gap = font:measure("A") + font:measure("V") - font:measure("AV")
+    check("kerning tightens AV", pair_gap > 0.5)
+    font:set_kerning(false)
+    check("kerning off", font:get_kerning() == false and font:measure("AVAV To") > kw + 2)
+    check("no kerning: AV is A + V",
+        math.abs(font:measure("A") + font:measure("V") - font:measure("AV")) < 0.01)
+    font:set_kerning(true)
+    check("kerning back on", math.abs(font:measure("AVAV To") - kw) < 0.01)
+
+    -- async load: worker rasterizes, get() returns the same Font every time
+    local pending = pb.text.load_async(font_path, font:get_size())
+    check("load_async returns a handle", pending ~= nil)
+    if pending then
+        local async_font = pending:get()
+        check("load_async get", async_font ~= nil and pending:is_done())
+        check("load_async get again", pending:get() == async_font)
+        check("async font measures like sync",
+            async_font ~= nil and math.abs(async_font:measure("AVAV To") - kw) < 0.01)
+        if async_font then async_font:destroy() end
+    end
+    check("load_async bad path", pb.text.load_async("/nonexistent/font.ttf", 24) == nil)
+
+    -- disk atlas cache: the second load maps the stored atlas
+    local font_cache_dir = os.tmpname()
+    os.remove(font_cache_dir)
+    check("font cache dir enabled", pb.text.set_cache_dir(font_cache_dir) == true)
+    check("font get_cache_dir", pb.text.get_cache_dir() == font_cache_dir)
+    pb.text.reset_disk_cache_stats()
+    local cold_font = pb.text.load(font_path, 19)
+    local warm_font = pb.text.load(font_path, 19)
+    local ds = pb.text.disk_cache_stats()
+    check("font cache cold then warm", ds.writes == 1 and ds.hits == 1 and ds.warm_loads == 1)
+    check("cached font measures the same", cold_font ~= nil and warm_font ~= nil and
+        math.abs(cold_font:measure("AVAV To") - warm_font:measure("AVAV To")) < 0.01)
+    check("cached font draws new glyphs", warm_font ~= nil and warm_font:preload("\u{E7}") == 1)
+    if cold_font then cold_font:destroy() end
+    if warm_font then warm_font:destroy() end
+    pb.text.set_cache_dir(nil)
+    check("font cache disabled", pb.text.get_cache_dir() == nil)
+    for _, name in ipairs(pb.studio.list_dir(font_cache_dir) or {}) do
+        os.remove(font_cache_dir .. "/" .. name)
+    end
+    os.remove(font_cache_dir)
+
+    -- character grid: only changed rows are rebuilt
+    local grid = pb.text.grid(20, 5, font)
+    check("text grid created", grid ~= nil)
+    local gcols, grows = grid:get_size()
+    check("grid size", gcols == 20 and grows == 5)
+    local gcw, gch = grid:get_cell_size()
+    check("grid cell size", gcw >= 1 and gch >= font:get_line_height())
+    check("grid print", grid:print(0, 0, "hi \u{E7}") == 4 and grid:print(18, 1, "clip") == 2)
+    local gcp, gfg, gbg = grid:get(3, 0)
+    check("grid get", gcp == 0xE7 and gfg.r == 1 and gbg.a == 0)
+    check("grid get outside", grid:get(20, 0) == nil)
+    pb.renderer.begin(1, 1)
+    check("grid first draw rebuilds all rows", grid:draw(0, 0) == 5 and grid:get_dirty_rows() == 0)
+    check("grid clean draw", grid:draw(0, 0) == 0)
+    grid:set(2, 3, "x", { r = 1, g = 0, b = 0 }, { r = 0, g = 0, b = 1, a = 1 })
+    grid:set(5, 3, 65)
+    check("grid set dirties one row", grid:get_dirty_rows() == 1)
+    grid:set(5, 3, "A")
+    check("unchanged cell stays clean", grid:get_dirty_rows() == 1)
+    check("grid redraws one row", grid:draw(0, 0) == 1)
+    grid:scroll(1)
+    check("grid scroll", grid:get(2, 2) == 120 and grid:get(0, 4) == 0 and grid:get_dirty_rows() == 1)
+    grid:fill(0, 0, 20, 5, "#")
+    grid:clear()
+    check("grid clear", grid:get(0, 0) == 0 and grid:get_dirty_rows() == 5)
+    check("grid draw after clear", grid:draw(0, 0) == 5)
+    pb.renderer.finish()
+    check("grid bad size", not pcall(pb.text.grid, 0, 5, font))
+
     -- destroy
     font:destroy()
     check("destroy runs", true)
@@ -302,10 +493,78 @@ if font then
     -- methods on destroyed font should error
     local ok_dead = pcall(font.get_size, font)
     check("dead font errors", not ok_dead)
+    check("text of dead font errors", not pcall(label.draw, label, 0, 0))
+    check("grid of dead font errors", not pcall(grid.draw, grid, 0, 0))
+    grid:destroy()
+    check("destroyed grid errors", not pcall(grid.get_size, grid))
 else
     print("  SKIP: no system font found for deeper tests")
 end
 
+-- BMFont: text and binary descriptors sharing one 16x8 page
+local bmf_base = os.tmpname()
+os.remove(bmf_base)
+local page_name = bmf_base:match("[^/\\]+$") .. "_page.tga"
+local page = io.open(bmf_base .. "_page.tga", "wb")
+if page then
+    -- uncompressed true-color TGA, top-left origin: left half opaque white
+    page:write(string.pack("<BBBI2I2BI2I2I2I2BB", 0, 0, 2, 0, 0, 0, 0, 0, 16, 8, 32, 0x28))
+    for _ = 1, 8 do
+        page:write(string.rep(string.char(255, 255, 255, 255), 8), string.rep(string.char(0, 0, 0, 0), 8))
+    end
+    page:close()
+end
+local fnt_text = io.open(bmf_base .. ".fnt", "wb")
+if fnt_text then
+    fnt_text:write([[info face="Test" size=10
+common lineHeight=12 base=9 scaleW=16 scaleH=8 pages=1 packed=0 alphaChnl=0
+page id=0 file="]] .. page_name .. [["
+chars count=3
+char id=65 x=0 y=0 width=8 height=8 xoffset=1 yoffset=1 xadvance=10 page=0 chnl=15
+char id=66 x=0 y=0 width=8 height=8 xoffset=0 yoffset=1 xadvance=9 page=0 chnl=15
+char id=32 x=0 y=0 width=0 height=0 xoffset=0 yoffset=0 xadvance=5 page=0 chnl=15
+kernings count=1
+kerning first=65 second=66 amount=-2
+]])
+    fnt_text:close()
+end
+local fnt_bin = io.open(bmf_base .. "_bin.fnt", "wb")
+if fnt_bin then
+    local function block(kind, data) return string.pack("<BI4", kind, #data) .. data end
+    local function char(id, xo, adv) return string.pack("<I4I2I2I2I2i2i2i2BB", id, 0, 0, 8, 8, xo, 1, adv, 0, 15) end
+    fnt_bin:write("BMF\3",
+        block(1, string.pack("<i2BBI2BBBBBBBB", 10, 0, 0, 100, 1, 0, 0, 0, 0, 0, 0, 0) .. "Test\0"),
+        block(2, string.pack("<I2I2I2I2I2BBBBB", 12, 9, 16, 8, 1, 0, 0, 4, 4, 4)),
+        block(3, page_name .. "\0"),
+        block(4, char(65, 1, 10) .. char(66, 0, 9) .. string.pack("<I4I2I2I2I2i2i2i2BB", 32, 0, 0, 0, 0, 0, 0, 5, 0, 15)),
+        block(5, string.pack("<I4I4i2", 65, 66, -2)))
+    fnt_bin:close()
+end
+check("text.load_bmfont is function", type(pb.text.load_bmfont) == "function")
+for _, suffix in ipairs({ ".fnt", "_bin.fnt" }) do
+    local bmf, bmf_err = pb.text.load_bmfont(bmf_base .. suffix)
+    check("bmfont loads " .. suffix, bmf ~= nil)
+    if not bmf then print("    " .. tostring(bmf_err)) end
+    if bmf then
+        check("bmfont native size " .. suffix, bmf:get_size() == 10 and bmf:get_line_height() == 12)
+        check("bmfont kerned measure " .. suffix, math.abs(bmf:measure("AB") - 17) < 0.01)
+        check("bmfont scaled measure " .. suffix, math.abs(bmf:measure("AB", 20) - 34) < 0.01)
+        check("bmfont skips missing chars " .. suffix, math.abs(bmf:measure("A\u{E7}") - 10) < 0.01)
+        check("bmfont has no sdf effects " .. suffix, not pcall(bmf.set_effects, bmf, { outline = 1 }))
+        pb.renderer.begin(1, 1)
+        check("bmfont draw runs " .. suffix, pcall(bmf.draw, bmf, "AB A", 0, 0, 1, 1, 1))
+        pb.text.flush()
+        pb.renderer.finish()
+        bmf:destroy()
+    end
+end
+local bad_bmf, bad_bmf_err = pb.text.load_bmfont(bmf_base .. "_page.tga")
+check("bmfont rejects non-fnt", bad_bmf == nil and type(bad_bmf_err) == "string")
+check("bmfont rejects bad filter", not pcall(pb.text.load_bmfont, bmf_base .. ".fnt", 10, { filter = "cubic" }))
+os.remove(bmf_base .. ".fnt")
+os.remove(bmf_base .. "_bin.fnt")
+os.remove(bmf_base .. "_page.tga")
+
 pb.window.destroy(w)
 
 print(string.format("TEXT_RESULT: %d passed, %d failed", pass, fail))
@@ -594,6 +853,51 @@ check("gradient top: less blue", tb < 50)
 check("gradient bot: less red",  br2 < 50)
 check("gradient bot: more blue", bb2 > 200)
 
+-- ════════ Test 9: premultiplied-alpha mode blends like straight alpha ════════
+check("premultiplied off by default", pb.renderer.get_premultiplied_alpha() == false)
+check("get_info reports simd path", type(pb.renderer.get_info().simd) == "string")
+local straight_tex = pb.texture.create(1, 1, {255, 0, 0, 128})
+for _, mode in ipairs({false, true}) do
+    pb.renderer.set_premultiplied_alpha(mode)
+    check("premultiplied mode set " .. tostring(mode), pb.renderer.get_premultiplied_alpha() == mode)
+    local label = mode and "premultiplied" or "straight"
+    pb.renderer.clear(0.0, 0.0, 0.0, 1.0)
+    pb.renderer.begin(W, H)
+    pb.renderer.rect_filled(0, 0, 32, 64, 0, 1, 0, 0.5)  -- half green
+    straight_tex:draw(32, 0, 32, 64)                      -- half red
+    pb.renderer.flush()
+    pb.texture.flush()
+    pb.renderer.finish()
+    r, g, b = pb.renderer.read_pixel(16, 32, H)
+    check(label .. " primitive: G ~128", near(g, 128, 8))
+    r, g, b = pb.renderer.read_pixel(48, 32, H)
+    check(label .. " texture: R ~128", near(r, 128, 8))
+end
+pb.renderer.set_premultiplied_alpha(false)
+straight_tex:destroy()
+
+-- ════════ Test 10: nine-slice keeps corners and stretches the center ════════
+local R, G, B = {255, 0, 0, 255}, {0, 255, 0, 255}, {0, 0, 255, 255}
+local cells = {R, G, R, G, B, G, R, G, R}
+local bytes = {}
+for _, c in ipairs(cells) do for _, v in ipairs(c) do bytes[#bytes + 1] = v end end
+local panel = pb.texture.create(3, 3, bytes)
+for _, tile in ipairs({false, true}) do
+    local label = tile and "tiled" or "stretched"
+    pb.renderer.clear(0.0, 0.0, 0.0, 1.0)
+    pb.renderer.begin(W, H)
+    panel:draw_nine_slice(0, 0, W, H, 1, 1, 1, 1, { tile = tile })
+    pb.texture.flush()
+    pb.renderer.finish()
+    r, g, b = pb.renderer.read_pixel(0, 0, H)
+    check(label .. " nine-slice corner red", r > 200 and g < 50 and b < 50)
+    r, g, b = pb.renderer.read_pixel(32, 0, H)
+    check(label .. " nine-slice edge green", g > 200 and r < 50 and b < 50)
+    r, g, b = pb.renderer.read_pixel(32, 32, H)
+    check(label .. " nine-slice center blue", b > 200 and r < 50 and g < 50)
+end
+panel:destroy()
+
 pb.window.destroy(w)
 print(string.format("RENDER_RESULT: %d passed, %d failed", pass, fail))
 if fail > 0 then os.exit(8) end
@@ -904,6 +1208,11 @@ check("label is function", type(pb.ui.label) == "function")
 check("panel is function", type(pb.ui.panel) == "function")
 check("button is function", type(pb.ui.button) == "function")
 check("slider is function", type(pb.ui.slider) == "function")
+check("stats is function", type(pb.ui.stats) == "function")
+check("get_state is function", type(pb.ui.get_state) == "function")
+check("set_state is function", type(pb.ui.set_state) == "function")
+check("list is function", type(pb.ui.list) == "function")
+check("table is function", type(pb.ui.table) == "function")
 
 -- begin/end frame should not crash
 pb.renderer.begin_ui(W, H)
@@ -928,6 +1237,119 @@ local ok_ef = pcall(pb.ui.end_frame)
 check("end_frame runs", ok_ef)
 pb.renderer.end_ui()
 
+-- Draw list: many widgets still come out as one or two draw calls
+pb.renderer.begin_ui(W, H)
+pb.ui.begin_frame()
+pb.ui.panel("Batch", 0, 0, W, H)
+for i = 1, 8 do
+    pb.ui.button("batch_btn" .. i, "B" .. i, 2, i * 6, 20, 5)
+    pb.ui.label("L" .. i, 30, i * 6)
+end
+pb.ui.end_frame()
+local ui_stats = pb.ui.stats()
+pb.renderer.end_ui()
+check("ui stats has vertices", ui_stats.vertices > 0)
+check("ui frame is one or two draw calls", ui_stats.draw_calls >= 1 and ui_stats.draw_calls <= 2)
+check("ui stats counts widgets", ui_stats.widgets == 8)
+check("ui stats no collisions", ui_stats.collisions == 0)
+
+-- Widget state persists while the id is used each frame, then is collected
+pb.ui.begin_frame()
+local sv, created = pb.ui.get_state("kept")
+check("state starts at zero", sv == 0 and created == true)
+pb.ui.set_state("kept", 3, 42)
+pb.ui.set_state("dropped", 1, 7)
+pb.ui.end_frame()
+pb.ui.begin_frame()
+sv, created = pb.ui.get_state("kept", 3)
+check("state persists across frames", sv == 42 and created == false)
+pb.ui.end_frame()
+check("unseen widget state collected", pb.ui.stats().collected == 1)
+pb.ui.begin_frame()
+check("collected state is reset", pb.ui.get_state("dropped") == 0)
+pb.ui.end_frame()
+check("state index checked", not pcall(pb.ui.get_state, "kept", 9))
+
+-- Virtualized lists: only visible rows reach callbacks, whatever the row count
+pb.renderer.begin_ui(W, H)
+pb.ui.begin_frame()
+local text_calls = 0
+local sel, clicked_row, first, last = pb.ui.list("big_list", 0, 0, W, 40, 100000, {
+    row_height = 10,
+    text = function(i) text_calls = text_calls + 1; return "row " .. i end,
+})
+check("list nothing selected", sel == nil and clicked_row == nil)
+check("list visible range", first == 1 and last == 4)
+check("list reads visible rows only", text_calls == 4)
+check("list rows drawn", pb.ui.stats().rows == 4)
+
+local cell_calls = 0
+local calls_before = pb.ui.stats().draw_calls
+pb.ui.table("big_table", 0, 0, W, 50, { "A", { title = "B", width = 20 } }, 100000, {
+    row_height = 10,
+    draw = function(row, col, x, y, w, h, selected)
+        cell_calls = cell_calls + 1
+        if col == 2 then check("table fixed column width", w == 20) end
+        pb.ui.label("c", x, y)
+    end,
+})
+check("table draws visible cells only", cell_calls == 8)
+check("table cells share draw calls", pb.ui.stats().draw_calls - calls_before <= 2)
+
+local height_calls = 0
+local function measure(i) height_calls = height_calls + 1; return (i % 2 == 0) and 8 or 16 end
+pb.ui.list("var_list", 0, 0, W, 40, 1000, { row_height = measure })
+check("only rows near the view measured", height_calls >= 3 and height_calls <= 20)
+local measured = height_calls
+pb.ui.end_frame()
+pb.ui.begin_frame()
+pb.ui.list("var_list", 0, 0, W, 40, 1000, { row_height = measure })
+check("row heights cached", height_calls == measured)
+pb.ui.list("var_list", 0, 0, W, 40, 1010, { row_height = measure })
+check("appended rows measured when seen", height_calls == measured)
+local _, _, vf, vl = pb.ui.list("var_list", 0, 0, W, 40, 1010, { row_height = measure })
+check("variable rows visible range", vf == 1 and vl == 3)
+check("list of strings", select(4, pb.ui.list("str_list", 0, 0, W, 40, { "a", "b" })) == 2)
+check("table needs columns", not pcall(pb.ui.table, "no_cols", 0, 0, W, 40, {}, 10))
+check("table accepts numeric titles", pcall(pb.ui.table, "num_cols", 0, 0, W, 40, { 1, { title = 2 } }, 1))
+
+-- Callback errors are raised after the list is drawn, and stop further callbacks
+local ok_err, err_msg = pcall(pb.ui.list, "err_list", 0, 0, W, 40, 10, {
+    row_height = 10,
+    draw = function() error("cell boom") end,
+})
+check("draw callback error is raised", not ok_err and tostring(err_msg):find("cell boom") ~= nil)
+local err_calls = 0
+pcall(pb.ui.list, "err_list", 0, 0, W, 40, 10, {
+    row_height = 10,
+    text = function() err_calls = err_calls + 1; error("text boom") end,
+})
+check("callbacks stop after an error", err_calls == 1)
+local fail_row = 3
+local function flaky(i) if i == fail_row then error("height boom") end return 10 end
+check("row_height error is raised", not pcall(pb.ui.list, "err_heights", 0, 0, W, 40, 10, { row_height = flaky }))
+fail_row = nil
+local _, _, ef, el = pb.ui.list("err_heights", 0, 0, W, 40, 10, { row_height = flaky })
+check("rows measured again after an error", ef == 1 and el == 4)
+pb.ui.end_frame()
+pb.renderer.end_ui()
+
+-- Visual: whatever a draw callback draws is scissored to the list rows
+pb.renderer.clear(0.0, 0.0, 0.0, 1.0)
+pb.renderer.begin_ui(W, H)
+pb.ui.begin_frame()
+pb.ui.list("clip_list", 0, 0, 32, 20, 1, {
+    row_height = 20,
+    draw = function(row, x, y, w, h) pb.renderer.rect(x - 100, y - 100, 300, 300, 0, 1, 0, 1) end,
+})
+pb.ui.end_frame()
+pb.renderer.end_ui()
+pb.renderer.finish()
+local cr, cg = pb.renderer.read_pixel(10, 10, H)
+check("draw callback draws inside its cell", cg > 200 and cr < 50)
+cr, cg = pb.renderer.read_pixel(48, 40, H)
+check("draw callback clipped to its cell", cg < 50)
+
 -- Visual: panel draws dark background that we can read
 pb.renderer.clear(1.0, 1.0, 1.0, 1.0)  -- white background
 pb.renderer.begin_ui(W, H)
@@ -1060,11 +1482,240 @@ if tex then
     check("dead texture returns nil", w_dead == nil and h_dead == nil)
 end
 
+-- binary string data is uploaded directly; update_from streams new pixels
+local str_tex = pb.texture.create(2, 2, string.rep(string.char(0, 0, 255, 255), 4))
+check("create from string succeeds", str_tex ~= nil)
+local short, short_err = pb.texture.create(2, 2, "abc")
+check("create rejects short buffer", short == nil and type(short_err) == "string")
+if str_tex then
+    check("update_from is method", type(str_tex.update_from) == "function")
+    check("update_from whole texture", str_tex:update_from(string.rep(string.char(0, 255, 0, 255), 4)) == true)
+    check("update_from region", str_tex:update_from(string.char(255, 0, 0, 255), 0, 0, 1, 1) == true)
+    local ok_oob = str_tex:update_from(string.char(255, 0, 0, 255), 2, 2, 1, 1)
+    check("update_from rejects out-of-bounds region", ok_oob == false)
+    pb.renderer.clear(0, 0, 0, 1)
+    pb.renderer.begin(W, H)
+    str_tex:draw(0, 0, W, H)
+    pb.texture.flush()
+    pb.renderer.finish()
+    local r, g, b = pb.renderer.read_pixel(8, 8, H)
+    check("updated region: red", r > 200 and g < 50 and b < 50)
+    r, g, b = pb.renderer.read_pixel(48, 48, H)
+    check("updated texture: green", g > 200 and r < 50 and b < 50)
+    str_tex:destroy()
+end
+
 -- load non-existent file
 local bad, err2 = pb.texture.load("non_existent_image_12345.png")
 check("load bad file returns nil", bad == nil)
 check("load bad file has error", type(err2) == "string")
 
+-- pre-decoded disk cache: write a 2x2 TGA, load it cold then warm
+check("texture.set_cache_dir is function", type(pb.texture.set_cache_dir) == "function")
+check("texture.disk_cache_stats is function", type(pb.texture.disk_cache_stats) == "function")
+local tmp_dir = os.tmpname()
+os.remove(tmp_dir)
+local img_path = tmp_dir .. "_img.tga"
+local f = io.open(img_path, "wb")
+if f then
+    -- uncompressed true-color TGA, top-left origin, BGRA pixels
+    f:write(string.pack("<BBBI2I2BI2I2I2I2BB", 0, 0, 2, 0, 0, 0, 0, 0, 2, 2, 32, 0x28))
+    f:write(string.char(0,0,255,255, 0,255,0,255, 255,0,0,255, 255,255,255,255))
+    f:close()
+end
+check("cache dir enabled", pb.texture.set_cache_dir(tmp_dir) == true)
+check("get_cache_dir returns dir", pb.texture.get_cache_dir() == tmp_dir)
+pb.texture.reset_disk_cache_stats()
+local cold = pb.texture.load(img_path)
+check("cold load succeeds", cold ~= nil)
+
+-- path registry: a second load shares the same texture
+check("texture.cache_stats is function", type(pb.texture.cache_stats) == "function")
+check("texture.purge_unused is function", type(pb.texture.purge_unused) == "function")
+local shared = pb.texture.load(img_path)
+local reg = pb.texture.cache_stats()
+check("duplicate load shares entry", reg.entries == 1 and reg.hits == 1)
+check("shared entry referenced", reg.referenced == 1)
+if cold then cold:destroy() end
+check("shared texture survives one destroy", shared ~= nil and shared:get_width() == 2)
+if shared then shared:destroy() end
+reg = pb.texture.cache_stats()
+check("released entry stays cached", reg.entries == 1 and reg.unreferenced == 1)
+check("purge destroys unreferenced entry", pb.texture.purge_unused() == 1)
+check("registry empty after purge", pb.texture.cache_stats().entries == 0)
+
+-- sampler options key separate entries, so one load cannot retune another
+local near_tex = pb.texture.load(img_path, { filter = "nearest" })
+local lin_tex = pb.texture.load(img_path, { filter = "linear" })
+check("sampler options key separate entries", pb.texture.cache_stats().entries == 2)
+local near_again = pb.texture.load(img_path, { filter = "nearest" })
+check("same sampler options share entry", pb.texture.cache_stats().entries == 2 and near_again ~= nil)
+for _, t in ipairs({ near_tex, lin_tex, near_again }) do t:destroy() end
+pb.texture.purge_unused()
+
+-- after the purge the next load goes to the disk cache
+local warm = pb.texture.load(img_path)
+local stats = pb.texture.disk_cache_stats()
+check("warm load succeeds", warm ~= nil)
+check("cache file written", stats.writes == 1)
+check("warm load hit cache", stats.hits == 1 and stats.warm_loads == 1)
+check("cold load counted", stats.cold_loads == 1)
+check("timings reported", type(stats.cold_ms) == "number" and type(stats.warm_ms) == "number")
+if warm then
+    local cw, ch = warm:get_size()
+    check("warm texture size 2x2", cw == 2 and ch == 2)
+    pb.renderer.clear(0, 0, 0, 1)
+    pb.renderer.begin(W, H)
+    warm:draw(0, 0, W, H)
+    pb.renderer.finish()
+    local r, g, b = pb.renderer.read_pixel(8, 8, H)
+    check("warm texture pixels: red", r > 200 and g < 50 and b < 50)
+end
+if warm then warm:destroy() end
+pb.texture.purge_unused()
+
+-- memory budget: evict a file-loaded texture and reload it transparently
+check("texture.memory_stats is function", type(pb.texture.memory_stats) == "function")
+local mem0 = pb.texture.memory_stats()
+check("memory stats totals", mem0.total_bytes == mem0.texture_bytes + mem0.font_bytes)
+local evictable = pb.texture.load(img_path)
+check("load adds 2x2 RGBA bytes", pb.texture.memory_stats().texture_bytes == mem0.texture_bytes + 16)
+pb.renderer.begin(W, H)
+pb.renderer.finish()
+pb.texture.set_memory_budget(1)
+check("memory budget set", pb.texture.get_memory_budget() == 1)
+local mem1 = pb.texture.memory_stats()
+check("over budget evicts texture", mem1.evicted == 1 and mem1.evictions == mem0.evictions + 1)
+check("evicted bytes released", mem1.texture_bytes == mem0.texture_bytes)
+check("evicted handle still valid", evictable ~= nil and evictable:get_width() == 2)
+if evictable then
+    pb.renderer.clear(0, 0, 0, 1)
+    pb.renderer.begin(W, H)
+    evictable:draw(0, 0, W, H)
+    pb.renderer.finish()
+    local r, g, b = pb.renderer.read_pixel(8, 8, H)
+    check("reloaded texture pixels: red", r > 200 and g < 50 and b < 50)
+    local mem2 = pb.texture.memory_stats()
+    check("reload counted", mem2.reloads == mem0.reloads + 1 and mem2.evicted == 0)
+    evictable:destroy()
+end
+pb.texture.set_memory_budget(nil)
+check("memory budget cleared", pb.texture.get_memory_budget() == nil)
+pb.texture.purge_unused()
+
+-- mipmaps and sampler settings
+local mem_before = pb.texture.memory_stats().texture_bytes
+local mipped = pb.texture.load(img_path, { mipmaps = true, filter = "linear", wrap = "repeat", lod_bias = 0.5 })
+check("load with mipmaps succeeds", mipped ~= nil)
+if mipped then
+    check("2x2 texture has 2 mip levels", mipped:get_mip_count() == 2)
+    check("mip bytes accounted", pb.texture.memory_stats().texture_bytes == mem_before + 16 + 4)
+    check("set_filter accepts nearest", pcall(mipped.set_filter, mipped, "nearest"))
+    check("set_filter rejects bad name", not pcall(mipped.set_filter, mipped, "cubic"))
+    check("set_wrap accepts two modes", pcall(mipped.set_wrap, mipped, "mirror", "clamp"))
+    check("set_lod_bias accepts number", pcall(mipped.set_lod_bias, mipped, 1.0))
+    mipped:destroy()
+end
+local plain = pb.texture.load(img_path)
+check("mipmap option keys a separate entry", plain ~= nil and plain:get_mip_count() == 1)
+if plain then plain:destroy() end
+pb.texture.purge_unused()
+local gen = pb.texture.create(4, 4, string.rep(string.char(255, 255, 255, 255), 16))
+if gen then
+    check("generate_mipmaps builds full chain", gen:generate_mipmaps() == 3)
+    check("created texture reports mips", gen:get_mip_count() == 3)
+    gen:destroy()
+end
+
+-- reduced storage formats (also round-trip through the disk cache)
+mem_before = pb.texture.memory_stats().texture_bytes
+local packed = pb.texture.load(img_path, { format = "rgb565" })
+check("load rgb565 succeeds", packed ~= nil)
+if packed then
+    check("get_format reports rgb565", packed:get_format() == "rgb565")
+    check("rgb565 uses 2 bytes per pixel", pb.texture.memory_stats().texture_bytes == mem_before + 8)
+    pb.renderer.clear(0, 0, 0, 1)
+    pb.renderer.begin(W, H)
+    packed:draw(0, 0, W, H)
+    pb.renderer.finish()
+    local r, g, b = pb.renderer.read_pixel(8, 8, H)
+    check("rgb565 texture pixels: red", r > 200 and g < 50 and b < 50)
+    packed:destroy()
+end
+pb.texture.purge_unused()
+local packed_warm = pb.texture.load(img_path, { format = "rgb565" })
+check("rgb565 reloads from cache", packed_warm ~= nil and packed_warm:get_format() == "rgb565")
+if packed_warm then packed_warm:destroy() end
+local auto = pb.texture.load(img_path, { format = "auto" })
+check("auto keeps RGBA source as rgba8", auto ~= nil and auto:get_format() == "rgba8")
+if auto then auto:destroy() end
+
+-- opaque gray PNG stored as r8 must stay opaque gray, not a white mask
+local function crc32(data)
+    local crc = 0xFFFFFFFF
+    for i = 1, #data do
+        crc = crc ~ data:byte(i)
+        for _ = 1, 8 do crc = (crc >> 1) ~ (0xEDB88320 & -(crc & 1)) end
+    end
+    return ~crc & 0xFFFFFFFF
+end
+local function png_chunk(kind, data)
+    return string.pack(">I4", #data) .. kind .. data .. string.pack(">I4", crc32(kind .. data))
+end
+local gray_rows = string.rep(string.char(0, 100, 100), 2)  -- filter byte + 2 pixels per row
+local adler_a, adler_b = 1, 0
+for i = 1, #gray_rows do
+    adler_a = (adler_a + gray_rows:byte(i)) % 65521
+    adler_b = (adler_b + adler_a) % 65521
+end
+local gray_path = tmp_dir .. "_gray.png"
+f = io.open(gray_path, "wb")
+if f then
+    f:write("\137PNG\r\n\26\n")
+    f:write(png_chunk("IHDR", string.pack(">I4I4BBBBB", 2, 2, 8, 0, 0, 0, 0)))
+    f:write(png_chunk("IDAT", "\120\1\1" .. string.pack("<I2I2", #gray_rows, ~#gray_rows & 0xFFFF)
+        .. gray_rows .. string.pack(">I4", (adler_b << 16) | adler_a)))
+    f:write(png_chunk("IEND", ""))
+    f:close()
+end
+for _, fmt in ipairs({ "r8", "auto" }) do
+    local gray = pb.texture.load(gray_path, { format = fmt })
+    check("gray png loads as " .. fmt, gray ~= nil and gray:get_format() == "r8")
+    if gray then
+        -- over red, an opaque gray covers it; a translucent white mask would not
+        pb.renderer.clear(1, 0, 0, 1)
+        pb.renderer.begin(W, H)
+        gray:draw(0, 0, W, H)
+        pb.renderer.finish()
+        local r, g, b = pb.renderer.read_pixel(8, 8, H)
+        check("gray r8 samples opaque gray (" .. fmt .. ")",
+            math.abs(r - 100) < 8 and math.abs(g - 100) < 8 and math.abs(b - 100) < 8)
+        gray:destroy()
+    end
+end
+-- updates of an opaque gray r8 texture keep packing the gray level, not alpha
+local gray = pb.texture.load(gray_path, { format = "r8" })
+if gray then
+    check("gray r8 update_from", gray:update_from(string.char(40, 40, 40, 255), 0, 0, 1, 1) == true)
+    pb.renderer.clear(1, 0, 0, 1)
+    pb.renderer.begin(W, H)
+    gray:draw(0, 0, W, H)
+    pb.renderer.finish()
+    local r, g, b = pb.renderer.read_pixel(8, 8, H)
+    check("updated gray r8 texel stays gray", math.abs(r - 40) < 8 and math.abs(g - 40) < 8 and math.abs(b - 40) < 8)
+    gray:destroy()
+end
+os.remove(gray_path)
+check("load rejects bad format", not pcall(pb.texture.load, img_path, { format = "dxt1" }))
+pb.texture.purge_unused()
+pb.texture.set_cache_dir(nil)
+check("cache disabled", pb.texture.get_cache_dir() == nil)
+os.remove(img_path)
+for _, name in ipairs(pb.studio.list_dir(tmp_dir) or {}) do
+    os.remove(tmp_dir .. "/" .. name)
+end
+os.remove(tmp_dir)
+
 pb.window.destroy(w)
 print(string.format("TEXTURE_RESULT: %d passed, %d failed", pass, fail))
 if fail > 0 then os.exit(13) end
@@ -1229,6 +1880,448 @@ else
     exit 15
 fi
 
+# ───────────────── Sprite module tests ─────────────────
+echo ""
+echo "Running sprite module tests..."
+SPRITE_OUTPUT=$(lua -e '
+package.cpath = "./?.so;" .. package.cpath
+local pb = require("PudimBasicsGl")
+
+local W, H = 64, 64
+local w = pb.window.create(W, H, "sprite_test")
+if not w then print("SPRITE_FAIL:window"); os.exit(2) end
+pb.renderer.init()
+
+local pass = 0
+local fail = 0
+local function check(name, cond)
+    if cond then pass = pass + 1; print("  OK: " .. name)
+    else fail = fail + 1; print("  FAIL: " .. name) end
+end
+
+check("sprite table exists", pb.sprite ~= nil)
+check("sprite.grid is function", type(pb.sprite.grid) == "function")
+check("sprite.load_atlas is function", type(pb.sprite.load_atlas) == "function")
+check("sprite.new_set is function", type(pb.sprite.new_set) == "function")
+
+-- 4x2 texture: left 2x2 red, right 2x2 green
+local red, green = string.char(255, 0, 0, 255), string.char(0, 255, 0, 255)
+local row = red .. red .. green .. green
+local tex = pb.texture.create(4, 2, row .. row)
+local sheet = pb.sprite.grid(tex, 2, 2)
+check("grid sheet created", sheet ~= nil)
+check("grid has 2 frames", sheet:get_frame_count() == 2)
+local fx, fy, fw, fh = sheet:get_frame(2)
+check("frame 2 rect", fx == 2 and fy == 0 and fw == 2 and fh == 2)
+check("grid rejects oversized frames", pb.sprite.grid(tex, 8, 8) == nil)
+
+check("add_clip succeeds", sheet:add_clip("blink", {1, 2}, { fps = 1 }) == true)
+check("add_clip rejects bad frame", sheet:add_clip("bad", {1, 5}) == false)
+check("has_clip", sheet:has_clip("blink") and not sheet:has_clip("bad"))
+check("add_clip rejects bad mode", not pcall(sheet.add_clip, sheet, "x", {1}, { mode = "bounce" }))
+
+local sprites = pb.sprite.new_set(sheet)
+local id = sprites:add(0, 0, { width = W, height = H, clip = "blink" })
+check("add returns id", type(id) == "number")
+check("count is 1", sprites:count() == 1)
+check("starts on first frame", sprites:get_frame(id) == 1)
+
+local function draw(dt)
+    pb.renderer.clear(0, 0, 0, 1)
+    pb.renderer.begin(W, H)
+    sprites:draw_all(dt)
+    pb.renderer.finish()
+    return pb.renderer.read_pixel(32, 32, H)
+end
+
+local r, g = draw(0)
+check("frame 1 draws red", r > 200 and g < 50)
+sprites:update(1.0)
+check("update advances clip", sprites:get_frame(id) == 2)
+r, g = draw()
+check("draw_all after update does not advance again", sprites:get_frame(id) == 2)
+check("frame 2 draws green", g > 200 and r < 50)
+draw(1.0)
+check("loop wraps to first frame", sprites:get_frame(id) == 1)
+
+sheet:add_clip("once", {1, 2}, { fps = 1, mode = "once" })
+sprites:play(id, "once", true)
+draw(5.0)
+check("once clip stops on last frame", sprites:get_frame(id) == 2 and not sprites:is_playing(id))
+check("play rejects unknown clip", not pcall(sprites.play, sprites, id, "nope"))
+
+sprites:set(id, { frame = 1, flip_x = true })
+check("set fixes a frame", sprites:get_frame(id) == 1)
+sprites:set_position(id, 5, 6)
+local px, py = sprites:get_position(id)
+check("set_position", px == 5 and py == 6)
+sprites:remove(id)
+check("remove drops sprite", sprites:count() == 0)
+check("removed id is invalid", not pcall(sprites.get_frame, sprites, id))
+
+-- Aseprite-style JSON atlas with a tag and per-frame durations
+local tmp = os.tmpname()
+local f = io.open(tmp, "w")
+f:write([[{"frames": [
+  {"filename": "a", "frame": {"x": 0, "y": 0, "w": 2, "h": 2}, "duration": 100},
+  {"filename": "b", "frame": {"x": 2, "y": 0, "w": 2, "h": 2}, "duration": 300}
+ ], "meta": {"frameTags": [{"name": "idle", "from": 0, "to": 1, "direction": "forward"}]}}]])
+f:close()
+local atlas, err = pb.sprite.load_atlas(tmp, tex)
+check("load_atlas succeeds", atlas ~= nil)
+if atlas then
+    check("atlas frame count", atlas:get_frame_count() == 2)
+    check("atlas frame lookup", atlas:find_frame("b") == 2)
+    check("tag becomes clip", atlas:get_clip_names()[1] == "idle")
+    local set = pb.sprite.new_set(atlas)
+    local a = set:add(0, 0, { clip = "idle" })
+    set:update(0.15)
+    check("per-frame duration advances", set:get_frame(a) == 2)
+    set:update(0.2)
+    check("long frame holds", set:get_frame(a) == 2)
+    set:update(0.1)
+    check("clip loops after durations", set:get_frame(a) == 1)
+    set:destroy()
+end
+os.remove(tmp)
+local missing, merr = pb.sprite.load_atlas("non_existent_atlas_12345.json")
+check("missing atlas returns nil, error", missing == nil and type(merr) == "string")
+
+sheet:destroy()
+sprites:clear()
+draw(0)
+check("set keeps destroyed sheet alive", true)
+sprites:destroy()
+tex:destroy()
+
+pb.window.destroy(w)
+print(string.format("SPRITE_RESULT: %d passed, %d failed", pass, fail))
+if fail > 0 then os.exit(16) end
+print("SPRITE_OK")
+' 2>&1 || true)
+
+printf "%s\n" "$SPRITE_OUTPUT"
+
+if printf "%s\n" "$SPRITE_OUTPUT" | grep -q "SPRITE_OK"; then
+    echo "Sprite module tests passed"
+else
+    echo "Sprite module tests failed!" >&2
+    exit 16
+fi
+
+# ───────────────── Tilemap module tests ─────────────────
+echo ""
+echo "Running tilemap module tests..."
+TILEMAP_OUTPUT=$(lua -e '
+package.cpath = "./?.so;" .. package.cpath
+local pb = require("PudimBasicsGl")
+
+local W, H = 64, 64
+local w = pb.window.create(W, H, "tilemap_test")
+if not w then print("TILEMAP_FAIL:window"); os.exit(2) end
+pb.renderer.init()
+
+local pass = 0
+local fail = 0
+local function check(name, cond)
+    if cond then pass = pass + 1; print("  OK: " .. name)
+    else fail = fail + 1; print("  FAIL: " .. name) end
+end
+
+check("tilemap table exists", pb.tilemap ~= nil)
+check("tilemap.new is function", type(pb.tilemap.new) == "function")
+check("tilemap.load_tiled is function", type(pb.tilemap.load_tiled) == "function")
+check("tilemap.load_csv is function", type(pb.tilemap.load_csv) == "function")
+
+-- 4x2 tileset of 2x2 tiles: tile 1 red, tile 2 green
+local red, green = string.char(255, 0, 0, 255), string.char(0, 255, 0, 255)
+local row = red .. red .. green .. green
+local tex = pb.texture.create(4, 2, row .. row)
+
+-- 100x40 tiles of 2px = 4x2 chunks of 64x64 px
+local map = pb.tilemap.new(100, 40, 2, 2, tex)
+check("map created", map ~= nil)
+local mw, mh = map:get_size()
+check("get_size", mw == 100 and mh == 40)
+check("one layer by default", map:get_layer_count() == 1)
+check("new rejects oversized tiles", pb.tilemap.new(4, 4, 8, 8, tex) == nil)
+
+map:fill(1, 0, 0, 100, 40, 1)
+map:set(1, 0, 0, 2)
+check("get returns set tile", map:get(1, 0, 0) == 2 and map:get(1, 1, 0) == 1)
+check("out of range get is 0", map:get(1, -1, 0) == 0 and map:get(1, 100, 0) == 0)
+check("set rejects unknown tile", not pcall(map.set, map, 1, 0, 0, 3))
+check("set rejects bad layer", not pcall(map.set, map, 2, 0, 0, 1))
+
+local function draw(x, y)
+    pb.renderer.clear(0, 0, 0, 1)
+    pb.renderer.begin(W, H)
+    local n = map:draw(x, y)
+    pb.renderer.finish()
+    return n
+end
+
+local n = draw()
+local r, g = pb.renderer.read_pixel(32, 32, H)
+check("tile 1 draws red", r > 200 and g < 50)
+r, g = pb.renderer.read_pixel(0, 0, H)
+check("tile 2 draws green", g > 200 and r < 50)
+check("only visible chunks drawn", n > 0 and n < 8 and map:stats().chunks_drawn == n)
+check("chunks built once", map:stats().chunk_rebuilds == n)
+draw()
+check("static chunks are not rebuilt", map:stats().chunk_rebuilds == n)
+
+pb.camera.set_position(10000, 10000)
+check("camera culls off-screen chunks", draw() == 0)
+pb.camera.reset()
+check("map offset culls chunks", draw(-10000, 0) == 0)
+
+check("set_animation succeeds", map:set_animation(1, {2}, 1.0) == true)
+check("set_animation rejects bad frame", not pcall(map.set_animation, map, 1, {9}))
+draw()
+r, g = pb.renderer.read_pixel(32, 32, H)
+check("animated tile shows its frame", g > 200 and r < 50)
+check("animation counted", map:stats().animations == 1)
+
+local top = map:add_layer("top")
+check("add_layer returns index", top == 2 and map:find_layer("top") == 2)
+check("find_layer missing is nil", map:find_layer("nope") == nil)
+map:set_layer_visible(1, false)
+check("hidden layers are skipped", draw() == 0)
+local tw, th = map:world_to_tile(5, 3)
+check("world_to_tile", tw == 2 and th == 1)
+map:destroy()
+check("destroyed map raises", not pcall(map.get, map, 1, 0, 0))
+
+-- CSV: 0-based indices, -1 empty
+local tmp = os.tmpname()
+local f = io.open(tmp, "w")
+f:write("0,1,-1\n1,0,0\n")
+f:close()
+local csv, cerr = pb.tilemap.load_csv(tmp, tex, 2, 2)
+check("load_csv succeeds", csv ~= nil)
+if csv then
+    local cw, ch = csv:get_size()
+    check("csv size", cw == 3 and ch == 2)
+    check("csv values", csv:get(1, 0, 0) == 1 and csv:get(1, 1, 0) == 2 and csv:get(1, 2, 0) == 0)
+    csv:destroy()
+end
+-- Long values stay one cell (out of range = empty); flip flags are masked
+f = io.open(tmp, "w")
+f:write("12345678901,2147483649,2\n")
+f:close()
+csv = pb.tilemap.load_csv(tmp, tex, 2, 2, { one_based = true })
+check("csv long values", csv ~= nil and select(1, csv:get_size()) == 3)
+if csv then
+    check("csv out of range is empty", csv:get(1, 0, 0) == 0)
+    check("csv flip flags masked", csv:get(1, 1, 0) == 1 and csv:get(1, 2, 0) == 2)
+    csv:destroy()
+end
+os.remove(tmp)
+
+-- Tiled JSON with an animated tile and a flipped gid
+tmp = os.tmpname()
+f = io.open(tmp, "w")
+f:write([[{"width": 2, "height": 1, "tilewidth": 2, "tileheight": 2, "infinite": false,
+ "layers": [{"type": "tilelayer", "name": "ground", "data": [2, 2147483649], "opacity": 1, "visible": true}],
+ "tilesets": [{"firstgid": 1, "tilewidth": 2, "tileheight": 2,
+   "tiles": [{"id": 0, "animation": [{"tileid": 0, "duration": 100}, {"tileid": 1, "duration": 100}]}]}]}]])
+f:close()
+local tiled, terr = pb.tilemap.load_tiled(tmp, tex)
+check("load_tiled succeeds", tiled ~= nil)
+if tiled then
+    check("tiled layer name", tiled:find_layer("ground") == 1)
+    check("tiled gids and flip bits", tiled:get(1, 0, 0) == 2 and tiled:get(1, 1, 0) == 1)
+    check("tiled animation imported", tiled:stats().animations == 1)
+    tiled:destroy()
+end
+f = io.open(tmp, "w")
+f:write([[{"width": 1, "height": 1, "tilewidth": 2, "tileheight": 2,
+ "layers": [{"type": "tilelayer", "encoding": "base64", "data": "AQAAAA=="}],
+ "tilesets": [{"firstgid": 1}]}]])
+f:close()
+local bad, berr = pb.tilemap.load_tiled(tmp, tex)
+check("base64 layers rejected", bad == nil and type(berr) == "string")
+
+-- 16px tileset tiles on a 32px map grid: cells grow, UVs keep the tileset size
+local red16, green16 = string.rep(red, 16), string.rep(green, 16)
+local big_tex = pb.texture.create(32, 16, string.rep(red16 .. green16, 16))
+f = io.open(tmp, "w")
+f:write([[{"width": 2, "height": 1, "tilewidth": 32, "tileheight": 32,
+ "layers": [{"type": "tilelayer", "name": "ground", "data": [1, 2]}],
+ "tilesets": [{"firstgid": 1, "tilewidth": 16, "tileheight": 16}]}]])
+f:close()
+local grid = pb.tilemap.load_tiled(tmp, big_tex)
+check("load_tiled with larger map cells", grid ~= nil)
+if grid then
+    local gw, gh = grid:get_tile_size()
+    check("cells follow the map grid", gw == 32 and gh == 32)
+    pb.renderer.clear(0, 0, 0, 1)
+    pb.renderer.begin(W, H)
+    grid:draw()
+    pb.renderer.finish()
+    r, g = pb.renderer.read_pixel(24, 8, H)
+    check("cell samples only its tile (red)", r > 200 and g < 50)
+    r, g = pb.renderer.read_pixel(56, 24, H)
+    check("second cell samples its tile (green)", g > 200 and r < 50)
+    grid:destroy()
+end
+big_tex:destroy()
+os.remove(tmp)
+local missing, merr = pb.tilemap.load_tiled("non_existent_map_12345.tmj")
+check("missing map returns nil, error", missing == nil and type(merr) == "string")
+
+tex:destroy()
+pb.window.destroy(w)
+print(string.format("TILEMAP_RESULT: %d passed, %d failed", pass, fail))
+if fail > 0 then os.exit(17) end
+print("TILEMAP_OK")
+' 2>&1 || true)
+
+printf "%s\n" "$TILEMAP_OUTPUT"
+
+if printf "%s\n" "$TILEMAP_OUTPUT" | grep -q "TILEMAP_OK"; then
+    echo "Tilemap module tests passed"
+else
+    echo "Tilemap module tests failed!" >&2
+    exit 17
+fi
+
+# ───────────────── Particles module tests ─────────────────
+echo ""
+echo "Running particles module tests..."
+PARTICLES_OUTPUT=$(lua -e '
+package.cpath = "./?.so;" .. package.cpath
+local pb = require("PudimBasicsGl")
+
+local W, H = 64, 64
+local w = pb.window.create(W, H, "particles_test")
+if not w then print("PARTICLES_FAIL:window"); os.exit(2) end
+pb.renderer.init()
+
+local pass = 0
+local fail = 0
+local function check(name, cond)
+    if cond then pass = pass + 1; print("  OK: " .. name)
+    else fail = fail + 1; print("  FAIL: " .. name) end
+end
+
+check("particles table exists", pb.particles ~= nil)
+check("particles.new is function", type(pb.particles.new) == "function")
+
+local e = pb.particles.new({ capacity = 100, rate = 0, x = 32, y = 32, speed = 0,
+    life = 1, size = 32, colors = { {1, 0, 0, 1} } })
+check("emitter created", e ~= nil)
+check("capacity", e:get_capacity() == 100)
+check("starts empty", e:count() == 0)
+check("emit spawns", e:emit(10) == 10 and e:count() == 10)
+check("emit is capped by capacity", e:emit(500) == 90 and e:count() == 100)
+
+local function draw()
+    pb.renderer.clear(0, 0, 0, 1)
+    pb.renderer.begin(W, H)
+    e:draw()
+    pb.renderer.finish()
+    return pb.renderer.read_pixel(32, 32, H)
+end
+
+local r, g, b = draw()
+check("particles draw at emitter", r > 200 and g < 50 and b < 50)
+r = pb.renderer.read_pixel(2, 2, H)
+check("particles are sized", r < 50)
+
+e:update(0.5)
+check("particles alive mid-life", e:count() == 100)
+e:update(0.6)
+check("particles retire after life", e:count() == 0)
+
+e:set({ rate = 100, speed = {0, 0} })
+e:update(0.5)
+check("rate emission", e:count() >= 49 and e:count() <= 51)
+e:stop()
+check("stop", not e:is_emitting())
+local n = e:count()
+e:update(0.1)
+check("stopped emitter does not emit", e:count() == n)
+e:clear()
+check("clear", e:count() == 0)
+
+-- Motion: gravity pulls particles down from the top edge
+e:set({ x = 32, y = 0, gravity_y = 2000, size = 8, life = 5 })
+e:emit(1)
+e:update(0.2)
+r = draw()
+check("gravity moves particles", r < 50)
+e:clear()
+
+-- Textured particles and color curves
+local green = string.char(0, 255, 0, 255)
+local tex = pb.texture.create(2, 2, green:rep(4))
+e:set({ x = 32, y = 32, gravity_y = 0, size = 32, colors = { {1, 1, 1, 1}, {1, 1, 1, 0} } })
+e:set_texture(tex)
+e:emit(1)
+r, g = draw()
+check("textured particle", g > 200 and r < 50)
+e:update(0.9 * 5)
+r, g = draw()
+check("color curve fades out", g < 60)
+e:set_texture(nil)
+
+check("bad shape raises", not pcall(e.set, e, { shape = "star" }))
+check("too many color keys raises", not pcall(e.set, e, { colors = { {1},{1},{1},{1},{1},{1},{1},{1},{1} } }))
+
+local shapes = pb.particles.new({ capacity = 1000, rate = 0, shape = "ring", radius = 10, radial = true })
+check("ring emitter", shapes:emit(1000) == 1000)
+shapes:update(0.016)
+shapes:destroy()
+check("destroyed emitter raises", not pcall(shapes.count, shapes))
+
+-- GPU particles: simulated with transform feedback, drawn from the result buffer
+check("particles.new_gpu is function", type(pb.particles.new_gpu) == "function")
+local gpu = pb.particles.new_gpu({ count = 4000, shape = "rect", x = 32, y = 32, width = 64, height = 64,
+    speed = 0, life = 1, size = 8, colors = { {0, 0, 1, 1} }, prewarm = 1.1 })
+check("gpu system created", gpu ~= nil)
+check("gpu count", gpu:get_count() == 4000)
+local function draw_gpu()
+    pb.renderer.clear(0, 0, 0, 1)
+    pb.renderer.begin(W, H)
+    gpu:draw()
+    pb.renderer.finish()
+    return pb.renderer.read_pixel(32, 32, H)
+end
+r, g, b = draw_gpu()
+check("gpu particles draw", b > 200 and r < 50)
+gpu:stop()
+check("gpu stop", not gpu:is_emitting())
+gpu:update(1.1)
+r, g, b = draw_gpu()
+check("stopped gpu particles die out", b < 50)
+gpu:start()
+gpu:reset()
+gpu:prewarm(1.1)
+r, g, b = draw_gpu()
+check("gpu reset and prewarm respawn", b > 200)
+check("gpu bad shape raises", not pcall(gpu.set, gpu, { shape = "star" }))
+gpu:destroy()
+check("destroyed gpu system raises", not pcall(gpu.get_count, gpu))
+
+e:destroy()
+tex:destroy()
+pb.window.destroy(w)
+print(string.format("PARTICLES_RESULT: %d passed, %d failed", pass, fail))
+if fail > 0 then os.exit(18) end
+print("PARTICLES_OK")
+' 2>&1 || true)
+
+printf "%s\n" "$PARTICLES_OUTPUT"
+
+if printf "%s\n" "$PARTICLES_OUTPUT" | grep -q "PARTICLES_OK"; then
+    echo "Particles module tests passed"
+else
+    echo "Particles module tests failed!" >&2
+    exit 18
+fi
+
 echo ""
 echo "════════════════════════════════════════════"
 echo " ALL TEST SUITES PASSED"
@@ -0,0 +1,464 @@
+#include <lua.h>
+#include <lauxlib.h>
+#include <lualib.h>
+#include "../render/particles.h"
+
+#define EMITTER_METATABLE "PudimBasicsGl.ParticleEmitter"
+#define GPU_PARTICLES_METATABLE "PudimBasicsGl.GpuParticles"
+#define TEXTURE_METATABLE "PudimBasicsGl.Texture"
+
+// Frame delta from pb.time (lua_time.c)
+extern double time_get_delta(void);
+
+static const char* const shape_names[] = {"point", "circle", "ring", "rect", "line", NULL};
+
+static ParticleEmitter* check_emitter(lua_State* L, int index) {
+    ParticleEmitter** emitter = (ParticleEmitter**)luaL_checkudata(L, index, EMITTER_METATABLE);
+    if (!*emitter) luaL_error(L, "particle emitter has been destroyed");
+    return *emitter;
+}
+
+static GpuParticleSystem* check_gpu(lua_State* L, int index) {
+    GpuParticleSystem** system = (GpuParticleSystem**)luaL_checkudata(L, index, GPU_PARTICLES_METATABLE);
+    if (!*system) luaL_error(L, "GPU particle system has been destroyed");
+    return *system;
+}
+
+static void opt_float(lua_State* L, int idx, const char* key, float* out) {
+    lua_getfield(L, idx, key);
+    if (!lua_isnil(L, -1)) *out = (float)luaL_checknumber(L, -1);
+    lua_pop(L, 1);
+}
+
+// A number or a {min, max} pair
+static void opt_range(lua_State* L, int idx, const char* key, float* lo, float* hi) {
+    lua_getfield(L, idx, key);
+    if (lua_istable(L, -1)) {
+        lua_rawgeti(L, -1, 1);
+        lua_rawgeti(L, -2, 2);
+        *lo = (float)luaL_checknumber(L, -2);
+        *hi = (float)luaL_optnumber(L, -1, *lo);
+        lua_pop(L, 2);
+    } else if (!lua_isnil(L, -1)) {
+        *lo = *hi = (float)luaL_checknumber(L, -1);
+    }
+    lua_pop(L, 1);
+}
+
+// Apply the fields of an options table on top of `c`
+static void read_config(lua_State* L, int idx, ParticleEmitterConfig* c) {
+    opt_float(L, idx, "x", &c->x);
+    opt_float(L, idx, "y", &c->y);
+    opt_float(L, idx, "rate", &c->rate);
+    opt_float(L, idx, "radius", &c->radius);
+    opt_float(L, idx, "width", &c->width);
+    opt_float(L, idx, "height", &c->height);
+    opt_float(L, idx, "angle", &c->angle);
+    opt_float(L, idx, "spread", &c->spread);
+    opt_float(L, idx, "gravity_x", &c->gravity_x);
+    opt_float(L, idx, "gravity_y", &c->gravity_y);
+    opt_float(L, idx, "drag", &c->drag);
+    opt_range(L, idx, "speed", &c->speed_min, &c->speed_max);
+    opt_range(L, idx, "life", &c->life_min, &c->life_max);
+    opt_range(L, idx, "spin", &c->spin_min, &c->spin_max);
+
+    lua_getfield(L, idx, "shape");
+    if (!lua_isnil(L, -1)) c->shape = (ParticleShape)luaL_checkoption(L, -1, NULL, shape_names);
+    lua_getfield(L, idx, "radial");
+    if (!lua_isnil(L, -1)) c->radial = lua_toboolean(L, -1);
+    lua_getfield(L, idx, "additive");
+    if (!lua_isnil(L, -1)) c->additive = lua_toboolean(L, -1);
+    lua_pop(L, 3);
+
+    lua_getfield(L, idx, "size");
+    if (!lua_isnil(L, -1)) {
+        c->sizes[0] = (float)luaL_checknumber(L, -1);
+        c->size_count = 1;
+    }
+    lua_pop(L, 1);
+
+    lua_getfield(L, idx, "sizes");
+    if (lua_istable(L, -1)) {
+        int n = (int)lua_rawlen(L, -1);
+        if (n < 1 || n > PARTICLE_CURVE_KEYS) luaL_error(L, "sizes needs 1 to %d keys", PARTICLE_CURVE_KEYS);
+        for (int i = 0; i < n; i++) {
+            lua_rawgeti(L, -1, i + 1);
+            c->sizes[i] = (float)luaL_checknumber(L, -1);
+            lua_pop(L, 1);
+        }
+        c->size_count = n;
+    }
+    lua_pop(L, 1);
+
+    // colors = { {r, g, b, a?}, ... } evenly spaced over the particle's life
+    lua_getfield(L, idx, "colors");
+    if (lua_istable(L, -1)) {
+        int n = (int)lua_rawlen(L, -1);
+        if (n < 1 || n > PARTICLE_CURVE_KEYS) luaL_error(L, "colors needs 1 to %d keys", PARTICLE_CURVE_KEYS);
+        for (int i = 0; i < n; i++) {
+            lua_rawgeti(L, -1, i + 1);
+            luaL_checktype(L, -1, LUA_TTABLE);
+            for (int ch = 0; ch < 4; ch++) {
+                lua_rawgeti(L, -1, ch + 1);
+                c->colors[i][ch] = (float)luaL_optnumber(L, -1, 1.0);
+                lua_pop(L, 1);
+            }
+            lua_pop(L, 1);
+        }
+        c->color_count = n;
+    }
+    lua_pop(L, 1);
+}
+
+static Texture* opt_texture(lua_State* L, int idx) {
+    if (lua_isnoneornil(L, idx)) return NULL;
+    return *(Texture**)luaL_checkudata(L, idx, TEXTURE_METATABLE);
+}
+
+// --- Module functions ---
+
+// PudimBasicsGl.particles.new(options?) -> ParticleEmitter
+// options: emitter fields plus { capacity = 10000, texture = Texture }
+static int l_particles_new(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1) && lua_istable(L, 2)) arg = 2; // allow pb.particles:new{...}
+    int capacity = 10000;
+    Texture* texture = NULL;
+    ParticleEmitterConfig config;
+    particle_config_defaults(&config);
+
+    if (lua_istable(L, arg)) {
+        lua_getfield(L, arg, "capacity");
+        capacity = (int)luaL_optinteger(L, -1, 10000);
+        lua_getfield(L, arg, "texture");
+        texture = opt_texture(L, lua_gettop(L));
+        lua_pop(L, 2);
+        read_config(L, arg, &config);
+    }
+    if (capacity <= 0) luaL_error(L, "capacity must be positive");
+
+    // Lazy init texture renderer (needs OpenGL context)
+    texture_renderer_init();
+
+    ParticleEmitter** udata = (ParticleEmitter**)lua_newuserdata(L, sizeof(ParticleEmitter*));
+    *udata = particle_emitter_create(capacity, &config, texture);
+    luaL_getmetatable(L, EMITTER_METATABLE);
+    lua_setmetatable(L, -2);
+    if (!*udata) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Failed to allocate particle pool");
+        return 2;
+    }
+    return 1;
+}
+
+// PudimBasicsGl.particles.new_gpu(options?) -> GpuParticles
+// options: emitter fields plus { count = 100000, texture = Texture, prewarm = seconds }
+static int l_particles_new_gpu(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1) && lua_istable(L, 2)) arg = 2; // allow pb.particles:new_gpu{...}
+    int count = 100000;
+    float prewarm = 0.0f;
+    Texture* texture = NULL;
+    ParticleEmitterConfig config;
+    particle_config_defaults(&config);
+
+    if (lua_istable(L, arg)) {
+        lua_getfield(L, arg, "count");
+        count = (int)luaL_optinteger(L, -1, 100000);
+        lua_getfield(L, arg, "prewarm");
+        prewarm = (float)luaL_optnumber(L, -1, 0.0);
+        lua_getfield(L, arg, "texture");
+        texture = opt_texture(L, lua_gettop(L));
+        lua_pop(L, 3);
+        read_config(L, arg, &config);
+    }
+    if (count <= 0) luaL_error(L, "count must be positive");
+
+    // Lazy init texture renderer (needs OpenGL context)
+    texture_renderer_init();
+
+    GpuParticleSystem** udata = (GpuParticleSystem**)lua_newuserdata(L, sizeof(GpuParticleSystem*));
+    *udata = gpu_particles_create(count, &config, texture);
+    luaL_getmetatable(L, GPU_PARTICLES_METATABLE);
+    lua_setmetatable(L, -2);
+    if (!*udata) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Failed to create GPU particle system");
+        return 2;
+    }
+    if (prewarm > 0.0f) gpu_particles_prewarm(*udata, prewarm);
+    return 1;
+}
+
+// --- ParticleEmitter methods ---
+
+// emitter:set(options)
+static int l_emitter_set(lua_State* L) {
+    ParticleEmitter* e = check_emitter(L, 1);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    ParticleEmitterConfig config = e->config;
+    read_config(L, 2, &config);
+    particle_emitter_configure(e, &config);
+
+    lua_getfield(L, 2, "texture");
+    if (!lua_isnil(L, -1)) particle_emitter_set_texture(e, opt_texture(L, lua_gettop(L)));
+    lua_pop(L, 1);
+    return 0;
+}
+
+// emitter:set_texture(texture?)  -- nil draws soft round dots
+static int l_emitter_set_texture(lua_State* L) {
+    ParticleEmitter* e = check_emitter(L, 1);
+    particle_emitter_set_texture(e, opt_texture(L, 2));
+    return 0;
+}
+
+// emitter:set_position(x, y)
+static int l_emitter_set_position(lua_State* L) {
+    ParticleEmitter* e = check_emitter(L, 1);
+    e->config.x = (float)luaL_checknumber(L, 2);
+    e->config.y = (float)luaL_checknumber(L, 3);
+    return 0;
+}
+
+// emitter:get_position() -> x, y
+static int l_emitter_get_position(lua_State* L) {
+    ParticleEmitter* e = check_emitter(L, 1);
+    lua_pushnumber(L, e->config.x);
+    lua_pushnumber(L, e->config.y);
+    return 2;
+}
+
+// emitter:emit(n) -> spawned
+static int l_emitter_emit(lua_State* L) {
+    ParticleEmitter* e = check_emitter(L, 1);
+    lua_pushinteger(L, particle_emitter_emit(e, (int)luaL_checkinteger(L, 2)));
+    return 1;
+}
+
+// emitter:start() / emitter:stop()  -- continuous emission by rate
+static int l_emitter_start(lua_State* L) {
+    check_emitter(L, 1)->emitting = 1;
+    return 0;
+}
+
+static int l_emitter_stop(lua_State* L) {
+    check_emitter(L, 1)->emitting = 0;
+    return 0;
+}
+
+// emitter:is_emitting() -> boolean
+static int l_emitter_is_emitting(lua_State* L) {
+    lua_pushboolean(L, check_emitter(L, 1)->emitting);
+    return 1;
+}
+
+// emitter:update(dt?)  -- dt defaults to pb.time.delta()
+static int l_emitter_update(lua_State* L) {
+    ParticleEmitter* e = check_emitter(L, 1);
+    double dt = lua_isnoneornil(L, 2) ? time_get_delta() : luaL_checknumber(L, 2);
+    particle_emitter_update(e, (float)dt);
+    return 0;
+}
+
+// emitter:draw()
+static int l_emitter_draw(lua_State* L) {
+    particle_emitter_draw(check_emitter(L, 1));
+    return 0;
+}
+
+// emitter:count() -> live particles
+static int l_emitter_count(lua_State* L) {
+    lua_pushinteger(L, check_emitter(L, 1)->count);
+    return 1;
+}
+
+// emitter:get_capacity() -> pool size
+static int l_emitter_get_capacity(lua_State* L) {
+    lua_pushinteger(L, check_emitter(L, 1)->capacity);
+    return 1;
+}
+
+// emitter:clear()
+static int l_emitter_clear(lua_State* L) {
+    particle_emitter_clear(check_emitter(L, 1));
+    return 0;
+}
+
+// emitter:destroy()
+static int l_emitter_destroy(lua_State* L) {
+    ParticleEmitter** e = (ParticleEmitter**)luaL_checkudata(L, 1, EMITTER_METATABLE);
+    if (*e) {
+        particle_emitter_destroy(*e);
+        *e = NULL;
+    }
+    return 0;
+}
+
+// --- GpuParticles methods ---
+
+// system:set(options)
+static int l_gpu_set(lua_State* L) {
+    GpuParticleSystem* s = check_gpu(L, 1);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    ParticleEmitterConfig config = s->config;
+    read_config(L, 2, &config);
+    gpu_particles_configure(s, &config);
+
+    lua_getfield(L, 2, "texture");
+    if (!lua_isnil(L, -1)) gpu_particles_set_texture(s, opt_texture(L, lua_gettop(L)));
+    lua_pop(L, 1);
+    return 0;
+}
+
+// system:set_texture(texture?)
+static int l_gpu_set_texture(lua_State* L) {
+    GpuParticleSystem* s = check_gpu(L, 1);
+    gpu_particles_set_texture(s, opt_texture(L, 2));
+    return 0;
+}
+
+// system:set_position(x, y)
+static int l_gpu_set_position(lua_State* L) {
+    GpuParticleSystem* s = check_gpu(L, 1);
+    s->config.x = (float)luaL_checknumber(L, 2);
+    s->config.y = (float)luaL_checknumber(L, 3);
+    return 0;
+}
+
+// system:get_position() -> x, y
+static int l_gpu_get_position(lua_State* L) {
+    GpuParticleSystem* s = check_gpu(L, 1);
+    lua_pushnumber(L, s->config.x);
+    lua_pushnumber(L, s->config.y);
+    return 2;
+}
+
+// system:start() / system:stop()  -- stopped systems let particles die out
+static int l_gpu_start(lua_State* L) {
+    check_gpu(L, 1)->emitting = 1;
+    return 0;
+}
+
+static int l_gpu_stop(lua_State* L) {
+    check_gpu(L, 1)->emitting = 0;
+    return 0;
+}
+
+// system:is_emitting() -> boolean
+static int l_gpu_is_emitting(lua_State* L) {
+    lua_pushboolean(L, check_gpu(L, 1)->emitting);
+    return 1;
+}
+
+// system:update(dt?)  -- dt defaults to pb.time.delta()
+static int l_gpu_update(lua_State* L) {
+    GpuParticleSystem* s = check_gpu(L, 1);
+    double dt = lua_isnoneornil(L, 2) ? time_get_delta() : luaL_checknumber(L, 2);
+    gpu_particles_update(s, (float)dt);
+    return 0;
+}
+
+// system:prewarm(seconds)
+static int l_gpu_prewarm(lua_State* L) {
+    GpuParticleSystem* s = check_gpu(L, 1);
+    gpu_particles_prewarm(s, (float)luaL_checknumber(L, 2));
+    return 0;
+}
+
+// system:reset()
+static int l_gpu_reset(lua_State* L) {
+    gpu_particles_reset(check_gpu(L, 1));
+    return 0;
+}
+
+// system:draw()
+static int l_gpu_draw(lua_State* L) {
+    gpu_particles_draw(check_gpu(L, 1));
+    return 0;
+}
+
+// system:get_count() -> pool size
+static int l_gpu_get_count(lua_State* L) {
+    lua_pushinteger(L, check_gpu(L, 1)->count);
+    return 1;
+}
+
+// system:destroy()
+static int l_gpu_destroy(lua_State* L) {
+    GpuParticleSystem** s = (GpuParticleSystem**)luaL_checkudata(L, 1, GPU_PARTICLES_METATABLE);
+    if (*s) {
+        gpu_particles_destroy(*s);
+        *s = NULL;
+    }
+    return 0;
+}
+
+static const luaL_Reg emitter_methods[] = {
+    {"set", l_emitter_set},
+    {"set_texture", l_emitter_set_texture},
+    {"set_position", l_emitter_set_position},
+    {"get_position", l_emitter_get_position},
+    {"emit", l_emitter_emit},
+    {"start", l_emitter_start},
+    {"stop", l_emitter_stop},
+    {"is_emitting", l_emitter_is_emitting},
+    {"update", l_emitter_update},
+    {"draw", l_emitter_draw},
+    {"count", l_emitter_count},
+    {"get_capacity", l_emitter_get_capacity},
+    {"clear", l_emitter_clear},
+    {"destroy", l_emitter_destroy},
+    {NULL, NULL}
+};
+
+static const luaL_Reg gpu_methods[] = {
+    {"set", l_gpu_set},
+    {"set_texture", l_gpu_set_texture},
+    {"set_position", l_gpu_set_position},
+    {"get_position", l_gpu_get_position},
+    {"start", l_gpu_start},
+    {"stop", l_gpu_stop},
+    {"is_emitting", l_gpu_is_emitting},
+    {"update", l_gpu_update},
+    {"prewarm", l_gpu_prewarm},
+    {"reset", l_gpu_reset},
+    {"draw", l_gpu_draw},
+    {"get_count", l_gpu_get_count},
+    {"destroy", l_gpu_destroy},
+    {NULL, NULL}
+};
+
+static const luaL_Reg particles_functions[] = {
+    {"new", l_particles_new},
+    {"new_gpu", l_particles_new_gpu},
+    {NULL, NULL}
+};
+
+static void register_metatable(lua_State* L, const char* name, const luaL_Reg* methods, lua_CFunction gc) {
+    luaL_newmetatable(L, name);
+
+    lua_pushstring(L, "__index");
+    lua_pushvalue(L, -2);
+    lua_settable(L, -3);
+
+    lua_pushstring(L, "__gc");
+    lua_pushcfunction(L, gc);
+    lua_settable(L, -3);
+
+    luaL_setfuncs(L, methods, 0);
+    lua_pop(L, 1);
+}
+
+void lua_register_particles_api(lua_State* L) {
+    register_metatable(L, EMITTER_METATABLE, emitter_methods, l_emitter_destroy);
+    register_metatable(L, GPU_PARTICLES_METATABLE, gpu_methods, l_gpu_destroy);
+
+    // Create PudimBasicsGl.particles table
+    lua_getglobal(L, "PudimBasicsGl");
+    lua_newtable(L);
+    luaL_setfuncs(L, particles_functions, 0);
+    lua_setfield(L, -2, "particles");
+    lua_pop(L, 1);
+}
@@ -3,6 +3,7 @@
 #include <lualib.h>
 #include <glad/glad.h>
 #include "../render/renderer.h"
+#include "../render/pixel_ops.h"
 
 // Helper to get color from Lua (r,g,b,a or table)
 static Color get_color_from_lua(lua_State* L, int start_idx) {
@@ -247,13 +248,27 @@ static int l_renderer_enable_depth_test(lua_State* L) {
 static int l_renderer_enable_blend(lua_State* L) {
     int enable = lua_toboolean(L, 1);
     if (enable) {
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        renderer_apply_blend();
     } else {
         glDisable(GL_BLEND);
     }
     return 0;
 }
+
+// pudim.renderer.set_premultiplied_alpha(enable)
+static int l_renderer_set_premultiplied_alpha(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1)) arg = 2;
+    renderer_set_premultiplied_alpha(lua_toboolean(L, arg));
+    return 0;
+}
+
+// pudim.renderer.get_premultiplied_alpha() -> boolean
+static int l_renderer_get_premultiplied_alpha(lua_State* L) {
+    lua_pushboolean(L, renderer_get_premultiplied_alpha());
+    return 1;
+}
+
 // pudim.renderer.begin_ui(width, height)
 // Start UI rendering mode (screen-space, ignores camera)
 static int l_renderer_begin_ui(lua_State* L) {
@@ -320,6 +335,9 @@ static int l_renderer_get_info(lua_State* L) {
     lua_pushstring(L, s ? s : "unknown");
     lua_setfield(L, -2, "glsl_version");
     
+    lua_pushstring(L, pixel_ops_level_name(pixel_ops_get_level()));
+    lua_setfield(L, -2, "simd");
+    
     return 1;
 }
 
@@ -361,6 +379,8 @@ static const luaL_Reg renderer_funcs[] = {
     {"set_clear_color", l_renderer_set_clear_color},
     {"enable_depth_test", l_renderer_enable_depth_test},
     {"enable_blend", l_renderer_enable_blend},
+    {"set_premultiplied_alpha", l_renderer_set_premultiplied_alpha},
+    {"get_premultiplied_alpha", l_renderer_get_premultiplied_alpha},
     {"set_viewport", l_renderer_set_viewport},
     {"get_info", l_renderer_get_info},
     {"begin_ui", l_renderer_begin_ui},
@@ -0,0 +1,522 @@
+#include <lua.h>
+#include <lauxlib.h>
+#include <lualib.h>
+#include <stdlib.h>
+#include "../render/sprite.h"
+
+#define SPRITE_SHEET_METATABLE "PudimBasicsGl.SpriteSheet"
+#define SPRITE_SET_METATABLE "PudimBasicsGl.SpriteSet"
+#define TEXTURE_METATABLE "PudimBasicsGl.Texture"
+
+// Frame delta from pb.time (lua_time.c)
+extern double time_get_delta(void);
+
+typedef struct {
+    SpriteSet* set;
+    int updated;    // update() was called since the last draw_all()
+} LuaSpriteSet;
+
+static const char* const loop_names[] = {"loop", "once", "pingpong", NULL};
+
+static SpriteSheet** check_sheet(lua_State* L, int index) {
+    return (SpriteSheet**)luaL_checkudata(L, index, SPRITE_SHEET_METATABLE);
+}
+
+static SpriteSheet* check_live_sheet(lua_State* L, int index) {
+    SpriteSheet** sheet = check_sheet(L, index);
+    if (!*sheet) luaL_error(L, "sprite sheet has been destroyed");
+    return *sheet;
+}
+
+static LuaSpriteSet* check_set(lua_State* L, int index) {
+    LuaSpriteSet* ud = (LuaSpriteSet*)luaL_checkudata(L, index, SPRITE_SET_METATABLE);
+    if (!ud->set) luaL_error(L, "sprite set has been destroyed");
+    return ud;
+}
+
+// Sprite ids are 1-based slot numbers
+static Sprite* check_sprite(lua_State* L, LuaSpriteSet* ud, int index) {
+    int id = (int)luaL_checkinteger(L, index);
+    Sprite* sprite = sprite_set_get(ud->set, id - 1);
+    if (!sprite) luaL_error(L, "invalid sprite id %d", id);
+    return sprite;
+}
+
+static void push_sheet(lua_State* L, SpriteSheet* sheet) {
+    SpriteSheet** udata = (SpriteSheet**)lua_newuserdata(L, sizeof(SpriteSheet*));
+    *udata = sheet;
+    luaL_getmetatable(L, SPRITE_SHEET_METATABLE);
+    lua_setmetatable(L, -2);
+}
+
+// Resolve a frame given as a 1-based index or an atlas frame name (-1 if invalid)
+static int frame_arg(lua_State* L, int index, const SpriteSheet* sheet) {
+    if (lua_type(L, index) == LUA_TSTRING) {
+        return sprite_sheet_find_frame(sheet, lua_tostring(L, index));
+    }
+    int frame = (int)luaL_checkinteger(L, index) - 1;
+    return frame >= 0 && frame < sheet->frame_count ? frame : -1;
+}
+
+// Apply the fields of an options table to a sprite
+static void apply_sprite_options(lua_State* L, int idx, LuaSpriteSet* ud, Sprite* s) {
+    const SpriteSheet* sheet = ud->set->sheet;
+
+    lua_getfield(L, idx, "x");
+    if (!lua_isnil(L, -1)) s->x = (float)luaL_checknumber(L, -1);
+    lua_getfield(L, idx, "y");
+    if (!lua_isnil(L, -1)) s->y = (float)luaL_checknumber(L, -1);
+    lua_getfield(L, idx, "width");
+    if (!lua_isnil(L, -1)) s->width = (float)luaL_checknumber(L, -1);
+    lua_getfield(L, idx, "height");
+    if (!lua_isnil(L, -1)) s->height = (float)luaL_checknumber(L, -1);
+    lua_pop(L, 4);
+
+    lua_getfield(L, idx, "scale");
+    if (!lua_isnil(L, -1)) s->scale_x = s->scale_y = (float)luaL_checknumber(L, -1);
+    lua_getfield(L, idx, "scale_x");
+    if (!lua_isnil(L, -1)) s->scale_x = (float)luaL_checknumber(L, -1);
+    lua_getfield(L, idx, "scale_y");
+    if (!lua_isnil(L, -1)) s->scale_y = (float)luaL_checknumber(L, -1);
+    lua_getfield(L, idx, "angle");
+    if (!lua_isnil(L, -1)) s->angle = (float)luaL_checknumber(L, -1);
+    lua_pop(L, 4);
+
+    lua_getfield(L, idx, "origin_x");
+    if (!lua_isnil(L, -1)) s->origin_x = (float)luaL_checknumber(L, -1);
+    lua_getfield(L, idx, "origin_y");
+    if (!lua_isnil(L, -1)) s->origin_y = (float)luaL_checknumber(L, -1);
+    lua_getfield(L, idx, "speed");
+    if (!lua_isnil(L, -1)) s->speed = (float)luaL_checknumber(L, -1);
+    lua_pop(L, 3);
+
+    lua_getfield(L, idx, "r");
+    if (!lua_isnil(L, -1)) s->r = (float)luaL_checknumber(L, -1);
+    lua_getfield(L, idx, "g");
+    if (!lua_isnil(L, -1)) s->g = (float)luaL_checknumber(L, -1);
+    lua_getfield(L, idx, "b");
+    if (!lua_isnil(L, -1)) s->b = (float)luaL_checknumber(L, -1);
+    lua_getfield(L, idx, "a");
+    if (!lua_isnil(L, -1)) s->a = (float)luaL_checknumber(L, -1);
+    lua_pop(L, 4);
+
+    lua_getfield(L, idx, "flip_x");
+    if (!lua_isnil(L, -1)) s->flip_x = (unsigned char)lua_toboolean(L, -1);
+    lua_getfield(L, idx, "flip_y");
+    if (!lua_isnil(L, -1)) s->flip_y = (unsigned char)lua_toboolean(L, -1);
+    lua_getfield(L, idx, "visible");
+    if (!lua_isnil(L, -1)) s->visible = (unsigned char)lua_toboolean(L, -1);
+    lua_pop(L, 3);
+
+    lua_getfield(L, idx, "frame");
+    if (!lua_isnil(L, -1)) {
+        int frame = frame_arg(L, -1, sheet);
+        if (frame < 0) luaL_error(L, "invalid sprite frame");
+        sprite_set_frame(s, frame);
+    }
+    lua_pop(L, 1);
+
+    lua_getfield(L, idx, "clip");
+    if (!lua_isnil(L, -1)) {
+        const char* name = luaL_checkstring(L, -1);
+        int clip = sprite_sheet_find_clip(sheet, name);
+        if (clip < 0) luaL_error(L, "unknown clip '%s'", name);
+        sprite_play(ud->set, s, clip, 0);
+    }
+    lua_pop(L, 1);
+}
+
+// --- Module functions ---
+
+// PudimBasicsGl.sprite.grid(texture, frame_w, frame_h, options?) -> SpriteSheet
+// options: { count = n, margin = px, spacing = px }
+static int l_sprite_grid(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1)) arg = 2; // allow pb.sprite:grid(...)
+    Texture** tex = (Texture**)luaL_checkudata(L, arg, TEXTURE_METATABLE);
+    int frame_w = (int)luaL_checkinteger(L, arg + 1);
+    int frame_h = (int)luaL_checkinteger(L, arg + 2);
+    int count = 0, margin = 0, spacing = 0;
+
+    if (lua_istable(L, arg + 3)) {
+        lua_getfield(L, arg + 3, "count");
+        count = (int)luaL_optinteger(L, -1, 0);
+        lua_getfield(L, arg + 3, "margin");
+        margin = (int)luaL_optinteger(L, -1, 0);
+        lua_getfield(L, arg + 3, "spacing");
+        spacing = (int)luaL_optinteger(L, -1, 0);
+        lua_pop(L, 3);
+    }
+
+    SpriteSheet* sheet = *tex ? sprite_sheet_create_grid(*tex, frame_w, frame_h, margin, spacing, count) : NULL;
+    if (!sheet) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Frame size does not fit the texture");
+        return 2;
+    }
+    push_sheet(L, sheet);
+    return 1;
+}
+
+// PudimBasicsGl.sprite.load_atlas(json_path, texture?) -> SpriteSheet | nil, error
+// Without a texture, "meta.image" is loaded relative to the JSON file
+static int l_sprite_load_atlas(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1)) arg = 2; // allow pb.sprite:load_atlas(path)
+    const char* path = luaL_checkstring(L, arg);
+    Texture* texture = NULL;
+    if (!lua_isnoneornil(L, arg + 1)) {
+        texture = *(Texture**)luaL_checkudata(L, arg + 1, TEXTURE_METATABLE);
+    }
+
+    // Lazy init texture renderer (needs OpenGL context)
+    texture_renderer_init();
+
+    char err[256];
+    SpriteSheet* sheet = sprite_sheet_load_json(path, texture, err, sizeof(err));
+    if (!sheet) {
+        lua_pushnil(L);
+        lua_pushstring(L, err);
+        return 2;
+    }
+    push_sheet(L, sheet);
+    return 1;
+}
+
+// PudimBasicsGl.sprite.new_set(sheet, capacity?) -> SpriteSet
+static int l_sprite_new_set(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1)) arg = 2; // allow pb.sprite:new_set(sheet)
+    SpriteSheet* sheet = check_live_sheet(L, arg);
+    int capacity = (int)luaL_optinteger(L, arg + 1, 64);
+
+    LuaSpriteSet* ud = (LuaSpriteSet*)lua_newuserdata(L, sizeof(LuaSpriteSet));
+    ud->set = sprite_set_create(sheet, capacity);
+    ud->updated = 0;
+    luaL_getmetatable(L, SPRITE_SET_METATABLE);
+    lua_setmetatable(L, -2);
+    if (!ud->set) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Failed to allocate sprite set");
+        return 2;
+    }
+    return 1;
+}
+
+// --- SpriteSheet methods ---
+
+// sheet:add_clip(name, frames, options?) -> true | false, error
+// frames: list of 1-based frame indices or atlas frame names
+// options: { fps = 10, mode = "loop"|"once"|"pingpong" }
+static int l_sheet_add_clip(lua_State* L) {
+    SpriteSheet* sheet = check_live_sheet(L, 1);
+    const char* name = luaL_checkstring(L, 2);
+    luaL_checktype(L, 3, LUA_TTABLE);
+
+    float fps = 10.0f;
+    SpriteLoopMode mode = SPRITE_LOOP_REPEAT;
+    if (lua_istable(L, 4)) {
+        lua_getfield(L, 4, "fps");
+        fps = (float)luaL_optnumber(L, -1, 10.0);
+        lua_getfield(L, 4, "mode");
+        mode = (SpriteLoopMode)luaL_checkoption(L, -1, "loop", loop_names);
+        lua_pop(L, 2);
+    }
+
+    int count = (int)lua_rawlen(L, 3);
+    if (count == 0) {
+        lua_pushboolean(L, 0);
+        lua_pushstring(L, "Clip has no frames");
+        return 2;
+    }
+    int* frames = (int*)malloc((size_t)count * sizeof(int));
+    if (!frames) {
+        lua_pushboolean(L, 0);
+        lua_pushstring(L, "Failed to allocate clip");
+        return 2;
+    }
+    for (int i = 0; i < count; i++) {
+        lua_rawgeti(L, 3, i + 1);
+        frames[i] = frame_arg(L, -1, sheet);
+        lua_pop(L, 1);
+    }
+
+    int ok = sprite_sheet_add_clip(sheet, name, frames, count, fps, mode) >= 0;
+    free(frames);
+    if (!ok) {
+        lua_pushboolean(L, 0);
+        lua_pushstring(L, "Clip references an unknown frame");
+        return 2;
+    }
+    lua_pushboolean(L, 1);
+    return 1;
+}
+
+// sheet:has_clip(name) -> boolean
+static int l_sheet_has_clip(lua_State* L) {
+    SpriteSheet* sheet = check_live_sheet(L, 1);
+    lua_pushboolean(L, sprite_sheet_find_clip(sheet, luaL_checkstring(L, 2)) >= 0);
+    return 1;
+}
+
+// sheet:get_clip_names() -> { name, ... }
+static int l_sheet_get_clip_names(lua_State* L) {
+    SpriteSheet* sheet = check_live_sheet(L, 1);
+    lua_createtable(L, sheet->clip_count, 0);
+    for (int i = 0; i < sheet->clip_count; i++) {
+        lua_pushstring(L, sheet->clips[i].name);
+        lua_rawseti(L, -2, i + 1);
+    }
+    return 1;
+}
+
+// sheet:get_frame_count() -> number
+static int l_sheet_get_frame_count(lua_State* L) {
+    lua_pushinteger(L, check_live_sheet(L, 1)->frame_count);
+    return 1;
+}
+
+// sheet:find_frame(name) -> index | nil
+static int l_sheet_find_frame(lua_State* L) {
+    SpriteSheet* sheet = check_live_sheet(L, 1);
+    int frame = sprite_sheet_find_frame(sheet, luaL_checkstring(L, 2));
+    if (frame < 0) {
+        lua_pushnil(L);
+    } else {
+        lua_pushinteger(L, frame + 1);
+    }
+    return 1;
+}
+
+// sheet:get_frame(index) -> x, y, w, h (packed rect in pixels)
+static int l_sheet_get_frame(lua_State* L) {
+    SpriteSheet* sheet = check_live_sheet(L, 1);
+    int frame = frame_arg(L, 2, sheet);
+    if (frame < 0) {
+        lua_pushnil(L);
+        return 1;
+    }
+    const SpriteFrame* f = &sheet->frames[frame];
+    lua_pushinteger(L, f->x);
+    lua_pushinteger(L, f->y);
+    lua_pushinteger(L, f->w);
+    lua_pushinteger(L, f->h);
+    return 4;
+}
+
+// sheet:draw_frame(index, x, y, scale_x?, scale_y?)
+static int l_sheet_draw_frame(lua_State* L) {
+    SpriteSheet* sheet = check_live_sheet(L, 1);
+    int frame = frame_arg(L, 2, sheet);
+    float x = (float)luaL_checknumber(L, 3);
+    float y = (float)luaL_checknumber(L, 4);
+    float sx = (float)luaL_optnumber(L, 5, 1.0);
+    float sy = (float)luaL_optnumber(L, 6, sx);
+    sprite_sheet_draw_frame(sheet, frame, x, y, sx, sy);
+    return 0;
+}
+
+// sheet:destroy() - sets keep the sheet alive until they are destroyed too
+static int l_sheet_destroy(lua_State* L) {
+    SpriteSheet** sheet = check_sheet(L, 1);
+    if (*sheet) {
+        sprite_sheet_release(*sheet);
+        *sheet = NULL;
+    }
+    return 0;
+}
+
+// --- SpriteSet methods ---
+
+// sprites:add(x, y, options?) -> id
+// options: clip, frame, scale, scale_x, scale_y, width, height, angle,
+//          origin_x, origin_y, r, g, b, a, speed, flip_x, flip_y, visible
+static int l_set_add(lua_State* L) {
+    LuaSpriteSet* ud = check_set(L, 1);
+    float x = (float)luaL_checknumber(L, 2);
+    float y = (float)luaL_checknumber(L, 3);
+
+    int id = sprite_set_add(ud->set, x, y);
+    if (id < 0) return luaL_error(L, "failed to allocate sprite");
+    if (lua_istable(L, 4)) {
+        apply_sprite_options(L, 4, ud, sprite_set_get(ud->set, id));
+    }
+    lua_pushinteger(L, id + 1);
+    return 1;
+}
+
+// sprites:set(id, options) - same fields as add() plus x, y
+static int l_set_set(lua_State* L) {
+    LuaSpriteSet* ud = check_set(L, 1);
+    Sprite* sprite = check_sprite(L, ud, 2);
+    luaL_checktype(L, 3, LUA_TTABLE);
+    apply_sprite_options(L, 3, ud, sprite);
+    return 0;
+}
+
+// sprites:remove(id)
+static int l_set_remove(lua_State* L) {
+    LuaSpriteSet* ud = check_set(L, 1);
+    sprite_set_remove(ud->set, (int)luaL_checkinteger(L, 2) - 1);
+    return 0;
+}
+
+// sprites:clear()
+static int l_set_clear(lua_State* L) {
+    sprite_set_clear(check_set(L, 1)->set);
+    return 0;
+}
+
+// sprites:count() -> number of live sprites
+static int l_set_count(lua_State* L) {
+    lua_pushinteger(L, check_set(L, 1)->set->live);
+    return 1;
+}
+
+// sprites:set_position(id, x, y)
+static int l_set_set_position(lua_State* L) {
+    LuaSpriteSet* ud = check_set(L, 1);
+    Sprite* sprite = check_sprite(L, ud, 2);
+    sprite->x = (float)luaL_checknumber(L, 3);
+    sprite->y = (float)luaL_checknumber(L, 4);
+    return 0;
+}
+
+// sprites:get_position(id) -> x, y
+static int l_set_get_position(lua_State* L) {
+    LuaSpriteSet* ud = check_set(L, 1);
+    Sprite* sprite = check_sprite(L, ud, 2);
+    lua_pushnumber(L, sprite->x);
+    lua_pushnumber(L, sprite->y);
+    return 2;
+}
+
+// sprites:play(id, clip, restart?) - restart defaults to false
+static int l_set_play(lua_State* L) {
+    LuaSpriteSet* ud = check_set(L, 1);
+    Sprite* sprite = check_sprite(L, ud, 2);
+    const char* name = luaL_checkstring(L, 3);
+    int clip = sprite_sheet_find_clip(ud->set->sheet, name);
+    if (clip < 0) return luaL_error(L, "unknown clip '%s'", name);
+    sprite_play(ud->set, sprite, clip, lua_toboolean(L, 4));
+    return 0;
+}
+
+// sprites:stop(id) - freeze on the current frame
+static int l_set_stop(lua_State* L) {
+    LuaSpriteSet* ud = check_set(L, 1);
+    check_sprite(L, ud, 2)->playing = 0;
+    return 0;
+}
+
+// sprites:is_playing(id) -> boolean (false once a "once" clip has finished)
+static int l_set_is_playing(lua_State* L) {
+    LuaSpriteSet* ud = check_set(L, 1);
+    lua_pushboolean(L, check_sprite(L, ud, 2)->playing);
+    return 1;
+}
+
+// sprites:get_frame(id) -> 1-based sheet frame currently shown
+static int l_set_get_frame(lua_State* L) {
+    LuaSpriteSet* ud = check_set(L, 1);
+    Sprite* sprite = check_sprite(L, ud, 2);
+    lua_pushinteger(L, sprite_current_frame(ud->set, sprite) + 1);
+    return 1;
+}
+
+// sprites:update(dt?) - advance every clip (dt defaults to pb.time.delta())
+static int l_set_update(lua_State* L) {
+    LuaSpriteSet* ud = check_set(L, 1);
+    float dt = (float)luaL_optnumber(L, 2, time_get_delta());
+    sprite_set_update(ud->set, dt);
+    ud->updated = 1;
+    return 0;
+}
+
+// sprites:draw_all(dt?) - advance (unless update() already ran this frame) and draw
+// every visible sprite in one batch. Pass 0 to draw without advancing.
+static int l_set_draw_all(lua_State* L) {
+    LuaSpriteSet* ud = check_set(L, 1);
+    if (!lua_isnoneornil(L, 2)) {
+        sprite_set_update(ud->set, (float)luaL_checknumber(L, 2));
+    } else if (!ud->updated) {
+        sprite_set_update(ud->set, (float)time_get_delta());
+    }
+    ud->updated = 0;
+    sprite_set_draw(ud->set);
+    return 0;
+}
+
+// sprites:destroy()
+static int l_set_destroy(lua_State* L) {
+    LuaSpriteSet* ud = (LuaSpriteSet*)luaL_checkudata(L, 1, SPRITE_SET_METATABLE);
+    if (ud->set) {
+        sprite_set_destroy(ud->set);
+        ud->set = NULL;
+    }
+    return 0;
+}
+
+static const luaL_Reg sheet_methods[] = {
+    {"add_clip", l_sheet_add_clip},
+    {"has_clip", l_sheet_has_clip},
+    {"get_clip_names", l_sheet_get_clip_names},
+    {"get_frame_count", l_sheet_get_frame_count},
+    {"find_frame", l_sheet_find_frame},
+    {"get_frame", l_sheet_get_frame},
+    {"draw_frame", l_sheet_draw_frame},
+    {"destroy", l_sheet_destroy},
+    {NULL, NULL}
+};
+
+static const luaL_Reg set_methods[] = {
+    {"add", l_set_add},
+    {"set", l_set_set},
+    {"remove", l_set_remove},
+    {"clear", l_set_clear},
+    {"count", l_set_count},
+    {"set_position", l_set_set_position},
+    {"get_position", l_set_get_position},
+    {"play", l_set_play},
+    {"stop", l_set_stop},
+    {"is_playing", l_set_is_playing},
+    {"get_frame", l_set_get_frame},
+    {"update", l_set_update},
+    {"draw_all", l_set_draw_all},
+    {"destroy", l_set_destroy},
+    {NULL, NULL}
+};
+
+static const luaL_Reg sprite_functions[] = {
+    {"grid", l_sprite_grid},
+    {"load_atlas", l_sprite_load_atlas},
+    {"new_set", l_sprite_new_set},
+    {NULL, NULL}
+};
+
+static void register_metatable(lua_State* L, const char* name, const luaL_Reg* methods, lua_CFunction gc) {
+    luaL_newmetatable(L, name);
+
+    lua_pushstring(L, "__index");
+    lua_pushvalue(L, -2);
+    lua_settable(L, -3);
+
+    lua_pushstring(L, "__gc");
+    lua_pushcfunction(L, gc);
+    lua_settable(L, -3);
+
+    luaL_setfuncs(L, methods, 0);
+    lua_pop(L, 1);
+}
+
+void lua_register_sprite_api(lua_State* L) {
+    register_metatable(L, SPRITE_SHEET_METATABLE, sheet_methods, l_sheet_destroy);
+    register_metatable(L, SPRITE_SET_METATABLE, set_methods, l_set_destroy);
+
+    // Create PudimBasicsGl.sprite table
+    lua_getglobal(L, "PudimBasicsGl");
+    lua_newtable(L);
+    luaL_setfuncs(L, sprite_functions, 0);
+    lua_setfield(L, -2, "sprite");
+    lua_pop(L, 1);
+}
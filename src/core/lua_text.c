@@ -1,16 +1,30 @@
 #include <lua.h>
 #include <lauxlib.h>
 #include <lualib.h>
+#include <string.h>
 #include "../render/text.h"
+#include "../render/font_cache.h"
 #include "../render/renderer.h"
+#include "../util/utf8.h"
 
 #define FONT_METATABLE "PudimBasicsGl.Font"
+#define TEXT_METATABLE "PudimBasicsGl.Text"
+#define FONT_LOAD_METATABLE "PudimBasicsGl.FontLoad"
+#define TEXT_GRID_METATABLE "PudimBasicsGl.TextGrid"
 
 // Helper to validate Font userdata
 static Font** check_font(lua_State* L, int idx) {
     return (Font**)luaL_checkudata(L, idx, FONT_METATABLE);
 }
 
+static void push_font(lua_State* L, Font* font) {
+    Font** udata = (Font**)lua_newuserdata(L, sizeof(Font*));
+    *udata = font;
+
+    luaL_getmetatable(L, FONT_METATABLE);
+    lua_setmetatable(L, -2);
+}
+
 // Helper to get color from Lua (r,g,b,a or table) - same pattern as lua_renderer.c
 static Color get_text_color_from_lua(lua_State* L, int start_idx) {
     Color c = {1.0f, 1.0f, 1.0f, 1.0f};
@@ -31,7 +45,46 @@ static Color get_text_color_from_lua(lua_State* L, int start_idx) {
     return c;
 }
 
-// pudim.text.load(filepath, size) -> Font
+static const char* const align_names[] = {"left", "center", "right", "justify", NULL};
+static const char* const wrap_names[] = {"word", "char", "none", NULL};
+static const char* const filter_names[] = {"nearest", "linear", NULL};
+
+// Index of a string field in `names` (default when absent)
+static int get_name_field(lua_State* L, int idx, const char* field, const char* const names[], int def) {
+    lua_getfield(L, idx, field);
+    int result = def;
+    if (!lua_isnil(L, -1)) {
+        const char* name = luaL_checkstring(L, -1);
+        for (result = 0; names[result] && strcmp(names[result], name) != 0; result++) {}
+        if (!names[result]) {
+            return luaL_error(L, "invalid %s '%s'", field, name);
+        }
+    }
+    lua_pop(L, 1);
+    return result;
+}
+
+// Layout options table: { width, size, wrap = "word"|"char"|"none",
+// align = "left"|"center"|"right"|"justify", line_spacing }
+static void get_layout_options(lua_State* L, int idx, TextLayoutOptions* options) {
+    memset(options, 0, sizeof(*options));
+    if (!lua_istable(L, idx)) return;
+
+    lua_getfield(L, idx, "width");
+    options->max_width = (float)luaL_optnumber(L, -1, 0.0);
+    lua_pop(L, 1);
+    lua_getfield(L, idx, "size");
+    options->size = (float)luaL_optnumber(L, -1, 0.0);
+    lua_pop(L, 1);
+    lua_getfield(L, idx, "line_spacing");
+    options->line_spacing = (float)luaL_optnumber(L, -1, 1.0);
+    lua_pop(L, 1);
+    options->wrap = (TextWrap)get_name_field(L, idx, "wrap", wrap_names, TEXT_WRAP_WORD);
+    options->align = (TextAlign)get_name_field(L, idx, "align", align_names, TEXT_ALIGN_LEFT);
+}
+
+// pudim.text.load(filepath, size, options?) -> Font
+// options: { sdf = true } renders from signed distance fields
 static int l_text_load(lua_State* L) {
     int arg = 1;
     if (lua_istable(L, 1)) arg = 2;  // skip self if called with ':'
@@ -39,23 +92,121 @@ static int l_text_load(lua_State* L) {
     const char* filepath = luaL_checkstring(L, arg);
     float size = (float)luaL_optnumber(L, arg + 1, 24.0);
 
-    Font* font = font_load(filepath, size);
+    int sdf = 0;
+    if (lua_istable(L, arg + 2)) {
+        lua_getfield(L, arg + 2, "sdf");
+        sdf = lua_toboolean(L, -1);
+        lua_pop(L, 1);
+    }
+
+    Font* font = sdf ? font_load_sdf(filepath, size) : font_load(filepath, size);
     if (!font) {
         lua_pushnil(L);
         lua_pushstring(L, "Failed to load font");
         return 2;
     }
 
-    Font** udata = (Font**)lua_newuserdata(L, sizeof(Font*));
-    *udata = font;
+    push_font(L, font);
+    return 1;
+}
 
-    luaL_getmetatable(L, FONT_METATABLE);
+// pudim.text.load_bmfont(filepath, size?, options?) - AngelCode BMFont (.fnt)
+// options: { filter = "nearest"|"linear" } (default nearest, for pixel fonts)
+static int l_text_load_bmfont(lua_State* L) {
+    const char* filepath = luaL_checkstring(L, 1);
+    float size = (float)luaL_optnumber(L, 2, 0.0);
+
+    TextureFilter filter = TEXTURE_FILTER_NEAREST;
+    if (lua_istable(L, 3)) {
+        lua_getfield(L, 3, "filter");
+        if (!lua_isnil(L, -1)) filter = (TextureFilter)luaL_checkoption(L, -1, NULL, filter_names);
+        lua_pop(L, 1);
+    }
+
+    char err[256];
+    Font* font = font_load_bmfont(filepath, size, filter, err, sizeof(err));
+    if (!font) {
+        lua_pushnil(L);
+        lua_pushstring(L, err);
+        return 2;
+    }
+
+    push_font(L, font);
+    return 1;
+}
+
+// pudim.text.load_async(filepath, size, options?) - parse and rasterize on a
+// worker thread; returns a FontLoad handle (or nil, error)
+static int l_text_load_async(lua_State* L) {
+    const char* filepath = luaL_checkstring(L, 1);
+    float size = (float)luaL_optnumber(L, 2, 24.0);
+
+    int sdf = 0;
+    if (lua_istable(L, 3)) {
+        lua_getfield(L, 3, "sdf");
+        sdf = lua_toboolean(L, -1);
+        lua_pop(L, 1);
+    }
+
+    FontLoadJob* job = font_load_async(filepath, size, sdf);
+    if (!job) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Failed to load font");
+        return 2;
+    }
+
+    // User value 1 keeps the Font once it has been created
+    FontLoadJob** udata = (FontLoadJob**)lua_newuserdatauv(L, sizeof(FontLoadJob*), 1);
+    *udata = job;
+    luaL_getmetatable(L, FONT_LOAD_METATABLE);
     lua_setmetatable(L, -2);
+    return 1;
+}
+
+static FontLoadJob** check_font_load(lua_State* L, int idx) {
+    return (FontLoadJob**)luaL_checkudata(L, idx, FONT_LOAD_METATABLE);
+}
 
+// load:is_done() - true once the worker has finished (get() will not block)
+static int l_font_load_is_done(lua_State* L) {
+    FontLoadJob** job = check_font_load(L, 1);
+    lua_pushboolean(L, !*job || font_load_async_done(*job));
     return 1;
 }
 
+// load:get() - wait for the worker if needed and return the Font (or nil, error).
+// The atlas is uploaded here, so call it from the thread that owns the window.
+static int l_font_load_get(lua_State* L) {
+    FontLoadJob** job = check_font_load(L, 1);
+    if (*job) {
+        Font* font = font_load_async_finish(*job);
+        font_load_async_destroy(*job);
+        *job = NULL;
+        if (font) {
+            push_font(L, font);
+            lua_setiuservalue(L, 1, 1);
+        }
+    }
+
+    if (lua_getiuservalue(L, 1, 1) != LUA_TUSERDATA) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Failed to load font");
+        return 2;
+    }
+    return 1;
+}
+
+static int l_font_load_gc(lua_State* L) {
+    FontLoadJob** job = check_font_load(L, 1);
+    if (*job) {
+        font_load_async_destroy(*job);
+        *job = NULL;
+    }
+    return 0;
+}
+
 // font:draw(text, x, y, r, g, b, a?) or font:draw(text, x, y, color_table)
+// font:draw(text, x, y, size, color_table?) draws at another pixel size
 static int l_font_draw(lua_State* L) {
     Font** font = check_font(L, 1);
     if (!*font) {
@@ -65,13 +216,23 @@ static int l_font_draw(lua_State* L) {
     const char* text = luaL_checkstring(L, 2);
     float x = (float)luaL_checknumber(L, 3);
     float y = (float)luaL_checknumber(L, 4);
-    Color c = get_text_color_from_lua(L, 5);
 
+    // A lone number (optionally followed by a color table) is a size
+    if (lua_type(L, 5) == LUA_TNUMBER && lua_type(L, 6) != LUA_TNUMBER) {
+        float size = (float)lua_tonumber(L, 5);
+        luaL_argcheck(L, size > 0, 5, "size must be positive");
+        Color c = {1.0f, 1.0f, 1.0f, 1.0f};
+        if (!lua_isnoneornil(L, 6)) c = get_text_color_from_lua(L, 6);
+        render_text_sized(*font, text, x, y, size, c);
+        return 0;
+    }
+
+    Color c = get_text_color_from_lua(L, 5);
     render_text(*font, text, x, y, c);
     return 0;
 }
 
-// font:measure(text) -> width, height
+// font:measure(text, size?) -> width, height
 static int l_font_measure(lua_State* L) {
     Font** font = check_font(L, 1);
     if (!*font) {
@@ -79,14 +240,53 @@ static int l_font_measure(lua_State* L) {
     }
 
     const char* text = luaL_checkstring(L, 2);
+    float size = (float)luaL_optnumber(L, 3, (*font)->font_size);
+    luaL_argcheck(L, size > 0, 3, "size must be positive");
     float w, h;
-    text_measure(*font, text, &w, &h);
+    text_measure_sized(*font, text, size, &w, &h);
 
     lua_pushnumber(L, w);
     lua_pushnumber(L, h);
     return 2;
 }
 
+// font:draw_layout(text, x, y, options, r?, g?, b?, a?) or (..., options, color_table)
+static int l_font_draw_layout(lua_State* L) {
+    Font** font = check_font(L, 1);
+    if (!*font) {
+        return luaL_error(L, "Font has been destroyed");
+    }
+
+    const char* text = luaL_checkstring(L, 2);
+    float x = (float)luaL_checknumber(L, 3);
+    float y = (float)luaL_checknumber(L, 4);
+    TextLayoutOptions options;
+    get_layout_options(L, 5, &options);
+    Color c = {1.0f, 1.0f, 1.0f, 1.0f};
+    if (!lua_isnoneornil(L, 6)) c = get_text_color_from_lua(L, 6);
+
+    render_text_layout(*font, text, x, y, &options, c);
+    return 0;
+}
+
+// font:measure_layout(text, options) -> width, height, lines
+static int l_font_measure_layout(lua_State* L) {
+    Font** font = check_font(L, 1);
+    if (!*font) {
+        return luaL_error(L, "Font has been destroyed");
+    }
+
+    const char* text = luaL_checkstring(L, 2);
+    TextLayoutOptions options;
+    get_layout_options(L, 3, &options);
+
+    const TextLayout* layout = text_layout_get(*font, text, &options);
+    lua_pushnumber(L, layout ? layout->width : 0);
+    lua_pushnumber(L, layout ? layout->height : 0);
+    lua_pushinteger(L, layout ? layout->line_count : 0);
+    return 3;
+}
+
 // font:set_size(size)
 static int l_font_set_size(lua_State* L) {
     Font** font = check_font(L, 1);
@@ -112,14 +312,114 @@ static int l_font_get_size(lua_State* L) {
     return 1;
 }
 
-// font:get_line_height() -> number
+// font:get_line_height(size?) -> number
 static int l_font_get_line_height(lua_State* L) {
     Font** font = check_font(L, 1);
     if (!*font) {
         return luaL_error(L, "Font has been destroyed");
     }
 
-    lua_pushnumber(L, (*font)->line_height);
+    if (lua_isnoneornil(L, 2)) {
+        lua_pushnumber(L, (*font)->line_height);
+        return 1;
+    }
+
+    float size = (float)luaL_checknumber(L, 2);
+    luaL_argcheck(L, size > 0, 2, "size must be positive");
+    FontStrike* strike = font_get_strike(*font, size);
+    if (!strike) {
+        return luaL_error(L, "Failed to rasterize font at size %f", size);
+    }
+    lua_pushnumber(L, strike->line_height);
+    return 1;
+}
+
+// font:preload(text, size?) -> number of glyphs rasterized
+static int l_font_preload(lua_State* L) {
+    Font** font = check_font(L, 1);
+    if (!*font) {
+        return luaL_error(L, "Font has been destroyed");
+    }
+
+    const char* text = luaL_checkstring(L, 2);
+    float size = (float)luaL_optnumber(L, 3, 0);
+    lua_pushinteger(L, font_preload(*font, text, size));
+    return 1;
+}
+
+// font:get_glyph_count() -> number of cached glyphs
+static int l_font_get_glyph_count(lua_State* L) {
+    Font** font = check_font(L, 1);
+    if (!*font) {
+        return luaL_error(L, "Font has been destroyed");
+    }
+
+    lua_pushinteger(L, font_get_glyph_count(*font));
+    return 1;
+}
+
+// Color field of an effects table, or `fallback` when absent
+static Color get_effect_color(lua_State* L, int idx, const char* key, Color fallback) {
+    lua_getfield(L, idx, key);
+    Color c = fallback;
+    if (lua_istable(L, -1)) c = get_text_color_from_lua(L, lua_gettop(L));
+    lua_pop(L, 1);
+    return c;
+}
+
+static float get_effect_number(lua_State* L, int idx, const char* key, float fallback) {
+    lua_getfield(L, idx, key);
+    float v = lua_isnil(L, -1) ? fallback : (float)luaL_checknumber(L, -1);
+    lua_pop(L, 1);
+    return v;
+}
+
+// font:set_effects({ outline, outline_color, glow, glow_color, shadow_x,
+// shadow_y, shadow_softness, shadow_color }) or font:set_effects(nil)
+static int l_font_set_effects(lua_State* L) {
+    Font** font = check_font(L, 1);
+    if (!*font) {
+        return luaL_error(L, "Font has been destroyed");
+    }
+    if (!(*font)->sdf) {
+        return luaL_error(L, "Text effects need an SDF font (load with { sdf = true })");
+    }
+
+    if (lua_isnoneornil(L, 2)) {
+        font_set_effects(*font, NULL);
+        return 0;
+    }
+    luaL_checktype(L, 2, LUA_TTABLE);
+
+    TextEffects fx;
+    fx.outline = get_effect_number(L, 2, "outline", 0.0f);
+    fx.outline_color = get_effect_color(L, 2, "outline_color", (Color){0.0f, 0.0f, 0.0f, 1.0f});
+    fx.glow = get_effect_number(L, 2, "glow", 0.0f);
+    fx.glow_color = get_effect_color(L, 2, "glow_color", (Color){1.0f, 1.0f, 1.0f, 1.0f});
+    fx.shadow_x = get_effect_number(L, 2, "shadow_x", 0.0f);
+    fx.shadow_y = get_effect_number(L, 2, "shadow_y", 0.0f);
+    fx.shadow_softness = get_effect_number(L, 2, "shadow_softness", 1.0f);
+
+    // Any shadow field turns the shadow on (half-transparent black by default)
+    lua_getfield(L, 2, "shadow_color");
+    int has_color = !lua_isnil(L, -1);
+    lua_pop(L, 1);
+    int has_shadow = has_color || fx.shadow_x != 0.0f || fx.shadow_y != 0.0f;
+    fx.shadow_color = get_effect_color(L, 2, "shadow_color",
+                                       (Color){0.0f, 0.0f, 0.0f, has_shadow ? 0.5f : 0.0f});
+
+    font_set_effects(*font, &fx);
+    return 0;
+}
+
+// font:is_sdf() -> boolean
+static int l_font_is_sdf(lua_State* L) {
+    Font** font = check_font(L, 1);
+    if (!*font) {
+        return luaL_error(L, "Font has been destroyed");
+    }
+
+    lua_pushboolean(L, (*font)->sdf);
     return 1;
 }
 
@@ -133,6 +433,53 @@ static int l_font_destroy(lua_State* L) {
     return 0;
 }
 
+// pudim.text.set_cache_dir(path|nil) -> boolean
+// Enables the persistent font atlas cache (nil disables it)
+static int l_text_set_cache_dir(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1)) arg = 2;
+    const char* dir = lua_isnoneornil(L, arg) ? NULL : luaL_checkstring(L, arg);
+
+    if (!font_cache_set_dir(dir)) {
+        lua_pushboolean(L, 0);
+        lua_pushstring(L, "Failed to create font cache directory");
+        return 2;
+    }
+    lua_pushboolean(L, 1);
+    return 1;
+}
+
+// pudim.text.get_cache_dir() -> string|nil
+static int l_text_get_cache_dir(lua_State* L) {
+    const char* dir = font_cache_get_dir();
+    if (dir) lua_pushstring(L, dir);
+    else lua_pushnil(L);
+    return 1;
+}
+
+// pudim.text.disk_cache_stats() -> table
+static int l_text_disk_cache_stats(lua_State* L) {
+    FontCacheStats stats;
+    font_cache_get_stats(&stats);
+
+    lua_newtable(L);
+    lua_pushinteger(L, stats.hits);         lua_setfield(L, -2, "hits");
+    lua_pushinteger(L, stats.misses);       lua_setfield(L, -2, "misses");
+    lua_pushinteger(L, stats.writes);       lua_setfield(L, -2, "writes");
+    lua_pushinteger(L, stats.cold_loads);   lua_setfield(L, -2, "cold_loads");
+    lua_pushnumber(L, stats.cold_seconds * 1000.0); lua_setfield(L, -2, "cold_ms");
+    lua_pushinteger(L, stats.warm_loads);   lua_setfield(L, -2, "warm_loads");
+    lua_pushnumber(L, stats.warm_seconds * 1000.0); lua_setfield(L, -2, "warm_ms");
+    return 1;
+}
+
+// pudim.text.reset_disk_cache_stats()
+static int l_text_reset_disk_cache_stats(lua_State* L) {
+    (void)L;
+    font_cache_reset_stats();
+    return 0;
+}
+
 // pudim.text.flush() - flush pending text draws
 static int l_text_flush(lua_State* L) {
     (void)L;
@@ -140,6 +487,404 @@ static int l_text_flush(lua_State* L) {
     return 0;
 }
 
+// pudim.text.cache_stats() -> table
+static int l_text_cache_stats(lua_State* L) {
+    TextCacheStats stats;
+    text_get_cache_stats(&stats);
+
+    lua_newtable(L);
+    lua_pushinteger(L, stats.frame_misses);            lua_setfield(L, -2, "frame_misses");
+    lua_pushinteger(L, stats.current_misses);          lua_setfield(L, -2, "current_misses");
+    lua_pushinteger(L, (lua_Integer)stats.hits);       lua_setfield(L, -2, "hits");
+    lua_pushinteger(L, (lua_Integer)stats.misses);     lua_setfield(L, -2, "misses");
+    lua_pushinteger(L, stats.evictions);               lua_setfield(L, -2, "evictions");
+    lua_pushinteger(L, stats.glyphs);                  lua_setfield(L, -2, "glyphs");
+    lua_pushinteger(L, stats.pages);                   lua_setfield(L, -2, "pages");
+    lua_pushinteger(L, stats.sizes);                   lua_setfield(L, -2, "sizes");
+    lua_pushinteger(L, stats.layouts);                 lua_setfield(L, -2, "layouts");
+    lua_pushinteger(L, stats.layout_frame_hits);       lua_setfield(L, -2, "layout_frame_hits");
+    lua_pushinteger(L, stats.layout_frame_misses);     lua_setfield(L, -2, "layout_frame_misses");
+    lua_pushinteger(L, stats.layout_entries);          lua_setfield(L, -2, "layout_entries");
+    return 1;
+}
+
+// --- Retained text objects ---
+// The Text userdata keeps its Font userdata as a user value so the font
+// outlives it; an explicitly destroyed font makes the text unusable.
+
+static TextObject** check_text(lua_State* L, int idx) {
+    TextObject** obj = (TextObject**)luaL_checkudata(L, idx, TEXT_METATABLE);
+    if (!*obj) {
+        luaL_error(L, "Text has been destroyed");
+    }
+    return obj;
+}
+
+// Point the object at its font again, erroring if the font was destroyed
+static TextObject* check_live_text(lua_State* L, int idx) {
+    TextObject* obj = *check_text(L, idx);
+    lua_getiuservalue(L, idx, 1);
+    Font** font = (Font**)luaL_testudata(L, -1, FONT_METATABLE);
+    lua_pop(L, 1);
+    if (!font || !*font) {
+        luaL_error(L, "Font has been destroyed");
+    }
+    obj->font = *font;
+    return obj;
+}
+
+// font:set_kerning(enabled)
+static int l_font_set_kerning(lua_State* L) {
+    Font** font = check_font(L, 1);
+    if (!*font) {
+        return luaL_error(L, "Font has been destroyed");
+    }
+
+    luaL_checkany(L, 2);
+    font_set_kerning(*font, lua_toboolean(L, 2));
+    return 0;
+}
+
+// font:get_kerning() -> boolean
+static int l_font_get_kerning(lua_State* L) {
+    Font** font = check_font(L, 1);
+    if (!*font) {
+        return luaL_error(L, "Font has been destroyed");
+    }
+
+    lua_pushboolean(L, (*font)->kerning_enabled);
+    return 1;
+}
+
+// font:create_text(text, options?) -> Text
+// options: layout options plus { gpu = boolean }
+static int l_font_create_text(lua_State* L) {
+    Font** font = check_font(L, 1);
+    if (!*font) {
+        return luaL_error(L, "Font has been destroyed");
+    }
+
+    const char* text = luaL_checkstring(L, 2);
+    TextLayoutOptions options;
+    get_layout_options(L, 3, &options);
+    int gpu = 0;
+    if (lua_istable(L, 3)) {
+        lua_getfield(L, 3, "gpu");
+        gpu = lua_toboolean(L, -1);
+        lua_pop(L, 1);
+    }
+
+    TextObject* obj = text_object_create(*font, text, &options, gpu);
+    if (!obj) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Failed to create text");
+        return 2;
+    }
+
+    TextObject** udata = (TextObject**)lua_newuserdatauv(L, sizeof(TextObject*), 1);
+    *udata = obj;
+    luaL_getmetatable(L, TEXT_METATABLE);
+    lua_setmetatable(L, -2);
+
+    lua_pushvalue(L, 1);
+    lua_setiuservalue(L, -2, 1);
+    return 1;
+}
+
+// text:draw(x, y, r?, g?, b?, a?) or text:draw(x, y, color_table)
+static int l_text_object_draw(lua_State* L) {
+    TextObject* obj = check_live_text(L, 1);
+    float x = (float)luaL_checknumber(L, 2);
+    float y = (float)luaL_checknumber(L, 3);
+    Color c = {1.0f, 1.0f, 1.0f, 1.0f};
+    if (!lua_isnoneornil(L, 4)) c = get_text_color_from_lua(L, 4);
+
+    text_object_draw(obj, x, y, c);
+    return 0;
+}
+
+// text:set_text(text) - lays out again only if the string changed
+static int l_text_object_set_text(lua_State* L) {
+    TextObject* obj = *check_text(L, 1);
+    const char* text = luaL_checkstring(L, 2);
+    if (!text_object_set_text(obj, text)) {
+        return luaL_error(L, "Failed to set text");
+    }
+    return 0;
+}
+
+// text:get_text() -> string
+static int l_text_object_get_text(lua_State* L) {
+    TextObject* obj = *check_text(L, 1);
+    lua_pushstring(L, obj->text);
+    return 1;
+}
+
+// text:set_font(font, size?)
+static int l_text_object_set_font(lua_State* L) {
+    TextObject* obj = *check_text(L, 1);
+    Font** font = check_font(L, 2);
+    if (!*font) {
+        return luaL_error(L, "Font has been destroyed");
+    }
+    float size = (float)luaL_optnumber(L, 3, 0.0);
+
+    text_object_set_font(obj, *font, size);
+    lua_pushvalue(L, 2);
+    lua_setiuservalue(L, 1, 1);
+    return 0;
+}
+
+// text:set_font_size(size)
+static int l_text_object_set_font_size(lua_State* L) {
+    TextObject* obj = check_live_text(L, 1);
+    float size = (float)luaL_checknumber(L, 2);
+    luaL_argcheck(L, size > 0, 2, "size must be positive");
+    text_object_set_font(obj, obj->font, size);
+    return 0;
+}
+
+// text:get_font_size() -> number
+static int l_text_object_get_font_size(lua_State* L) {
+    TextObject* obj = *check_text(L, 1);
+    lua_pushnumber(L, obj->layout.size);
+    return 1;
+}
+
+// text:set_layout(options) - width, wrap, align and line_spacing (size is kept
+// unless given)
+static int l_text_object_set_layout(lua_State* L) {
+    TextObject* obj = *check_text(L, 1);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    TextLayoutOptions options;
+    get_layout_options(L, 2, &options);
+    text_object_set_layout(obj, &options);
+    return 0;
+}
+
+// text:get_size() -> width, height
+static int l_text_object_get_size(lua_State* L) {
+    TextObject* obj = check_live_text(L, 1);
+    float w, h;
+    text_object_get_size(obj, &w, &h);
+    lua_pushnumber(L, w);
+    lua_pushnumber(L, h);
+    return 2;
+}
+
+// text:destroy()
+static int l_text_object_destroy(lua_State* L) {
+    TextObject** obj = (TextObject**)luaL_checkudata(L, 1, TEXT_METATABLE);
+    if (*obj) {
+        text_object_destroy(*obj);
+        *obj = NULL;
+    }
+    return 0;
+}
+
+// --- Character grids ---
+// Like Text, a TextGrid keeps its Font userdata as user value 1.
+
+static TextGrid** check_grid(lua_State* L, int idx) {
+    TextGrid** grid = (TextGrid**)luaL_checkudata(L, idx, TEXT_GRID_METATABLE);
+    if (!*grid) {
+        luaL_error(L, "TextGrid has been destroyed");
+    }
+    return grid;
+}
+
+static TextGrid* check_live_grid(lua_State* L, int idx) {
+    TextGrid* grid = *check_grid(L, idx);
+    lua_getiuservalue(L, idx, 1);
+    Font** font = (Font**)luaL_testudata(L, -1, FONT_METATABLE);
+    lua_pop(L, 1);
+    if (!font || !*font) {
+        luaL_error(L, "Font has been destroyed");
+    }
+    grid->font = *font;
+    return grid;
+}
+
+// Optional color table argument as RGBA8
+static uint32_t opt_grid_color(lua_State* L, int idx, uint32_t def) {
+    if (lua_isnoneornil(L, idx)) return def;
+    luaL_checktype(L, idx, LUA_TTABLE);
+    return text_grid_color(get_text_color_from_lua(L, idx));
+}
+
+// A character: code point or the first character of a string ("" = empty)
+static uint32_t check_grid_char(lua_State* L, int idx) {
+    if (lua_type(L, idx) == LUA_TNUMBER) {
+        lua_Integer cp = luaL_checkinteger(L, idx);
+        luaL_argcheck(L, cp >= 0 && cp <= 0x10FFFF, idx, "invalid code point");
+        return (uint32_t)cp;
+    }
+    const char* s = luaL_checkstring(L, idx);
+    return utf8_decode(&s);
+}
+
+static void push_grid_color(lua_State* L, uint32_t color) {
+    lua_createtable(L, 0, 4);
+    lua_pushnumber(L, (color & 0xFF) / 255.0);          lua_setfield(L, -2, "r");
+    lua_pushnumber(L, (color >> 8 & 0xFF) / 255.0);     lua_setfield(L, -2, "g");
+    lua_pushnumber(L, (color >> 16 & 0xFF) / 255.0);    lua_setfield(L, -2, "b");
+    lua_pushnumber(L, (color >> 24) / 255.0);           lua_setfield(L, -2, "a");
+}
+
+#define GRID_DEFAULT_FG 0xFFFFFFFFu  // opaque white
+#define GRID_DEFAULT_BG 0u           // transparent
+
+// PudimBasicsGl.text.grid(cols, rows, font) -> TextGrid
+static int l_text_grid(lua_State* L) {
+    lua_Integer cols = luaL_checkinteger(L, 1);
+    lua_Integer rows = luaL_checkinteger(L, 2);
+    Font** font = check_font(L, 3);
+    if (!*font) {
+        return luaL_error(L, "Font has been destroyed");
+    }
+    luaL_argcheck(L, cols > 0 && cols <= 4096, 1, "cols must be between 1 and 4096");
+    luaL_argcheck(L, rows > 0 && rows <= 4096, 2, "rows must be between 1 and 4096");
+
+    TextGrid* grid = text_grid_create(*font, (int)cols, (int)rows);
+    if (!grid) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Failed to create text grid");
+        return 2;
+    }
+
+    TextGrid** udata = (TextGrid**)lua_newuserdatauv(L, sizeof(TextGrid*), 1);
+    *udata = grid;
+    luaL_getmetatable(L, TEXT_GRID_METATABLE);
+    lua_setmetatable(L, -2);
+
+    lua_pushvalue(L, 3);
+    lua_setiuservalue(L, -2, 1);
+    return 1;
+}
+
+// grid:set(col, row, char, fg?, bg?) - char is a string or code point
+static int l_grid_set(lua_State* L) {
+    TextGrid* grid = *check_grid(L, 1);
+    int col = (int)luaL_checkinteger(L, 2);
+    int row = (int)luaL_checkinteger(L, 3);
+    uint32_t cp = check_grid_char(L, 4);
+    text_grid_set(grid, col, row, cp, opt_grid_color(L, 5, GRID_DEFAULT_FG), opt_grid_color(L, 6, GRID_DEFAULT_BG));
+    return 0;
+}
+
+// grid:print(col, row, text, fg?, bg?) -> cells written
+static int l_grid_print(lua_State* L) {
+    TextGrid* grid = *check_grid(L, 1);
+    int col = (int)luaL_checkinteger(L, 2);
+    int row = (int)luaL_checkinteger(L, 3);
+    const char* text = luaL_checkstring(L, 4);
+    int written = text_grid_print(grid, col, row, text, opt_grid_color(L, 5, GRID_DEFAULT_FG),
+                                  opt_grid_color(L, 6, GRID_DEFAULT_BG));
+    lua_pushinteger(L, written);
+    return 1;
+}
+
+// grid:fill(col, row, w, h, char, fg?, bg?)
+static int l_grid_fill(lua_State* L) {
+    TextGrid* grid = *check_grid(L, 1);
+    int col = (int)luaL_checkinteger(L, 2);
+    int row = (int)luaL_checkinteger(L, 3);
+    int w = (int)luaL_checkinteger(L, 4);
+    int h = (int)luaL_checkinteger(L, 5);
+    uint32_t cp = check_grid_char(L, 6);
+    text_grid_fill(grid, col, row, w, h, cp, opt_grid_color(L, 7, GRID_DEFAULT_FG),
+                   opt_grid_color(L, 8, GRID_DEFAULT_BG));
+    return 0;
+}
+
+// grid:clear(bg?)
+static int l_grid_clear(lua_State* L) {
+    TextGrid* grid = *check_grid(L, 1);
+    text_grid_fill(grid, 0, 0, grid->cols, grid->rows, 0, 0, opt_grid_color(L, 2, GRID_DEFAULT_BG));
+    return 0;
+}
+
+// grid:scroll(lines, bg?) - positive moves the contents up
+static int l_grid_scroll(lua_State* L) {
+    TextGrid* grid = *check_grid(L, 1);
+    int lines = (int)luaL_checkinteger(L, 2);
+    text_grid_scroll(grid, lines, opt_grid_color(L, 3, GRID_DEFAULT_BG));
+    return 0;
+}
+
+// grid:get(col, row) -> codepoint, fg, bg (nil outside the grid)
+static int l_grid_get(lua_State* L) {
+    TextGrid* grid = *check_grid(L, 1);
+    int col = (int)luaL_checkinteger(L, 2);
+    int row = (int)luaL_checkinteger(L, 3);
+    const TextGridCell* cell = text_grid_get(grid, col, row);
+    if (!cell) {
+        lua_pushnil(L);
+        return 1;
+    }
+    lua_pushinteger(L, cell->codepoint);
+    push_grid_color(L, cell->fg);
+    push_grid_color(L, cell->bg);
+    return 3;
+}
+
+// grid:draw(x, y) -> rows rebuilt
+static int l_grid_draw(lua_State* L) {
+    TextGrid* grid = check_live_grid(L, 1);
+    float x = (float)luaL_checknumber(L, 2);
+    float y = (float)luaL_checknumber(L, 3);
+    lua_pushinteger(L, text_grid_draw(grid, x, y));
+    return 1;
+}
+
+// grid:get_size() -> cols, rows
+static int l_grid_get_size(lua_State* L) {
+    TextGrid* grid = *check_grid(L, 1);
+    lua_pushinteger(L, grid->cols);
+    lua_pushinteger(L, grid->rows);
+    return 2;
+}
+
+// grid:get_cell_size() -> width, height in pixels
+static int l_grid_get_cell_size(lua_State* L) {
+    TextGrid* grid = check_live_grid(L, 1);
+    float w, h;
+    text_grid_get_cell_size(grid, &w, &h);
+    lua_pushnumber(L, w);
+    lua_pushnumber(L, h);
+    return 2;
+}
+
+// grid:get_dirty_rows() -> rows waiting to be rebuilt on the next draw
+static int l_grid_get_dirty_rows(lua_State* L) {
+    TextGrid* grid = *check_grid(L, 1);
+    lua_pushinteger(L, grid->dirty_count);
+    return 1;
+}
+
+// grid:set_font(font)
+static int l_grid_set_font(lua_State* L) {
+    TextGrid* grid = *check_grid(L, 1);
+    Font** font = check_font(L, 2);
+    if (!*font) {
+        return luaL_error(L, "Font has been destroyed");
+    }
+    text_grid_set_font(grid, *font);
+    lua_pushvalue(L, 2);
+    lua_setiuservalue(L, 1, 1);
+    return 0;
+}
+
+// grid:destroy()
+static int l_grid_destroy(lua_State* L) {
+    TextGrid** grid = (TextGrid**)luaL_checkudata(L, 1, TEXT_GRID_METATABLE);
+    if (*grid) {
+        text_grid_destroy(*grid);
+        *grid = NULL;
+    }
+    return 0;
+}
+
 // Garbage collector
 static int l_font_gc(lua_State* L) {
     Font** font = check_font(L, 1);
@@ -153,18 +898,72 @@ static int l_font_gc(lua_State* L) {
 // Metatable methods (instance methods on Font userdata)
 static const luaL_Reg font_methods[] = {
     {"draw", l_font_draw},
+    {"draw_layout", l_font_draw_layout},
     {"measure", l_font_measure},
+    {"measure_layout", l_font_measure_layout},
     {"set_size", l_font_set_size},
     {"get_size", l_font_get_size},
     {"get_line_height", l_font_get_line_height},
+    {"preload", l_font_preload},
+    {"get_glyph_count", l_font_get_glyph_count},
+    {"set_effects", l_font_set_effects},
+    {"is_sdf", l_font_is_sdf},
+    {"set_kerning", l_font_set_kerning},
+    {"get_kerning", l_font_get_kerning},
+    {"create_text", l_font_create_text},
     {"destroy", l_font_destroy},
     {NULL, NULL}
 };
 
+// Methods on retained Text userdata
+static const luaL_Reg text_object_methods[] = {
+    {"draw", l_text_object_draw},
+    {"set_text", l_text_object_set_text},
+    {"get_text", l_text_object_get_text},
+    {"set_font", l_text_object_set_font},
+    {"set_font_size", l_text_object_set_font_size},
+    {"get_font_size", l_text_object_get_font_size},
+    {"set_layout", l_text_object_set_layout},
+    {"get_size", l_text_object_get_size},
+    {"destroy", l_text_object_destroy},
+    {NULL, NULL}
+};
+
+// Methods on TextGrid userdata
+static const luaL_Reg text_grid_methods[] = {
+    {"set", l_grid_set},
+    {"print", l_grid_print},
+    {"fill", l_grid_fill},
+    {"clear", l_grid_clear},
+    {"scroll", l_grid_scroll},
+    {"get", l_grid_get},
+    {"draw", l_grid_draw},
+    {"get_size", l_grid_get_size},
+    {"get_cell_size", l_grid_get_cell_size},
+    {"get_dirty_rows", l_grid_get_dirty_rows},
+    {"set_font", l_grid_set_font},
+    {"destroy", l_grid_destroy},
+    {NULL, NULL}
+};
+
 // Module functions (PudimBasicsGl.text.*)
+static const luaL_Reg font_load_methods[] = {
+    {"is_done", l_font_load_is_done},
+    {"get", l_font_load_get},
+    {NULL, NULL}
+};
+
 static const luaL_Reg text_functions[] = {
     {"load", l_text_load},
+    {"load_async", l_text_load_async},
+    {"load_bmfont", l_text_load_bmfont},
+    {"grid", l_text_grid},
     {"flush", l_text_flush},
+    {"cache_stats", l_text_cache_stats},
+    {"set_cache_dir", l_text_set_cache_dir},
+    {"get_cache_dir", l_text_get_cache_dir},
+    {"disk_cache_stats", l_text_disk_cache_stats},
+    {"reset_disk_cache_stats", l_text_reset_disk_cache_stats},
     {NULL, NULL}
 };
 
@@ -184,6 +983,33 @@ void lua_register_text_api(lua_State* L) {
     luaL_setfuncs(L, font_methods, 0);
     lua_pop(L, 1);
 
+    // Create metatable for retained Text objects
+    luaL_newmetatable(L, TEXT_METATABLE);
+    lua_pushvalue(L, -1);
+    lua_setfield(L, -2, "__index");
+    lua_pushcfunction(L, l_text_object_destroy);
+    lua_setfield(L, -2, "__gc");
+    luaL_setfuncs(L, text_object_methods, 0);
+    lua_pop(L, 1);
+
+    // Create metatable for pending async font loads
+    luaL_newmetatable(L, FONT_LOAD_METATABLE);
+    lua_pushvalue(L, -1);
+    lua_setfield(L, -2, "__index");
+    lua_pushcfunction(L, l_font_load_gc);
+    lua_setfield(L, -2, "__gc");
+    luaL_setfuncs(L, font_load_methods, 0);
+    lua_pop(L, 1);
+
+    // Create metatable for character grids
+    luaL_newmetatable(L, TEXT_GRID_METATABLE);
+    lua_pushvalue(L, -1);
+    lua_setfield(L, -2, "__index");
+    lua_pushcfunction(L, l_grid_destroy);
+    lua_setfield(L, -2, "__gc");
+    luaL_setfuncs(L, text_grid_methods, 0);
+    lua_pop(L, 1);
+
     // Create PudimBasicsGl.text table
     lua_getglobal(L, "PudimBasicsGl");
     if (lua_isnil(L, -1)) {
@@ -3,6 +3,9 @@
 #include <lualib.h>
 #include <stdlib.h>
 #include "../render/texture.h"
+#include "../render/texture_cache.h"
+#include "../render/texture_registry.h"
+#include "../render/texture_memory.h"
 
 #define TEXTURE_METATABLE "PudimBasicsGl.Texture"
 
@@ -22,17 +25,62 @@ static Texture** check_texture(lua_State* L, int index) {
     return (Texture**)luaL_checkudata(L, index, TEXTURE_METATABLE);
 }
 
-// PudimBasicsGl.texture.load(filepath) -> Texture
+static const char* const filter_names[] = {"nearest", "linear", NULL};
+static const char* const wrap_names[] = {"clamp", "repeat", "mirror", NULL};
+// Indexed by TextureFormat + 1
+static const char* const format_names[] = {"auto", "rgba8", "r8", "rg8", "rgb565", "rgba4", NULL};
+
+// Read filter / wrap / lod_bias fields of an options table into load options.
+// They are part of the registry key, so shared textures keep their sampling.
+static void check_sampler_options(lua_State* L, int idx, TextureLoadOptions* options) {
+    lua_getfield(L, idx, "filter");
+    if (!lua_isnil(L, -1)) {
+        options->filter = (TextureFilter)luaL_checkoption(L, -1, NULL, filter_names);
+    }
+    lua_pop(L, 1);
+
+    lua_getfield(L, idx, "wrap");
+    if (!lua_isnil(L, -1)) {
+        options->wrap = (TextureWrap)luaL_checkoption(L, -1, NULL, wrap_names);
+    }
+    lua_pop(L, 1);
+
+    lua_getfield(L, idx, "lod_bias");
+    if (!lua_isnil(L, -1)) {
+        options->lod_bias = (float)luaL_checknumber(L, -1);
+    }
+    lua_pop(L, 1);
+}
+
+// PudimBasicsGl.texture.load(filepath, options?) -> Texture
 // Accept optional self when called as module:load(filepath)
+// Repeated loads of the same file share one GL texture (see texture_registry.h)
+// options: { mipmaps = bool, filter = "nearest"|"linear", wrap = "clamp"|"repeat"|"mirror", lod_bias = number,
+//            format = "rgba8"|"r8"|"rg8"|"rgb565"|"rgba4"|"auto" }
 static int l_texture_load(lua_State* L) {
     int arg = 1;
     if (lua_istable(L, 1)) arg = 2; // allow pb.texture:load(path)
     const char* filepath = luaL_checkstring(L, arg);
+    int has_options = lua_istable(L, arg + 1);
+    
+    TextureLoadOptions options;
+    texture_load_options_init(&options);
+    if (has_options) {
+        lua_getfield(L, arg + 1, "mipmaps");
+        options.mipmaps = lua_toboolean(L, -1);
+        lua_pop(L, 1);
+        lua_getfield(L, arg + 1, "format");
+        if (!lua_isnil(L, -1)) {
+            options.format = (TextureFormat)(luaL_checkoption(L, -1, NULL, format_names) - 1);
+        }
+        lua_pop(L, 1);
+        check_sampler_options(L, arg + 1, &options);
+    }
     
     // Lazy init texture renderer (needs OpenGL context)
     ensure_texture_renderer_init();
     
-    Texture* tex = texture_load(filepath);
+    Texture* tex = texture_registry_acquire(filepath, &options);
     if (!tex) {
         lua_pushnil(L);
         lua_pushstring(L, "Failed to load texture");
@@ -68,7 +116,14 @@ static int l_texture_load_with_colorkey(lua_State* L) {
     
     ensure_texture_renderer_init();
     
-    Texture* tex = texture_load_with_colorkey(filepath, (unsigned char)r, (unsigned char)g, (unsigned char)b);
+    TextureLoadOptions options;
+    texture_load_options_init(&options);
+    options.use_colorkey = 1;
+    options.colorkey_r = (unsigned char)r;
+    options.colorkey_g = (unsigned char)g;
+    options.colorkey_b = (unsigned char)b;
+    
+    Texture* tex = texture_registry_acquire(filepath, &options);
     if (!tex) {
         lua_pushnil(L);
         lua_pushstring(L, "Failed to load texture with colorkey");
@@ -84,37 +139,82 @@ static int l_texture_load_with_colorkey(lua_State* L) {
     return 1;
 }
 
+// Resolve a pixel data argument holding `needed` bytes of RGBA.
+// Strings and full userdata (byte buffers) are used in place without copying;
+// tables of byte values are copied into *owned, which the caller must free.
+// Returns NULL and sets *err on failure.
+static const unsigned char* get_pixel_data(lua_State* L, int idx, size_t needed,
+                                           unsigned char** owned, const char** err) {
+    *owned = NULL;
+
+    if (lua_type(L, idx) == LUA_TSTRING || lua_type(L, idx) == LUA_TUSERDATA) {
+        size_t len = 0;
+        const unsigned char* bytes;
+        if (lua_type(L, idx) == LUA_TSTRING) {
+            bytes = (const unsigned char*)lua_tolstring(L, idx, &len);
+        } else {
+            bytes = (const unsigned char*)lua_touserdata(L, idx);
+            len = (size_t)lua_rawlen(L, idx);
+        }
+        if (len < needed) {
+            *err = "Pixel buffer is smaller than width * height * 4 bytes";
+            return NULL;
+        }
+        return bytes;
+    }
+
+    if (lua_istable(L, idx)) {
+        unsigned char* data = (unsigned char*)malloc(needed);
+        if (!data) {
+            *err = "Failed to allocate texture data";
+            return NULL;
+        }
+        for (size_t i = 0; i < needed; i++) {
+            lua_rawgeti(L, idx, (lua_Integer)i + 1);
+            data[i] = (unsigned char)lua_tointeger(L, -1);
+            lua_pop(L, 1);
+        }
+        *owned = data;
+        return data;
+    }
+
+    *err = "Pixel data must be a string, byte buffer userdata or table";
+    return NULL;
+}
+
 // PudimBasicsGl.texture.create(width, height, data?) -> Texture
 // Accept optional self when called as module:create(width, height, data?)
+// data may be a string or byte buffer (uploaded without a copy) or a table of bytes
 static int l_texture_create(lua_State* L) {
     int arg = 1;
     if (lua_istable(L, 1)) arg = 2; // allow pb.texture:create(w,h,...)
     int width = (int)luaL_checkinteger(L, arg);
     int height = (int)luaL_checkinteger(L, arg + 1);
     
+    if (width <= 0 || height <= 0) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Texture size must be positive");
+        return 2;
+    }
+    
     // Lazy init texture renderer (needs OpenGL context)
     ensure_texture_renderer_init();
     
-    unsigned char* data = NULL;
+    const unsigned char* data = NULL;
+    unsigned char* owned = NULL;
     
-    // If data table provided, use it
-    if (lua_istable(L, arg + 2)) {
-        int size = width * height * 4;
-        data = (unsigned char*)malloc(size);
+    if (!lua_isnoneornil(L, arg + 2)) {
+        const char* err = NULL;
+        data = get_pixel_data(L, arg + 2, (size_t)width * (size_t)height * 4, &owned, &err);
         if (!data) {
             lua_pushnil(L);
-            lua_pushstring(L, "Failed to allocate texture data");
+            lua_pushstring(L, err);
             return 2;
         }
-        for (int i = 0; i < size; i++) {
-            lua_rawgeti(L, arg + 2, i + 1);
-            data[i] = (unsigned char)lua_tointeger(L, -1);
-            lua_pop(L, 1);
-        }
     }
     
     Texture* tex = texture_create(width, height, data);
-    if (data) free(data);
+    free(owned);
     
     if (!tex) {
         lua_pushnil(L);
@@ -131,11 +231,55 @@ static int l_texture_create(lua_State* L) {
     return 1;
 }
 
-// texture:destroy()
+// texture:update_from(data, x?, y?, width?, height?) -> boolean
+// Streams new pixels into the texture (whole texture by default).
+// data is a string, byte buffer userdata or table holding width * height * 4 bytes.
+static int l_texture_update_from(lua_State* L) {
+    Texture** tex = check_texture(L, 1);
+    if (!*tex) {
+        lua_pushboolean(L, 0);
+        lua_pushstring(L, "Texture has been destroyed");
+        return 2;
+    }
+    
+    int x = (int)luaL_optinteger(L, 3, 0);
+    int y = (int)luaL_optinteger(L, 4, 0);
+    int w = (int)luaL_optinteger(L, 5, (*tex)->width - x);
+    int h = (int)luaL_optinteger(L, 6, (*tex)->height - y);
+    
+    if (w <= 0 || h <= 0 || x < 0 || y < 0 ||
+        x + w > (*tex)->width || y + h > (*tex)->height) {
+        lua_pushboolean(L, 0);
+        lua_pushstring(L, "Update region is outside the texture");
+        return 2;
+    }
+    
+    const char* err = NULL;
+    unsigned char* owned = NULL;
+    const unsigned char* data = get_pixel_data(L, 2, (size_t)w * (size_t)h * 4, &owned, &err);
+    if (!data) {
+        lua_pushboolean(L, 0);
+        lua_pushstring(L, err);
+        return 2;
+    }
+    
+    int ok = texture_update(*tex, x, y, w, h, data);
+    free(owned);
+    
+    if (!ok) {
+        lua_pushboolean(L, 0);
+        lua_pushstring(L, "Failed to update texture");
+        return 2;
+    }
+    lua_pushboolean(L, 1);
+    return 1;
+}
+
+// texture:destroy() - drops this handle's reference to the (possibly shared) texture
 static int l_texture_destroy(lua_State* L) {
     Texture** tex = check_texture(L, 1);
     if (*tex) {
-        texture_destroy(*tex);
+        texture_release(*tex);
         *tex = NULL;
     }
     return 0;
@@ -279,6 +423,96 @@ static int l_texture_draw_region_ex(lua_State* L) {
     return 0;
 }
 
+// texture:draw_nine_slice(x, y, w, h, left, right, top, bottom, options?)
+// options: { r, g, b, a, tile = bool, src_x, src_y, src_w, src_h }
+static int l_texture_draw_nine_slice(lua_State* L) {
+    Texture** tex = check_texture(L, 1);
+    if (!*tex) return 0;
+    
+    int x = (int)luaL_checknumber(L, 2);
+    int y = (int)luaL_checknumber(L, 3);
+    int w = (int)luaL_checknumber(L, 4);
+    int h = (int)luaL_checknumber(L, 5);
+    int left = (int)luaL_checknumber(L, 6);
+    int right = (int)luaL_checknumber(L, 7);
+    int top = (int)luaL_checknumber(L, 8);
+    int bottom = (int)luaL_checknumber(L, 9);
+    
+    float color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    int src[4] = {0, 0, (*tex)->width, (*tex)->height};
+    int tile = 0;
+    if (lua_istable(L, 10)) {
+        static const char* const color_keys[] = {"r", "g", "b", "a"};
+        static const char* const src_keys[] = {"src_x", "src_y", "src_w", "src_h"};
+        for (int i = 0; i < 4; i++) {
+            lua_getfield(L, 10, color_keys[i]);
+            color[i] = (float)luaL_optnumber(L, -1, color[i]);
+            lua_getfield(L, 10, src_keys[i]);
+            src[i] = (int)luaL_optinteger(L, -1, src[i]);
+            lua_pop(L, 2);
+        }
+        lua_getfield(L, 10, "tile");
+        tile = lua_toboolean(L, -1);
+        lua_pop(L, 1);
+    }
+    
+    render_texture_nine_slice_region(*tex, x, y, w, h, src[0], src[1], src[2], src[3],
+                                     left, right, top, bottom,
+                                     color[0], color[1], color[2], color[3], tile);
+    return 0;
+}
+
+// texture:set_filter("nearest"|"linear")
+static int l_texture_set_filter(lua_State* L) {
+    Texture** tex = check_texture(L, 1);
+    TextureFilter filter = (TextureFilter)luaL_checkoption(L, 2, NULL, filter_names);
+    if (*tex) texture_set_filter(*tex, filter);
+    return 0;
+}
+
+// texture:set_wrap(mode_s, mode_t?) - "clamp" | "repeat" | "mirror"
+static int l_texture_set_wrap(lua_State* L) {
+    Texture** tex = check_texture(L, 1);
+    TextureWrap wrap_s = (TextureWrap)luaL_checkoption(L, 2, NULL, wrap_names);
+    TextureWrap wrap_t = lua_isnoneornil(L, 3) ? wrap_s
+                                                : (TextureWrap)luaL_checkoption(L, 3, NULL, wrap_names);
+    if (*tex) texture_set_wrap(*tex, wrap_s, wrap_t);
+    return 0;
+}
+
+// texture:set_lod_bias(bias) - positive values sample smaller mip levels
+static int l_texture_set_lod_bias(lua_State* L) {
+    Texture** tex = check_texture(L, 1);
+    float bias = (float)luaL_checknumber(L, 2);
+    if (*tex) texture_set_lod_bias(*tex, bias);
+    return 0;
+}
+
+// texture:generate_mipmaps() -> number of levels
+static int l_texture_generate_mipmaps(lua_State* L) {
+    Texture** tex = check_texture(L, 1);
+    lua_pushinteger(L, *tex ? texture_generate_mipmaps(*tex) : 0);
+    return 1;
+}
+
+// texture:get_mip_count() -> number
+static int l_texture_get_mip_count(lua_State* L) {
+    Texture** tex = check_texture(L, 1);
+    lua_pushinteger(L, *tex ? (*tex)->mip_count : 0);
+    return 1;
+}
+
+// texture:get_format() -> "rgba8" | "r8" | "rg8" | "rgb565" | "rgba4"
+static int l_texture_get_format(lua_State* L) {
+    Texture** tex = check_texture(L, 1);
+    if (!*tex) {
+        lua_pushnil(L);
+        return 1;
+    }
+    lua_pushstring(L, format_names[(*tex)->format + 1]);
+    return 1;
+}
+
 // PudimBasicsGl.texture.flush() - flush pending texture draws
 static int l_texture_flush(lua_State* L) {
     (void)L;
@@ -286,11 +520,127 @@ static int l_texture_flush(lua_State* L) {
     return 0;
 }
 
+// PudimBasicsGl.texture.set_cache_dir(path|nil) -> boolean
+// Enables the pre-decoded disk cache (nil disables it)
+static int l_texture_set_cache_dir(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1)) arg = 2;
+    const char* dir = lua_isnoneornil(L, arg) ? NULL : luaL_checkstring(L, arg);
+
+    if (!texture_cache_set_dir(dir)) {
+        lua_pushboolean(L, 0);
+        lua_pushstring(L, "Failed to create texture cache directory");
+        return 2;
+    }
+    lua_pushboolean(L, 1);
+    return 1;
+}
+
+// PudimBasicsGl.texture.get_cache_dir() -> string|nil
+static int l_texture_get_cache_dir(lua_State* L) {
+    const char* dir = texture_cache_get_dir();
+    if (dir) lua_pushstring(L, dir);
+    else lua_pushnil(L);
+    return 1;
+}
+
+// PudimBasicsGl.texture.set_cache_compression(enabled)
+static int l_texture_set_cache_compression(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1)) arg = 2;
+    texture_cache_set_compression(lua_toboolean(L, arg));
+    return 0;
+}
+
+// PudimBasicsGl.texture.disk_cache_stats() -> table
+static int l_texture_disk_cache_stats(lua_State* L) {
+    TextureCacheStats stats;
+    texture_cache_get_stats(&stats);
+
+    lua_newtable(L);
+    lua_pushinteger(L, stats.hits);         lua_setfield(L, -2, "hits");
+    lua_pushinteger(L, stats.misses);       lua_setfield(L, -2, "misses");
+    lua_pushinteger(L, stats.writes);       lua_setfield(L, -2, "writes");
+    lua_pushinteger(L, stats.cold_loads);   lua_setfield(L, -2, "cold_loads");
+    lua_pushnumber(L, stats.cold_seconds * 1000.0); lua_setfield(L, -2, "cold_ms");
+    lua_pushinteger(L, stats.warm_loads);   lua_setfield(L, -2, "warm_loads");
+    lua_pushnumber(L, stats.warm_seconds * 1000.0); lua_setfield(L, -2, "warm_ms");
+    return 1;
+}
+
+// PudimBasicsGl.texture.reset_disk_cache_stats()
+static int l_texture_reset_disk_cache_stats(lua_State* L) {
+    (void)L;
+    texture_cache_reset_stats();
+    return 0;
+}
+
+// PudimBasicsGl.texture.cache_stats() -> table
+static int l_texture_cache_stats(lua_State* L) {
+    TextureRegistryStats stats;
+    texture_registry_get_stats(&stats);
+
+    lua_newtable(L);
+    lua_pushinteger(L, stats.entries);      lua_setfield(L, -2, "entries");
+    lua_pushinteger(L, stats.referenced);   lua_setfield(L, -2, "referenced");
+    lua_pushinteger(L, stats.unreferenced); lua_setfield(L, -2, "unreferenced");
+    lua_pushinteger(L, stats.hits);         lua_setfield(L, -2, "hits");
+    lua_pushinteger(L, stats.misses);       lua_setfield(L, -2, "misses");
+    return 1;
+}
+
+// PudimBasicsGl.texture.purge_unused() -> number of textures destroyed
+static int l_texture_purge_unused(lua_State* L) {
+    lua_pushinteger(L, texture_registry_purge());
+    return 1;
+}
+
+// PudimBasicsGl.texture.set_memory_budget(bytes|nil)
+// Textures loaded from files are evicted (least recently drawn first) when
+// textures + font atlases exceed the budget. nil or 0 removes the limit.
+static int l_texture_set_memory_budget(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1)) arg = 2;
+    lua_Integer bytes = lua_isnoneornil(L, arg) ? 0 : luaL_checkinteger(L, arg);
+    texture_memory_set_budget(bytes > 0 ? (size_t)bytes : 0);
+    return 0;
+}
+
+// PudimBasicsGl.texture.get_memory_budget() -> bytes|nil
+static int l_texture_get_memory_budget(lua_State* L) {
+    size_t budget = texture_memory_get_budget();
+    if (budget > 0) lua_pushinteger(L, (lua_Integer)budget);
+    else lua_pushnil(L);
+    return 1;
+}
+
+// PudimBasicsGl.texture.memory_stats() -> table
+static int l_texture_memory_stats(lua_State* L) {
+    TextureMemoryStats stats;
+    texture_memory_get_stats(&stats);
+
+    lua_newtable(L);
+    lua_pushinteger(L, (lua_Integer)stats.texture_bytes); lua_setfield(L, -2, "texture_bytes");
+    lua_pushinteger(L, (lua_Integer)stats.font_bytes);    lua_setfield(L, -2, "font_bytes");
+    lua_pushinteger(L, (lua_Integer)(stats.texture_bytes + stats.font_bytes));
+    lua_setfield(L, -2, "total_bytes");
+    if (stats.budget > 0) {
+        lua_pushinteger(L, (lua_Integer)stats.budget);
+        lua_setfield(L, -2, "budget");
+    }
+    lua_pushinteger(L, stats.textures);     lua_setfield(L, -2, "textures");
+    lua_pushinteger(L, stats.font_atlases); lua_setfield(L, -2, "font_atlases");
+    lua_pushinteger(L, stats.evicted);      lua_setfield(L, -2, "evicted");
+    lua_pushinteger(L, stats.evictions);    lua_setfield(L, -2, "evictions");
+    lua_pushinteger(L, stats.reloads);      lua_setfield(L, -2, "reloads");
+    return 1;
+}
+
 // Garbage collector
 static int l_texture_gc(lua_State* L) {
     Texture** tex = check_texture(L, 1);
     if (*tex) {
-        texture_destroy(*tex);
+        texture_release(*tex);
         *tex = NULL;
     }
     return 0;
@@ -308,6 +658,14 @@ static const luaL_Reg texture_methods[] = {
     {"draw_ex", l_texture_draw_ex},
     {"draw_region", l_texture_draw_region},
     {"draw_region_ex", l_texture_draw_region_ex},
+    {"draw_nine_slice", l_texture_draw_nine_slice},
+    {"update_from", l_texture_update_from},
+    {"set_filter", l_texture_set_filter},
+    {"set_wrap", l_texture_set_wrap},
+    {"set_lod_bias", l_texture_set_lod_bias},
+    {"generate_mipmaps", l_texture_generate_mipmaps},
+    {"get_mip_count", l_texture_get_mip_count},
+    {"get_format", l_texture_get_format},
     {NULL, NULL}
 };
 
@@ -317,6 +675,16 @@ static const luaL_Reg texture_functions[] = {
     {"load_with_colorkey", l_texture_load_with_colorkey},
     {"create", l_texture_create},
     {"flush", l_texture_flush},
+    {"set_cache_dir", l_texture_set_cache_dir},
+    {"get_cache_dir", l_texture_get_cache_dir},
+    {"set_cache_compression", l_texture_set_cache_compression},
+    {"disk_cache_stats", l_texture_disk_cache_stats},
+    {"reset_disk_cache_stats", l_texture_reset_disk_cache_stats},
+    {"cache_stats", l_texture_cache_stats},
+    {"purge_unused", l_texture_purge_unused},
+    {"set_memory_budget", l_texture_set_memory_budget},
+    {"get_memory_budget", l_texture_get_memory_budget},
+    {"memory_stats", l_texture_memory_stats},
     {NULL, NULL}
 };
 
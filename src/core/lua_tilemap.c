@@ -0,0 +1,347 @@
+#include <lua.h>
+#include <lauxlib.h>
+#include <lualib.h>
+#include <math.h>
+#include <GLFW/glfw3.h>
+#include "../render/tilemap.h"
+
+#define TILEMAP_METATABLE "PudimBasicsGl.Tilemap"
+#define TEXTURE_METATABLE "PudimBasicsGl.Texture"
+
+static Tilemap* check_map(lua_State* L, int index) {
+    Tilemap** map = (Tilemap**)luaL_checkudata(L, index, TILEMAP_METATABLE);
+    if (!*map) luaL_error(L, "tilemap has been destroyed");
+    return *map;
+}
+
+// Layers are 1-based in Lua
+static int check_layer(lua_State* L, Tilemap* map, int index) {
+    int layer = (int)luaL_checkinteger(L, index) - 1;
+    if (layer < 0 || layer >= map->layer_count) luaL_error(L, "invalid layer %d", layer + 1);
+    return layer;
+}
+
+static uint16_t check_tile(lua_State* L, Tilemap* map, int index) {
+    lua_Integer tile = luaL_checkinteger(L, index);
+    if (tile < 0 || tile > map->tile_count) luaL_error(L, "invalid tile id %d", (int)tile);
+    return (uint16_t)tile;
+}
+
+static int push_map(lua_State* L, Tilemap* map, const char* err) {
+    if (!map) {
+        lua_pushnil(L);
+        lua_pushstring(L, err);
+        return 2;
+    }
+    Tilemap** udata = (Tilemap**)lua_newuserdata(L, sizeof(Tilemap*));
+    *udata = map;
+    luaL_getmetatable(L, TILEMAP_METATABLE);
+    lua_setmetatable(L, -2);
+    return 1;
+}
+
+// --- Module functions ---
+
+// PudimBasicsGl.tilemap.new(width, height, tile_w, tile_h, texture, options?) -> Tilemap
+// options: { layers = 1, margin = px, spacing = px }
+static int l_tilemap_new(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1)) arg = 2; // allow pb.tilemap:new(...)
+    int width = (int)luaL_checkinteger(L, arg);
+    int height = (int)luaL_checkinteger(L, arg + 1);
+    int tile_w = (int)luaL_checkinteger(L, arg + 2);
+    int tile_h = (int)luaL_checkinteger(L, arg + 3);
+    Texture** tex = (Texture**)luaL_checkudata(L, arg + 4, TEXTURE_METATABLE);
+    int layers = 1, margin = 0, spacing = 0;
+
+    if (lua_istable(L, arg + 5)) {
+        lua_getfield(L, arg + 5, "layers");
+        layers = (int)luaL_optinteger(L, -1, 1);
+        lua_getfield(L, arg + 5, "margin");
+        margin = (int)luaL_optinteger(L, -1, 0);
+        lua_getfield(L, arg + 5, "spacing");
+        spacing = (int)luaL_optinteger(L, -1, 0);
+        lua_pop(L, 3);
+    }
+
+    Tilemap* map = *tex ? tilemap_create(width, height, tile_w, tile_h, *tex, margin, spacing, layers) : NULL;
+    return push_map(L, map, "Invalid map size or tile size does not fit the texture");
+}
+
+// PudimBasicsGl.tilemap.load_tiled(path, texture?) -> Tilemap | nil, error
+// Without a texture, the tileset image is loaded relative to the map file
+static int l_tilemap_load_tiled(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1)) arg = 2; // allow pb.tilemap:load_tiled(path)
+    const char* path = luaL_checkstring(L, arg);
+    Texture* texture = NULL;
+    if (!lua_isnoneornil(L, arg + 1)) {
+        texture = *(Texture**)luaL_checkudata(L, arg + 1, TEXTURE_METATABLE);
+    }
+
+    // Lazy init texture renderer (needs OpenGL context)
+    texture_renderer_init();
+
+    char err[256];
+    Tilemap* map = tilemap_load_tiled(path, texture, err, sizeof(err));
+    return push_map(L, map, err);
+}
+
+// PudimBasicsGl.tilemap.load_csv(path, texture, tile_w, tile_h, options?) -> Tilemap | nil, error
+// options: { one_based = false }
+static int l_tilemap_load_csv(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1)) arg = 2; // allow pb.tilemap:load_csv(...)
+    const char* path = luaL_checkstring(L, arg);
+    Texture** tex = (Texture**)luaL_checkudata(L, arg + 1, TEXTURE_METATABLE);
+    int tile_w = (int)luaL_checkinteger(L, arg + 2);
+    int tile_h = (int)luaL_checkinteger(L, arg + 3);
+    int one_based = 0;
+    if (lua_istable(L, arg + 4)) {
+        lua_getfield(L, arg + 4, "one_based");
+        one_based = lua_toboolean(L, -1);
+        lua_pop(L, 1);
+    }
+    if (!*tex) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Texture has been destroyed");
+        return 2;
+    }
+
+    char err[256];
+    Tilemap* map = tilemap_load_csv(path, *tex, tile_w, tile_h, one_based, err, sizeof(err));
+    return push_map(L, map, err);
+}
+
+// --- Tilemap methods ---
+
+// map:set(layer, x, y, tile)  -- tile 0 clears the cell
+static int l_map_set(lua_State* L) {
+    Tilemap* map = check_map(L, 1);
+    int layer = check_layer(L, map, 2);
+    int x = (int)luaL_checkinteger(L, 3);
+    int y = (int)luaL_checkinteger(L, 4);
+    tilemap_set(map, layer, x, y, check_tile(L, map, 5));
+    return 0;
+}
+
+// map:get(layer, x, y) -> tile
+static int l_map_get(lua_State* L) {
+    Tilemap* map = check_map(L, 1);
+    int layer = check_layer(L, map, 2);
+    int x = (int)luaL_checkinteger(L, 3);
+    int y = (int)luaL_checkinteger(L, 4);
+    lua_pushinteger(L, tilemap_get(map, layer, x, y));
+    return 1;
+}
+
+// map:fill(layer, x, y, w, h, tile)
+static int l_map_fill(lua_State* L) {
+    Tilemap* map = check_map(L, 1);
+    int layer = check_layer(L, map, 2);
+    int x = (int)luaL_checkinteger(L, 3);
+    int y = (int)luaL_checkinteger(L, 4);
+    int w = (int)luaL_checkinteger(L, 5);
+    int h = (int)luaL_checkinteger(L, 6);
+    tilemap_fill(map, layer, x, y, w, h, check_tile(L, map, 7));
+    return 0;
+}
+
+// map:add_layer(name?) -> layer
+static int l_map_add_layer(lua_State* L) {
+    Tilemap* map = check_map(L, 1);
+    int layer = tilemap_add_layer(map, luaL_optstring(L, 2, NULL));
+    if (layer < 0) {
+        lua_pushnil(L);
+        lua_pushstring(L, "Failed to allocate layer");
+        return 2;
+    }
+    lua_pushinteger(L, layer + 1);
+    return 1;
+}
+
+// map:find_layer(name) -> layer | nil
+static int l_map_find_layer(lua_State* L) {
+    Tilemap* map = check_map(L, 1);
+    int layer = tilemap_find_layer(map, luaL_checkstring(L, 2));
+    if (layer < 0) {
+        lua_pushnil(L);
+    } else {
+        lua_pushinteger(L, layer + 1);
+    }
+    return 1;
+}
+
+// map:get_layer_count() -> count
+static int l_map_get_layer_count(lua_State* L) {
+    lua_pushinteger(L, check_map(L, 1)->layer_count);
+    return 1;
+}
+
+// map:set_layer_visible(layer, visible)
+static int l_map_set_layer_visible(lua_State* L) {
+    Tilemap* map = check_map(L, 1);
+    map->layers[check_layer(L, map, 2)].visible = lua_toboolean(L, 3);
+    return 0;
+}
+
+// map:set_layer_opacity(layer, opacity)
+static int l_map_set_layer_opacity(lua_State* L) {
+    Tilemap* map = check_map(L, 1);
+    int layer = check_layer(L, map, 2);
+    float opacity = (float)luaL_checknumber(L, 3);
+    map->layers[layer].opacity = opacity < 0.0f ? 0.0f : (opacity > 1.0f ? 1.0f : opacity);
+    return 0;
+}
+
+// map:set_animation(tile, frames, duration) -> true | false, error
+// duration: seconds per frame, or a list with one duration per frame
+static int l_map_set_animation(lua_State* L) {
+    Tilemap* map = check_map(L, 1);
+    uint16_t tile = check_tile(L, map, 2);
+    luaL_checktype(L, 3, LUA_TTABLE);
+
+    int count = (int)lua_rawlen(L, 3);
+    if (count == 0 || count > TILEMAP_MAX_ANIM_FRAMES) {
+        lua_pushboolean(L, 0);
+        lua_pushfstring(L, "Animation needs 1 to %d frames", TILEMAP_MAX_ANIM_FRAMES);
+        return 2;
+    }
+
+    uint16_t frames[TILEMAP_MAX_ANIM_FRAMES];
+    float durations[TILEMAP_MAX_ANIM_FRAMES];
+    float duration = lua_istable(L, 4) ? 0.1f : (float)luaL_optnumber(L, 4, 0.1);
+    for (int i = 0; i < count; i++) {
+        lua_rawgeti(L, 3, i + 1);
+        frames[i] = check_tile(L, map, -1);
+        lua_pop(L, 1);
+        durations[i] = duration;
+        if (lua_istable(L, 4)) {
+            lua_rawgeti(L, 4, i + 1);
+            durations[i] = (float)luaL_optnumber(L, -1, 0.1);
+            lua_pop(L, 1);
+        }
+    }
+
+    if (!tilemap_set_animation(map, tile, frames, durations, count)) {
+        lua_pushboolean(L, 0);
+        lua_pushstring(L, "Invalid animation or too many animated tiles");
+        return 2;
+    }
+    lua_pushboolean(L, 1);
+    return 1;
+}
+
+// map:draw(x?, y?, layer?) -> chunks_drawn
+// Draws every visible layer unless a layer is given
+static int l_map_draw(lua_State* L) {
+    Tilemap* map = check_map(L, 1);
+    float x = (float)luaL_optnumber(L, 2, 0.0);
+    float y = (float)luaL_optnumber(L, 3, 0.0);
+    int layer = lua_isnoneornil(L, 4) ? -1 : check_layer(L, map, 4);
+
+    // Lazy init texture renderer (needs OpenGL context)
+    texture_renderer_init();
+
+    lua_pushinteger(L, tilemap_draw(map, layer, x, y, glfwGetTime()));
+    return 1;
+}
+
+// map:get_size() -> width, height (in tiles)
+static int l_map_get_size(lua_State* L) {
+    Tilemap* map = check_map(L, 1);
+    lua_pushinteger(L, map->width);
+    lua_pushinteger(L, map->height);
+    return 2;
+}
+
+// map:get_tile_size() -> tile_w, tile_h
+static int l_map_get_tile_size(lua_State* L) {
+    Tilemap* map = check_map(L, 1);
+    lua_pushinteger(L, map->tile_width);
+    lua_pushinteger(L, map->tile_height);
+    return 2;
+}
+
+// map:world_to_tile(wx, wy, map_x?, map_y?) -> tx, ty
+static int l_map_world_to_tile(lua_State* L) {
+    Tilemap* map = check_map(L, 1);
+    double wx = luaL_checknumber(L, 2) - luaL_optnumber(L, 4, 0.0);
+    double wy = luaL_checknumber(L, 3) - luaL_optnumber(L, 5, 0.0);
+    lua_pushinteger(L, (lua_Integer)floor(wx / map->tile_width));
+    lua_pushinteger(L, (lua_Integer)floor(wy / map->tile_height));
+    return 2;
+}
+
+// map:stats() -> { chunks_drawn, chunk_rebuilds, chunks, animations }
+static int l_map_stats(lua_State* L) {
+    Tilemap* map = check_map(L, 1);
+    lua_createtable(L, 0, 4);
+    lua_pushinteger(L, map->chunks_drawn);
+    lua_setfield(L, -2, "chunks_drawn");
+    lua_pushinteger(L, map->chunk_rebuilds);
+    lua_setfield(L, -2, "chunk_rebuilds");
+    lua_pushinteger(L, map->chunks_x * map->chunks_y * map->layer_count);
+    lua_setfield(L, -2, "chunks");
+    lua_pushinteger(L, map->animation_count);
+    lua_setfield(L, -2, "animations");
+    return 1;
+}
+
+// map:destroy()
+static int l_map_destroy(lua_State* L) {
+    Tilemap** map = (Tilemap**)luaL_checkudata(L, 1, TILEMAP_METATABLE);
+    if (*map) {
+        tilemap_destroy(*map);
+        *map = NULL;
+    }
+    return 0;
+}
+
+static const luaL_Reg map_methods[] = {
+    {"set", l_map_set},
+    {"get", l_map_get},
+    {"fill", l_map_fill},
+    {"add_layer", l_map_add_layer},
+    {"find_layer", l_map_find_layer},
+    {"get_layer_count", l_map_get_layer_count},
+    {"set_layer_visible", l_map_set_layer_visible},
+    {"set_layer_opacity", l_map_set_layer_opacity},
+    {"set_animation", l_map_set_animation},
+    {"draw", l_map_draw},
+    {"get_size", l_map_get_size},
+    {"get_tile_size", l_map_get_tile_size},
+    {"world_to_tile", l_map_world_to_tile},
+    {"stats", l_map_stats},
+    {"destroy", l_map_destroy},
+    {NULL, NULL}
+};
+
+static const luaL_Reg tilemap_functions[] = {
+    {"new", l_tilemap_new},
+    {"load_tiled", l_tilemap_load_tiled},
+    {"load_csv", l_tilemap_load_csv},
+    {NULL, NULL}
+};
+
+void lua_register_tilemap_api(lua_State* L) {
+    luaL_newmetatable(L, TILEMAP_METATABLE);
+
+    lua_pushstring(L, "__index");
+    lua_pushvalue(L, -2);
+    lua_settable(L, -3);
+
+    lua_pushstring(L, "__gc");
+    lua_pushcfunction(L, l_map_destroy);
+    lua_settable(L, -3);
+
+    luaL_setfuncs(L, map_methods, 0);
+    lua_pop(L, 1);
+
+    // Create PudimBasicsGl.tilemap table
+    lua_getglobal(L, "PudimBasicsGl");
+    lua_newtable(L);
+    luaL_setfuncs(L, tilemap_functions, 0);
+    lua_setfield(L, -2, "tilemap");
+    lua_pop(L, 1);
+}
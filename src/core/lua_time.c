@@ -18,6 +18,11 @@ static void ensure_time_init(void) {
     }
 }
 
+// Frame delta for C modules that animate themselves (see lua_sprite.c)
+double time_get_delta(void) {
+    return g_delta_time;
+}
+
 // pudim.time.get() -> number (total time since start)
 // Accept optional self when called as pb.time:get()
 static int l_time_get(lua_State* L) {
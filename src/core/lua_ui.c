@@ -5,7 +5,10 @@
 #include <lauxlib.h>
 #include <lualib.h>
 
+#include <string.h>
+
 #include "../render/ui.h"
+#include "../render/ui_state.h"
 #include "../render/text.h"
 
 #define FONT_METATABLE "PudimBasicsGl.Font"
@@ -106,6 +109,279 @@ static int l_ui_slider(lua_State* L) {
     return 1;
 }
 
+// --- Lists and tables ---
+
+#define UI_MAX_COLUMNS 32
+
+// Stack slots of one pb.ui.list / pb.ui.table call, read by the row callbacks
+typedef struct {
+    lua_State* L;
+    int rows;               // table of rows, 0 = row count only
+    int height;             // row_height function, 0 = fixed height
+    int draw;               // draw callback, 0 = draw text
+    int text;               // text callback, 0 = read the rows table
+    int cell_text;          // keeps the cell text being drawn alive
+    int table;              // rows are tables of cells
+    int error;              // first error raised by a callback
+    int failed;             // skip further callbacks once one failed
+} LuaListRows;
+
+// Call the function below `nargs` arguments in protected mode. An error is
+// kept and raised once the widget has returned, since unwinding through it
+// would skip its cleanup.
+static int call_row_callback(LuaListRows* rows, int nargs, int nresults) {
+    lua_State* L = rows->L;
+    if (lua_pcall(L, nargs, nresults, 0) == LUA_OK) return 1;
+    lua_replace(L, rows->error);
+    rows->failed = 1;
+    return 0;
+}
+
+static float lua_row_height(int row, void* user_data) {
+    LuaListRows* rows = (LuaListRows*)user_data;
+    lua_State* L = rows->L;
+    if (rows->failed) return 0.0f;
+    lua_pushvalue(L, rows->height);
+    lua_pushinteger(L, row + 1);
+    if (!call_row_callback(rows, 1, 1)) return 0.0f;
+    float height = (float)lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    return height;
+}
+
+static const char* lua_cell_text(int row, int column, void* user_data) {
+    LuaListRows* rows = (LuaListRows*)user_data;
+    lua_State* L = rows->L;
+    if (rows->failed) return NULL;
+    if (rows->text) {
+        lua_pushvalue(L, rows->text);
+        lua_pushinteger(L, row + 1);
+        lua_pushinteger(L, column + 1);
+        if (!call_row_callback(rows, 2, 1)) return NULL;
+    } else if (rows->rows) {
+        // Raw reads, like the row count: no metamethod can raise here
+        lua_rawgeti(L, rows->rows, row + 1);
+        if (rows->table) {
+            if (lua_istable(L, -1)) lua_rawgeti(L, -1, column + 1);
+            else lua_pushnil(L);
+            lua_remove(L, -2);
+        }
+    } else {
+        return NULL;
+    }
+
+    if (!lua_isstring(L, -1)) {
+        lua_pop(L, 1);
+        return NULL;
+    }
+    lua_replace(L, rows->cell_text);
+    return lua_tostring(L, rows->cell_text);
+}
+
+static void lua_draw_cell(int row, int column, float x, float y, float w, float h, int selected,
+                          void* user_data) {
+    LuaListRows* rows = (LuaListRows*)user_data;
+    lua_State* L = rows->L;
+    if (rows->failed) return;
+    int nargs = 6;
+    lua_pushvalue(L, rows->draw);
+    lua_pushinteger(L, row + 1);
+    if (rows->table) {
+        lua_pushinteger(L, column + 1);
+        nargs++;
+    }
+    lua_pushnumber(L, (double)x);
+    lua_pushnumber(L, (double)y);
+    lua_pushnumber(L, (double)w);
+    lua_pushnumber(L, (double)h);
+    lua_pushboolean(L, selected);
+    call_row_callback(rows, nargs, 0);
+}
+
+// Fill `desc` from the rows argument (table or count) and the options table
+static void check_list_rows(lua_State* L, int rows_arg, int opts_arg, int table, LuaListRows* rows,
+                            UiListDesc* desc) {
+    memset(rows, 0, sizeof(*rows));
+    memset(desc, 0, sizeof(*desc));
+    rows->L = L;
+    rows->table = table;
+    desc->user_data = rows;
+
+    if (lua_istable(L, rows_arg)) {
+        rows->rows = lua_absindex(L, rows_arg);
+        desc->row_count = (int)lua_rawlen(L, rows_arg);
+        desc->text_fn = lua_cell_text;
+    } else {
+        lua_Integer count = luaL_checkinteger(L, rows_arg);
+        luaL_argcheck(L, count >= 0 && count <= 0x7FFFFFFF, rows_arg, "row count out of range");
+        desc->row_count = (int)count;
+    }
+
+    lua_pushnil(L);
+    rows->cell_text = lua_gettop(L);
+    lua_pushnil(L);
+    rows->error = lua_gettop(L);
+
+    if (lua_isnoneornil(L, opts_arg)) return;
+    luaL_checktype(L, opts_arg, LUA_TTABLE);
+
+    if (lua_getfield(L, opts_arg, "row_height") == LUA_TFUNCTION) {
+        rows->height = lua_gettop(L);
+        desc->height_fn = lua_row_height;
+    } else {
+        desc->row_height = (float)luaL_optnumber(L, -1, 0.0);
+        lua_pop(L, 1);
+    }
+
+    lua_getfield(L, opts_arg, "revision");
+    desc->revision = (unsigned int)luaL_optinteger(L, -1, 0);
+    lua_pop(L, 1);
+
+    if (lua_getfield(L, opts_arg, "text") == LUA_TFUNCTION) {
+        rows->text = lua_gettop(L);
+        desc->text_fn = lua_cell_text;
+    } else {
+        lua_pop(L, 1);
+    }
+
+    if (lua_getfield(L, opts_arg, "draw") == LUA_TFUNCTION) {
+        rows->draw = lua_gettop(L);
+        desc->draw_fn = lua_draw_cell;
+    } else {
+        lua_pop(L, 1);
+    }
+}
+
+// Rows are 1-based in Lua; `last` is inclusive. Raises the error of a
+// failed callback instead.
+static int push_list_result(lua_State* L, const char* id, const LuaListRows* rows,
+                            const UiListResult* result) {
+    if (rows->failed) {
+        if (rows->height) ui_list_remeasure(id);  // heights after the error were not measured
+        lua_pushvalue(L, rows->error);
+        return lua_error(L);
+    }
+    if (result->selected >= 0) lua_pushinteger(L, result->selected + 1);
+    else lua_pushnil(L);
+    if (result->clicked >= 0) lua_pushinteger(L, result->clicked + 1);
+    else lua_pushnil(L);
+    lua_pushinteger(L, result->first + 1);
+    lua_pushinteger(L, result->last);
+    return 4;
+}
+
+// pudim.ui.list(id, x, y, w, h, rows, options?) -> selected, clicked, first, last
+static int l_ui_list(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1)) arg = 2;
+    const char* id = luaL_checkstring(L, arg);
+    float x = (float)luaL_checknumber(L, arg + 1);
+    float y = (float)luaL_checknumber(L, arg + 2);
+    float w = (float)luaL_checknumber(L, arg + 3);
+    float h = (float)luaL_checknumber(L, arg + 4);
+
+    LuaListRows rows;
+    UiListDesc desc;
+    check_list_rows(L, arg + 5, arg + 6, 0, &rows, &desc);
+
+    UiListResult result = {-1, -1, 0, 0, 0.0f};  // left as is when out of memory
+    ui_list(id, x, y, w, h, &desc, &result);
+    return push_list_result(L, id, &rows, &result);
+}
+
+// pudim.ui.table(id, x, y, w, h, columns, rows, options?) -> selected, clicked, first, last
+static int l_ui_table(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1)) arg = 2;
+    const char* id = luaL_checkstring(L, arg);
+    float x = (float)luaL_checknumber(L, arg + 1);
+    float y = (float)luaL_checknumber(L, arg + 2);
+    float w = (float)luaL_checknumber(L, arg + 3);
+    float h = (float)luaL_checknumber(L, arg + 4);
+
+    // Columns: titles, or { title = "Name", width = 120 } tables. Each title
+    // stays on the stack: lua_tostring converts numbers into a new string.
+    luaL_checktype(L, arg + 5, LUA_TTABLE);
+    UiColumn columns[UI_MAX_COLUMNS];
+    int column_count = (int)lua_rawlen(L, arg + 5);
+    luaL_argcheck(L, column_count >= 1 && column_count <= UI_MAX_COLUMNS, arg + 5,
+                  "expected 1 to 32 columns");
+    luaL_checkstack(L, column_count + 2, "too many columns");
+    for (int c = 0; c < column_count; c++) {
+        columns[c].width = 0.0f;
+        if (lua_geti(L, arg + 5, c + 1) == LUA_TTABLE) {
+            lua_getfield(L, -1, "title");
+            lua_getfield(L, -2, "width");
+            columns[c].width = (float)luaL_optnumber(L, -1, 0.0);
+            lua_pop(L, 1);
+            lua_remove(L, -2);
+        }
+        columns[c].title = lua_tostring(L, -1);
+    }
+
+    LuaListRows rows;
+    UiListDesc desc;
+    check_list_rows(L, arg + 6, arg + 7, 1, &rows, &desc);
+
+    UiListResult result = {-1, -1, 0, 0, 0.0f};  // left as is when out of memory
+    ui_table(id, x, y, w, h, columns, column_count, &desc, &result);
+    return push_list_result(L, id, &rows, &result);
+}
+
+// pudim.ui.stats() -> table
+static int l_ui_stats(lua_State* L) {
+    UiStats stats;
+    ui_get_stats(&stats);
+
+    lua_newtable(L);
+    lua_pushinteger(L, stats.draw_calls); lua_setfield(L, -2, "draw_calls");
+    lua_pushinteger(L, stats.vertices);   lua_setfield(L, -2, "vertices");
+    lua_pushinteger(L, stats.rows);       lua_setfield(L, -2, "rows");
+
+    UiStateStats state;
+    ui_state_get_stats(&state);
+    lua_pushinteger(L, state.widgets);    lua_setfield(L, -2, "widgets");
+    lua_pushinteger(L, state.collected);  lua_setfield(L, -2, "collected");
+    lua_pushinteger(L, state.collisions); lua_setfield(L, -2, "collisions");
+    return 1;
+}
+
+// Widget state slot index, 1-based in Lua
+static int check_state_index(lua_State* L, int arg) {
+    lua_Integer i = luaL_optinteger(L, arg, 1);
+    luaL_argcheck(L, i >= 1 && i <= UI_STATE_VALUES, arg, "state index out of range (1-8)");
+    return (int)i - 1;
+}
+
+// pudim.ui.get_state(id, index?) -> number, created
+static int l_ui_get_state(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1)) arg = 2;
+    const char* id = luaL_checkstring(L, arg);
+    int index = check_state_index(L, arg + 1);
+
+    int created = 0;
+    UiState* state = ui_state_get(id, &created);
+    if (!state) return luaL_error(L, "Out of memory for UI state");
+    lua_pushnumber(L, (double)state->values[index]);
+    lua_pushboolean(L, created);
+    return 2;
+}
+
+// pudim.ui.set_state(id, index, value)
+static int l_ui_set_state(lua_State* L) {
+    int arg = 1;
+    if (lua_istable(L, 1)) arg = 2;
+    const char* id = luaL_checkstring(L, arg);
+    int index = check_state_index(L, arg + 1);
+    float value = (float)luaL_checknumber(L, arg + 2);
+
+    UiState* state = ui_state_get(id, NULL);
+    if (!state) return luaL_error(L, "Out of memory for UI state");
+    state->values[index] = value;
+    return 0;
+}
+
 static const luaL_Reg ui_funcs[] = {
     {"set_font",    l_ui_set_font},
     {"begin_frame", l_ui_begin_frame},
@@ -114,6 +390,11 @@ static const luaL_Reg ui_funcs[] = {
     {"panel",       l_ui_panel},
     {"button",      l_ui_button},
     {"slider",      l_ui_slider},
+    {"list",        l_ui_list},
+    {"table",       l_ui_table},
+    {"stats",       l_ui_stats},
+    {"get_state",   l_ui_get_state},
+    {"set_state",   l_ui_set_state},
     {NULL, NULL}
 };
 
@@ -37,6 +37,9 @@ extern void lua_register_shader_api(lua_State* L);
 extern void lua_register_studio_api(lua_State* L);
 extern void lua_register_ui_api(lua_State* L);
 extern void lua_register_math_api(lua_State* L);
+extern void lua_register_sprite_api(lua_State* L);
+extern void lua_register_tilemap_api(lua_State* L);
+extern void lua_register_particles_api(lua_State* L);
 
 // Module entry point - called when require("PudimBasicsGl") is used
 int luaopen_PudimBasicsGl(lua_State* L) {
@@ -60,6 +63,9 @@ int luaopen_PudimBasicsGl(lua_State* L) {
     lua_register_studio_api(L);
     lua_register_ui_api(L);
     lua_register_math_api(L);
+    lua_register_sprite_api(L);
+    lua_register_tilemap_api(L);
+    lua_register_particles_api(L);
     
     // Return the PudimBasicsGl table
     return 1;
@@ -0,0 +1,201 @@
+#define _XOPEN_SOURCE 700
+#include "filemap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <direct.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <limits.h>
+#endif
+
+int filemap_open(const char* filepath, FileMap* map) {
+    memset(map, 0, sizeof(*map));
+    if (!filepath) return 0;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return 0;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+        CloseHandle(file);
+        return 0;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        CloseHandle(file);
+        return 0;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return 0;
+    }
+
+    map->data = (const unsigned char*)data;
+    map->size = (size_t)size.QuadPart;
+    map->file_handle = file;
+    map->mapping_handle = mapping;
+    return 1;
+#else
+    int fd = open(filepath, O_RDONLY);
+    if (fd < 0) return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return 0;
+    }
+
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // the mapping keeps its own reference to the file
+    if (data == MAP_FAILED) return 0;
+
+    map->data = (const unsigned char*)data;
+    map->size = (size_t)st.st_size;
+    return 1;
+#endif
+}
+
+void filemap_close(FileMap* map) {
+    if (!map || !map->data) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile((LPCVOID)map->data);
+    CloseHandle((HANDLE)map->mapping_handle);
+    CloseHandle((HANDLE)map->file_handle);
+#else
+    munmap((void*)map->data, map->size);
+#endif
+    memset(map, 0, sizeof(*map));
+}
+
+int file_get_info(const char* filepath, int64_t* mtime, int64_t* size) {
+#ifdef _WIN32
+    struct __stat64 st;
+    if (_stat64(filepath, &st) != 0) return 0;
+#else
+    struct stat st;
+    if (stat(filepath, &st) != 0) return 0;
+#endif
+    if (mtime) *mtime = (int64_t)st.st_mtime;
+    if (size) *size = (int64_t)st.st_size;
+    return 1;
+}
+
+int file_canonical_path(const char* filepath, char* out, size_t out_size) {
+    if (!filepath || !out || out_size == 0) return 0;
+
+#ifdef _WIN32
+    if (_fullpath(out, filepath, out_size)) {
+        // Windows paths are case-insensitive: normalize so keys compare equal
+        for (char* p = out; *p; p++) {
+            if (*p == '\\') *p = '/';
+            else if (*p >= 'A' && *p <= 'Z') *p = (char)(*p - 'A' + 'a');
+        }
+        return 1;
+    }
+#else
+    char resolved[PATH_MAX];
+    if (realpath(filepath, resolved) && strlen(resolved) < out_size) {
+        strcpy(out, resolved);
+        return 1;
+    }
+#endif
+
+    snprintf(out, out_size, "%s", filepath);
+    return 0;
+}
+
+void file_resolve_relative(const char* base_file, const char* relative, char* out, size_t out_size) {
+    const char* slash = strrchr(base_file, '/');
+    const char* backslash = strrchr(base_file, '\\');
+    if (backslash && (!slash || backslash > slash)) slash = backslash;
+
+    int absolute = relative[0] == '/' || relative[0] == '\\' ||
+                   (relative[0] && relative[1] == ':');  // Windows drive letter
+    if (slash && !absolute) {
+        snprintf(out, out_size, "%.*s/%s", (int)(slash - base_file), base_file, relative);
+    } else {
+        snprintf(out, out_size, "%s", relative);
+    }
+}
+
+static int make_dir(const char* path) {
+#ifdef _WIN32
+    return _mkdir(path) == 0;
+#else
+    return mkdir(path, 0755) == 0;
+#endif
+}
+
+int file_make_dirs(const char* dirpath) {
+    if (!dirpath || !*dirpath) return 0;
+
+    char buf[1024];
+    size_t len = strlen(dirpath);
+    if (len >= sizeof(buf)) return 0;
+    memcpy(buf, dirpath, len + 1);
+
+    // Create each missing parent in turn
+    for (size_t i = 1; i < len; i++) {
+        if (buf[i] == '/' || buf[i] == '\\') {
+            char saved = buf[i];
+            buf[i] = '\0';
+            make_dir(buf);
+            buf[i] = saved;
+        }
+    }
+    make_dir(buf);
+
+    struct stat st;
+    return stat(buf, &st) == 0 && (st.st_mode & S_IFMT) == S_IFDIR;
+}
+
+int file_write_atomic(const char* filepath, const void* const* chunks, const size_t* sizes, int count) {
+    char tmp_path[1100];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", filepath);
+
+    FILE* f = fopen(tmp_path, "wb");
+    if (!f) return 0;
+
+    int ok = 1;
+    for (int i = 0; i < count && ok; i++) {
+        if (sizes[i] > 0 && fwrite(chunks[i], 1, sizes[i], f) != sizes[i]) {
+            ok = 0;
+        }
+    }
+    if (fclose(f) != 0) ok = 0;
+
+    if (ok) {
+#ifdef _WIN32
+        ok = MoveFileExA(tmp_path, filepath, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        ok = rename(tmp_path, filepath) == 0;
+#endif
+    }
+    if (!ok) remove(tmp_path);
+    return ok;
+}
+
+uint64_t fnv1a64(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* p = (const unsigned char*)data;
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
@@ -0,0 +1,44 @@
+#ifndef FILEMAP_H
+#define FILEMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Read-only memory mapping of a whole file
+typedef struct {
+    const unsigned char* data;
+    size_t size;
+#ifdef _WIN32
+    void* file_handle;
+    void* mapping_handle;
+#endif
+} FileMap;
+
+// Map a file read-only. Returns 1 on success, 0 on failure (map is zeroed).
+int filemap_open(const char* filepath, FileMap* map);
+
+// Unmap a file previously opened with filemap_open
+void filemap_close(FileMap* map);
+
+// Query modification time (seconds) and size of a file. Returns 1 on success.
+int file_get_info(const char* filepath, int64_t* mtime, int64_t* size);
+
+// Resolve a path to an absolute, normalized form. Falls back to a copy of the
+// input when the path cannot be resolved. Returns 1 on success.
+int file_canonical_path(const char* filepath, char* out, size_t out_size);
+
+// Resolve `relative` against the directory containing `base_file` (asset
+// files referencing images next to them). Absolute paths are copied as-is.
+void file_resolve_relative(const char* base_file, const char* relative, char* out, size_t out_size);
+
+// Create a directory (and missing parents). Returns 1 if it exists afterwards.
+int file_make_dirs(const char* dirpath);
+
+// Write a file atomically (temp file + rename) from a list of memory chunks
+int file_write_atomic(const char* filepath, const void* const* chunks, const size_t* sizes, int count);
+
+// 64-bit FNV-1a hash, chainable through `seed` (use FNV64_SEED to start)
+#define FNV64_SEED 14695981039346656037ULL
+uint64_t fnv1a64(const void* data, size_t size, uint64_t seed);
+
+#endif // FILEMAP_H
@@ -0,0 +1,66 @@
+#include "thread.h"
+#include <stdlib.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+struct PlatformThread {
+    void (*fn)(void* arg);
+    void* arg;
+#ifdef _WIN32
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+};
+
+#ifdef _WIN32
+static DWORD WINAPI thread_main(LPVOID param) {
+    PlatformThread* thread = (PlatformThread*)param;
+    thread->fn(thread->arg);
+    return 0;
+}
+#else
+static void* thread_main(void* param) {
+    PlatformThread* thread = (PlatformThread*)param;
+    thread->fn(thread->arg);
+    return NULL;
+}
+#endif
+
+PlatformThread* thread_start(void (*fn)(void* arg), void* arg) {
+    PlatformThread* thread = (PlatformThread*)calloc(1, sizeof(PlatformThread));
+    if (!thread) return NULL;
+    thread->fn = fn;
+    thread->arg = arg;
+
+#ifdef _WIN32
+    thread->handle = CreateThread(NULL, 0, thread_main, thread, 0, NULL);
+    if (!thread->handle) {
+        free(thread);
+        return NULL;
+    }
+#else
+    if (pthread_create(&thread->handle, NULL, thread_main, thread) != 0) {
+        free(thread);
+        return NULL;
+    }
+#endif
+    return thread;
+}
+
+void thread_join(PlatformThread* thread) {
+    if (!thread) return;
+
+#ifdef _WIN32
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+#else
+    pthread_join(thread->handle, NULL);
+#endif
+    free(thread);
+}
@@ -0,0 +1,13 @@
+#ifndef THREAD_H
+#define THREAD_H
+
+// Minimal worker threads: pthreads, or Win32 threads on Windows
+typedef struct PlatformThread PlatformThread;
+
+// Run fn(arg) on a new thread. Returns NULL on failure.
+PlatformThread* thread_start(void (*fn)(void* arg), void* arg);
+
+// Wait for the thread to finish and free it
+void thread_join(PlatformThread* thread);
+
+#endif // THREAD_H
@@ -44,6 +44,14 @@ static void framebuffer_size_callback(GLFWwindow* glfw_window, int width, int he
     }
 }
 
+static void scroll_callback(GLFWwindow* glfw_window, double dx, double dy) {
+    Window* window = (Window*)glfwGetWindowUserPointer(glfw_window);
+    if (window) {
+        window->scroll_x += dx;
+        window->scroll_y += dy;
+    }
+}
+
 static void error_callback(int error, const char* description) {
     fprintf(stderr, "GLFW Error %d: %s\n", error, description);
 }
@@ -96,12 +104,15 @@ Window* window_create(int width, int height, const char* title) {
     window->windowed_h = height;
     window->resize_callback = NULL;
     window->resize_user_data = NULL;
+    window->scroll_x = 0.0;
+    window->scroll_y = 0.0;
     
     // Store window pointer for callbacks
     glfwSetWindowUserPointer(window->handle, window);
     
     glfwMakeContextCurrent(window->handle);
     glfwSetFramebufferSizeCallback(window->handle, framebuffer_size_callback);
+    glfwSetScrollCallback(window->handle, scroll_callback);
     
     // Load OpenGL function pointers with GLAD
     if (!gladLoaderLoadGL()) {
@@ -241,3 +252,10 @@ int window_is_focused(Window* window) {
 void window_set_resizable(Window* window, int resizable) {
     glfwSetWindowAttrib(window->handle, GLFW_RESIZABLE, resizable ? GLFW_TRUE : GLFW_FALSE);
 }
+
+void window_take_scroll(Window* window, double* dx, double* dy) {
+    *dx = window->scroll_x;
+    *dy = window->scroll_y;
+    window->scroll_x = 0.0;
+    window->scroll_y = 0.0;
+}
@@ -17,6 +17,7 @@ typedef struct {
     int windowed_w, windowed_h;    // Size before fullscreen
     WindowResizeCallback resize_callback;
     void* resize_user_data;
+    double scroll_x, scroll_y;     // Wheel offset since the last window_take_scroll
 } Window;
 
 Window* window_create(int width, int height, const char* title);
@@ -41,4 +42,7 @@ void window_focus(Window* window);
 int window_is_focused(Window* window);
 void window_set_resizable(Window* window, int resizable);
 
+// Return and reset the wheel offset accumulated by poll_events
+void window_take_scroll(Window* window, double* dx, double* dy);
+
 #endif // WINDOW_H
@@ -0,0 +1,327 @@
+#include "bmfont.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BMFONT_MAX_CHARS    (1 << 20)
+#define BMFONT_MAX_KERNINGS (1 << 20)
+#define BMFONT_MAX_ATTRS    32
+
+// --- Shared ---
+
+static int add_char(BmFontDesc* desc, int* capacity, const BmFontChar* c) {
+    if (desc->char_count >= BMFONT_MAX_CHARS) return 0;
+    if (desc->char_count == *capacity) {
+        int grown = *capacity ? *capacity * 2 : 128;
+        BmFontChar* chars = (BmFontChar*)realloc(desc->chars, (size_t)grown * sizeof(BmFontChar));
+        if (!chars) return 0;
+        desc->chars = chars;
+        *capacity = grown;
+    }
+    desc->chars[desc->char_count++] = *c;
+    return 1;
+}
+
+static int add_kerning(BmFontDesc* desc, int* capacity, const BmFontKerning* k) {
+    if (desc->kerning_count >= BMFONT_MAX_KERNINGS) return 0;
+    if (desc->kerning_count == *capacity) {
+        int grown = *capacity ? *capacity * 2 : 64;
+        BmFontKerning* kernings = (BmFontKerning*)realloc(desc->kernings, (size_t)grown * sizeof(BmFontKerning));
+        if (!kernings) return 0;
+        desc->kernings = kernings;
+        *capacity = grown;
+    }
+    desc->kernings[desc->kerning_count++] = *k;
+    return 1;
+}
+
+static int set_page(BmFontDesc* desc, int id, const char* name, size_t len) {
+    if (id < 0 || id >= BMFONT_MAX_PAGES) return 0;
+    char* copy = (char*)malloc(len + 1);
+    if (!copy) return 0;
+    memcpy(copy, name, len);
+    copy[len] = '\0';
+
+    free(desc->pages[id]);
+    desc->pages[id] = copy;
+    if (id >= desc->page_count) desc->page_count = id + 1;
+    return 1;
+}
+
+// --- Text format ---
+
+typedef struct {
+    const char* key;
+    size_t key_len;
+    const char* value;
+    size_t value_len;
+} Attr;
+
+// Split `tag key=value key="quoted value" ...` (one line) into attributes
+static int parse_attrs(const char* p, const char* end, Attr* attrs, int max) {
+    int count = 0;
+    while (p < end && count < max) {
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        const char* key = p;
+        while (p < end && *p != '=' && *p != ' ' && *p != '\t') p++;
+        if (p >= end || *p != '=') continue;  // a bare word (the tag)
+
+        Attr* attr = &attrs[count++];
+        attr->key = key;
+        attr->key_len = (size_t)(p - key);
+        p++;
+        if (p < end && *p == '"') {
+            attr->value = ++p;
+            while (p < end && *p != '"') p++;
+            attr->value_len = (size_t)(p - attr->value);
+            if (p < end) p++;
+        } else {
+            attr->value = p;
+            while (p < end && *p != ' ' && *p != '\t') p++;
+            attr->value_len = (size_t)(p - attr->value);
+        }
+    }
+    return count;
+}
+
+static const Attr* find_attr(const Attr* attrs, int count, const char* key) {
+    size_t len = strlen(key);
+    for (int i = 0; i < count; i++) {
+        if (attrs[i].key_len == len && memcmp(attrs[i].key, key, len) == 0) return &attrs[i];
+    }
+    return NULL;
+}
+
+static long attr_int(const Attr* attrs, int count, const char* key, long fallback) {
+    const Attr* attr = find_attr(attrs, count, key);
+    if (!attr || attr->value_len == 0 || attr->value_len > 15) return fallback;
+
+    char buf[16];
+    memcpy(buf, attr->value, attr->value_len);
+    buf[attr->value_len] = '\0';
+    char* stop;
+    long value = strtol(buf, &stop, 10);
+    return stop == buf ? fallback : value;
+}
+
+static int is_tag(const char* line, const char* end, const char* tag) {
+    size_t len = strlen(tag);
+    return (size_t)(end - line) > len && memcmp(line, tag, len) == 0 &&
+           (line[len] == ' ' || line[len] == '\t');
+}
+
+static int parse_text(const char* p, const char* end, BmFontDesc* desc, char* err, size_t err_size) {
+    int char_capacity = 0, kerning_capacity = 0;
+    int has_common = 0;
+    Attr attrs[BMFONT_MAX_ATTRS];
+
+    while (p < end) {
+        const char* line = p;
+        while (p < end && *p != '\n') p++;
+        const char* line_end = p;
+        if (line_end > line && line_end[-1] == '\r') line_end--;
+        if (p < end) p++;
+
+        while (line < line_end && (*line == ' ' || *line == '\t')) line++;
+        int n = parse_attrs(line, line_end, attrs, BMFONT_MAX_ATTRS);
+
+        if (is_tag(line, line_end, "info")) {
+            desc->size = (int)attr_int(attrs, n, "size", 0);
+        } else if (is_tag(line, line_end, "common")) {
+            has_common = 1;
+            desc->line_height = (int)attr_int(attrs, n, "lineHeight", 0);
+            desc->base = (int)attr_int(attrs, n, "base", 0);
+            desc->scale_w = (int)attr_int(attrs, n, "scaleW", 0);
+            desc->scale_h = (int)attr_int(attrs, n, "scaleH", 0);
+            desc->packed = (int)attr_int(attrs, n, "packed", 0);
+            desc->alpha_chnl = (int)attr_int(attrs, n, "alphaChnl", BMFONT_CHANNEL_GLYPH);
+            desc->red_chnl = (int)attr_int(attrs, n, "redChnl", BMFONT_CHANNEL_GLYPH);
+            desc->green_chnl = (int)attr_int(attrs, n, "greenChnl", BMFONT_CHANNEL_GLYPH);
+            desc->blue_chnl = (int)attr_int(attrs, n, "blueChnl", BMFONT_CHANNEL_GLYPH);
+        } else if (is_tag(line, line_end, "page")) {
+            const Attr* file = find_attr(attrs, n, "file");
+            if (!file || !set_page(desc, (int)attr_int(attrs, n, "id", -1), file->value, file->value_len)) {
+                snprintf(err, err_size, "Invalid BMFont page entry");
+                return 0;
+            }
+        } else if (is_tag(line, line_end, "char")) {
+            BmFontChar c;
+            c.id = (uint32_t)attr_int(attrs, n, "id", 0);
+            c.x = (int)attr_int(attrs, n, "x", 0);
+            c.y = (int)attr_int(attrs, n, "y", 0);
+            c.width = (int)attr_int(attrs, n, "width", 0);
+            c.height = (int)attr_int(attrs, n, "height", 0);
+            c.xoffset = (int)attr_int(attrs, n, "xoffset", 0);
+            c.yoffset = (int)attr_int(attrs, n, "yoffset", 0);
+            c.xadvance = (int)attr_int(attrs, n, "xadvance", 0);
+            c.page = (int)attr_int(attrs, n, "page", 0);
+            c.chnl = (int)attr_int(attrs, n, "chnl", 15);
+            if (!add_char(desc, &char_capacity, &c)) {
+                snprintf(err, err_size, "Too many BMFont characters");
+                return 0;
+            }
+        } else if (is_tag(line, line_end, "kerning")) {
+            BmFontKerning k;
+            k.first = (uint32_t)attr_int(attrs, n, "first", 0);
+            k.second = (uint32_t)attr_int(attrs, n, "second", 0);
+            k.amount = (int)attr_int(attrs, n, "amount", 0);
+            if (!add_kerning(desc, &kerning_capacity, &k)) {
+                snprintf(err, err_size, "Too many BMFont kerning pairs");
+                return 0;
+            }
+        }
+    }
+
+    if (!has_common) {
+        snprintf(err, err_size, "Not a BMFont file (missing common line)");
+        return 0;
+    }
+    return 1;
+}
+
+// --- Binary format ---
+
+static uint32_t read_u32(const unsigned char* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static int read_u16(const unsigned char* p) {
+    return p[0] | p[1] << 8;
+}
+
+static int read_i16(const unsigned char* p) {
+    return (int16_t)(uint16_t)(p[0] | p[1] << 8);
+}
+
+static int parse_binary(const unsigned char* data, size_t size, BmFontDesc* desc, char* err, size_t err_size) {
+    if (data[3] != 3) {
+        snprintf(err, err_size, "Unsupported binary BMFont version %d", data[3]);
+        return 0;
+    }
+
+    int char_capacity = 0, kerning_capacity = 0;
+    int has_common = 0;
+    size_t pos = 4;
+    while (pos + 5 <= size) {
+        int type = data[pos];
+        uint32_t len = read_u32(data + pos + 1);
+        const unsigned char* block = data + pos + 5;
+        pos += 5;
+        if (len > size - pos) {
+            snprintf(err, err_size, "Truncated BMFont block %d", type);
+            return 0;
+        }
+        pos += len;
+
+        switch (type) {
+        case 1:  // info
+            if (len >= 2) desc->size = read_i16(block);
+            break;
+        case 2:  // common
+            if (len < 15) break;
+            has_common = 1;
+            desc->line_height = read_u16(block);
+            desc->base = read_u16(block + 2);
+            desc->scale_w = read_u16(block + 4);
+            desc->scale_h = read_u16(block + 6);
+            desc->packed = (block[10] & 0x80) != 0;
+            desc->alpha_chnl = block[11];
+            desc->red_chnl = block[12];
+            desc->green_chnl = block[13];
+            desc->blue_chnl = block[14];
+            break;
+        case 3: {  // pages: null-terminated names back to back
+            int id = 0;
+            for (uint32_t i = 0; i < len; id++) {
+                const unsigned char* name = block + i;
+                const unsigned char* nul = memchr(name, 0, len - i);
+                size_t name_len = nul ? (size_t)(nul - name) : len - i;
+                if (!set_page(desc, id, (const char*)name, name_len)) {
+                    snprintf(err, err_size, "Invalid BMFont page entry");
+                    return 0;
+                }
+                i += (uint32_t)name_len + 1;
+            }
+            break;
+        }
+        case 4:  // chars: 20 bytes each
+            for (uint32_t i = 0; i + 20 <= len; i += 20) {
+                const unsigned char* r = block + i;
+                BmFontChar c;
+                c.id = read_u32(r);
+                c.x = read_u16(r + 4);
+                c.y = read_u16(r + 6);
+                c.width = read_u16(r + 8);
+                c.height = read_u16(r + 10);
+                c.xoffset = read_i16(r + 12);
+                c.yoffset = read_i16(r + 14);
+                c.xadvance = read_i16(r + 16);
+                c.page = r[18];
+                c.chnl = r[19];
+                if (!add_char(desc, &char_capacity, &c)) {
+                    snprintf(err, err_size, "Too many BMFont characters");
+                    return 0;
+                }
+            }
+            break;
+        case 5:  // kerning pairs: 10 bytes each
+            for (uint32_t i = 0; i + 10 <= len; i += 10) {
+                const unsigned char* r = block + i;
+                BmFontKerning k;
+                k.first = read_u32(r);
+                k.second = read_u32(r + 4);
+                k.amount = read_i16(r + 8);
+                if (!add_kerning(desc, &kerning_capacity, &k)) {
+                    snprintf(err, err_size, "Too many BMFont kerning pairs");
+                    return 0;
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (!has_common) {
+        snprintf(err, err_size, "Not a BMFont file (missing common block)");
+        return 0;
+    }
+    return 1;
+}
+
+// --- Public ---
+
+int bmfont_parse(const unsigned char* data, size_t size, BmFontDesc* out, char* err, size_t err_size) {
+    memset(out, 0, sizeof(*out));
+    if (!data || size == 0) {
+        snprintf(err, err_size, "Empty BMFont file");
+        return 0;
+    }
+
+    int ok = size >= 4 && memcmp(data, "BMF", 3) == 0
+                 ? parse_binary(data, size, out, err, err_size)
+                 : parse_text((const char*)data, (const char*)data + size, out, err, err_size);
+    if (!ok) return 0;
+
+    if (out->line_height <= 0 || out->scale_w <= 0 || out->scale_h <= 0 || out->page_count == 0) {
+        snprintf(err, err_size, "BMFont has no pages or invalid metrics");
+        return 0;
+    }
+    for (int i = 0; i < out->page_count; i++) {
+        if (!out->pages[i]) {
+            snprintf(err, err_size, "BMFont page %d has no file", i);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+void bmfont_free(BmFontDesc* desc) {
+    if (!desc) return;
+    for (int i = 0; i < desc->page_count; i++) {
+        free(desc->pages[i]);
+    }
+    free(desc->chars);
+    free(desc->kernings);
+    memset(desc, 0, sizeof(*desc));
+}
@@ -0,0 +1,56 @@
+#ifndef BMFONT_H
+#define BMFONT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// AngelCode BMFont descriptors (.fnt), text or binary (version 3). Only the
+// fields needed to draw are kept; page images are loaded by the caller.
+
+#define BMFONT_MAX_PAGES 64
+#define BMFONT_INVALID_CHAR 0xFFFFFFFFu  // id -1: drawn for missing characters
+
+// Channel values of the common block (alphaChnl, redChnl, ...)
+#define BMFONT_CHANNEL_GLYPH   0
+#define BMFONT_CHANNEL_OUTLINE 1
+#define BMFONT_CHANNEL_BOTH    2
+#define BMFONT_CHANNEL_ZERO    3
+#define BMFONT_CHANNEL_ONE     4
+
+typedef struct {
+    uint32_t id;            // code point (0xFFFFFFFF = the "invalid char" glyph)
+    int x, y, width, height;
+    int xoffset, yoffset, xadvance;
+    int page;
+    int chnl;               // 1 blue, 2 green, 4 red, 8 alpha, 15 all
+} BmFontChar;
+
+typedef struct {
+    uint32_t first, second;
+    int amount;
+} BmFontKerning;
+
+typedef struct {
+    int size;               // font size it was generated at (negative = cell height)
+    int line_height;
+    int base;               // distance from the top of a line to the baseline
+    int scale_w, scale_h;   // page dimensions
+    int packed;             // glyphs packed in separate channels (see chnl)
+    int alpha_chnl, red_chnl, green_chnl, blue_chnl;
+
+    char* pages[BMFONT_MAX_PAGES];  // page image file names, relative to the .fnt
+    int page_count;
+
+    BmFontChar* chars;
+    int char_count;
+    BmFontKerning* kernings;
+    int kerning_count;
+} BmFontDesc;
+
+// Parse a text or binary descriptor. Returns 1 on success; on failure writes
+// a message to `err`. Free the result with bmfont_free either way.
+int bmfont_parse(const unsigned char* data, size_t size, BmFontDesc* out, char* err, size_t err_size);
+
+void bmfont_free(BmFontDesc* desc);
+
+#endif // BMFONT_H
@@ -0,0 +1,257 @@
+#include "font_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static char g_cache_dir[1024] = {0};
+static int g_cache_enabled = 0;
+static FontCacheStats g_stats = {0};
+
+#define KERNING_BYTES ((size_t)FONT_NUM_CHARS * FONT_NUM_CHARS * sizeof(int16_t))
+
+// --- Helpers ---
+
+// Cache file path: <dir>/<hash of canonical font path + strike settings>.pbfnt
+static void build_cache_path(const char* filepath, float size, int sdf, char* out, size_t out_size) {
+    char canonical[1024];
+    file_canonical_path(filepath, canonical, sizeof(canonical));
+
+    uint32_t settings[4];
+    memcpy(&settings[0], &size, sizeof(float));
+    settings[1] = FONT_OVERSAMPLE;
+    settings[2] = (uint32_t)sdf;
+    settings[3] = FONT_SDF_PADDING;
+
+    uint64_t key = fnv1a64(canonical, strlen(canonical), FNV64_SEED);
+    key = fnv1a64(settings, sizeof(settings), key);
+
+    snprintf(out, out_size, "%s/%016llx.pbfnt", g_cache_dir, (unsigned long long)key);
+}
+
+static uint32_t page_rows(const FontAtlasPage* page) {
+    int rows = page->shelf_y + page->shelf_h;
+    return (uint32_t)(rows < page->height ? rows : page->height);
+}
+
+static int glyph_valid(const FontCacheHeader* header, const FontCacheGlyph* glyph) {
+    if (glyph->page < 0) return 1;
+    if ((uint32_t)glyph->page >= header->page_count) return 0;
+
+    const FontCachePage* page = &header->pages[glyph->page];
+    return glyph->atlas_x >= 0 && glyph->atlas_y >= 0 &&
+           glyph->atlas_w > 0 && glyph->atlas_h > 0 &&
+           (uint32_t)(glyph->atlas_x + glyph->atlas_w) <= header->page_size &&
+           (uint32_t)(glyph->atlas_y + glyph->atlas_h) <= page->rows;
+}
+
+// --- Configuration ---
+
+int font_cache_set_dir(const char* dir) {
+    if (!dir || !*dir) {
+        g_cache_dir[0] = '\0';
+        g_cache_enabled = 0;
+        return 1;
+    }
+
+    if (strlen(dir) >= sizeof(g_cache_dir) - 32) {
+        fprintf(stderr, "[Text] Cache directory path too long: %s\n", dir);
+        return 0;
+    }
+
+    if (!file_make_dirs(dir)) {
+        fprintf(stderr, "[Text] Failed to create cache directory: %s\n", dir);
+        return 0;
+    }
+
+    snprintf(g_cache_dir, sizeof(g_cache_dir), "%s", dir);
+    // Strip a trailing separator so built paths stay clean
+    size_t len = strlen(g_cache_dir);
+    if (len > 1 && (g_cache_dir[len - 1] == '/' || g_cache_dir[len - 1] == '\\')) {
+        g_cache_dir[len - 1] = '\0';
+    }
+    g_cache_enabled = 1;
+    return 1;
+}
+
+const char* font_cache_get_dir(void) {
+    return g_cache_enabled ? g_cache_dir : NULL;
+}
+
+// --- Lookup ---
+
+int font_cache_load(const char* filepath, float size, int sdf, FontCacheImage* out) {
+    memset(out, 0, sizeof(*out));
+    if (!g_cache_enabled || !filepath) return 0;
+
+    int64_t src_mtime, src_size;
+    if (!file_get_info(filepath, &src_mtime, &src_size)) return 0;
+
+    char cache_path[1100];
+    build_cache_path(filepath, size, sdf, cache_path, sizeof(cache_path));
+
+    if (!filemap_open(cache_path, &out->map)) {
+        g_stats.misses++;
+        return 0;
+    }
+
+    FontCacheHeader* header = &out->header;
+    if (out->map.size < sizeof(*header)) goto stale;
+    memcpy(header, out->map.data, sizeof(*header));
+
+    if (memcmp(header->magic, FONT_CACHE_MAGIC, 4) != 0 ||
+        header->version != FONT_CACHE_VERSION ||
+        header->source_mtime != src_mtime ||
+        header->source_size != src_size ||
+        header->size != size ||
+        header->oversample != FONT_OVERSAMPLE ||
+        header->sdf != (uint32_t)sdf ||
+        header->sdf_padding != FONT_SDF_PADDING ||
+        header->glyph_count > FONT_CACHE_MAX_GLYPHS ||
+        header->page_count > FONT_MAX_PAGES ||
+        header->page_size == 0 || header->page_size > 4096) {
+        goto stale;
+    }
+
+    // Expected payload size, checking each page on the way
+    size_t offset = sizeof(*header);
+    out->glyphs = out->map.data + offset;
+    offset += (size_t)header->glyph_count * sizeof(FontCacheGlyph);
+    if (header->has_kerning) {
+        out->kerning = out->map.data + offset;
+        offset += KERNING_BYTES;
+    }
+    for (uint32_t i = 0; i < header->page_count; i++) {
+        const FontCachePage* page = &header->pages[i];
+        if (page->height == 0 || page->height > header->page_size || page->rows > page->height ||
+            page->shelf_x > header->page_size || page->shelf_y > page->height) {
+            goto stale;
+        }
+        out->pages[i] = out->map.data + offset;
+        offset += (size_t)page->rows * header->page_size;
+    }
+    if (offset != out->map.size) goto stale;
+
+    for (uint32_t i = 0; i < header->glyph_count; i++) {
+        FontCacheGlyph glyph;
+        font_cache_get_glyph(out, (int)i, &glyph);
+        if (!glyph_valid(header, &glyph)) goto stale;
+    }
+
+    g_stats.hits++;
+    return 1;
+
+stale:
+    font_cache_release(out);
+    g_stats.misses++;
+    return 0;
+}
+
+void font_cache_get_glyph(const FontCacheImage* image, int i, FontCacheGlyph* out) {
+    memcpy(out, image->glyphs + (size_t)i * sizeof(FontCacheGlyph), sizeof(*out));
+}
+
+void font_cache_release(FontCacheImage* image) {
+    if (!image) return;
+    filemap_close(&image->map);
+    memset(image, 0, sizeof(*image));
+}
+
+// --- Store ---
+
+int font_cache_store(const char* filepath, const FontStrike* strike, const int16_t* kerning) {
+    if (!g_cache_enabled || !filepath || !strike) return 0;
+    if (strike->glyph_count > FONT_CACHE_MAX_GLYPHS) return 0;
+
+    int64_t src_mtime, src_size;
+    if (!file_get_info(filepath, &src_mtime, &src_size)) return 0;
+
+    FontCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, FONT_CACHE_MAGIC, 4);
+    header.version = FONT_CACHE_VERSION;
+    header.source_mtime = src_mtime;
+    header.source_size = src_size;
+    header.size = strike->size;
+    header.oversample = FONT_OVERSAMPLE;
+    header.sdf = (uint32_t)strike->sdf;
+    header.sdf_padding = FONT_SDF_PADDING;
+    header.glyph_count = (uint32_t)strike->glyph_count;
+    header.page_count = (uint32_t)strike->page_count;
+    header.page_size = (uint32_t)strike->page_size;
+    header.has_kerning = kerning != NULL;
+
+    FontCacheGlyph* glyphs = (FontCacheGlyph*)malloc((strike->glyph_count + 1) * sizeof(FontCacheGlyph));
+    if (!glyphs) return 0;
+    for (int i = 0; i < strike->glyph_count; i++) {
+        const Glyph* g = &strike->glyphs[i];
+        FontCacheGlyph* out = &glyphs[i];
+        out->codepoint = g->codepoint;
+        out->advance_x = g->advance_x;
+        out->offset_x = g->offset_x;
+        out->offset_y = g->offset_y;
+        out->width = g->width;
+        out->height = g->height;
+        out->page = g->page;
+        out->atlas_x = g->atlas_x;
+        out->atlas_y = g->atlas_y;
+        out->atlas_w = g->atlas_w;
+        out->atlas_h = g->atlas_h;
+    }
+
+    const void* chunks[3 + FONT_MAX_PAGES];
+    size_t sizes[3 + FONT_MAX_PAGES];
+    int count = 0;
+
+    chunks[count] = &header;
+    sizes[count++] = sizeof(header);
+    chunks[count] = glyphs;
+    sizes[count++] = (size_t)strike->glyph_count * sizeof(FontCacheGlyph);
+    if (kerning) {
+        chunks[count] = kerning;
+        sizes[count++] = KERNING_BYTES;
+    }
+    for (int i = 0; i < strike->page_count; i++) {
+        const FontAtlasPage* page = &strike->pages[i];
+        FontCachePage* out = &header.pages[i];
+        out->height = (uint32_t)page->height;
+        out->rows = page_rows(page);
+        out->shelf_x = (uint32_t)page->shelf_x;
+        out->shelf_y = (uint32_t)page->shelf_y;
+        out->shelf_h = (uint32_t)page->shelf_h;
+
+        chunks[count] = page->pixels;
+        sizes[count++] = (size_t)out->rows * page->width;
+    }
+
+    char cache_path[1100];
+    build_cache_path(filepath, strike->size, strike->sdf, cache_path, sizeof(cache_path));
+    int ok = file_write_atomic(cache_path, chunks, sizes, count);
+    free(glyphs);
+
+    if (ok) {
+        g_stats.writes++;
+    } else {
+        fprintf(stderr, "[Text] Failed to write cache file: %s\n", cache_path);
+    }
+    return ok;
+}
+
+// --- Stats ---
+
+void font_cache_record_load(int warm, double seconds) {
+    if (warm) {
+        g_stats.warm_loads++;
+        g_stats.warm_seconds += seconds;
+    } else {
+        g_stats.cold_loads++;
+        g_stats.cold_seconds += seconds;
+    }
+}
+
+void font_cache_get_stats(FontCacheStats* out) {
+    *out = g_stats;
+}
+
+void font_cache_reset_stats(void) {
+    memset(&g_stats, 0, sizeof(g_stats));
+}
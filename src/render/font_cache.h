@@ -0,0 +1,106 @@
+#ifndef FONT_CACHE_H
+#define FONT_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "text.h"
+#include "../platform/filemap.h"
+
+// Persistent font atlas cache.
+//
+// With a cache directory configured, the strike a font is loaded at (its
+// atlas pages, glyph metrics and ASCII kerning table) is written to
+// `<dir>/<key>.pbfnt`. The key hashes the canonical font path, the pixel
+// size and the rasterization settings (oversampling, SDF padding); the header
+// stores the font file's mtime and size so edited fonts are rasterized again.
+// Later loads map the file and upload the pages straight from the mapping.
+//
+// File layout (little-endian):
+//   FontCacheHeader
+//   FontCacheGlyph[glyph_count]
+//   int16 kerning[FONT_NUM_CHARS * FONT_NUM_CHARS] (only when has_kerning)
+//   page pixels: for each page, rows x page_size bytes (the rows below are empty)
+
+#define FONT_CACHE_MAGIC   "PBFT"
+#define FONT_CACHE_VERSION 1
+
+#define FONT_CACHE_MAX_GLYPHS 65536
+
+typedef struct {
+    uint32_t height;
+    uint32_t rows;           // rows stored (the used part of the page)
+    uint32_t shelf_x, shelf_y, shelf_h;
+} FontCachePage;
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    int64_t source_mtime;
+    int64_t source_size;
+    float size;              // strike size in pixels
+    uint32_t oversample;
+    uint32_t sdf;
+    uint32_t sdf_padding;
+    uint32_t glyph_count;
+    uint32_t page_count;
+    uint32_t page_size;      // page width
+    uint32_t has_kerning;
+    FontCachePage pages[FONT_MAX_PAGES];
+} FontCacheHeader;
+
+typedef struct {
+    uint32_t codepoint;
+    float advance_x;
+    float offset_x, offset_y;
+    float width, height;
+    int32_t page;            // -1 for glyphs without pixels
+    int32_t atlas_x, atlas_y;
+    int32_t atlas_w, atlas_h;
+} FontCacheGlyph;
+
+// A validated cache entry. Pointers reference the file mapping.
+typedef struct {
+    FontCacheHeader header;
+    const unsigned char* glyphs;    // FontCacheGlyph records (unaligned)
+    const unsigned char* kerning;   // int16 table (unaligned), NULL without kerning
+    const unsigned char* pages[FONT_MAX_PAGES];
+    FileMap map;
+} FontCacheImage;
+
+typedef struct {
+    int hits;
+    int misses;
+    int writes;
+    int cold_loads;         // loads that rasterized the font
+    double cold_seconds;
+    int warm_loads;         // loads served from the cache
+    double warm_seconds;
+} FontCacheStats;
+
+// Set the cache directory (created if missing). NULL or "" disables the cache.
+// Returns 1 on success.
+int font_cache_set_dir(const char* dir);
+
+// Current cache directory, or NULL when disabled
+const char* font_cache_get_dir(void);
+
+// Look up a valid entry for `filepath` at strike `size`. Returns 1 on hit;
+// release the image with font_cache_release when done.
+int font_cache_load(const char* filepath, float size, int sdf, FontCacheImage* out);
+
+// Read glyph `i` of a cache image
+void font_cache_get_glyph(const FontCacheImage* image, int i, FontCacheGlyph* out);
+
+void font_cache_release(FontCacheImage* image);
+
+// Write `strike` (and the font's ASCII kerning table, may be NULL) for
+// `filepath`. Returns 1 on success.
+int font_cache_store(const char* filepath, const FontStrike* strike, const int16_t* kerning);
+
+// Record the time spent on a cold (rasterize) or warm (cache) load
+void font_cache_record_load(int warm, double seconds);
+
+void font_cache_get_stats(FontCacheStats* out);
+void font_cache_reset_stats(void);
+
+#endif // FONT_CACHE_H
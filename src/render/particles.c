@@ -0,0 +1,846 @@
+#include "particles.h"
+#include "pixel_ops.h"
+#include "camera.h"
+#include "renderer.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define PARTICLES_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define PARTICLES_ARM_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Same runtime-selected AVX2 build as pixel_ops.c
+#if defined(PARTICLES_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PARTICLES_HAS_AVX2 1
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#define PARTICLE_INSTANCE_SIZE 8   // x, y, size, rotation, r, g, b, a
+#define PARTICLE_POOL_ARRAYS 8
+#define PARTICLE_ALIGN 32
+#define DEG2RAD 0.017453292519943295f
+
+static const char* particle_vertex_shader_source =
+    "#version 330 core\n"
+    "layout (location = 0) in vec4 aParticle;\n"   // x, y, size, rotation
+    "layout (location = 1) in vec4 aColor;\n"
+    "out vec2 TexCoord;\n"
+    "out vec4 Color;\n"
+    "uniform mat4 projection;\n"
+    "void main() {\n"
+    "    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) - 0.5;\n"
+    "    float c = cos(aParticle.w);\n"
+    "    float s = sin(aParticle.w);\n"
+    "    vec2 offset = vec2(corner.x * c - corner.y * s, corner.x * s + corner.y * c) * aParticle.z;\n"
+    "    gl_Position = projection * vec4(aParticle.xy + offset, 0.0, 1.0);\n"
+    "    TexCoord = corner + 0.5;\n"
+    "    Color = aColor;\n"
+    "}\n";
+
+static const char* particle_fragment_shader_source =
+    "#version 330 core\n"
+    "in vec2 TexCoord;\n"
+    "in vec4 Color;\n"
+    "out vec4 FragColor;\n"
+    "uniform sampler2D textureSampler;\n"
+    "uniform bool useTexture;\n"
+    "uniform bool premultiplied;\n"
+    "uniform bool texturePremultiplied;\n"
+    "void main() {\n"
+    "    vec4 texColor = useTexture ? texture(textureSampler, TexCoord)\n"
+    "                               : vec4(1.0, 1.0, 1.0, 1.0 - smoothstep(0.3, 0.5, length(TexCoord - 0.5)));\n"
+    "    vec4 color = Color;\n"
+    "    if (premultiplied) {\n"
+    "        if (!useTexture || !texturePremultiplied) texColor.rgb *= texColor.a;\n"
+    "        color.rgb *= color.a;\n"
+    "    } else if (useTexture && texturePremultiplied && texColor.a > 0.0) {\n"
+    "        texColor.rgb /= texColor.a;\n"
+    "    }\n"
+    "    FragColor = texColor * color;\n"
+    "    if (FragColor.a < 0.001) discard;\n"
+    "}\n";
+
+// GPU particles: simulation pass, captured with transform feedback
+static const char* gpu_update_shader_source =
+    "#version 330 core\n"
+    "layout (location = 0) in vec4 aPosVel;\n"     // x, y, vx, vy
+    "layout (location = 1) in vec4 aState;\n"      // age, life, seed, alive
+    "out vec4 vPosVel;\n"
+    "out vec4 vState;\n"
+    "uniform float dt;\n"
+    "uniform uint frame;\n"
+    "uniform bool emitting;\n"
+    "uniform vec2 origin;\n"
+    "uniform int shape;\n"
+    "uniform float radius;\n"
+    "uniform vec2 area;\n"
+    "uniform bool radial;\n"
+    "uniform float angle;\n"
+    "uniform float spread;\n"
+    "uniform vec2 speedRange;\n"
+    "uniform vec2 lifeRange;\n"
+    "uniform vec2 gravity;\n"
+    "uniform float damp;\n"
+    "uint rngState;\n"
+    "uint pcg(uint v) {\n"
+    "    uint state = v * 747796405u + 2891336453u;\n"
+    "    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;\n"
+    "    return (word >> 22u) ^ word;\n"
+    "}\n"
+    "float rand() {\n"
+    "    rngState = pcg(rngState);\n"
+    "    return float(rngState >> 8u) * (1.0 / 16777216.0);\n"
+    "}\n"
+    "void main() {\n"
+    "    vec4 pv = aPosVel;\n"
+    "    vec4 st = aState;\n"
+    "    st.x += dt;\n"
+    "    if (st.x >= st.y) {\n"
+    "        if (emitting) {\n"
+    "            rngState = pcg(uint(gl_VertexID) ^ pcg(frame) ^ floatBitsToUint(st.z));\n"
+    "            vec2 o = vec2(0.0);\n"
+    "            if (shape == 1 || shape == 2) {\n"
+    "                float th = rand() * 6.2831853;\n"
+    "                float r = shape == 2 ? radius : radius * sqrt(rand());\n"
+    "                o = vec2(cos(th), sin(th)) * r;\n"
+    "            } else if (shape == 3) {\n"
+    "                o = (vec2(rand(), rand()) - 0.5) * area;\n"
+    "            } else if (shape == 4) {\n"
+    "                o = vec2((rand() - 0.5) * area.x, 0.0);\n"
+    "            }\n"
+    "            float dir = angle;\n"
+    "            if (radial && (o.x != 0.0 || o.y != 0.0)) dir = atan(o.y, o.x);\n"
+    "            dir += (rand() - 0.5) * spread;\n"
+    "            float speed = mix(speedRange.x, speedRange.y, rand());\n"
+    "            pv = vec4(origin + o, cos(dir) * speed, sin(dir) * speed);\n"
+    "            st = vec4(0.0, mix(lifeRange.x, lifeRange.y, rand()), rand(), 1.0);\n"
+    "        } else {\n"
+    "            st.w = 0.0;\n"
+    "        }\n"
+    "    } else if (st.w > 0.5) {\n"
+    "        pv.zw = (pv.zw + gravity * dt) * damp;\n"
+    "        pv.xy += pv.zw * dt;\n"
+    "    }\n"
+    "    vPosVel = pv;\n"
+    "    vState = st;\n"
+    "}\n";
+
+// GPU particles: drawn straight from the simulation buffer
+static const char* gpu_render_shader_source =
+    "#version 330 core\n"
+    "layout (location = 0) in vec4 aPosVel;\n"
+    "layout (location = 1) in vec4 aState;\n"
+    "out vec2 TexCoord;\n"
+    "out vec4 Color;\n"
+    "uniform mat4 projection;\n"
+    "uniform vec4 colors[8];\n"
+    "uniform int colorCount;\n"
+    "uniform float sizes[8];\n"
+    "uniform int sizeCount;\n"
+    "uniform vec2 spinRange;\n"
+    "void main() {\n"
+    "    float t = clamp(aState.x / aState.y, 0.0, 1.0);\n"
+    "    float p = t * float(colorCount - 1);\n"
+    "    int k = min(int(p), max(colorCount - 2, 0));\n"
+    "    Color = colorCount > 1 ? mix(colors[k], colors[k + 1], p - float(k)) : colors[0];\n"
+    "    p = t * float(sizeCount - 1);\n"
+    "    k = min(int(p), max(sizeCount - 2, 0));\n"
+    "    float size = sizeCount > 1 ? mix(sizes[k], sizes[k + 1], p - float(k)) : sizes[0];\n"
+    "    if (aState.w < 0.5) size = 0.0;\n"
+    "    float angle = mix(spinRange.x, spinRange.y, aState.z) * aState.x;\n"
+    "    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) - 0.5;\n"
+    "    float c = cos(angle);\n"
+    "    float s = sin(angle);\n"
+    "    vec2 offset = vec2(corner.x * c - corner.y * s, corner.x * s + corner.y * c) * size;\n"
+    "    gl_Position = projection * vec4(aPosVel.xy + offset, 0.0, 1.0);\n"
+    "    TexCoord = corner + 0.5;\n"
+    "}\n";
+
+// Uniforms shared by both draw programs
+typedef struct {
+    GLuint program;
+    GLint projection_loc;
+    GLint texture_loc;
+    GLint use_texture_loc;
+    GLint premultiplied_loc;
+    GLint texture_premultiplied_loc;
+} ParticleDrawProgram;
+
+// Shared by every emitter; created on the first use
+typedef struct {
+    ParticleDrawProgram cpu;
+    ParticleDrawProgram gpu;
+    GLint gpu_colors_loc, gpu_color_count_loc, gpu_sizes_loc, gpu_size_count_loc, gpu_spin_loc;
+
+    GLuint update;
+    GLint dt_loc, frame_loc, emitting_loc, origin_loc, shape_loc, radius_loc, area_loc;
+    GLint radial_loc, angle_loc, spread_loc, speed_loc, life_loc, gravity_loc, damp_loc;
+    int initialized;
+} ParticleRendererState;
+
+static ParticleRendererState pt_state = {0};
+
+static GLuint compile_stage(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char info_log[512];
+        glGetShaderInfoLog(shader, 512, NULL, info_log);
+        fprintf(stderr, "[Particles] Shader compile error: %s\n", info_log);
+    }
+    return shader;
+}
+
+// Link a program; without a fragment stage the outputs are captured by
+// transform feedback as `varyings`
+static GLuint link_program(const char* vs_source, const char* fs_source,
+                           const char* const* varyings, int varying_count) {
+    GLuint program = glCreateProgram();
+    GLuint vs = compile_stage(GL_VERTEX_SHADER, vs_source);
+    GLuint fs = fs_source ? compile_stage(GL_FRAGMENT_SHADER, fs_source) : 0;
+    glAttachShader(program, vs);
+    if (fs) glAttachShader(program, fs);
+    if (varyings) glTransformFeedbackVaryings(program, varying_count, varyings, GL_INTERLEAVED_ATTRIBS);
+    glLinkProgram(program);
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        char info_log[512];
+        glGetProgramInfoLog(program, 512, NULL, info_log);
+        fprintf(stderr, "[Particles] Shader linking error: %s\n", info_log);
+    }
+    glDeleteShader(vs);
+    if (fs) glDeleteShader(fs);
+    return program;
+}
+
+static void init_draw_program(ParticleDrawProgram* p, const char* vs_source) {
+    p->program = link_program(vs_source, particle_fragment_shader_source, NULL, 0);
+    p->projection_loc = glGetUniformLocation(p->program, "projection");
+    p->texture_loc = glGetUniformLocation(p->program, "textureSampler");
+    p->use_texture_loc = glGetUniformLocation(p->program, "useTexture");
+    p->premultiplied_loc = glGetUniformLocation(p->program, "premultiplied");
+    p->texture_premultiplied_loc = glGetUniformLocation(p->program, "texturePremultiplied");
+}
+
+static void ensure_renderer(void) {
+    if (pt_state.initialized) return;
+
+    init_draw_program(&pt_state.cpu, particle_vertex_shader_source);
+    init_draw_program(&pt_state.gpu, gpu_render_shader_source);
+    GLuint g = pt_state.gpu.program;
+    pt_state.gpu_colors_loc = glGetUniformLocation(g, "colors");
+    pt_state.gpu_color_count_loc = glGetUniformLocation(g, "colorCount");
+    pt_state.gpu_sizes_loc = glGetUniformLocation(g, "sizes");
+    pt_state.gpu_size_count_loc = glGetUniformLocation(g, "sizeCount");
+    pt_state.gpu_spin_loc = glGetUniformLocation(g, "spinRange");
+
+    static const char* const varyings[] = {"vPosVel", "vState"};
+    GLuint u = pt_state.update = link_program(gpu_update_shader_source, NULL, varyings, 2);
+    pt_state.dt_loc = glGetUniformLocation(u, "dt");
+    pt_state.frame_loc = glGetUniformLocation(u, "frame");
+    pt_state.emitting_loc = glGetUniformLocation(u, "emitting");
+    pt_state.origin_loc = glGetUniformLocation(u, "origin");
+    pt_state.shape_loc = glGetUniformLocation(u, "shape");
+    pt_state.radius_loc = glGetUniformLocation(u, "radius");
+    pt_state.area_loc = glGetUniformLocation(u, "area");
+    pt_state.radial_loc = glGetUniformLocation(u, "radial");
+    pt_state.angle_loc = glGetUniformLocation(u, "angle");
+    pt_state.spread_loc = glGetUniformLocation(u, "spread");
+    pt_state.speed_loc = glGetUniformLocation(u, "speedRange");
+    pt_state.life_loc = glGetUniformLocation(u, "lifeRange");
+    pt_state.gravity_loc = glGetUniformLocation(u, "gravity");
+    pt_state.damp_loc = glGetUniformLocation(u, "damp");
+    pt_state.initialized = 1;
+}
+
+// Flush pending batches and bind a draw program with the current projection,
+// blend mode and texture. Returns 1 if additive blending was enabled.
+static int begin_draw(const ParticleDrawProgram* p, Texture* texture, int additive) {
+    int use_texture = texture && texture_ensure_resident(texture);
+
+    // Keep painter's order: everything batched so far goes first
+    renderer_switch_batch(BATCH_NONE);
+
+    int sw, sh;
+    renderer_get_screen_size(&sw, &sh);
+    float projection[16];
+    if (renderer_is_ui_mode()) {
+        renderer_get_ui_projection(projection, sw, sh);
+    } else {
+        camera_get_matrix(projection, sw, sh);
+    }
+
+    int premultiplied = renderer_get_premultiplied_alpha();
+    if (additive) {
+        glEnable(GL_BLEND);
+        glBlendFunc(premultiplied ? GL_ONE : GL_SRC_ALPHA, GL_ONE);
+    } else {
+        renderer_apply_blend();
+    }
+
+    glUseProgram(p->program);
+    glUniformMatrix4fv(p->projection_loc, 1, GL_FALSE, projection);
+    glUniform1i(p->texture_loc, 0);
+    glUniform1i(p->use_texture_loc, use_texture);
+    glUniform1i(p->premultiplied_loc, premultiplied);
+    glUniform1i(p->texture_premultiplied_loc, use_texture ? texture->premultiplied : 0);
+    if (use_texture) {
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, texture->id);
+    }
+    return additive;
+}
+
+static void end_draw(int additive) {
+    glBindVertexArray(0);
+    glUseProgram(0);
+    if (additive) renderer_apply_blend();
+}
+
+// --- Configuration ---
+
+void particle_config_defaults(ParticleEmitterConfig* config) {
+    memset(config, 0, sizeof(*config));
+    config->rate = 50.0f;
+    config->shape = PARTICLE_SHAPE_POINT;
+    config->angle = -90.0f;
+    config->spread = 30.0f;
+    config->speed_min = 50.0f;
+    config->speed_max = 100.0f;
+    config->life_min = 1.0f;
+    config->life_max = 1.0f;
+    config->colors[0][0] = config->colors[0][1] = config->colors[0][2] = config->colors[0][3] = 1.0f;
+    config->colors[1][0] = config->colors[1][1] = config->colors[1][2] = 1.0f;
+    config->colors[1][3] = 0.0f;
+    config->color_count = 2;
+    config->sizes[0] = 8.0f;
+    config->size_count = 1;
+}
+
+// Piecewise-linear sample of evenly spaced keys at t in [0, 1]
+static float curve_sample(const float* keys, int stride, int count, float t) {
+    if (count <= 1) return keys[0];
+    float pos = t * (float)(count - 1);
+    int k = (int)pos;
+    if (k >= count - 1) return keys[(count - 1) * stride];
+    float f = pos - (float)k;
+    return keys[k * stride] + (keys[(k + 1) * stride] - keys[k * stride]) * f;
+}
+
+static void bake_curves(ParticleEmitter* e) {
+    const ParticleEmitterConfig* c = &e->config;
+    for (int i = 0; i < PARTICLE_LUT_SIZE; i++) {
+        float t = (float)i / (PARTICLE_LUT_SIZE - 1);
+        for (int ch = 0; ch < 4; ch++) {
+            e->color_lut[i][ch] = curve_sample(&c->colors[0][ch], 4, c->color_count, t);
+        }
+        e->size_lut[i] = curve_sample(c->sizes, 1, c->size_count, t);
+    }
+}
+
+// Clamp counts and ranges to something the simulation can use
+static void sanitize_config(ParticleEmitterConfig* c) {
+    if (c->color_count < 1) c->color_count = 1;
+    if (c->color_count > PARTICLE_CURVE_KEYS) c->color_count = PARTICLE_CURVE_KEYS;
+    if (c->size_count < 1) c->size_count = 1;
+    if (c->size_count > PARTICLE_CURVE_KEYS) c->size_count = PARTICLE_CURVE_KEYS;
+    if (c->speed_max < c->speed_min) c->speed_max = c->speed_min;
+    if (c->life_min < 0.001f) c->life_min = 0.001f;
+    if (c->life_max < c->life_min) c->life_max = c->life_min;
+    if (c->spin_max < c->spin_min) c->spin_max = c->spin_min;
+    if (c->drag < 0.0f) c->drag = 0.0f;
+    if (c->rate < 0.0f) c->rate = 0.0f;
+}
+
+void particle_emitter_configure(ParticleEmitter* emitter, const ParticleEmitterConfig* config) {
+    emitter->config = *config;
+    sanitize_config(&emitter->config);
+    bake_curves(emitter);
+}
+
+void particle_emitter_set_texture(ParticleEmitter* emitter, Texture* texture) {
+    if (texture) texture_retain(texture);
+    if (emitter->texture) texture_release(emitter->texture);
+    emitter->texture = texture;
+}
+
+// --- Lifetime ---
+
+ParticleEmitter* particle_emitter_create(int capacity, const ParticleEmitterConfig* config, Texture* texture) {
+    if (capacity <= 0) return NULL;
+    ParticleEmitter* e = (ParticleEmitter*)calloc(1, sizeof(ParticleEmitter));
+    if (!e) return NULL;
+
+    // One block for every pool, each array starting on a 32-byte boundary
+    size_t stride = ((size_t)capacity * sizeof(float) + PARTICLE_ALIGN - 1) & ~(size_t)(PARTICLE_ALIGN - 1);
+    e->block = calloc(1, stride * PARTICLE_POOL_ARRAYS + PARTICLE_ALIGN);
+    e->instances = (float*)malloc((size_t)capacity * PARTICLE_INSTANCE_SIZE * sizeof(float));
+    if (!e->block || !e->instances) {
+        free(e->block);
+        free(e->instances);
+        free(e);
+        return NULL;
+    }
+    uintptr_t base = ((uintptr_t)e->block + PARTICLE_ALIGN - 1) & ~(uintptr_t)(PARTICLE_ALIGN - 1);
+    float** pools[PARTICLE_POOL_ARRAYS] = {&e->x, &e->y, &e->vx, &e->vy, &e->age, &e->age_rate, &e->rotation, &e->spin};
+    for (int i = 0; i < PARTICLE_POOL_ARRAYS; i++) {
+        *pools[i] = (float*)(base + stride * (size_t)i);
+    }
+
+    e->capacity = capacity;
+    e->emitting = 1;
+    e->rng = 0x9E3779B9u ^ (uint32_t)(uintptr_t)e;
+    if (e->rng == 0) e->rng = 1;
+
+    ParticleEmitterConfig defaults;
+    if (!config) {
+        particle_config_defaults(&defaults);
+        config = &defaults;
+    }
+    particle_emitter_configure(e, config);
+    particle_emitter_set_texture(e, texture);
+    return e;
+}
+
+void particle_emitter_destroy(ParticleEmitter* emitter) {
+    if (!emitter) return;
+    if (emitter->vbo) glDeleteBuffers(1, &emitter->vbo);
+    if (emitter->vao) glDeleteVertexArrays(1, &emitter->vao);
+    if (emitter->texture) texture_release(emitter->texture);
+    free(emitter->instances);
+    free(emitter->block);
+    free(emitter);
+}
+
+void particle_emitter_clear(ParticleEmitter* emitter) {
+    emitter->count = 0;
+    emitter->emit_accum = 0.0f;
+}
+
+// --- Emission ---
+
+// xorshift32, uniform in [0, 1)
+static inline float next_random(ParticleEmitter* e) {
+    uint32_t r = e->rng;
+    r ^= r << 13;
+    r ^= r >> 17;
+    r ^= r << 5;
+    e->rng = r;
+    return (float)(r >> 8) * (1.0f / 16777216.0f);
+}
+
+static inline float random_range(ParticleEmitter* e, float lo, float hi) {
+    return lo + (hi - lo) * next_random(e);
+}
+
+static void spawn(ParticleEmitter* e, int i) {
+    const ParticleEmitterConfig* c = &e->config;
+    float ox = 0.0f, oy = 0.0f;
+
+    switch (c->shape) {
+        case PARTICLE_SHAPE_CIRCLE:
+        case PARTICLE_SHAPE_RING: {
+            float theta = next_random(e) * 6.2831853f;
+            float r = c->shape == PARTICLE_SHAPE_RING ? c->radius : c->radius * sqrtf(next_random(e));
+            ox = cosf(theta) * r;
+            oy = sinf(theta) * r;
+            break;
+        }
+        case PARTICLE_SHAPE_RECT:
+            ox = (next_random(e) - 0.5f) * c->width;
+            oy = (next_random(e) - 0.5f) * c->height;
+            break;
+        case PARTICLE_SHAPE_LINE:
+            ox = (next_random(e) - 0.5f) * c->width;
+            break;
+        default:
+            break;
+    }
+
+    float direction = c->angle * DEG2RAD;
+    if (c->radial && (ox != 0.0f || oy != 0.0f)) direction = atan2f(oy, ox);
+    direction += (next_random(e) - 0.5f) * c->spread * DEG2RAD;
+    float speed = random_range(e, c->speed_min, c->speed_max);
+
+    e->x[i] = c->x + ox;
+    e->y[i] = c->y + oy;
+    e->vx[i] = cosf(direction) * speed;
+    e->vy[i] = sinf(direction) * speed;
+    e->age[i] = 0.0f;
+    e->age_rate[i] = 1.0f / random_range(e, c->life_min, c->life_max);
+    e->rotation[i] = 0.0f;
+    e->spin[i] = random_range(e, c->spin_min, c->spin_max) * DEG2RAD;
+}
+
+int particle_emitter_emit(ParticleEmitter* emitter, int n) {
+    int room = emitter->capacity - emitter->count;
+    if (n > room) n = room;
+    for (int i = 0; i < n; i++) {
+        spawn(emitter, emitter->count + i);
+    }
+    if (n > 0) emitter->count += n;
+    return n > 0 ? n : 0;
+}
+
+// --- Integration ---
+
+// Arguments shared by every integration variant
+typedef struct {
+    float* x; float* y; float* vx; float* vy;
+    float* age; const float* age_rate;
+    float* rotation; const float* spin;
+    float gx, gy;             // gravity * dt
+    float damp;               // velocity scale from drag
+    float dt;
+} IntegrateArgs;
+
+static void integrate_scalar(const IntegrateArgs* a, int start, int end) {
+    for (int i = start; i < end; i++) {
+        a->vx[i] = (a->vx[i] + a->gx) * a->damp;
+        a->vy[i] = (a->vy[i] + a->gy) * a->damp;
+        a->x[i] += a->vx[i] * a->dt;
+        a->y[i] += a->vy[i] * a->dt;
+        a->age[i] += a->age_rate[i] * a->dt;
+        a->rotation[i] += a->spin[i] * a->dt;
+    }
+}
+
+#ifdef PARTICLES_X86
+// SSE2 (4 particles per iteration)
+static int integrate_sse2(const IntegrateArgs* a, int count) {
+    const __m128 gx = _mm_set1_ps(a->gx), gy = _mm_set1_ps(a->gy);
+    const __m128 damp = _mm_set1_ps(a->damp), dt = _mm_set1_ps(a->dt);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 vx = _mm_mul_ps(_mm_add_ps(_mm_load_ps(a->vx + i), gx), damp);
+        __m128 vy = _mm_mul_ps(_mm_add_ps(_mm_load_ps(a->vy + i), gy), damp);
+        _mm_store_ps(a->vx + i, vx);
+        _mm_store_ps(a->vy + i, vy);
+        _mm_store_ps(a->x + i, _mm_add_ps(_mm_load_ps(a->x + i), _mm_mul_ps(vx, dt)));
+        _mm_store_ps(a->y + i, _mm_add_ps(_mm_load_ps(a->y + i), _mm_mul_ps(vy, dt)));
+        _mm_store_ps(a->age + i, _mm_add_ps(_mm_load_ps(a->age + i), _mm_mul_ps(_mm_load_ps(a->age_rate + i), dt)));
+        _mm_store_ps(a->rotation + i, _mm_add_ps(_mm_load_ps(a->rotation + i), _mm_mul_ps(_mm_load_ps(a->spin + i), dt)));
+    }
+    return i;
+}
+#endif
+
+#ifdef PARTICLES_HAS_AVX2
+// AVX2 (8 particles per iteration)
+TARGET_AVX2 static int integrate_avx2(const IntegrateArgs* a, int count) {
+    const __m256 gx = _mm256_set1_ps(a->gx), gy = _mm256_set1_ps(a->gy);
+    const __m256 damp = _mm256_set1_ps(a->damp), dt = _mm256_set1_ps(a->dt);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 vx = _mm256_mul_ps(_mm256_add_ps(_mm256_load_ps(a->vx + i), gx), damp);
+        __m256 vy = _mm256_mul_ps(_mm256_add_ps(_mm256_load_ps(a->vy + i), gy), damp);
+        _mm256_store_ps(a->vx + i, vx);
+        _mm256_store_ps(a->vy + i, vy);
+        _mm256_store_ps(a->x + i, _mm256_add_ps(_mm256_load_ps(a->x + i), _mm256_mul_ps(vx, dt)));
+        _mm256_store_ps(a->y + i, _mm256_add_ps(_mm256_load_ps(a->y + i), _mm256_mul_ps(vy, dt)));
+        _mm256_store_ps(a->age + i, _mm256_add_ps(_mm256_load_ps(a->age + i), _mm256_mul_ps(_mm256_load_ps(a->age_rate + i), dt)));
+        _mm256_store_ps(a->rotation + i, _mm256_add_ps(_mm256_load_ps(a->rotation + i), _mm256_mul_ps(_mm256_load_ps(a->spin + i), dt)));
+    }
+    return i;
+}
+#endif
+
+#ifdef PARTICLES_ARM_NEON
+// NEON (4 particles per iteration)
+static int integrate_neon(const IntegrateArgs* a, int count) {
+    const float32x4_t gx = vdupq_n_f32(a->gx), gy = vdupq_n_f32(a->gy);
+    const float32x4_t damp = vdupq_n_f32(a->damp), dt = vdupq_n_f32(a->dt);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t vx = vmulq_f32(vaddq_f32(vld1q_f32(a->vx + i), gx), damp);
+        float32x4_t vy = vmulq_f32(vaddq_f32(vld1q_f32(a->vy + i), gy), damp);
+        vst1q_f32(a->vx + i, vx);
+        vst1q_f32(a->vy + i, vy);
+        vst1q_f32(a->x + i, vaddq_f32(vld1q_f32(a->x + i), vmulq_f32(vx, dt)));
+        vst1q_f32(a->y + i, vaddq_f32(vld1q_f32(a->y + i), vmulq_f32(vy, dt)));
+        vst1q_f32(a->age + i, vaddq_f32(vld1q_f32(a->age + i), vmulq_f32(vld1q_f32(a->age_rate + i), dt)));
+        vst1q_f32(a->rotation + i, vaddq_f32(vld1q_f32(a->rotation + i), vmulq_f32(vld1q_f32(a->spin + i), dt)));
+    }
+    return i;
+}
+#endif
+
+static void integrate(ParticleEmitter* e, float dt) {
+    IntegrateArgs a = {
+        e->x, e->y, e->vx, e->vy, e->age, e->age_rate, e->rotation, e->spin,
+        e->config.gravity_x * dt, e->config.gravity_y * dt,
+        expf(-e->config.drag * dt), dt
+    };
+
+    int done = 0;
+    switch (pixel_ops_get_level()) {
+#ifdef PARTICLES_HAS_AVX2
+        case PIXEL_OPS_AVX2: done = integrate_avx2(&a, e->count); break;
+#endif
+#ifdef PARTICLES_X86
+        case PIXEL_OPS_SSE2: done = integrate_sse2(&a, e->count); break;
+#endif
+#ifdef PARTICLES_ARM_NEON
+        case PIXEL_OPS_NEON: done = integrate_neon(&a, e->count); break;
+#endif
+        default: break;
+    }
+    integrate_scalar(&a, done, e->count);
+}
+
+// Swap-remove every particle that reached the end of its life
+static void retire(ParticleEmitter* e) {
+    int i = 0;
+    while (i < e->count) {
+        if (e->age[i] < 1.0f) {
+            i++;
+            continue;
+        }
+        int last = --e->count;
+        e->x[i] = e->x[last];
+        e->y[i] = e->y[last];
+        e->vx[i] = e->vx[last];
+        e->vy[i] = e->vy[last];
+        e->age[i] = e->age[last];
+        e->age_rate[i] = e->age_rate[last];
+        e->rotation[i] = e->rotation[last];
+        e->spin[i] = e->spin[last];
+    }
+}
+
+void particle_emitter_update(ParticleEmitter* emitter, float dt) {
+    if (dt <= 0.0f) return;
+
+    integrate(emitter, dt);
+    retire(emitter);
+
+    // New particles start this frame untouched by forces
+    if (emitter->emitting && emitter->config.rate > 0.0f) {
+        emitter->emit_accum += emitter->config.rate * dt;
+        int n = (int)emitter->emit_accum;
+        emitter->emit_accum -= (float)n;
+        particle_emitter_emit(emitter, n);
+    }
+}
+
+// --- Rendering ---
+
+static void ensure_buffers(ParticleEmitter* e) {
+    if (e->vao) return;
+    glGenVertexArrays(1, &e->vao);
+    glGenBuffers(1, &e->vbo);
+    glBindVertexArray(e->vao);
+    glBindBuffer(GL_ARRAY_BUFFER, e->vbo);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)e->capacity * PARTICLE_INSTANCE_SIZE * sizeof(float), NULL, GL_STREAM_DRAW);
+
+    GLsizei stride = PARTICLE_INSTANCE_SIZE * sizeof(float);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribDivisor(0, 1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void particle_emitter_draw(ParticleEmitter* e) {
+    if (e->count == 0) return;
+    ensure_renderer();
+    ensure_buffers(e);
+
+    float* out = e->instances;
+    for (int i = 0; i < e->count; i++) {
+        int k = (int)(e->age[i] * (PARTICLE_LUT_SIZE - 1) + 0.5f);
+        if (k > PARTICLE_LUT_SIZE - 1) k = PARTICLE_LUT_SIZE - 1;
+        out[0] = e->x[i];
+        out[1] = e->y[i];
+        out[2] = e->size_lut[k];
+        out[3] = e->rotation[i];
+        memcpy(out + 4, e->color_lut[k], 4 * sizeof(float));
+        out += PARTICLE_INSTANCE_SIZE;
+    }
+
+    int additive = begin_draw(&pt_state.cpu, e->texture, e->config.additive);
+
+    // Orphan the previous frame's storage so the upload never waits on the GPU
+    GLsizeiptr bytes = (GLsizeiptr)e->count * PARTICLE_INSTANCE_SIZE * sizeof(float);
+    glBindBuffer(GL_ARRAY_BUFFER, e->vbo);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)e->capacity * PARTICLE_INSTANCE_SIZE * sizeof(float), NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, e->instances);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindVertexArray(e->vao);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, e->count);
+    end_draw(additive);
+}
+
+// --- GPU particles ---
+
+#define GPU_PARTICLE_SIZE 8        // x, y, vx, vy, age, life, seed, alive
+#define GPU_PREWARM_STEP (1.0f / 30.0f)
+
+// Dead particles with staggered lifetimes, so spawning ramps up over the
+// first lifetime instead of everything launching on the first frame
+static void upload_initial_state(GpuParticleSystem* s) {
+    float* data = (float*)calloc((size_t)s->count, GPU_PARTICLE_SIZE * sizeof(float));
+    if (!data) return;
+
+    uint32_t rng = 0x2545F491u;
+    for (int i = 0; i < s->count; i++) {
+        float* p = data + (size_t)i * GPU_PARTICLE_SIZE;
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        p[5] = (float)(rng >> 8) * (1.0f / 16777216.0f) * s->config.life_max;  // spawn delay
+        p[6] = (float)i / (float)s->count;                                        // seed
+    }
+    for (int b = 0; b < 2; b++) {
+        glBindBuffer(GL_ARRAY_BUFFER, s->vbo[b]);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)s->count * GPU_PARTICLE_SIZE * sizeof(float), data, GL_DYNAMIC_COPY);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    free(data);
+    s->current = 0;
+}
+
+static void setup_state_attributes(GLuint vao, GLuint vbo, int instanced) {
+    GLsizei stride = GPU_PARTICLE_SIZE * sizeof(float);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(0, instanced ? 1 : 0);
+    glVertexAttribDivisor(1, instanced ? 1 : 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+GpuParticleSystem* gpu_particles_create(int count, const ParticleEmitterConfig* config, Texture* texture) {
+    if (count <= 0) return NULL;
+    GpuParticleSystem* s = (GpuParticleSystem*)calloc(1, sizeof(GpuParticleSystem));
+    if (!s) return NULL;
+
+    s->count = count;
+    s->emitting = 1;
+    ParticleEmitterConfig defaults;
+    if (!config) {
+        particle_config_defaults(&defaults);
+        config = &defaults;
+    }
+    gpu_particles_configure(s, config);
+    gpu_particles_set_texture(s, texture);
+
+    ensure_renderer();
+    glGenBuffers(2, s->vbo);
+    glGenVertexArrays(2, s->update_vao);
+    glGenVertexArrays(2, s->render_vao);
+    upload_initial_state(s);
+    for (int b = 0; b < 2; b++) {
+        setup_state_attributes(s->update_vao[b], s->vbo[b], 0);
+        setup_state_attributes(s->render_vao[b], s->vbo[b], 1);
+    }
+    return s;
+}
+
+void gpu_particles_destroy(GpuParticleSystem* system) {
+    if (!system) return;
+    glDeleteVertexArrays(2, system->render_vao);
+    glDeleteVertexArrays(2, system->update_vao);
+    glDeleteBuffers(2, system->vbo);
+    if (system->texture) texture_release(system->texture);
+    free(system);
+}
+
+void gpu_particles_configure(GpuParticleSystem* system, const ParticleEmitterConfig* config) {
+    system->config = *config;
+    sanitize_config(&system->config);
+}
+
+void gpu_particles_set_texture(GpuParticleSystem* system, Texture* texture) {
+    if (texture) texture_retain(texture);
+    if (system->texture) texture_release(system->texture);
+    system->texture = texture;
+}
+
+void gpu_particles_reset(GpuParticleSystem* system) {
+    upload_initial_state(system);
+}
+
+void gpu_particles_update(GpuParticleSystem* s, float dt) {
+    if (dt <= 0.0f) return;
+    ensure_renderer();
+    const ParticleEmitterConfig* c = &s->config;
+
+    glUseProgram(pt_state.update);
+    glUniform1f(pt_state.dt_loc, dt);
+    glUniform1ui(pt_state.frame_loc, ++s->frame);
+    glUniform1i(pt_state.emitting_loc, s->emitting);
+    glUniform2f(pt_state.origin_loc, c->x, c->y);
+    glUniform1i(pt_state.shape_loc, (int)c->shape);
+    glUniform1f(pt_state.radius_loc, c->radius);
+    glUniform2f(pt_state.area_loc, c->width, c->height);
+    glUniform1i(pt_state.radial_loc, c->radial);
+    glUniform1f(pt_state.angle_loc, c->angle * DEG2RAD);
+    glUniform1f(pt_state.spread_loc, c->spread * DEG2RAD);
+    glUniform2f(pt_state.speed_loc, c->speed_min, c->speed_max);
+    glUniform2f(pt_state.life_loc, c->life_min, c->life_max);
+    glUniform2f(pt_state.gravity_loc, c->gravity_x, c->gravity_y);
+    glUniform1f(pt_state.damp_loc, expf(-c->drag * dt));
+
+    // Read the current buffer, capture into the other one; nothing is rasterized
+    int next = 1 - s->current;
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindVertexArray(s->update_vao[s->current]);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, s->vbo[next]);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, s->count);
+    glEndTransformFeedback();
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glBindVertexArray(0);
+    glDisable(GL_RASTERIZER_DISCARD);
+    glUseProgram(0);
+
+    s->current = next;
+}
+
+void gpu_particles_prewarm(GpuParticleSystem* system, float seconds) {
+    int steps = (int)ceilf(seconds / GPU_PREWARM_STEP);
+    if (steps > 1800) steps = 1800;  // one minute of simulation
+    for (int i = 0; i < steps; i++) {
+        gpu_particles_update(system, GPU_PREWARM_STEP);
+    }
+}
+
+void gpu_particles_draw(GpuParticleSystem* s) {
+    ensure_renderer();
+    const ParticleEmitterConfig* c = &s->config;
+    int additive = begin_draw(&pt_state.gpu, s->texture, c->additive);
+
+    glUniform4fv(pt_state.gpu_colors_loc, PARTICLE_CURVE_KEYS, &c->colors[0][0]);
+    glUniform1i(pt_state.gpu_color_count_loc, c->color_count);
+    glUniform1fv(pt_state.gpu_sizes_loc, PARTICLE_CURVE_KEYS, c->sizes);
+    glUniform1i(pt_state.gpu_size_count_loc, c->size_count);
+    glUniform2f(pt_state.gpu_spin_loc, c->spin_min * DEG2RAD, c->spin_max * DEG2RAD);
+
+    glBindVertexArray(s->render_vao[s->current]);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, s->count);
+    end_draw(additive);
+}
@@ -0,0 +1,146 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <glad/glad.h>
+#include <stdint.h>
+#include "texture.h"
+
+// CPU particle emitters.
+//
+// Particle state lives in structure-of-arrays pools (one float array per
+// attribute) so the per-frame integration runs on SSE2 / AVX2 / NEON vectors,
+// following the level chosen by pixel_ops_get_level(). Dead particles are
+// swap-removed, keeping the live range dense.
+//
+// Color and size over life are sampled from lookup tables baked when the
+// curves change. Each emitter renders with a single instanced draw call.
+//
+// GPU particle systems use the same configuration but keep their state in
+// two vertex buffers on the GPU: a vertex shader simulates every particle
+// and writes the result into the other buffer with transform feedback, and
+// drawing reads that buffer directly. Each particle respawns when it dies,
+// so the pool size and lifetime set the density; the CPU only uploads
+// uniforms.
+
+#define PARTICLE_CURVE_KEYS 8
+#define PARTICLE_LUT_SIZE 256
+
+typedef enum {
+    PARTICLE_SHAPE_POINT = 0,
+    PARTICLE_SHAPE_CIRCLE,    // anywhere inside radius
+    PARTICLE_SHAPE_RING,      // on the circle of radius
+    PARTICLE_SHAPE_RECT,      // inside width x height, centered
+    PARTICLE_SHAPE_LINE       // along width, centered
+} ParticleShape;
+
+typedef struct {
+    // Emission
+    float x, y;
+    float rate;               // particles per second (0 = burst only)
+    ParticleShape shape;
+    float radius;
+    float width, height;
+    int radial;               // launch away from the center instead of along angle
+
+    // Launch
+    float angle, spread;      // degrees
+    float speed_min, speed_max;
+    float life_min, life_max; // seconds
+    float spin_min, spin_max; // degrees per second
+
+    // Forces
+    float gravity_x, gravity_y;
+    float drag;               // velocity damping per second
+
+    // Over life (evenly spaced keys from birth to death)
+    float colors[PARTICLE_CURVE_KEYS][4];
+    int color_count;
+    float sizes[PARTICLE_CURVE_KEYS];
+    int size_count;
+
+    int additive;
+} ParticleEmitterConfig;
+
+typedef struct {
+    ParticleEmitterConfig config;
+    Texture* texture;         // retained; NULL = soft round dots
+
+    // SoA pools (capacity floats each, 32-byte aligned)
+    float* x; float* y;
+    float* vx; float* vy;
+    float* age;               // 0 at birth, 1 at death
+    float* age_rate;          // 1 / lifetime
+    float* rotation;          // radians
+    float* spin;              // radians per second
+    void* block;
+    int count;
+    int capacity;
+
+    int emitting;
+    float emit_accum;
+    uint32_t rng;
+
+    // Baked curves
+    float color_lut[PARTICLE_LUT_SIZE][4];
+    float size_lut[PARTICLE_LUT_SIZE];
+
+    // Rendering
+    float* instances;         // per-particle draw data staged for upload
+    GLuint vao;
+    GLuint vbo;
+} ParticleEmitter;
+
+// Defaults: point shape, 50 particles/s, upward-ish launch, white fading out
+void particle_config_defaults(ParticleEmitterConfig* config);
+
+ParticleEmitter* particle_emitter_create(int capacity, const ParticleEmitterConfig* config, Texture* texture);
+void particle_emitter_destroy(ParticleEmitter* emitter);
+
+// Replace the configuration (rebakes the curves)
+void particle_emitter_configure(ParticleEmitter* emitter, const ParticleEmitterConfig* config);
+void particle_emitter_set_texture(ParticleEmitter* emitter, Texture* texture);
+
+// Spawn up to n particles now. Returns how many fit in the pool.
+int particle_emitter_emit(ParticleEmitter* emitter, int n);
+
+// Emit by rate, integrate forces and retire dead particles
+void particle_emitter_update(ParticleEmitter* emitter, float dt);
+
+// Draw every live particle in one instanced call
+void particle_emitter_draw(ParticleEmitter* emitter);
+
+void particle_emitter_clear(ParticleEmitter* emitter);
+
+typedef struct {
+    ParticleEmitterConfig config;
+    Texture* texture;         // retained; NULL = soft round dots
+    int count;
+    int emitting;
+
+    GLuint vbo[2];            // ping-pong particle state
+    GLuint update_vao[2];     // reads vbo[i] as vertices
+    GLuint render_vao[2];     // reads vbo[i] as instances
+    int current;              // buffer holding the latest state
+    unsigned int frame;       // feeds the shader's random numbers
+} GpuParticleSystem;
+
+// Create `count` particles that start dead and spawn over their first lifetime
+GpuParticleSystem* gpu_particles_create(int count, const ParticleEmitterConfig* config, Texture* texture);
+void gpu_particles_destroy(GpuParticleSystem* system);
+
+void gpu_particles_configure(GpuParticleSystem* system, const ParticleEmitterConfig* config);
+void gpu_particles_set_texture(GpuParticleSystem* system, Texture* texture);
+
+// Kill every particle and restart the staggered spawn
+void gpu_particles_reset(GpuParticleSystem* system);
+
+// One simulation step on the GPU (no pixels are drawn)
+void gpu_particles_update(GpuParticleSystem* system, float dt);
+
+// Run `seconds` of simulation in fixed steps, e.g. so rain is already falling
+void gpu_particles_prewarm(GpuParticleSystem* system, float seconds);
+
+// Draw every live particle in one instanced call
+void gpu_particles_draw(GpuParticleSystem* system);
+
+#endif // PARTICLES_H
@@ -0,0 +1,480 @@
+#include "pixel_ops.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define PIXEL_OPS_X86 1
+#include <emmintrin.h>
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define PIXEL_OPS_ARM_NEON 1
+#include <arm_neon.h>
+#endif
+
+// AVX2 functions are compiled for AVX2 regardless of the global -m flags and
+// only called after a runtime CPU check.
+#if defined(PIXEL_OPS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PIXEL_OPS_HAS_AVX2 1
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+static int g_level = -1;
+
+// Exact round(c * a / 255) without a division
+static inline unsigned char mul_div255(unsigned int c, unsigned int a) {
+    unsigned int t = c * a + 128;
+    return (unsigned char)((t + (t >> 8)) >> 8);
+}
+
+// ---------------------------------------------------------------------------
+// Scalar reference implementations
+// ---------------------------------------------------------------------------
+
+static void colorkey_scalar(unsigned char* p, size_t n, unsigned char r, unsigned char g, unsigned char b) {
+    for (size_t i = 0; i < n; i++, p += 4) {
+        if (p[0] == r && p[1] == g && p[2] == b) {
+            p[3] = 0;
+        }
+    }
+}
+
+static void premultiply_scalar(unsigned char* p, size_t n) {
+    for (size_t i = 0; i < n; i++, p += 4) {
+        unsigned int a = p[3];
+        p[0] = mul_div255(p[0], a);
+        p[1] = mul_div255(p[1], a);
+        p[2] = mul_div255(p[2], a);
+    }
+}
+
+static void swizzle_scalar(unsigned char* p, size_t n, const int order[4]) {
+    for (size_t i = 0; i < n; i++, p += 4) {
+        unsigned char px[4] = {p[0], p[1], p[2], p[3]};
+        p[0] = px[order[0]];
+        p[1] = px[order[1]];
+        p[2] = px[order[2]];
+        p[3] = px[order[3]];
+    }
+}
+
+// ---------------------------------------------------------------------------
+// SSE2 (4 pixels per iteration)
+// ---------------------------------------------------------------------------
+
+#ifdef PIXEL_OPS_X86
+static void colorkey_sse2(unsigned char* p, size_t n, unsigned char r, unsigned char g, unsigned char b) {
+    const __m128i rgb_mask = _mm_set1_epi32(0x00FFFFFF);
+    const __m128i alpha_mask = _mm_set1_epi32((int)0xFF000000u);
+    const __m128i key = _mm_set1_epi32((int)((uint32_t)r | ((uint32_t)g << 8) | ((uint32_t)b << 16)));
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i px = _mm_loadu_si128((const __m128i*)(p + i * 4));
+        __m128i hit = _mm_cmpeq_epi32(_mm_and_si128(px, rgb_mask), key);
+        px = _mm_andnot_si128(_mm_and_si128(hit, alpha_mask), px);
+        _mm_storeu_si128((__m128i*)(p + i * 4), px);
+    }
+    colorkey_scalar(p + i * 4, n - i, r, g, b);
+}
+
+// Multiply 8 16-bit channels by their pixel's alpha (alpha lanes keep alpha)
+static inline __m128i premultiply_lanes_sse2(__m128i c16) {
+    const __m128i alpha_lanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    const __m128i v255 = _mm_set1_epi16(255);
+    const __m128i v128 = _mm_set1_epi16(128);
+
+    __m128i a = _mm_shufflelo_epi16(c16, _MM_SHUFFLE(3, 3, 3, 3));
+    a = _mm_shufflehi_epi16(a, _MM_SHUFFLE(3, 3, 3, 3));
+    // Alpha channel is multiplied by 255 so it comes back unchanged
+    a = _mm_or_si128(_mm_andnot_si128(alpha_lanes, a), _mm_and_si128(alpha_lanes, v255));
+
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(c16, a), v128);
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+static void premultiply_sse2(unsigned char* p, size_t n) {
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i px = _mm_loadu_si128((const __m128i*)(p + i * 4));
+        __m128i lo = premultiply_lanes_sse2(_mm_unpacklo_epi8(px, zero));
+        __m128i hi = premultiply_lanes_sse2(_mm_unpackhi_epi8(px, zero));
+        _mm_storeu_si128((__m128i*)(p + i * 4), _mm_packus_epi16(lo, hi));
+    }
+    premultiply_scalar(p + i * 4, n - i);
+}
+
+// SSE2 has no byte shuffle: handle the common R<->B swap with shifts/masks
+static void swizzle_sse2(unsigned char* p, size_t n, const int order[4]) {
+    if (!(order[0] == 2 && order[1] == 1 && order[2] == 0 && order[3] == 3)) {
+        swizzle_scalar(p, n, order);
+        return;
+    }
+
+    const __m128i keep = _mm_set1_epi32((int)0xFF00FF00u);
+    const __m128i low = _mm_set1_epi32(0x000000FF);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i px = _mm_loadu_si128((const __m128i*)(p + i * 4));
+        __m128i r = _mm_slli_epi32(_mm_and_si128(px, low), 16);
+        __m128i b = _mm_and_si128(_mm_srli_epi32(px, 16), low);
+        px = _mm_or_si128(_mm_and_si128(px, keep), _mm_or_si128(r, b));
+        _mm_storeu_si128((__m128i*)(p + i * 4), px);
+    }
+    swizzle_scalar(p + i * 4, n - i, order);
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// AVX2 (8 pixels per iteration)
+// ---------------------------------------------------------------------------
+
+#ifdef PIXEL_OPS_HAS_AVX2
+TARGET_AVX2
+static void colorkey_avx2(unsigned char* p, size_t n, unsigned char r, unsigned char g, unsigned char b) {
+    const __m256i rgb_mask = _mm256_set1_epi32(0x00FFFFFF);
+    const __m256i alpha_mask = _mm256_set1_epi32((int)0xFF000000u);
+    const __m256i key = _mm256_set1_epi32((int)((uint32_t)r | ((uint32_t)g << 8) | ((uint32_t)b << 16)));
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i px = _mm256_loadu_si256((const __m256i*)(p + i * 4));
+        __m256i hit = _mm256_cmpeq_epi32(_mm256_and_si256(px, rgb_mask), key);
+        px = _mm256_andnot_si256(_mm256_and_si256(hit, alpha_mask), px);
+        _mm256_storeu_si256((__m256i*)(p + i * 4), px);
+    }
+    colorkey_scalar(p + i * 4, n - i, r, g, b);
+}
+
+TARGET_AVX2
+static inline __m256i premultiply_lanes_avx2(__m256i c16) {
+    const __m256i alpha_lanes = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+    const __m256i v255 = _mm256_set1_epi16(255);
+    const __m256i v128 = _mm256_set1_epi16(128);
+
+    __m256i a = _mm256_shufflelo_epi16(c16, _MM_SHUFFLE(3, 3, 3, 3));
+    a = _mm256_shufflehi_epi16(a, _MM_SHUFFLE(3, 3, 3, 3));
+    a = _mm256_or_si256(_mm256_andnot_si256(alpha_lanes, a), _mm256_and_si256(alpha_lanes, v255));
+
+    __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(c16, a), v128);
+    return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+TARGET_AVX2
+static void premultiply_avx2(unsigned char* p, size_t n) {
+    const __m256i zero = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        // unpack/pack work per 128-bit lane, so the pixel order round-trips
+        __m256i px = _mm256_loadu_si256((const __m256i*)(p + i * 4));
+        __m256i lo = premultiply_lanes_avx2(_mm256_unpacklo_epi8(px, zero));
+        __m256i hi = premultiply_lanes_avx2(_mm256_unpackhi_epi8(px, zero));
+        _mm256_storeu_si256((__m256i*)(p + i * 4), _mm256_packus_epi16(lo, hi));
+    }
+    premultiply_scalar(p + i * 4, n - i);
+}
+
+TARGET_AVX2
+static void swizzle_avx2(unsigned char* p, size_t n, const int order[4]) {
+    char idx[32];
+    for (int px = 0; px < 8; px++) {
+        for (int c = 0; c < 4; c++) {
+            idx[px * 4 + c] = (char)((px % 4) * 4 + order[c]);  // per 128-bit lane
+        }
+    }
+    const __m256i shuffle = _mm256_loadu_si256((const __m256i*)idx);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i px = _mm256_loadu_si256((const __m256i*)(p + i * 4));
+        _mm256_storeu_si256((__m256i*)(p + i * 4), _mm256_shuffle_epi8(px, shuffle));
+    }
+    swizzle_scalar(p + i * 4, n - i, order);
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// NEON (16 pixels per iteration, deinterleaved loads)
+// ---------------------------------------------------------------------------
+
+#ifdef PIXEL_OPS_ARM_NEON
+static void colorkey_neon(unsigned char* p, size_t n, unsigned char r, unsigned char g, unsigned char b) {
+    const uint8x16_t kr = vdupq_n_u8(r);
+    const uint8x16_t kg = vdupq_n_u8(g);
+    const uint8x16_t kb = vdupq_n_u8(b);
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16x4_t px = vld4q_u8(p + i * 4);
+        uint8x16_t hit = vandq_u8(vandq_u8(vceqq_u8(px.val[0], kr), vceqq_u8(px.val[1], kg)),
+                                  vceqq_u8(px.val[2], kb));
+        px.val[3] = vbicq_u8(px.val[3], hit);
+        vst4q_u8(p + i * 4, px);
+    }
+    colorkey_scalar(p + i * 4, n - i, r, g, b);
+}
+
+// (t + ((t + 128) >> 8) + 128) >> 8 == round(c * a / 255)
+static inline uint8x8_t mul_div255_neon(uint8x8_t c, uint8x8_t a) {
+    uint16x8_t t = vmull_u8(c, a);
+    return vraddhn_u16(t, vrshrq_n_u16(t, 8));
+}
+
+static void premultiply_neon(unsigned char* p, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint8x8x4_t px = vld4_u8(p + i * 4);
+        px.val[0] = mul_div255_neon(px.val[0], px.val[3]);
+        px.val[1] = mul_div255_neon(px.val[1], px.val[3]);
+        px.val[2] = mul_div255_neon(px.val[2], px.val[3]);
+        vst4_u8(p + i * 4, px);
+    }
+    premultiply_scalar(p + i * 4, n - i);
+}
+
+static void swizzle_neon(unsigned char* p, size_t n, const int order[4]) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16x4_t in = vld4q_u8(p + i * 4);
+        uint8x16x4_t out;
+        out.val[0] = in.val[order[0]];
+        out.val[1] = in.val[order[1]];
+        out.val[2] = in.val[order[2]];
+        out.val[3] = in.val[order[3]];
+        vst4q_u8(p + i * 4, out);
+    }
+    swizzle_scalar(p + i * 4, n - i, order);
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Dispatch
+// ---------------------------------------------------------------------------
+
+PixelOpsLevel pixel_ops_detect(void) {
+#if defined(PIXEL_OPS_HAS_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return PIXEL_OPS_AVX2;
+    return PIXEL_OPS_SSE2;
+#elif defined(PIXEL_OPS_X86)
+    return PIXEL_OPS_SSE2;
+#elif defined(PIXEL_OPS_ARM_NEON)
+    return PIXEL_OPS_NEON;
+#else
+    return PIXEL_OPS_SCALAR;
+#endif
+}
+
+PixelOpsLevel pixel_ops_get_level(void) {
+    if (g_level < 0) g_level = (int)pixel_ops_detect();
+    return (PixelOpsLevel)g_level;
+}
+
+void pixel_ops_set_level(PixelOpsLevel level) {
+    PixelOpsLevel best = pixel_ops_detect();
+    if (level == PIXEL_OPS_SCALAR) {
+        g_level = PIXEL_OPS_SCALAR;
+    } else if (best == PIXEL_OPS_NEON) {
+        g_level = PIXEL_OPS_NEON;
+    } else if (level == PIXEL_OPS_NEON || level > best) {
+        g_level = (int)best;
+    } else {
+        g_level = (int)level;
+    }
+}
+
+const char* pixel_ops_level_name(PixelOpsLevel level) {
+    switch (level) {
+        case PIXEL_OPS_SSE2: return "sse2";
+        case PIXEL_OPS_AVX2: return "avx2";
+        case PIXEL_OPS_NEON: return "neon";
+        default:             return "scalar";
+    }
+}
+
+void pixels_colorkey(unsigned char* rgba, size_t pixel_count,
+                     unsigned char r, unsigned char g, unsigned char b) {
+    switch (pixel_ops_get_level()) {
+#ifdef PIXEL_OPS_HAS_AVX2
+        case PIXEL_OPS_AVX2: colorkey_avx2(rgba, pixel_count, r, g, b); return;
+#endif
+#ifdef PIXEL_OPS_X86
+        case PIXEL_OPS_SSE2: colorkey_sse2(rgba, pixel_count, r, g, b); return;
+#endif
+#ifdef PIXEL_OPS_ARM_NEON
+        case PIXEL_OPS_NEON: colorkey_neon(rgba, pixel_count, r, g, b); return;
+#endif
+        default: colorkey_scalar(rgba, pixel_count, r, g, b); return;
+    }
+}
+
+void pixels_premultiply(unsigned char* rgba, size_t pixel_count) {
+    switch (pixel_ops_get_level()) {
+#ifdef PIXEL_OPS_HAS_AVX2
+        case PIXEL_OPS_AVX2: premultiply_avx2(rgba, pixel_count); return;
+#endif
+#ifdef PIXEL_OPS_X86
+        case PIXEL_OPS_SSE2: premultiply_sse2(rgba, pixel_count); return;
+#endif
+#ifdef PIXEL_OPS_ARM_NEON
+        case PIXEL_OPS_NEON: premultiply_neon(rgba, pixel_count); return;
+#endif
+        default: premultiply_scalar(rgba, pixel_count); return;
+    }
+}
+
+void pixels_swizzle(unsigned char* rgba, size_t pixel_count, const int order[4]) {
+    for (int c = 0; c < 4; c++) {
+        if (order[c] < 0 || order[c] > 3) return;
+    }
+
+    switch (pixel_ops_get_level()) {
+#ifdef PIXEL_OPS_HAS_AVX2
+        case PIXEL_OPS_AVX2: swizzle_avx2(rgba, pixel_count, order); return;
+#endif
+#ifdef PIXEL_OPS_X86
+        case PIXEL_OPS_SSE2: swizzle_sse2(rgba, pixel_count, order); return;
+#endif
+#ifdef PIXEL_OPS_ARM_NEON
+        case PIXEL_OPS_NEON: swizzle_neon(rgba, pixel_count, order); return;
+#endif
+        default: swizzle_scalar(rgba, pixel_count, order); return;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Reduced-precision packing (load-time only; simple loops the compiler vectorizes)
+// ---------------------------------------------------------------------------
+
+// Round an 8-bit channel to `bits` bits
+static inline unsigned int quantize(unsigned int c, unsigned int max) {
+    return (c * max + 127) / 255;
+}
+
+void pixels_pack_r8(const unsigned char* rgba, size_t n, unsigned char* dst, int use_alpha) {
+    int channel = use_alpha ? 3 : 0;
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = rgba[i * 4 + channel];
+    }
+}
+
+void pixels_pack_rg8(const unsigned char* rgba, size_t n, unsigned char* dst) {
+    for (size_t i = 0; i < n; i++) {
+        const unsigned char* p = rgba + i * 4;
+        dst[i * 2 + 0] = (unsigned char)((77u * p[0] + 150u * p[1] + 29u * p[2] + 128u) >> 8);
+        dst[i * 2 + 1] = p[3];
+    }
+}
+
+void pixels_pack_rgb565(const unsigned char* rgba, size_t n, uint16_t* dst) {
+    for (size_t i = 0; i < n; i++) {
+        const unsigned char* p = rgba + i * 4;
+        dst[i] = (uint16_t)((quantize(p[0], 31) << 11) | (quantize(p[1], 63) << 5) | quantize(p[2], 31));
+    }
+}
+
+void pixels_pack_rgba4(const unsigned char* rgba, size_t n, uint16_t* dst) {
+    for (size_t i = 0; i < n; i++) {
+        const unsigned char* p = rgba + i * 4;
+        dst[i] = (uint16_t)((quantize(p[0], 15) << 12) | (quantize(p[1], 15) << 8) |
+                            (quantize(p[2], 15) << 4) | quantize(p[3], 15));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Mipmap downsampling
+// ---------------------------------------------------------------------------
+
+#define LINEAR_TO_SRGB_STEPS 4096
+
+static float g_srgb_to_linear[256];
+static unsigned char g_linear_to_srgb[LINEAR_TO_SRGB_STEPS + 1];
+static int g_gamma_tables_ready = 0;
+
+static void init_gamma_tables(void) {
+    if (g_gamma_tables_ready) return;
+
+    for (int i = 0; i < 256; i++) {
+        float c = (float)i / 255.0f;
+        g_srgb_to_linear[i] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+    }
+    for (int i = 0; i <= LINEAR_TO_SRGB_STEPS; i++) {
+        float l = (float)i / LINEAR_TO_SRGB_STEPS;
+        float c = l <= 0.0031308f ? l * 12.92f : 1.055f * powf(l, 1.0f / 2.4f) - 0.055f;
+        g_linear_to_srgb[i] = (unsigned char)(c * 255.0f + 0.5f);
+    }
+    g_gamma_tables_ready = 1;
+}
+
+static inline unsigned char linear_to_srgb(float l) {
+    if (l <= 0.0f) return 0;
+    if (l >= 1.0f) return 255;
+    return g_linear_to_srgb[(int)(l * LINEAR_TO_SRGB_STEPS + 0.5f)];
+}
+
+void pixels_downsample_box(const unsigned char* src, int width, int height,
+                           unsigned char* dst, int premultiplied) {
+    if (!src || !dst || width <= 0 || height <= 0) return;
+    init_gamma_tables();
+
+    int dw = width > 1 ? width / 2 : 1;
+    int dh = height > 1 ? height / 2 : 1;
+
+    for (int y = 0; y < dh; y++) {
+        int y0 = y * 2 < height ? y * 2 : height - 1;
+        int y1 = y * 2 + 1 < height ? y * 2 + 1 : height - 1;
+
+        for (int x = 0; x < dw; x++) {
+            int x0 = x * 2 < width ? x * 2 : width - 1;
+            int x1 = x * 2 + 1 < width ? x * 2 + 1 : width - 1;
+            const unsigned char* px[4] = {
+                src + ((size_t)y0 * width + x0) * 4, src + ((size_t)y0 * width + x1) * 4,
+                src + ((size_t)y1 * width + x0) * 4, src + ((size_t)y1 * width + x1) * 4,
+            };
+
+            float rgb[3] = {0.0f, 0.0f, 0.0f};
+            unsigned int alpha_sum = 0;
+            float weight_sum = 0.0f;
+            for (int i = 0; i < 4; i++) {
+                float w = premultiplied ? 1.0f : (float)px[i][3];
+                rgb[0] += g_srgb_to_linear[px[i][0]] * w;
+                rgb[1] += g_srgb_to_linear[px[i][1]] * w;
+                rgb[2] += g_srgb_to_linear[px[i][2]] * w;
+                weight_sum += w;
+                alpha_sum += px[i][3];
+            }
+
+            unsigned char* out = dst + ((size_t)y * dw + x) * 4;
+            for (int c = 0; c < 3; c++) {
+                out[c] = weight_sum > 0.0f ? linear_to_srgb(rgb[c] / weight_sum) : 0;
+            }
+            out[3] = (unsigned char)((alpha_sum + 2) / 4);
+        }
+    }
+}
+
+// Row swaps are plain memcpy, which libc already vectorizes
+void pixels_flip_vertical(unsigned char* data, int width, int height, int bytes_per_pixel) {
+    if (!data || width <= 0 || height <= 1 || bytes_per_pixel <= 0) return;
+
+    size_t stride = (size_t)width * (size_t)bytes_per_pixel;
+    unsigned char* tmp = (unsigned char*)malloc(stride);
+    if (!tmp) return;
+
+    for (int y = 0; y < height / 2; y++) {
+        unsigned char* top = data + (size_t)y * stride;
+        unsigned char* bottom = data + (size_t)(height - 1 - y) * stride;
+        memcpy(tmp, top, stride);
+        memcpy(top, bottom, stride);
+        memcpy(bottom, tmp, stride);
+    }
+
+    free(tmp);
+}
@@ -0,0 +1,59 @@
+#ifndef PIXEL_OPS_H
+#define PIXEL_OPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// CPU pixel pipeline for RGBA8 image data.
+//
+// Each operation has a scalar reference implementation plus SSE2 / AVX2
+// (x86, selected at runtime) and NEON (ARM, selected at compile time)
+// variants that produce bit-identical results.
+
+typedef enum {
+    PIXEL_OPS_SCALAR = 0,
+    PIXEL_OPS_SSE2,
+    PIXEL_OPS_AVX2,
+    PIXEL_OPS_NEON
+} PixelOpsLevel;
+
+// Best level supported by this CPU/build
+PixelOpsLevel pixel_ops_detect(void);
+
+// Level currently used by the pixel_* functions (defaults to pixel_ops_detect())
+PixelOpsLevel pixel_ops_get_level(void);
+
+// Force a level (clamped to what the CPU supports). Used by benchmarks/tests.
+void pixel_ops_set_level(PixelOpsLevel level);
+
+const char* pixel_ops_level_name(PixelOpsLevel level);
+
+// Set alpha to 0 for every pixel whose RGB equals (r, g, b)
+void pixels_colorkey(unsigned char* rgba, size_t pixel_count,
+                     unsigned char r, unsigned char g, unsigned char b);
+
+// Multiply RGB by alpha (rounded, exact division by 255)
+void pixels_premultiply(unsigned char* rgba, size_t pixel_count);
+
+// Reorder channels: out[i] = in[order[i]] for each pixel (e.g. {2,1,0,3} = RGBA<->BGRA)
+void pixels_swizzle(unsigned char* rgba, size_t pixel_count, const int order[4]);
+
+// Gamma-correct 2x2 box downsample of an RGBA8 image to (max(w/2,1), max(h/2,1)).
+// Color is averaged in linear light; straight-alpha input is alpha weighted so
+// transparent texels do not darken edges.
+void pixels_downsample_box(const unsigned char* src, int width, int height,
+                           unsigned char* dst, int premultiplied);
+
+// Pack RGBA8 pixels into reduced-precision layouts (rounded to nearest).
+// r8: one byte per pixel, taken from alpha (use_alpha) or from red.
+// rg8: luma (Rec.601) + alpha.
+// rgb565 / rgba4: native-endian 16-bit words, red in the high bits (GL order).
+void pixels_pack_r8(const unsigned char* rgba, size_t pixel_count, unsigned char* dst, int use_alpha);
+void pixels_pack_rg8(const unsigned char* rgba, size_t pixel_count, unsigned char* dst);
+void pixels_pack_rgb565(const unsigned char* rgba, size_t pixel_count, uint16_t* dst);
+void pixels_pack_rgba4(const unsigned char* rgba, size_t pixel_count, uint16_t* dst);
+
+// Flip rows in place (top <-> bottom)
+void pixels_flip_vertical(unsigned char* data, int width, int height, int bytes_per_pixel);
+
+#endif // PIXEL_OPS_H
@@ -1,6 +1,7 @@
 #include "renderer.h"
 #include "texture.h"
 #include "camera.h"
+#include "texture_memory.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -12,6 +13,10 @@ extern void texture_renderer_flush(void);
 // External function from text.c
 extern void text_renderer_set_screen_size(int width, int height);
 extern void text_renderer_flush(void);
+extern void text_renderer_begin_frame(void);
+
+// External function from ui.c
+extern void ui_flush(void);
 
 // Shader sources
 static const char* vertex_shader_src = 
@@ -20,9 +25,10 @@ static const char* vertex_shader_src =
     "layout (location = 1) in vec4 aColor;\n"
     "out vec4 vertexColor;\n"
     "uniform mat4 projection;\n"
+    "uniform bool premultiplied;\n"
     "void main() {\n"
     "    gl_Position = projection * vec4(aPos, 0.0, 1.0);\n"
-    "    vertexColor = aColor;\n"
+    "    vertexColor = premultiplied ? vec4(aColor.rgb * aColor.a, aColor.a) : aColor;\n"
     "}\n";
 
 static const char* fragment_shader_src = 
@@ -42,6 +48,7 @@ typedef struct {
     GLuint vbo;
     GLuint shader;
     GLint projection_loc;
+    GLint premultiplied_loc;
     
     float vertices[MAX_VERTICES * VERTEX_SIZE];
     int vertex_count;
@@ -56,6 +63,9 @@ static RendererState state = {0};
 // Active batch tracking for draw-order preservation across renderers
 static ActiveBatchType g_active_batch = BATCH_NONE;
 
+// Blend mode shared by the primitive, texture and text renderers
+static int g_premultiplied_alpha = 0;
+
 // Shader compilation helper
 static GLuint compile_shader(GLenum type, const char* source) {
     GLuint shader = glCreateShader(type);
@@ -117,6 +127,7 @@ void renderer_init(void) {
     // Create shader program
     state.shader = create_shader_program();
     state.projection_loc = glGetUniformLocation(state.shader, "projection");
+    state.premultiplied_loc = glGetUniformLocation(state.shader, "premultiplied");
     
     // Create VAO and VBO
     glGenVertexArrays(1, &state.vao);
@@ -140,8 +151,7 @@ void renderer_init(void) {
     // Enable features
     glDisable(GL_DEPTH_TEST);
     glDepthMask(GL_FALSE);  // Don't write to depth buffer (2D engine)
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    renderer_apply_blend();
     glEnable(GL_PROGRAM_POINT_SIZE);
     
     state.vertex_count = 0;
@@ -171,11 +181,15 @@ void renderer_begin(int screen_width, int screen_height) {
     state.vertex_count = 0;
     g_active_batch = BATCH_NONE;
     
+    // Advance the texture LRU clock and apply the memory budget between frames
+    texture_memory_begin_frame();
+    
     // Update texture renderer screen size too
     texture_renderer_set_screen_size(screen_width, screen_height);
     
     // Update text renderer screen size too
     text_renderer_set_screen_size(screen_width, screen_height);
+    text_renderer_begin_frame();
     
     // Create projection * view matrix (incorporates camera transform)
     float projection[16];
@@ -189,6 +203,7 @@ void renderer_flush(void) {
     if (state.vertex_count == 0) return;
     
     glUseProgram(state.shader);
+    glUniform1i(state.premultiplied_loc, g_premultiplied_alpha);
     glBindVertexArray(state.vao);
     glBindBuffer(GL_ARRAY_BUFFER, state.vbo);
     glBufferSubData(GL_ARRAY_BUFFER, 0, state.vertex_count * VERTEX_SIZE * sizeof(float), state.vertices);
@@ -346,6 +361,7 @@ void renderer_switch_batch(ActiveBatchType new_batch) {
         case BATCH_PRIMITIVES: renderer_flush(); break;
         case BATCH_TEXTURES:   texture_renderer_flush(); break;
         case BATCH_TEXT:        text_renderer_flush(); break;
+        case BATCH_UI:          ui_flush(); break;
         default: break;
     }
 
@@ -360,6 +376,11 @@ int renderer_is_ui_mode(void) {
     return g_ui_mode;
 }
 
+void renderer_get_screen_size(int* width, int* height) {
+    *width = state.screen_width;
+    *height = state.screen_height;
+}
+
 void renderer_get_ui_projection(float* out, int screen_width, int screen_height) {
     float sw = (float)screen_width;
     float sh = (float)screen_height;
@@ -370,6 +391,32 @@ void renderer_get_ui_projection(float* out, int screen_width, int screen_height)
     out[12] = -1.0f;      out[13] =  1.0f;       out[14] =  0.0f; out[15] = 1.0f;
 }
 
+// --- Premultiplied alpha ---
+
+void renderer_set_premultiplied_alpha(int enabled) {
+    enabled = enabled ? 1 : 0;
+    if (enabled == g_premultiplied_alpha) return;
+
+    // Geometry already batched was built for the old blend mode
+    renderer_flush();
+    texture_renderer_flush();
+    text_renderer_flush();
+    ui_flush();
+
+    g_premultiplied_alpha = enabled;
+    renderer_apply_blend();
+    printf("[Renderer] Premultiplied alpha %s\n", enabled ? "enabled" : "disabled");
+}
+
+int renderer_get_premultiplied_alpha(void) {
+    return g_premultiplied_alpha;
+}
+
+void renderer_apply_blend(void) {
+    glEnable(GL_BLEND);
+    glBlendFunc(g_premultiplied_alpha ? GL_ONE : GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
 // --- UI Rendering (screen-space, ignores camera) ---
 
 void renderer_begin_ui(int screen_width, int screen_height) {
@@ -377,6 +424,7 @@ void renderer_begin_ui(int screen_width, int screen_height) {
     renderer_flush();
     texture_renderer_flush();
     text_renderer_flush();
+    ui_flush();
     g_active_batch = BATCH_NONE;
 
     // Enter UI mode
@@ -401,6 +449,7 @@ void renderer_end_ui(void) {
     renderer_flush();
     texture_renderer_flush();
     text_renderer_flush();
+    ui_flush();
     g_active_batch = BATCH_NONE;
 
     // Exit UI mode
@@ -57,6 +57,7 @@ void renderer_end_ui(void);
 
 // Shared rendering state — queried by text/texture renderers
 int renderer_is_ui_mode(void);
+void renderer_get_screen_size(int* width, int* height);
 void renderer_get_ui_projection(float* out, int screen_width, int screen_height);
 
 // Active batch tracking — ensures correct draw order across renderers
@@ -64,13 +65,24 @@ typedef enum {
     BATCH_NONE = 0,
     BATCH_PRIMITIVES,
     BATCH_TEXTURES,
-    BATCH_TEXT
+    BATCH_TEXT,
+    BATCH_UI                // ui.c draw list
 } ActiveBatchType;
 
 // Call before adding geometry to a batch. Automatically flushes the previous
 // batch if a different renderer was active, preserving painter's-algorithm order.
 void renderer_switch_batch(ActiveBatchType new_batch);
 
+// Premultiplied-alpha mode (off by default). When enabled, blending uses
+// GL_ONE / GL_ONE_MINUS_SRC_ALPHA, vertex and tint colors are premultiplied in
+// the shaders, and newly loaded textures are premultiplied on the CPU.
+// Switching flushes all pending batches.
+void renderer_set_premultiplied_alpha(int enabled);
+int renderer_get_premultiplied_alpha(void);
+
+// Enable blending with the blend function for the current alpha mode
+void renderer_apply_blend(void);
+
 // Gradient rectangle
 void render_rect_gradient(int x, int y, int width, int height, Color top_color, Color bottom_color);
 
@@ -0,0 +1,474 @@
+#include "sprite.h"
+#include "texture_registry.h"
+#include "../util/json.h"
+#include "../platform/filemap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SPRITE_DEFAULT_DURATION 0.1f   // seconds, for frames without timing
+#define SPRITE_MAX_STEPS 256           // frame advances per update (large dt guard)
+
+// --- Sheets ---
+
+static SpriteSheet* sheet_alloc(Texture* texture, int frame_count) {
+    SpriteSheet* sheet = (SpriteSheet*)calloc(1, sizeof(SpriteSheet));
+    if (!sheet) return NULL;
+    sheet->frames = (SpriteFrame*)calloc((size_t)(frame_count > 0 ? frame_count : 1), sizeof(SpriteFrame));
+    sheet->frame_names = (char**)calloc((size_t)(frame_count > 0 ? frame_count : 1), sizeof(char*));
+    if (!sheet->frames || !sheet->frame_names) {
+        free(sheet->frames);
+        free(sheet->frame_names);
+        free(sheet);
+        return NULL;
+    }
+    sheet->texture = texture;
+    sheet->refcount = 1;
+    return sheet;
+}
+
+// Fill a frame's rect and precompute its UVs
+static void set_frame_rect(SpriteFrame* frame, const Texture* texture, int x, int y, int w, int h) {
+    frame->x = x;
+    frame->y = y;
+    frame->w = w;
+    frame->h = h;
+    frame->u0 = (float)x / texture->width;
+    frame->v0 = (float)y / texture->height;
+    frame->u1 = (float)(x + w) / texture->width;
+    frame->v1 = (float)(y + h) / texture->height;
+    frame->source_w = w;
+    frame->source_h = h;
+}
+
+SpriteSheet* sprite_sheet_create_grid(Texture* texture, int frame_w, int frame_h,
+                                      int margin, int spacing, int count) {
+    if (!texture || frame_w <= 0 || frame_h <= 0 || margin < 0 || spacing < 0) return NULL;
+
+    int cols = (texture->width - 2 * margin + spacing) / (frame_w + spacing);
+    int rows = (texture->height - 2 * margin + spacing) / (frame_h + spacing);
+    int total = cols * rows;
+    if (total <= 0) return NULL;
+    if (count > 0 && count < total) total = count;
+
+    SpriteSheet* sheet = sheet_alloc(texture, total);
+    if (!sheet) return NULL;
+    texture_retain(texture);
+
+    for (int i = 0; i < total; i++) {
+        int x = margin + (i % cols) * (frame_w + spacing);
+        int y = margin + (i / cols) * (frame_h + spacing);
+        set_frame_rect(&sheet->frames[i], texture, x, y, frame_w, frame_h);
+    }
+    sheet->frame_count = total;
+    return sheet;
+}
+
+static void json_rect(const JsonValue* rect, int* x, int* y, int* w, int* h) {
+    *x = (int)json_get_number(rect, "x", 0);
+    *y = (int)json_get_number(rect, "y", 0);
+    *w = (int)json_get_number(rect, "w", 0);
+    *h = (int)json_get_number(rect, "h", 0);
+}
+
+// Load "meta.image" next to the JSON file
+static Texture* load_atlas_image(const char* json_path, const char* image) {
+    char path[1024];
+    file_resolve_relative(json_path, image, path, sizeof(path));
+    return texture_registry_acquire(path, NULL);
+}
+
+static SpriteLoopMode parse_direction(const char* direction, int* reverse) {
+    *reverse = 0;
+    if (strcmp(direction, "reverse") == 0) {
+        *reverse = 1;
+        return SPRITE_LOOP_REPEAT;
+    }
+    if (strcmp(direction, "pingpong") == 0) return SPRITE_LOOP_PINGPONG;
+    if (strcmp(direction, "pingpong_reverse") == 0) {
+        *reverse = 1;
+        return SPRITE_LOOP_PINGPONG;
+    }
+    return SPRITE_LOOP_REPEAT;
+}
+
+SpriteSheet* sprite_sheet_load_json(const char* json_path, Texture* texture, char* err, size_t err_size) {
+    JsonValue* root = json_parse_file(json_path, err, err_size);
+    if (!root) return NULL;
+
+    const JsonValue* frames = json_get(root, "frames");
+    const JsonValue* meta = json_get(root, "meta");
+    if (!frames || (frames->type != JSON_OBJECT && frames->type != JSON_ARRAY) || frames->count == 0) {
+        snprintf(err, err_size, "Atlas has no frames");
+        json_free(root);
+        return NULL;
+    }
+
+    int owns_texture = 0;
+    if (!texture) {
+        const char* image = json_get_string(meta, "image", NULL);
+        if (!image) {
+            snprintf(err, err_size, "Atlas has no meta.image and no texture was given");
+            json_free(root);
+            return NULL;
+        }
+        texture = load_atlas_image(json_path, image);
+        if (!texture) {
+            snprintf(err, err_size, "Failed to load atlas image: %s", image);
+            json_free(root);
+            return NULL;
+        }
+        owns_texture = 1;
+    }
+
+    SpriteSheet* sheet = sheet_alloc(texture, (int)frames->count);
+    if (!sheet) {
+        if (owns_texture) texture_release(texture);
+        json_free(root);
+        snprintf(err, err_size, "Out of memory");
+        return NULL;
+    }
+    if (!owns_texture) texture_retain(texture);
+
+    int warned_rotated = 0;
+    for (size_t i = 0; i < frames->count; i++) {
+        const JsonValue* entry = &frames->items[i];
+        const char* name = frames->type == JSON_OBJECT ? frames->keys[i]
+                                                       : json_get_string(entry, "filename", NULL);
+        SpriteFrame* frame = &sheet->frames[i];
+        int x, y, w, h;
+        json_rect(json_get(entry, "frame"), &x, &y, &w, &h);
+        set_frame_rect(frame, texture, x, y, w, h);
+
+        if (json_bool(json_get(entry, "rotated"), 0) && !warned_rotated) {
+            fprintf(stderr, "[Sprite] Rotated atlas frames are not supported: %s\n", json_path);
+            warned_rotated = 1;
+        }
+        if (json_bool(json_get(entry, "trimmed"), 0)) {
+            int sx, sy, sw, sh;
+            json_rect(json_get(entry, "spriteSourceSize"), &sx, &sy, &sw, &sh);
+            const JsonValue* source = json_get(entry, "sourceSize");
+            frame->offset_x = (float)sx;
+            frame->offset_y = (float)sy;
+            frame->source_w = (int)json_get_number(source, "w", w);
+            frame->source_h = (int)json_get_number(source, "h", h);
+        }
+        frame->duration = (float)json_get_number(entry, "duration", 0) / 1000.0f;  // Aseprite: ms
+        if (name) {
+            size_t len = strlen(name);
+            sheet->frame_names[i] = (char*)malloc(len + 1);
+            if (sheet->frame_names[i]) memcpy(sheet->frame_names[i], name, len + 1);
+        }
+    }
+    sheet->frame_count = (int)frames->count;
+
+    // Aseprite tags -> clips (timed by the per-frame durations)
+    const JsonValue* tags = json_get(meta, "frameTags");
+    for (size_t t = 0; tags && t < tags->count; t++) {
+        const JsonValue* tag = &tags->items[t];
+        const char* name = json_get_string(tag, "name", NULL);
+        int from = (int)json_get_number(tag, "from", 0);
+        int to = (int)json_get_number(tag, "to", 0);
+        if (!name || from < 0 || to < from || to >= sheet->frame_count) continue;
+
+        int reverse;
+        SpriteLoopMode mode = parse_direction(json_get_string(tag, "direction", "forward"), &reverse);
+        int n = to - from + 1;
+        int* indices = (int*)malloc((size_t)n * sizeof(int));
+        if (!indices) continue;
+        for (int k = 0; k < n; k++) {
+            indices[k] = reverse ? to - k : from + k;
+        }
+        sprite_sheet_add_clip(sheet, name, indices, n, 0.0f, mode);
+        free(indices);
+    }
+
+    json_free(root);
+    printf("[Sprite] Loaded atlas: %s (%d frames, %d clips)\n", json_path, sheet->frame_count, sheet->clip_count);
+    return sheet;
+}
+
+void sprite_sheet_retain(SpriteSheet* sheet) {
+    if (sheet) sheet->refcount++;
+}
+
+void sprite_sheet_release(SpriteSheet* sheet) {
+    if (!sheet || --sheet->refcount > 0) return;
+
+    for (int i = 0; i < sheet->clip_count; i++) {
+        free(sheet->clips[i].frames);
+    }
+    for (int i = 0; i < sheet->frame_count; i++) {
+        free(sheet->frame_names[i]);
+    }
+    free(sheet->clips);
+    free(sheet->frame_names);
+    free(sheet->frames);
+    texture_release(sheet->texture);
+    free(sheet);
+}
+
+int sprite_sheet_add_clip(SpriteSheet* sheet, const char* name, const int* frames, int frame_count,
+                          float fps, SpriteLoopMode mode) {
+    if (!sheet || !name || !frames || frame_count <= 0) return -1;
+    for (int i = 0; i < frame_count; i++) {
+        if (frames[i] < 0 || frames[i] >= sheet->frame_count) return -1;
+    }
+
+    int* copy = (int*)malloc((size_t)frame_count * sizeof(int));
+    if (!copy) return -1;
+    memcpy(copy, frames, (size_t)frame_count * sizeof(int));
+
+    int index = sprite_sheet_find_clip(sheet, name);
+    if (index >= 0) {
+        free(sheet->clips[index].frames);
+    } else {
+        if (sheet->clip_count == sheet->clip_capacity) {
+            int cap = sheet->clip_capacity ? sheet->clip_capacity * 2 : 8;
+            SpriteClip* clips = (SpriteClip*)realloc(sheet->clips, (size_t)cap * sizeof(SpriteClip));
+            if (!clips) {
+                free(copy);
+                return -1;
+            }
+            sheet->clips = clips;
+            sheet->clip_capacity = cap;
+        }
+        index = sheet->clip_count++;
+        snprintf(sheet->clips[index].name, SPRITE_CLIP_NAME_MAX, "%s", name);
+    }
+
+    SpriteClip* clip = &sheet->clips[index];
+    clip->frames = copy;
+    clip->frame_count = frame_count;
+    clip->fps = fps > 0.0f ? fps : 0.0f;
+    clip->mode = mode;
+    return index;
+}
+
+int sprite_sheet_find_clip(const SpriteSheet* sheet, const char* name) {
+    for (int i = 0; i < sheet->clip_count; i++) {
+        if (strncmp(sheet->clips[i].name, name, SPRITE_CLIP_NAME_MAX) == 0) return i;
+    }
+    return -1;
+}
+
+int sprite_sheet_find_frame(const SpriteSheet* sheet, const char* name) {
+    for (int i = 0; i < sheet->frame_count; i++) {
+        if (sheet->frame_names[i] && strcmp(sheet->frame_names[i], name) == 0) return i;
+    }
+    return -1;
+}
+
+// Push one frame as a quad. (x, y) is the top-left of the untrimmed frame;
+// `kx`/`ky` scale source pixels to screen pixels.
+static void draw_frame_quad(Texture* texture, const SpriteFrame* f, float x, float y, float kx, float ky,
+                            float angle, float origin_x, float origin_y, int flip_x, int flip_y,
+                            float r, float g, float b, float a) {
+    float off_x = flip_x ? (float)(f->source_w - f->w) - f->offset_x : f->offset_x;
+    float off_y = flip_y ? (float)(f->source_h - f->h) - f->offset_y : f->offset_y;
+    float qw = (float)f->w * kx;
+    float qh = (float)f->h * ky;
+    if (qw <= 0.0f || qh <= 0.0f) return;
+
+    // Re-express the frame-relative origin relative to the (trimmed) quad
+    float ox = (origin_x * (float)f->source_w - off_x) * kx / qw;
+    float oy = (origin_y * (float)f->source_h - off_y) * ky / qh;
+
+    render_texture_uv_ex(texture, x + off_x * kx, y + off_y * ky, qw, qh,
+                         flip_x ? f->u1 : f->u0, flip_y ? f->v1 : f->v0,
+                         flip_x ? f->u0 : f->u1, flip_y ? f->v0 : f->v1,
+                         angle, ox, oy, r, g, b, a);
+}
+
+void sprite_sheet_draw_frame(const SpriteSheet* sheet, int frame, float x, float y,
+                             float scale_x, float scale_y) {
+    if (!sheet || frame < 0 || frame >= sheet->frame_count) return;
+    draw_frame_quad(sheet->texture, &sheet->frames[frame], x, y, scale_x, scale_y,
+                    0.0f, 0.5f, 0.5f, 0, 0, 1.0f, 1.0f, 1.0f, 1.0f);
+}
+
+// --- Sets ---
+
+SpriteSet* sprite_set_create(SpriteSheet* sheet, int capacity) {
+    if (!sheet) return NULL;
+    SpriteSet* set = (SpriteSet*)calloc(1, sizeof(SpriteSet));
+    if (!set) return NULL;
+
+    if (capacity < 16) capacity = 16;
+    set->sprites = (Sprite*)malloc((size_t)capacity * sizeof(Sprite));
+    set->free_slots = (int*)malloc((size_t)capacity * sizeof(int));
+    if (!set->sprites || !set->free_slots) {
+        free(set->sprites);
+        free(set->free_slots);
+        free(set);
+        return NULL;
+    }
+    set->capacity = capacity;
+    set->sheet = sheet;
+    sprite_sheet_retain(sheet);
+    return set;
+}
+
+void sprite_set_destroy(SpriteSet* set) {
+    if (!set) return;
+    sprite_sheet_release(set->sheet);
+    free(set->sprites);
+    free(set->free_slots);
+    free(set);
+}
+
+int sprite_set_add(SpriteSet* set, float x, float y) {
+    int slot;
+    if (set->free_count > 0) {
+        slot = set->free_slots[--set->free_count];
+    } else {
+        if (set->slot_count == set->capacity) {
+            int cap = set->capacity * 2;
+            Sprite* sprites = (Sprite*)realloc(set->sprites, (size_t)cap * sizeof(Sprite));
+            if (!sprites) return -1;
+            set->sprites = sprites;
+            int* free_slots = (int*)realloc(set->free_slots, (size_t)cap * sizeof(int));
+            if (!free_slots) return -1;
+            set->free_slots = free_slots;
+            set->capacity = cap;
+        }
+        slot = set->slot_count++;
+    }
+
+    Sprite* s = &set->sprites[slot];
+    memset(s, 0, sizeof(*s));
+    s->x = x;
+    s->y = y;
+    s->scale_x = s->scale_y = 1.0f;
+    s->origin_x = s->origin_y = 0.5f;
+    s->r = s->g = s->b = s->a = 1.0f;
+    s->speed = 1.0f;
+    s->clip = -1;
+    s->direction = 1;
+    s->visible = 1;
+    s->active = 1;
+    set->live++;
+    return slot;
+}
+
+Sprite* sprite_set_get(SpriteSet* set, int id) {
+    if (!set || id < 0 || id >= set->slot_count || !set->sprites[id].active) return NULL;
+    return &set->sprites[id];
+}
+
+void sprite_set_remove(SpriteSet* set, int id) {
+    Sprite* s = sprite_set_get(set, id);
+    if (!s) return;
+    s->active = 0;
+    set->free_slots[set->free_count++] = id;
+    set->live--;
+}
+
+void sprite_set_clear(SpriteSet* set) {
+    set->slot_count = 0;
+    set->free_count = 0;
+    set->live = 0;
+}
+
+void sprite_play(const SpriteSet* set, Sprite* sprite, int clip, int restart) {
+    if (!sprite || clip < 0 || clip >= set->sheet->clip_count) return;
+    if (sprite->clip == clip && sprite->playing && !restart) return;
+    sprite->clip = clip;
+    sprite->frame = 0;
+    sprite->time = 0.0f;
+    sprite->direction = 1;
+    sprite->playing = 1;
+}
+
+void sprite_set_frame(Sprite* sprite, int frame) {
+    if (!sprite) return;
+    sprite->clip = -1;
+    sprite->frame = frame;
+    sprite->playing = 0;
+    sprite->time = 0.0f;
+}
+
+int sprite_current_frame(const SpriteSet* set, const Sprite* sprite) {
+    if (sprite->clip < 0) return sprite->frame;
+    const SpriteClip* clip = &set->sheet->clips[sprite->clip];
+    // The clip may have been redefined shorter while playing
+    int position = sprite->frame < clip->frame_count ? sprite->frame : clip->frame_count - 1;
+    return clip->frames[position];
+}
+
+static float frame_duration(const SpriteSheet* sheet, const SpriteClip* clip, int position) {
+    if (clip->fps > 0.0f) return 1.0f / clip->fps;
+    float d = sheet->frames[clip->frames[position]].duration;
+    return d > 0.0f ? d : SPRITE_DEFAULT_DURATION;
+}
+
+// Step to the next clip position. Returns 0 when a one-shot clip ends.
+static int advance(Sprite* s, const SpriteClip* clip) {
+    int n = clip->frame_count;
+    switch (clip->mode) {
+        case SPRITE_LOOP_ONCE:
+            if (s->frame + 1 >= n) return 0;
+            s->frame++;
+            return 1;
+        case SPRITE_LOOP_PINGPONG:
+            if (n > 1) {
+                int next = s->frame + s->direction;
+                if (next < 0 || next >= n) {
+                    s->direction = (signed char)-s->direction;
+                    next = s->frame + s->direction;
+                }
+                s->frame = next;
+            }
+            return 1;
+        default:
+            s->frame = (s->frame + 1) % n;
+            return 1;
+    }
+}
+
+void sprite_set_update(SpriteSet* set, float dt) {
+    const SpriteSheet* sheet = set->sheet;
+    if (dt <= 0.0f) return;
+
+    for (int i = 0; i < set->slot_count; i++) {
+        Sprite* s = &set->sprites[i];
+        if (!s->active || !s->playing || s->clip < 0) continue;
+
+        const SpriteClip* clip = &sheet->clips[s->clip];
+        if (s->frame >= clip->frame_count) s->frame = clip->frame_count - 1;
+        s->time += dt * s->speed;
+        float d = frame_duration(sheet, clip, s->frame);
+        int steps = 0;
+        while (s->time >= d) {
+            s->time -= d;
+            if (!advance(s, clip)) {
+                s->playing = 0;
+                s->time = 0.0f;
+                break;
+            }
+            if (++steps >= SPRITE_MAX_STEPS) {
+                s->time = 0.0f;
+                break;
+            }
+            d = frame_duration(sheet, clip, s->frame);
+        }
+    }
+}
+
+void sprite_set_draw(const SpriteSet* set) {
+    const SpriteSheet* sheet = set->sheet;
+
+    for (int i = 0; i < set->slot_count; i++) {
+        const Sprite* s = &set->sprites[i];
+        if (!s->active || !s->visible) continue;
+
+        int frame = sprite_current_frame(set, s);
+        if (frame < 0 || frame >= sheet->frame_count) continue;
+        const SpriteFrame* f = &sheet->frames[frame];
+
+        float kx = s->width > 0.0f ? s->width / (float)f->source_w : s->scale_x;
+        float ky = s->height > 0.0f ? s->height / (float)f->source_h : s->scale_y;
+        draw_frame_quad(sheet->texture, f, s->x, s->y, kx, ky, s->angle, s->origin_x, s->origin_y,
+                        s->flip_x, s->flip_y, s->r, s->g, s->b, s->a);
+    }
+}
@@ -0,0 +1,135 @@
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include "texture.h"
+
+// Sprite sheets and animated sprite sets.
+//
+// A SpriteSheet slices a texture into frames (from a grid or an Aseprite /
+// TexturePacker JSON atlas) with UVs computed once at load time, plus named
+// animation clips. A SpriteSet holds many sprite instances sharing one sheet;
+// sprite_set_update() advances every clip and sprite_set_draw() pushes all
+// visible sprites into the texture batch in one pass.
+
+#define SPRITE_CLIP_NAME_MAX 32
+
+typedef enum {
+    SPRITE_LOOP_REPEAT = 0,   // restart from the first frame
+    SPRITE_LOOP_ONCE,         // stop on the last frame
+    SPRITE_LOOP_PINGPONG      // play forward then backward
+} SpriteLoopMode;
+
+typedef struct {
+    float u0, v0, u1, v1;     // texture coordinates of the packed rect
+    int x, y, w, h;           // packed rect in pixels
+    float offset_x, offset_y; // position of the packed rect inside the source (trimmed atlases)
+    int source_w, source_h;   // untrimmed frame size
+    float duration;           // seconds (from the atlas; 0 = use clip fps)
+} SpriteFrame;
+
+typedef struct {
+    char name[SPRITE_CLIP_NAME_MAX];
+    int* frames;              // sheet frame indices
+    int frame_count;
+    float fps;                // 0 = per-frame durations
+    SpriteLoopMode mode;
+} SpriteClip;
+
+typedef struct {
+    Texture* texture;         // retained
+    SpriteFrame* frames;
+    char** frame_names;       // atlas names (NULL entries for grid sheets)
+    int frame_count;
+    SpriteClip* clips;
+    int clip_count;
+    int clip_capacity;
+    int refcount;
+} SpriteSheet;
+
+typedef struct {
+    float x, y;
+    float width, height;      // 0 = frame source size * scale
+    float scale_x, scale_y;
+    float angle;              // degrees
+    float origin_x, origin_y; // rotation/anchor point, normalized to the frame
+    float r, g, b, a;
+    float speed;              // playback rate multiplier
+    float time;               // seconds into the current frame
+    int clip;                 // -1 = static frame
+    int frame;                // sheet frame (static) or position in the clip
+    signed char direction;    // +1 / -1 (pingpong)
+    unsigned char playing;
+    unsigned char visible;
+    unsigned char flip_x;
+    unsigned char flip_y;
+    unsigned char active;     // slot in use
+} Sprite;
+
+typedef struct {
+    SpriteSheet* sheet;       // retained
+    Sprite* sprites;
+    int slot_count;           // slots used (active or free)
+    int capacity;
+    int live;                 // active sprites
+    int* free_slots;
+    int free_count;
+} SpriteSet;
+
+// --- Sheets ---
+
+// Slice `texture` into a grid of `frame_w` x `frame_h` cells, row by row.
+// `margin` is the border around the grid, `spacing` the gap between cells;
+// `count` limits the frame count (0 = every full cell).
+SpriteSheet* sprite_sheet_create_grid(Texture* texture, int frame_w, int frame_h,
+                                      int margin, int spacing, int count);
+
+// Load an Aseprite or TexturePacker JSON atlas (hash or array "frames").
+// `texture` may be NULL to load "meta.image" relative to the JSON file.
+// Aseprite frame tags become clips. Returns NULL and fills `err` on failure.
+SpriteSheet* sprite_sheet_load_json(const char* json_path, Texture* texture, char* err, size_t err_size);
+
+void sprite_sheet_retain(SpriteSheet* sheet);
+void sprite_sheet_release(SpriteSheet* sheet);
+
+// Add a clip over `frame_count` sheet frames. Returns the clip index, or -1.
+// A clip with an existing name is replaced.
+int sprite_sheet_add_clip(SpriteSheet* sheet, const char* name, const int* frames, int frame_count,
+                          float fps, SpriteLoopMode mode);
+
+// Clip / frame lookup by name (-1 if missing)
+int sprite_sheet_find_clip(const SpriteSheet* sheet, const char* name);
+int sprite_sheet_find_frame(const SpriteSheet* sheet, const char* name);
+
+// Draw a single frame at its source size * scale
+void sprite_sheet_draw_frame(const SpriteSheet* sheet, int frame, float x, float y,
+                             float scale_x, float scale_y);
+
+// --- Sets ---
+
+SpriteSet* sprite_set_create(SpriteSheet* sheet, int capacity);
+void sprite_set_destroy(SpriteSet* set);
+
+// Add a sprite showing frame 0. Returns its id, or -1 on allocation failure.
+int sprite_set_add(SpriteSet* set, float x, float y);
+void sprite_set_remove(SpriteSet* set, int id);
+void sprite_set_clear(SpriteSet* set);
+
+// Sprite by id (NULL if the id is not live)
+Sprite* sprite_set_get(SpriteSet* set, int id);
+
+// Start `clip` on a sprite (restart = 0 keeps the position if already playing it)
+void sprite_play(const SpriteSet* set, Sprite* sprite, int clip, int restart);
+
+// Show a fixed sheet frame (stops any clip)
+void sprite_set_frame(Sprite* sprite, int frame);
+
+// Sheet frame currently shown by a sprite
+int sprite_current_frame(const SpriteSet* set, const Sprite* sprite);
+
+// Advance every playing clip by `dt` seconds
+void sprite_set_update(SpriteSet* set, float dt);
+
+// Draw every visible sprite (one texture batch, no state changes per sprite)
+void sprite_set_draw(const SpriteSet* set);
+
+#endif // SPRITE_H
@@ -1,9 +1,19 @@
 #define STB_TRUETYPE_IMPLEMENTATION
 #include "stb/stb_truetype.h"
+#include "stb/stb_image.h"
 
 #include "text.h"
+#include "font_cache.h"
+#include "bmfont.h"
 #include "camera.h"
 #include "renderer.h"
+#include "texture_memory.h"
+#include "ui.h"
+#include "../util/utf8.h"
+#include "../platform/filemap.h"
+#include "../platform/thread.h"
+#include <GLFW/glfw3.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -18,10 +28,12 @@ static const char* text_vertex_shader_source =
     "out vec2 TexCoord;\n"
     "out vec4 Color;\n"
     "uniform mat4 projection;\n"
+    "uniform vec2 offset;\n"     // retained text origin (zero for the batch)
+    "uniform vec4 tint;\n"
     "void main() {\n"
-    "    gl_Position = projection * vec4(aPos, 0.0, 1.0);\n"
+    "    gl_Position = projection * vec4(aPos + offset, 0.0, 1.0);\n"
     "    TexCoord = aTexCoord;\n"
-    "    Color = aColor;\n"
+    "    Color = aColor * tint;\n"
     "}\n";
 
 static const char* text_fragment_shader_source =
@@ -30,10 +42,64 @@ static const char* text_fragment_shader_source =
     "in vec4 Color;\n"
     "out vec4 FragColor;\n"
     "uniform sampler2D fontAtlas;\n"
+    "uniform bool premultiplied;\n"
     "void main() {\n"
     "    float alpha = texture(fontAtlas, TexCoord).r;\n"
     "    FragColor = vec4(Color.rgb, Color.a * alpha);\n"
     "    if (FragColor.a < 0.01) discard;\n"
+    "    if (premultiplied) FragColor.rgb *= FragColor.a;\n"
+    "}\n";
+
+// Signed distance field text: the atlas stores distance to the glyph edge
+// (0.5 on the edge), converted to screen pixels with the UV derivatives so
+// one atlas stays crisp at any size or camera zoom. Effect widths are in
+// screen pixels and are limited by the field's margin (FONT_SDF_PADDING
+// texels at the SDF size).
+static const char* sdf_fragment_shader_source =
+    "#version 330 core\n"
+    "in vec2 TexCoord;\n"
+    "in vec4 Color;\n"
+    "out vec4 FragColor;\n"
+    "uniform sampler2D fontAtlas;\n"
+    "uniform bool premultiplied;\n"
+    "uniform float distRange;\n"       // atlas texels per unit of field value
+    "uniform float outlineWidth;\n"
+    "uniform vec4 outlineColor;\n"
+    "uniform float glowWidth;\n"
+    "uniform vec4 glowColor;\n"
+    "uniform vec2 shadowOffset;\n"
+    "uniform float shadowSoftness;\n"
+    "uniform vec4 shadowColor;\n"
+    "float texelsPerPixel;\n"
+    "float distanceAt(vec2 uv) {\n"
+    "    float field = texture(fontAtlas, uv).r;\n"
+    "    return (field - 0.5) * distRange / texelsPerPixel;\n"
+    "}\n"
+    "vec4 over(vec4 dst, vec4 src, float coverage) {\n"
+    "    float a = src.a * coverage;\n"
+    "    return vec4(src.rgb * a, a) + dst * (1.0 - a);\n"
+    "}\n"
+    "void main() {\n"
+    "    vec2 texels = vec2(textureSize(fontAtlas, 0));\n"
+    "    vec2 dx = dFdx(TexCoord), dy = dFdy(TexCoord);\n"
+    "    texelsPerPixel = max(0.5 * (length(dx * texels) + length(dy * texels)), 1e-4);\n"
+    "    float d = distanceAt(TexCoord);\n"
+    "    vec4 result = vec4(0.0);\n"
+    "    if (shadowColor.a > 0.0) {\n"
+    // Screen y points down, window-space derivatives point up
+    "        float ds = distanceAt(TexCoord - dx * shadowOffset.x + dy * shadowOffset.y);\n"
+    "        float soft = max(shadowSoftness, 1.0);\n"
+    "        result = over(result, shadowColor, smoothstep(-soft * 0.5, soft * 0.5, ds));\n"
+    "    }\n"
+    "    if (glowWidth > 0.0) {\n"
+    "        result = over(result, glowColor, 1.0 - smoothstep(0.0, glowWidth, -d));\n"
+    "    }\n"
+    "    if (outlineWidth > 0.0) {\n"
+    "        result = over(result, outlineColor, clamp(d + outlineWidth + 0.5, 0.0, 1.0));\n"
+    "    }\n"
+    "    result = over(result, Color, clamp(d + 0.5, 0.0, 1.0));\n"
+    "    if (result.a < 0.004) discard;\n"
+    "    FragColor = premultiplied ? result : vec4(result.rgb / result.a, result.a);\n"
     "}\n";
 
 // Text renderer state
@@ -41,14 +107,36 @@ static const char* text_fragment_shader_source =
 #define TEXT_VERTEX_SIZE 8  // x, y, u, v, r, g, b, a
 
 typedef struct {
-    GLuint vao;
-    GLuint vbo;
-    GLuint shader;
+    GLuint program;
     GLint projection_loc;
     GLint texture_loc;
+    GLint premultiplied_loc;
+    GLint offset_loc;
+    GLint tint_loc;
+} TextProgram;
+
+typedef struct {
+    TextProgram program;
+    GLint dist_range_loc;
+    GLint outline_width_loc;
+    GLint outline_color_loc;
+    GLint glow_width_loc;
+    GLint glow_color_loc;
+    GLint shadow_offset_loc;
+    GLint shadow_softness_loc;
+    GLint shadow_color_loc;
+} SdfTextProgram;
+
+typedef struct {
+    GLuint vao;
+    GLuint vbo;
+    TextProgram bitmap;
+    SdfTextProgram sdf;       // created with the first SDF font
     float vertices[TEXT_MAX_VERTICES * TEXT_VERTEX_SIZE];
     int vertex_count;
     GLuint current_texture;
+    int current_sdf;          // pending vertices use the SDF program
+    TextEffects current_effects;
     int screen_width;
     int screen_height;
     int initialized;
@@ -56,7 +144,7 @@ typedef struct {
 
 static TextRendererState text_state = {0};
 
-static GLuint create_text_shader(void) {
+static GLuint create_text_shader(const char* fragment_source) {
     GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
     glShaderSource(vertex_shader, 1, &text_vertex_shader_source, NULL);
     glCompileShader(vertex_shader);
@@ -70,7 +158,7 @@ static GLuint create_text_shader(void) {
     }
 
     GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment_shader, 1, &text_fragment_shader_source, NULL);
+    glShaderSource(fragment_shader, 1, &fragment_source, NULL);
     glCompileShader(fragment_shader);
 
     glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
@@ -96,12 +184,35 @@ static GLuint create_text_shader(void) {
     return program;
 }
 
+static void init_text_program(TextProgram* program, const char* fragment_source) {
+    program->program = create_text_shader(fragment_source);
+    program->projection_loc = glGetUniformLocation(program->program, "projection");
+    program->texture_loc = glGetUniformLocation(program->program, "fontAtlas");
+    program->premultiplied_loc = glGetUniformLocation(program->program, "premultiplied");
+    program->offset_loc = glGetUniformLocation(program->program, "offset");
+    program->tint_loc = glGetUniformLocation(program->program, "tint");
+}
+
+static void init_sdf_program(void) {
+    SdfTextProgram* sdf = &text_state.sdf;
+    if (sdf->program.program) return;
+
+    init_text_program(&sdf->program, sdf_fragment_shader_source);
+    GLuint p = sdf->program.program;
+    sdf->dist_range_loc = glGetUniformLocation(p, "distRange");
+    sdf->outline_width_loc = glGetUniformLocation(p, "outlineWidth");
+    sdf->outline_color_loc = glGetUniformLocation(p, "outlineColor");
+    sdf->glow_width_loc = glGetUniformLocation(p, "glowWidth");
+    sdf->glow_color_loc = glGetUniformLocation(p, "glowColor");
+    sdf->shadow_offset_loc = glGetUniformLocation(p, "shadowOffset");
+    sdf->shadow_softness_loc = glGetUniformLocation(p, "shadowSoftness");
+    sdf->shadow_color_loc = glGetUniformLocation(p, "shadowColor");
+}
+
 void text_renderer_init(void) {
     if (text_state.initialized) return;
 
-    text_state.shader = create_text_shader();
-    text_state.projection_loc = glGetUniformLocation(text_state.shader, "projection");
-    text_state.texture_loc = glGetUniformLocation(text_state.shader, "fontAtlas");
+    init_text_program(&text_state.bitmap, text_fragment_shader_source);
 
     glGenVertexArrays(1, &text_state.vao);
     glGenBuffers(1, &text_state.vbo);
@@ -137,16 +248,35 @@ void text_renderer_shutdown(void) {
 
     glDeleteVertexArrays(1, &text_state.vao);
     glDeleteBuffers(1, &text_state.vbo);
-    glDeleteProgram(text_state.shader);
+    glDeleteProgram(text_state.bitmap.program);
+    if (text_state.sdf.program.program) {
+        glDeleteProgram(text_state.sdf.program.program);
+    }
+    memset(&text_state.sdf, 0, sizeof(text_state.sdf));
+    text_layout_clear();
+    text_grid_shutdown();
     text_state.initialized = 0;
 }
 
-void text_renderer_flush(void) {
-    if (text_state.vertex_count == 0 || !text_state.initialized) return;
+static void apply_sdf_uniforms(const SdfTextProgram* sdf, const TextEffects* fx) {
+    const Color* oc = &fx->outline_color;
+    const Color* gc = &fx->glow_color;
+    const Color* sc = &fx->shadow_color;
+
+    glUniform1f(sdf->dist_range_loc, FONT_SDF_PADDING * 255.0f / 128.0f);
+    glUniform1f(sdf->outline_width_loc, fx->outline);
+    glUniform4f(sdf->outline_color_loc, oc->r, oc->g, oc->b, oc->a);
+    glUniform1f(sdf->glow_width_loc, fx->glow);
+    glUniform4f(sdf->glow_color_loc, gc->r, gc->g, gc->b, gc->a);
+    glUniform2f(sdf->shadow_offset_loc, fx->shadow_x, fx->shadow_y);
+    glUniform1f(sdf->shadow_softness_loc, fx->shadow_softness);
+    glUniform4f(sdf->shadow_color_loc, sc->r, sc->g, sc->b, sc->a);
+}
 
+// Bind the program for `sdf` text with the current projection and blending
+static void use_text_program(int sdf, const TextEffects* effects, float offset_x, float offset_y, Color tint) {
     // Enable alpha blending for text rendering
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    renderer_apply_blend();
 
     // Get the correct projection matrix (UI mode = plain ortho, otherwise camera)
     float projection[16];
@@ -156,9 +286,22 @@ void text_renderer_flush(void) {
         camera_get_matrix(projection, text_state.screen_width, text_state.screen_height);
     }
 
-    glUseProgram(text_state.shader);
-    glUniformMatrix4fv(text_state.projection_loc, 1, GL_FALSE, projection);
-    glUniform1i(text_state.texture_loc, 0);
+    const TextProgram* program = sdf ? &text_state.sdf.program : &text_state.bitmap;
+    glUseProgram(program->program);
+    glUniformMatrix4fv(program->projection_loc, 1, GL_FALSE, projection);
+    glUniform1i(program->texture_loc, 0);
+    glUniform1i(program->premultiplied_loc, renderer_get_premultiplied_alpha());
+    glUniform2f(program->offset_loc, offset_x, offset_y);
+    glUniform4f(program->tint_loc, tint.r, tint.g, tint.b, tint.a);
+    if (sdf) {
+        apply_sdf_uniforms(&text_state.sdf, effects);
+    }
+}
+
+void text_renderer_flush(void) {
+    if (text_state.vertex_count == 0 || !text_state.initialized) return;
+
+    use_text_program(text_state.current_sdf, &text_state.current_effects, 0.0f, 0.0f, COLOR_WHITE);
 
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, text_state.current_texture);
@@ -199,282 +342,1706 @@ static void add_text_vertex(float x, float y, float u, float v, float r, float g
     text_state.vertex_count++;
 }
 
-static void ensure_font_texture(GLuint texture_id) {
-    if (text_state.current_texture != texture_id) {
+// Pending vertices share one texture, program and effect set
+static void ensure_font_texture(GLuint texture_id, const Font* font) {
+    if (text_state.current_texture != texture_id || text_state.current_sdf != font->sdf ||
+        (font->sdf && memcmp(&text_state.current_effects, &font->effects, sizeof(TextEffects)) != 0)) {
         text_renderer_flush();
         text_state.current_texture = texture_id;
+        text_state.current_sdf = font->sdf;
+        if (font->sdf) text_state.current_effects = font->effects;
+    }
+}
+
+// --- Glyph cache ---
+
+static TextCacheStats cache_stats = {0};
+
+// Bumped whenever cached glyphs move or disappear (page growth, page
+// eviction, dropped strikes) or kerning is toggled; retained text built
+// before is laid out again
+static unsigned int atlas_generation = 1;
+
+unsigned int text_atlas_generation(void) {
+    return atlas_generation;
+}
+
+void text_renderer_begin_frame(void) {
+    cache_stats.frame_misses = cache_stats.current_misses;
+    cache_stats.current_misses = 0;
+    text_layout_begin_frame();
+}
+
+void text_get_cache_stats(TextCacheStats* out) {
+    if (!out) return;
+    *out = cache_stats;
+    text_layout_get_stats(out);
+}
+
+static uint32_t hash_codepoint(uint32_t cp) {
+    return cp * 2654435761u;
+}
+
+// Slot holding `cp`, or the empty slot where it would be inserted
+static uint32_t find_slot(const FontStrike* strike, uint32_t cp) {
+    uint32_t i = hash_codepoint(cp) & strike->slot_mask;
+    for (;;) {
+        int32_t g = strike->slots[i];
+        if (g == 0 || strike->glyphs[g - 1].codepoint == cp) return i;
+        i = (i + 1) & strike->slot_mask;
+    }
+}
+
+static int resize_slots(FontStrike* strike, uint32_t count) {
+    int32_t* slots = (int32_t*)calloc(count, sizeof(int32_t));
+    if (!slots) return 0;
+
+    free(strike->slots);
+    strike->slots = slots;
+    strike->slot_mask = count - 1;
+    for (int g = 0; g < strike->glyph_count; g++) {
+        strike->slots[find_slot(strike, strike->glyphs[g].codepoint)] = g + 1;
+    }
+    return 1;
+}
+
+// Linear-probing delete: shift later entries of the cluster back so lookups
+// never stop early at the hole
+static void remove_slot(FontStrike* strike, uint32_t cp) {
+    uint32_t mask = strike->slot_mask;
+    uint32_t hole = find_slot(strike, cp);
+    if (strike->slots[hole] == 0) return;
+
+    uint32_t j = hole;
+    for (;;) {
+        j = (j + 1) & mask;
+        int32_t g = strike->slots[j];
+        if (g == 0) break;
+
+        uint32_t home = hash_codepoint(strike->glyphs[g - 1].codepoint) & mask;
+        // Entry at j may move to the hole only if its home is not in (hole, j]
+        int stays = (hole <= j) ? (home > hole && home <= j)
+                                : (home > hole || home <= j);
+        if (!stays) {
+            strike->slots[hole] = g;
+            hole = j;
+        }
+    }
+    strike->slots[hole] = 0;
+}
+
+// Drop glyph `g` from the cache (swap-remove, fixing the moved entry's slot)
+static void remove_glyph(FontStrike* strike, int g) {
+    remove_slot(strike, strike->glyphs[g].codepoint);
+
+    int last = strike->glyph_count - 1;
+    if (g != last) {
+        strike->slots[find_slot(strike, strike->glyphs[last].codepoint)] = g + 1;
+        strike->glyphs[g] = strike->glyphs[last];
+    }
+    strike->glyph_count--;
+    cache_stats.glyphs--;
+}
+
+static void upload_page(FontAtlasPage* page, int x, int y, int w, int h, int realloc_storage) {
+    glBindTexture(GL_TEXTURE_2D, page->texture_id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (realloc_storage) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, page->width, page->height, 0, GL_RED, GL_UNSIGNED_BYTE, page->pixels);
+    } else {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, page->width);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, GL_RED, GL_UNSIGNED_BYTE,
+                        page->pixels + (size_t)y * page->width + x);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
     }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-// Rasterize font atlas at a given size using stb_truetype
-static int rasterize_font(Font* font, float size) {
-    stbtt_fontinfo info;
-    if (!stbtt_InitFont(&info, font->font_data, stbtt_GetFontOffsetForIndex(font->font_data, 0))) {
-        fprintf(stderr, "[Text] Failed to init font\n");
+// Pending vertices (the text batch and the UI draw list) sample the page with
+// its current layout; draw them before the page is resized or cleared
+static void flush_if_bound(const FontAtlasPage* page) {
+    if (text_state.current_texture == page->texture_id) {
+        text_renderer_flush();
+    }
+    ui_flush_if_uses(page->texture_id);
+}
+
+static int create_page_sized(FontStrike* strike, int height) {
+    FontAtlasPage* page = &strike->pages[strike->page_count];
+
+    page->pixels = (unsigned char*)calloc((size_t)strike->page_size * height, 1);
+    if (!page->pixels) {
+        fprintf(stderr, "[Text] Failed to allocate atlas page\n");
         return 0;
     }
+    page->width = strike->page_size;
+    page->height = height;
+    page->shelf_x = 1;
+    page->shelf_y = 1;
+    page->shelf_h = 0;
+    page->last_used = texture_memory_current_frame();
+
+    glGenTextures(1, &page->texture_id);
+    glBindTexture(GL_TEXTURE_2D, page->texture_id);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    upload_page(page, 0, 0, 0, 0, 1);
 
-    float scale = stbtt_ScaleForPixelHeight(&info, size);
+    texture_memory_track_font_atlas((long long)page->width * page->height, 1);
+    strike->page_count++;
+    cache_stats.pages++;
+    return 1;
+}
 
-    int ascent, descent, line_gap;
-    stbtt_GetFontVMetrics(&info, &ascent, &descent, &line_gap);
-    font->ascent = ascent * scale;
-    font->descent = descent * scale;
-    font->line_gap = line_gap * scale;
-    font->line_height = font->ascent - font->descent + font->line_gap;
-    font->font_size = size;
+static int create_page(FontStrike* strike) {
+    int height = strike->page_size / 4;
+    if (height < 64) height = 64;
+    return create_page_sized(strike, height);
+}
 
-    // Determine atlas size — with 2x oversampling, effective size is doubled
-    // so we need generous atlas dimensions
-    int atlas_w, atlas_h;
-    float effective = size * 2;  // account for 2x oversampling
+static void destroy_pages(FontStrike* strike) {
+    for (int i = 0; i < strike->page_count; i++) {
+        FontAtlasPage* page = &strike->pages[i];
+        flush_if_bound(page);
+        glDeleteTextures(1, &page->texture_id);
+        texture_memory_track_font_atlas(-(long long)page->width * page->height, -1);
+        free(page->pixels);
+        memset(page, 0, sizeof(*page));
+    }
+    cache_stats.pages -= strike->page_count;
+    strike->page_count = 0;
+}
 
+// Double the page height; texel positions stay, V coordinates are rescaled
+static int grow_page(FontStrike* strike, int index) {
+    FontAtlasPage* page = &strike->pages[index];
+    int height = page->height * 2;
+    if (height > strike->page_size) return 0;
+
+    unsigned char* pixels = (unsigned char*)realloc(page->pixels, (size_t)page->width * height);
+    if (!pixels) return 0;
+    memset(pixels + (size_t)page->width * page->height, 0, (size_t)page->width * (height - page->height));
+
+    flush_if_bound(page);
+    texture_memory_track_font_atlas((long long)page->width * (height - page->height), 0);
+    page->pixels = pixels;
+    page->height = height;
+    upload_page(page, 0, 0, 0, 0, 1);
+    atlas_generation++;
+
+    for (int g = 0; g < strike->glyph_count; g++) {
+        Glyph* glyph = &strike->glyphs[g];
+        if (glyph->page != index) continue;
+        glyph->v0 = (float)glyph->atlas_y / height;
+        glyph->v1 = (float)(glyph->atlas_y + glyph->atlas_h) / height;
+    }
+    return 1;
+}
+
+// Empty the least-recently-drawn page so it can be refilled
+static int evict_page(FontStrike* strike) {
+    int index = 0;
+    for (int i = 1; i < strike->page_count; i++) {
+        if (strike->pages[i].last_used < strike->pages[index].last_used) index = i;
+    }
+
+    FontAtlasPage* page = &strike->pages[index];
+    flush_if_bound(page);
+    for (int g = strike->glyph_count - 1; g >= 0; g--) {
+        if (strike->glyphs[g].page == index) remove_glyph(strike, g);
+    }
+
+    memset(page->pixels, 0, (size_t)page->width * page->height);
+    upload_page(page, 0, 0, 0, 0, 1);
+    page->shelf_x = 1;
+    page->shelf_y = 1;
+    page->shelf_h = 0;
+    cache_stats.evictions++;
+    atlas_generation++;
+    return index;
+}
+
+// Reserve w x h texels (plus a one-texel gutter) on the page's shelves
+static int page_alloc(FontAtlasPage* page, int w, int h, int* out_x, int* out_y) {
+    if (page->shelf_x + w + 1 > page->width) {
+        page->shelf_y += page->shelf_h;
+        page->shelf_x = 1;
+        page->shelf_h = 0;
+    }
+    if (page->shelf_y + h + 1 > page->height) return 0;
+
+    *out_x = page->shelf_x;
+    *out_y = page->shelf_y;
+    page->shelf_x += w + 1;
+    if (h + 1 > page->shelf_h) page->shelf_h = h + 1;
+    return 1;
+}
+
+// Find room for a glyph bitmap: existing pages (growing them), a new page,
+// or the least-recently-drawn page once FONT_MAX_PAGES are in use
+static int place_glyph(FontStrike* strike, int w, int h, int* out_page, int* out_x, int* out_y) {
+    if (w + 2 > strike->page_size || h + 2 > strike->page_size) return 0;
+
+    for (int i = 0; i < strike->page_count; i++) {
+        do {
+            if (page_alloc(&strike->pages[i], w, h, out_x, out_y)) {
+                *out_page = i;
+                return 1;
+            }
+        } while (grow_page(strike, i));
+    }
+
+    int index;
+    if (strike->page_count < FONT_MAX_PAGES) {
+        if (!create_page(strike)) return 0;
+        index = strike->page_count - 1;
+    } else {
+        index = evict_page(strike);
+    }
+
+    do {
+        if (page_alloc(&strike->pages[index], w, h, out_x, out_y)) {
+            *out_page = index;
+            return 1;
+        }
+    } while (grow_page(strike, index));
+    return 0;
+}
+
+static void set_glyph_rect(Glyph* glyph, const FontAtlasPage* page, int page_index, int x, int y, int w, int h) {
+    glyph->page = page_index;
+    glyph->atlas_x = x;
+    glyph->atlas_y = y;
+    glyph->atlas_w = w;
+    glyph->atlas_h = h;
+    glyph->u0 = (float)x / page->width;
+    glyph->v0 = (float)y / page->height;
+    glyph->u1 = (float)(x + w) / page->width;
+    glyph->v1 = (float)(y + h) / page->height;
+}
+
+// A glyph rasterized outside the atlas. Producing one only reads the font
+// data, so worker threads can do it.
+typedef struct {
+    float advance_x;
+    float offset_x, offset_y;
+    float width, height;
+    int w, h;               // bitmap texels
+    unsigned char* pixels;  // NULL for glyphs without pixels (space)
+} GlyphBitmap;
+
+static int rasterize_glyph(const stbtt_fontinfo* info, float scale, int sdf, uint32_t cp, GlyphBitmap* out) {
+    memset(out, 0, sizeof(*out));
+
+    // Unknown code points map to glyph 0, the font's "missing glyph" box
+    int index = stbtt_FindGlyphIndex(info, (int)cp);
+
+    int advance, lsb;
+    stbtt_GetGlyphHMetrics(info, index, &advance, &lsb);
+    out->advance_x = advance * scale;
+
+    if (sdf) {
+        int w, h, xoff, yoff;
+        unsigned char* field = stbtt_GetGlyphSDF(info, scale, index, FONT_SDF_PADDING,
+                                                 128, 128.0f / FONT_SDF_PADDING, &w, &h, &xoff, &yoff);
+        if (field) {
+            out->pixels = field;  // STBTT_malloc is malloc
+            out->w = w;
+            out->h = h;
+            out->offset_x = (float)xoff;
+            out->offset_y = (float)yoff;
+            out->width = (float)w;
+            out->height = (float)h;
+        }
+        return 1;
+    }
+
+    float s = scale * FONT_OVERSAMPLE;
+    int x0, y0, x1, y1;
+    stbtt_GetGlyphBitmapBoxSubpixel(info, index, s, s, 0, 0, &x0, &y0, &x1, &y1);
+    if (x1 <= x0 || y1 <= y0 || stbtt_IsGlyphEmpty(info, index)) return 1;
+
+    int w = x1 - x0 + FONT_OVERSAMPLE - 1;
+    int h = y1 - y0 + FONT_OVERSAMPLE - 1;
+    unsigned char* pixels = (unsigned char*)calloc((size_t)w * h, 1);
+    if (!pixels) return 0;
+
+    float sub_x, sub_y;
+    stbtt_MakeGlyphBitmapSubpixelPrefilter(info, pixels, w, h, w, s, s, 0, 0,
+                                           FONT_OVERSAMPLE, FONT_OVERSAMPLE, &sub_x, &sub_y, index);
+    out->pixels = pixels;
+    out->w = w;
+    out->h = h;
+    out->offset_x = (float)x0 / FONT_OVERSAMPLE + sub_x;
+    out->offset_y = (float)y0 / FONT_OVERSAMPLE + sub_y;
+    out->width = (float)w / FONT_OVERSAMPLE;
+    out->height = (float)h / FONT_OVERSAMPLE;
+    return 1;
+}
+
+// Make room for one more glyph in the array and the hash table
+static int reserve_glyph(FontStrike* strike) {
+    if (strike->glyph_count == strike->glyph_capacity) {
+        int capacity = strike->glyph_capacity ? strike->glyph_capacity * 2 : 128;
+        Glyph* glyphs = (Glyph*)realloc(strike->glyphs, capacity * sizeof(Glyph));
+        if (!glyphs) return 0;
+        strike->glyphs = glyphs;
+        strike->glyph_capacity = capacity;
+    }
+    // Keep the table at most half full
+    if ((uint32_t)(strike->glyph_count + 1) * 2 > strike->slot_mask + 1) {
+        if (!resize_slots(strike, (strike->slot_mask + 1) * 2)) return 0;
+    }
+    return 1;
+}
+
+// Pack a rasterized glyph into the atlas and add it to the cache. Returns
+// the glyph index or -1.
+static int insert_glyph(FontStrike* strike, uint32_t cp, const GlyphBitmap* bitmap) {
+    if (!reserve_glyph(strike)) return -1;
+
+    Glyph glyph;
+    memset(&glyph, 0, sizeof(glyph));
+    glyph.codepoint = cp;
+    glyph.page = -1;
+    glyph.advance_x = bitmap->advance_x;
+
+    int page_index, ax, ay;
+    if (bitmap->pixels && place_glyph(strike, bitmap->w, bitmap->h, &page_index, &ax, &ay)) {
+        FontAtlasPage* page = &strike->pages[page_index];
+        for (int row = 0; row < bitmap->h; row++) {
+            memcpy(page->pixels + (size_t)(ay + row) * page->width + ax,
+                   bitmap->pixels + (size_t)row * bitmap->w, bitmap->w);
+        }
+        upload_page(page, ax, ay, bitmap->w, bitmap->h, 0);
+
+        set_glyph_rect(&glyph, page, page_index, ax, ay, bitmap->w, bitmap->h);
+        glyph.offset_x = bitmap->offset_x;
+        glyph.offset_y = bitmap->offset_y;
+        glyph.width = bitmap->width;
+        glyph.height = bitmap->height;
+    }
+
+    // place_glyph may have evicted glyphs, so the slot is looked up last
+    int g = strike->glyph_count++;
+    strike->glyphs[g] = glyph;
+    strike->slots[find_slot(strike, cp)] = g + 1;
+
+    cache_stats.glyphs++;
+    cache_stats.misses++;
+    cache_stats.current_misses++;
+    return g;
+}
+
+// Rasterize `cp` and add it to the cache. Returns the glyph index or -1.
+static int cache_glyph(FontStrike* strike, uint32_t cp) {
+    GlyphBitmap bitmap;
+    if (!rasterize_glyph(strike->info, strike->scale, strike->sdf, cp, &bitmap)) return -1;
+
+    int g = insert_glyph(strike, cp, &bitmap);
+    free(bitmap.pixels);
+    return g;
+}
+
+const Glyph* font_strike_get_glyph(FontStrike* strike, uint32_t codepoint) {
+    // C0 and C1 controls are never drawn (newline and tab are layout)
+    if (codepoint < 32 || (codepoint >= 0x7F && codepoint < 0xA0)) return NULL;
+
+    int32_t g = strike->slots[find_slot(strike, codepoint)];
+    if (g) {
+        cache_stats.hits++;
+        return &strike->glyphs[g - 1];
+    }
+    if (strike->prebaked) {
+        g = strike->slots[find_slot(strike, BMFONT_INVALID_CHAR)];
+        return g ? &strike->glyphs[g - 1] : NULL;
+    }
+
+    int index = cache_glyph(strike, codepoint);
+    return index >= 0 ? &strike->glyphs[index] : NULL;
+}
+
+static void destroy_strike(FontStrike* strike) {
+    destroy_pages(strike);
+    atlas_generation++;
+    cache_stats.glyphs -= strike->glyph_count;
+    cache_stats.sizes--;
+    free(strike->glyphs);
+    free(strike->slots);
+    free(strike);
+}
+
+// Set up the metrics and an empty cache for `size`
+static FontStrike* new_strike(Font* font, float size) {
+    FontStrike* strike = (FontStrike*)calloc(1, sizeof(FontStrike));
+    if (!strike) return NULL;
+    cache_stats.sizes++;
+
+    const stbtt_fontinfo* info = font->info;
+    float scale = stbtt_ScaleForPixelHeight(info, size);
+
+    int ascent, descent, line_gap;
+    stbtt_GetFontVMetrics(info, &ascent, &descent, &line_gap);
+    strike->info = info;
+    strike->sdf = font->sdf;
+    strike->size = size;
+    strike->scale = scale;
+    strike->ascent = ascent * scale;
+    strike->descent = descent * scale;
+    strike->line_gap = line_gap * scale;
+    strike->line_height = strike->ascent - strike->descent + strike->line_gap;
+    strike->last_used = texture_memory_current_frame();
+
+    // Pages are as wide as the old fixed atlases; they start a quarter as
+    // tall and only grow when glyphs need the room
+    float effective = font->sdf ? size + 2 * FONT_SDF_PADDING : size * FONT_OVERSAMPLE;
     if (effective <= 64) {
-        atlas_w = 512;  atlas_h = 512;
+        strike->page_size = 512;
     } else if (effective <= 128) {
-        atlas_w = 1024; atlas_h = 1024;
+        strike->page_size = 1024;
     } else if (effective <= 256) {
-        atlas_w = 2048; atlas_h = 2048;
+        strike->page_size = 2048;
     } else {
-        atlas_w = 4096; atlas_h = 4096;
+        strike->page_size = 4096;
     }
 
-    unsigned char* atlas_bitmap = (unsigned char*)calloc(atlas_w * atlas_h, 1);
-    if (!atlas_bitmap) {
-        fprintf(stderr, "[Text] Failed to allocate atlas bitmap\n");
-        return 0;
+    if (!resize_slots(strike, 256)) {
+        destroy_strike(strike);
+        return NULL;
     }
+    return strike;
+}
 
-    // Pack characters into atlas
-    stbtt_pack_context pack_ctx;
-    if (!stbtt_PackBegin(&pack_ctx, atlas_bitmap, atlas_w, atlas_h, 0, 1, NULL)) {
-        fprintf(stderr, "[Text] Failed to begin font packing\n");
-        free(atlas_bitmap);
-        return 0;
+// New strike with printable ASCII warmed up
+static FontStrike* create_strike(Font* font, float size) {
+    FontStrike* strike = new_strike(font, size);
+    if (!strike) return NULL;
+
+    for (uint32_t c = FONT_FIRST_CHAR; c < FONT_FIRST_CHAR + FONT_NUM_CHARS; c++) {
+        if (cache_glyph(strike, c) < 0) {
+            destroy_strike(strike);
+            return NULL;
+        }
     }
+    // Warm-up glyphs are not frame misses
+    cache_stats.misses -= FONT_NUM_CHARS;
+    cache_stats.current_misses -= FONT_NUM_CHARS;
+    return strike;
+}
 
-    stbtt_PackSetOversampling(&pack_ctx, 2, 2);
+// Strike rebuilt from a disk cache entry: pages are uploaded as stored,
+// nothing is rasterized
+static FontStrike* restore_strike(Font* font, const FontCacheImage* image) {
+    const FontCacheHeader* header = &image->header;
+    FontStrike* strike = new_strike(font, header->size);
+    if (!strike) return NULL;
+    if ((uint32_t)strike->page_size != header->page_size) {
+        destroy_strike(strike);
+        return NULL;
+    }
 
-    stbtt_packedchar packed_chars[FONT_NUM_CHARS];
-    if (!stbtt_PackFontRange(&pack_ctx, font->font_data, 0, size,
-                             FONT_FIRST_CHAR, FONT_NUM_CHARS, packed_chars)) {
-        fprintf(stderr, "[Text] Failed to pack font range\n");
-        stbtt_PackEnd(&pack_ctx);
-        free(atlas_bitmap);
-        return 0;
+    for (uint32_t i = 0; i < header->page_count; i++) {
+        const FontCachePage* cached = &header->pages[i];
+        if (!create_page_sized(strike, (int)cached->height)) {
+            destroy_strike(strike);
+            return NULL;
+        }
+        FontAtlasPage* page = &strike->pages[i];
+        memcpy(page->pixels, image->pages[i], (size_t)cached->rows * page->width);
+        page->shelf_x = (int)cached->shelf_x;
+        page->shelf_y = (int)cached->shelf_y;
+        page->shelf_h = (int)cached->shelf_h;
+        upload_page(page, 0, 0, page->width, (int)cached->rows, 0);
     }
 
-    stbtt_PackEnd(&pack_ctx);
+    for (uint32_t i = 0; i < header->glyph_count; i++) {
+        FontCacheGlyph cached;
+        font_cache_get_glyph(image, (int)i, &cached);
+        if (!reserve_glyph(strike)) {
+            destroy_strike(strike);
+            return NULL;
+        }
 
-    // Extract per-character metrics
-    for (int i = 0; i < FONT_NUM_CHARS; i++) {
-        stbtt_packedchar* pc = &packed_chars[i];
-        font->advance_x[i] = pc->xadvance;
-        font->offset_x[i] = pc->xoff;
-        font->offset_y[i] = pc->yoff;
-        font->width[i] = pc->xoff2 - pc->xoff;
-        font->height[i] = pc->yoff2 - pc->yoff;
-        font->uv_x0[i] = (float)pc->x0 / atlas_w;
-        font->uv_y0[i] = (float)pc->y0 / atlas_h;
-        font->uv_x1[i] = (float)pc->x1 / atlas_w;
-        font->uv_y1[i] = (float)pc->y1 / atlas_h;
+        Glyph glyph;
+        memset(&glyph, 0, sizeof(glyph));
+        glyph.codepoint = cached.codepoint;
+        glyph.page = -1;
+        glyph.advance_x = cached.advance_x;
+        if (cached.page >= 0) {
+            set_glyph_rect(&glyph, &strike->pages[cached.page], cached.page,
+                           cached.atlas_x, cached.atlas_y, cached.atlas_w, cached.atlas_h);
+            glyph.offset_x = cached.offset_x;
+            glyph.offset_y = cached.offset_y;
+            glyph.width = cached.width;
+            glyph.height = cached.height;
+        }
+
+        uint32_t slot = find_slot(strike, glyph.codepoint);
+        if (strike->slots[slot]) continue;  // duplicate entry
+        int g = strike->glyph_count++;
+        strike->glyphs[g] = glyph;
+        strike->slots[slot] = g + 1;
+        cache_stats.glyphs++;
     }
+    return strike;
+}
 
-    // Create or update OpenGL texture
-    if (font->texture_id == 0) {
-        glGenTextures(1, &font->texture_id);
+FontStrike* font_get_strike(Font* font, float size) {
+    if (!font || size <= 0) return NULL;
+    if (font->sdf) size = FONT_SDF_SIZE;
+    else if (font->prebaked_size > 0) size = font->prebaked_size;
+
+    unsigned int frame = texture_memory_current_frame();
+    if (font->current && font->current->size == size) {
+        font->current->last_used = frame;
+        return font->current;
+    }
+    for (int i = 0; i < font->strike_count; i++) {
+        if (font->strikes[i]->size == size) {
+            font->strikes[i]->last_used = frame;
+            return font->strikes[i];
+        }
     }
 
-    glBindTexture(GL_TEXTURE_2D, font->texture_id);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    FontStrike* strike = create_strike(font, size);
+    if (!strike) return NULL;
 
-    // Upload single-channel (RED) texture
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, atlas_w, atlas_h, 0, GL_RED, GL_UNSIGNED_BYTE, atlas_bitmap);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    if (font->strike_count < FONT_MAX_SIZES) {
+        font->strikes[font->strike_count++] = strike;
+        return strike;
+    }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    // Replace the least-recently-used strike other than the current size
+    int victim = -1;
+    for (int i = 0; i < font->strike_count; i++) {
+        if (font->strikes[i] == font->current) continue;
+        if (victim < 0 || font->strikes[i]->last_used < font->strikes[victim]->last_used) victim = i;
+    }
+    destroy_strike(font->strikes[victim]);
+    font->strikes[victim] = strike;
+    return strike;
+}
+
+static int font_preload_strike(FontStrike* strike, const char* text) {
+    int before = cache_stats.current_misses;
+    uint32_t cp;
+    while ((cp = utf8_decode(&text)) != 0) {
+        font_strike_get_glyph(strike, cp);
+    }
+    return cache_stats.current_misses - before;
+}
+
+int font_preload(Font* font, const char* text, float size) {
+    if (!font || !text) return 0;
+
+    FontStrike* strike = size > 0 ? font_get_strike(font, size) : font->current;
+    if (!strike) return 0;
+    return font_preload_strike(strike, text);
+}
+
+int font_get_glyph_count(const Font* font) {
+    int count = 0;
+    for (int i = 0; i < font->strike_count; i++) {
+        count += font->strikes[i]->glyph_count;
+    }
+    return count;
+}
 
-    font->atlas_width = atlas_w;
-    font->atlas_height = atlas_h;
+// --- Kerning ---
 
-    free(atlas_bitmap);
+// Dense table of every printable ASCII pair, read once when the font loads.
+// Only reads the font, so async loads build it on their worker.
+static int build_kerning(const stbtt_fontinfo* info, int16_t** out) {
+    *out = NULL;
+    if (!info->kern && !info->gpos) return 1;  // no kerning data
+
+    int16_t* ascii = (int16_t*)malloc(FONT_NUM_CHARS * FONT_NUM_CHARS * sizeof(int16_t));
+    if (!ascii) return 0;
+
+    int index[FONT_NUM_CHARS];
+    for (int i = 0; i < FONT_NUM_CHARS; i++) {
+        index[i] = stbtt_FindGlyphIndex(info, FONT_FIRST_CHAR + i);
+    }
+    for (int a = 0; a < FONT_NUM_CHARS; a++) {
+        for (int b = 0; b < FONT_NUM_CHARS; b++) {
+            ascii[a * FONT_NUM_CHARS + b] = (int16_t)stbtt_GetGlyphKernAdvance(info, index[a], index[b]);
+        }
+    }
+    *out = ascii;
     return 1;
 }
 
-Font* font_load(const char* filepath, float size) {
-    // Read font file
-    FILE* f = fopen(filepath, "rb");
-    if (!f) {
+static void destroy_kerning(FontKerning* kerning) {
+    free(kerning->ascii);
+    free(kerning->pair_keys);
+    free(kerning->pair_values);
+    memset(kerning, 0, sizeof(*kerning));
+}
+
+static uint32_t hash_pair(uint64_t key) {
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+static int resize_pairs(FontKerning* kerning, uint32_t count) {
+    uint64_t* keys = (uint64_t*)calloc(count, sizeof(uint64_t));
+    int16_t* values = (int16_t*)malloc(count * sizeof(int16_t));
+    if (!keys || !values) {
+        free(keys);
+        free(values);
+        return 0;
+    }
+
+    uint32_t mask = count - 1;
+    for (uint32_t i = 0; kerning->pair_keys && i <= kerning->pair_mask; i++) {
+        uint64_t key = kerning->pair_keys[i];
+        if (!key) continue;
+        uint32_t j = hash_pair(key) & mask;
+        while (keys[j]) j = (j + 1) & mask;
+        keys[j] = key;
+        values[j] = kerning->pair_values[i];
+    }
+
+    free(kerning->pair_keys);
+    free(kerning->pair_values);
+    kerning->pair_keys = keys;
+    kerning->pair_values = values;
+    kerning->pair_mask = mask;
+    return 1;
+}
+
+// Add a pair that is known not to be in the table
+static void store_kerning_pair(FontKerning* kerning, uint64_t key, int value) {
+    if (kerning->pair_count >= FONT_KERN_MAX_PAIRS) return;
+
+    // Keep the table at most half full
+    if ((uint32_t)(kerning->pair_count + 1) * 2 > (kerning->pair_keys ? kerning->pair_mask + 1 : 0)) {
+        if (!resize_pairs(kerning, kerning->pair_keys ? (kerning->pair_mask + 1) * 2 : 256)) return;
+    }
+    uint32_t i = hash_pair(key) & kerning->pair_mask;
+    while (kerning->pair_keys[i]) i = (i + 1) & kerning->pair_mask;
+    kerning->pair_keys[i] = key;
+    kerning->pair_values[i] = (int16_t)value;
+    kerning->pair_count++;
+}
+
+// Pairs outside ASCII: looked up in the font once, then memoized
+static int lookup_kerning_pair(Font* font, uint32_t left, uint32_t right) {
+    FontKerning* kerning = &font->kerning;
+    uint64_t key = (uint64_t)left << 32 | right;
+
+    if (kerning->pair_keys) {
+        uint32_t i = hash_pair(key) & kerning->pair_mask;
+        while (kerning->pair_keys[i]) {
+            if (kerning->pair_keys[i] == key) return kerning->pair_values[i];
+            i = (i + 1) & kerning->pair_mask;
+        }
+    }
+
+    // BMFont pairs are all in the table already
+    const stbtt_fontinfo* info = font->info;
+    if (!info) return 0;
+
+    int value = stbtt_GetGlyphKernAdvance(info, stbtt_FindGlyphIndex(info, (int)left),
+                                          stbtt_FindGlyphIndex(info, (int)right));
+    store_kerning_pair(kerning, key, value);
+    return value;
+}
+
+int font_get_kerning(Font* font, uint32_t left, uint32_t right) {
+    if (!font->kerning_enabled || !font->kerning.ascii) return 0;
+
+    uint32_t a = left - FONT_FIRST_CHAR;
+    uint32_t b = right - FONT_FIRST_CHAR;
+    if (a < FONT_NUM_CHARS && b < FONT_NUM_CHARS) {
+        return font->kerning.ascii[a * FONT_NUM_CHARS + b];
+    }
+    return lookup_kerning_pair(font, left, right);
+}
+
+void font_set_kerning(Font* font, int enabled) {
+    if (!font || font->kerning_enabled == !!enabled) return;
+
+    font->kerning_enabled = !!enabled;
+    // Every cached layout of the font changes
+    text_layout_forget_font(font);
+    atlas_generation++;
+}
+
+// --- Font files ---
+
+// Mapped font files, shared by every Font opened on the same path. Only
+// touched from the GL thread; async workers read a mapping they were handed.
+typedef struct FontFile {
+    char path[1024];
+    FileMap map;
+    int refs;
+    struct FontFile* next;
+} FontFile;
+
+static FontFile* font_files = NULL;
+
+static FontFile* acquire_font_file(const char* filepath) {
+    char path[1024];
+    file_canonical_path(filepath, path, sizeof(path));
+
+    for (FontFile* file = font_files; file; file = file->next) {
+        if (strcmp(file->path, path) == 0) {
+            file->refs++;
+            return file;
+        }
+    }
+
+    FontFile* file = (FontFile*)calloc(1, sizeof(FontFile));
+    if (!file) return NULL;
+    if (!filemap_open(filepath, &file->map)) {
         fprintf(stderr, "[Text] Failed to open font file: %s\n", filepath);
+        free(file);
+        return NULL;
+    }
+    if (file->map.size == 0) {
+        fprintf(stderr, "[Text] Font file is empty: %s\n", filepath);
+        filemap_close(&file->map);
+        free(file);
         return NULL;
     }
 
-    fseek(f, 0, SEEK_END);
-    long file_size = ftell(f);
-    fseek(f, 0, SEEK_SET);
+    memcpy(file->path, path, sizeof(path));
+    file->refs = 1;
+    file->next = font_files;
+    font_files = file;
+    return file;
+}
 
-    if (file_size <= 0) {
-        fprintf(stderr, "[Text] Font file is empty: %s\n", filepath);
-        fclose(f);
+static void release_font_file(FontFile* file) {
+    if (!file || --file->refs > 0) return;
+
+    for (FontFile** link = &font_files; *link; link = &(*link)->next) {
+        if (*link == file) {
+            *link = file->next;
+            break;
+        }
+    }
+    filemap_close(&file->map);
+    free(file);
+}
+
+static int init_font_info(stbtt_fontinfo* info, const FontFile* file) {
+    const unsigned char* data = file->map.data;
+    int offset = stbtt_GetFontOffsetForIndex(data, 0);
+    return offset >= 0 && stbtt_InitFont(info, data, offset);
+}
+
+// Font over an already initialized file and info (both owned by the font)
+static Font* new_font(FontFile* file, stbtt_fontinfo* info, int16_t* kerning, int sdf) {
+    Font* font = (Font*)calloc(1, sizeof(Font));
+    if (!font) return NULL;
+
+    font->file = file;
+    font->font_data = file->map.data;
+    font->font_data_size = file->map.size;
+    font->info = info;
+    font->kerning.ascii = kerning;
+    font->kerning_enabled = 1;
+    font->sdf = sdf;
+    return font;
+}
+
+// Copy of a cache entry's kerning table (NULL when the font has none)
+static int16_t* cached_kerning(const FontCacheImage* image) {
+    if (!image->kerning) return NULL;
+    int16_t* ascii = (int16_t*)malloc(FONT_NUM_CHARS * FONT_NUM_CHARS * sizeof(int16_t));
+    if (ascii) memcpy(ascii, image->kerning, FONT_NUM_CHARS * FONT_NUM_CHARS * sizeof(int16_t));
+    return ascii;
+}
+
+// Give a new font the strike restored from `cached` (released here)
+static int use_cached_strike(Font* font, FontCacheImage* cached) {
+    FontStrike* strike = restore_strike(font, cached);
+    font_cache_release(cached);
+    if (!strike) return 0;
+    font->strikes[font->strike_count++] = strike;
+    return 1;
+}
+
+static Font* load_font_file(const char* filepath, float size, int sdf) {
+    double start = glfwGetTime();
+
+    FontFile* file = acquire_font_file(filepath);
+    if (!file) return NULL;
+
+    // Ensure text renderer is initialized
+    text_renderer_init();
+
+    stbtt_fontinfo* info = (stbtt_fontinfo*)malloc(sizeof(stbtt_fontinfo));
+    if (!info || !init_font_info(info, file)) {
+        if (info) fprintf(stderr, "[Text] Failed to init font: %s\n", filepath);
+        free(info);
+        release_font_file(file);
         return NULL;
     }
 
-    unsigned char* font_data = (unsigned char*)malloc(file_size);
-    if (!font_data) {
-        fprintf(stderr, "[Text] Failed to allocate memory for font data\n");
-        fclose(f);
+    // Warm path: atlas, metrics and kerning mapped from the disk cache
+    FontCacheImage cached;
+    int warm = font_cache_load(filepath, sdf ? FONT_SDF_SIZE : size, sdf, &cached);
+
+    int16_t* kerning = NULL;
+    Font* font = NULL;
+    int ok;
+    if (warm) {
+        kerning = cached_kerning(&cached);
+        ok = kerning || !cached.kerning;
+    } else {
+        ok = build_kerning(info, &kerning);
+    }
+    if (!ok || !(font = new_font(file, info, kerning, sdf))) {
+        if (warm) font_cache_release(&cached);
+        free(kerning);
+        free(info);
+        release_font_file(file);
+        return NULL;
+    }
+
+    if (warm && !use_cached_strike(font, &cached)) warm = 0;
+    if (!font_set_size(font, size)) {
+        font_destroy(font);
+        return NULL;
+    }
+    if (!warm) font_cache_store(filepath, font->current, font->kerning.ascii);
+    font_cache_record_load(warm, glfwGetTime() - start);
+
+    printf("[Text] Loaded %sfont%s: %s (size %.0f)\n", sdf ? "SDF " : "", warm ? " from cache" : "",
+           filepath, size);
+    return font;
+}
+
+Font* font_load(const char* filepath, float size) {
+    return load_font_file(filepath, size, 0);
+}
+
+Font* font_load_sdf(const char* filepath, float size) {
+    text_renderer_init();
+    init_sdf_program();
+    return load_font_file(filepath, size, 1);
+}
+
+// --- BMFont ---
+
+// Atlas pages are single-channel: each (page image, channel) pair the glyphs
+// use becomes one page
+typedef struct {
+    int page;
+    int channel;            // 0-3 = RGBA
+} BmFontPageKey;
+
+typedef struct {
+    unsigned char* pixels[BMFONT_MAX_PAGES];  // decoded RGBA page images
+    int has_alpha[BMFONT_MAX_PAGES];
+    BmFontPageKey keys[FONT_MAX_PAGES];
+    int key_count;
+} BmFontPages;
+
+static int bmfont_channel(const BmFontDesc* desc, int chnl, int has_alpha) {
+    if (desc->packed) {
+        switch (chnl) {
+        case 1: return 2;  // blue
+        case 2: return 1;  // green
+        case 4: return 0;  // red
+        case 8: return 3;  // alpha
+        default: break;
+        }
+    }
+    // Glyphs in every channel: alpha when it holds them, else white-on-black red
+    return has_alpha && desc->alpha_chnl <= BMFONT_CHANNEL_BOTH ? 3 : 0;
+}
+
+// Index of the atlas page for a glyph, creating the page on first use
+static int bmfont_page(FontStrike* strike, const BmFontDesc* desc, BmFontPages* pages, const char* filepath,
+                       const BmFontChar* c, TextureFilter filter, char* err, size_t err_size) {
+    if (c->page < 0 || c->page >= desc->page_count) {
+        snprintf(err, err_size, "BMFont character %u uses missing page %d", c->id, c->page);
+        return -1;
+    }
+
+    if (!pages->pixels[c->page]) {
+        char path[1024];
+        file_resolve_relative(filepath, desc->pages[c->page], path, sizeof(path));
+        int w, h, channels;
+        pages->pixels[c->page] = stbi_load(path, &w, &h, &channels, 4);
+        if (!pages->pixels[c->page]) {
+            snprintf(err, err_size, "Failed to load BMFont page: %s", path);
+            return -1;
+        }
+        if (w != desc->scale_w || h != desc->scale_h) {
+            snprintf(err, err_size, "BMFont page %s is %dx%d, expected %dx%d", path, w, h,
+                     desc->scale_w, desc->scale_h);
+            return -1;
+        }
+        pages->has_alpha[c->page] = channels == 2 || channels == 4;
+    }
+
+    int channel = bmfont_channel(desc, c->chnl, pages->has_alpha[c->page]);
+    for (int i = 0; i < pages->key_count; i++) {
+        if (pages->keys[i].page == c->page && pages->keys[i].channel == channel) return i;
+    }
+
+    if (pages->key_count == FONT_MAX_PAGES || !create_page_sized(strike, desc->scale_h)) {
+        snprintf(err, err_size, "BMFont uses more than %d page channels", FONT_MAX_PAGES);
+        return -1;
+    }
+    int index = pages->key_count++;
+    pages->keys[index].page = c->page;
+    pages->keys[index].channel = channel;
+
+    FontAtlasPage* page = &strike->pages[index];
+    const unsigned char* src = pages->pixels[c->page] + channel;
+    size_t count = (size_t)page->width * page->height;
+    for (size_t i = 0; i < count; i++) {
+        page->pixels[i] = src[i * 4];
+    }
+    page->shelf_y = page->height;  // full: nothing is packed into it later
+    upload_page(page, 0, 0, page->width, page->height, 0);
+
+    if (filter == TEXTURE_FILTER_NEAREST) {
+        glBindTexture(GL_TEXTURE_2D, page->texture_id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    return index;
+}
+
+static int build_bmfont_glyphs(FontStrike* strike, const BmFontDesc* desc, const char* filepath,
+                               TextureFilter filter, char* err, size_t err_size) {
+    BmFontPages pages;
+    memset(&pages, 0, sizeof(pages));
+    int ok = 1;
+
+    for (int i = 0; i < desc->char_count && ok; i++) {
+        const BmFontChar* c = &desc->chars[i];
+        uint32_t slot = find_slot(strike, c->id);
+        if (strike->slots[slot]) continue;  // duplicate entry
+
+        Glyph glyph;
+        memset(&glyph, 0, sizeof(glyph));
+        glyph.codepoint = c->id;
+        glyph.page = -1;
+        glyph.advance_x = (float)c->xadvance;
+
+        if (c->width > 0 && c->height > 0) {
+            if (c->x < 0 || c->y < 0 || c->x + c->width > desc->scale_w || c->y + c->height > desc->scale_h) {
+                snprintf(err, err_size, "BMFont character %u lies outside its page", c->id);
+                ok = 0;
+                break;
+            }
+            int index = bmfont_page(strike, desc, &pages, filepath, c, filter, err, err_size);
+            if (index < 0) {
+                ok = 0;
+                break;
+            }
+            set_glyph_rect(&glyph, &strike->pages[index], index, c->x, c->y, c->width, c->height);
+            glyph.offset_x = (float)c->xoffset;
+            glyph.offset_y = (float)(c->yoffset - desc->base);
+            glyph.width = (float)c->width;
+            glyph.height = (float)c->height;
+        }
+
+        if (!reserve_glyph(strike)) {
+            snprintf(err, err_size, "Out of memory");
+            ok = 0;
+            break;
+        }
+        int g = strike->glyph_count++;
+        strike->glyphs[g] = glyph;
+        strike->slots[find_slot(strike, c->id)] = g + 1;
+        cache_stats.glyphs++;
+    }
+
+    for (int i = 0; i < desc->page_count; i++) {
+        stbi_image_free(pages.pixels[i]);
+    }
+    return ok;
+}
+
+static int build_bmfont_kerning(FontKerning* kerning, const BmFontDesc* desc) {
+    if (desc->kerning_count == 0) return 1;
+
+    kerning->ascii = (int16_t*)calloc(FONT_NUM_CHARS * FONT_NUM_CHARS, sizeof(int16_t));
+    if (!kerning->ascii) return 0;
+
+    for (int i = 0; i < desc->kerning_count; i++) {
+        const BmFontKerning* pair = &desc->kernings[i];
+        uint32_t a = pair->first - FONT_FIRST_CHAR;
+        uint32_t b = pair->second - FONT_FIRST_CHAR;
+        if (a < FONT_NUM_CHARS && b < FONT_NUM_CHARS) {
+            kerning->ascii[a * FONT_NUM_CHARS + b] = (int16_t)pair->amount;
+        } else {
+            store_kerning_pair(kerning, (uint64_t)pair->first << 32 | pair->second, pair->amount);
+        }
+    }
+    return 1;
+}
+
+static Font* build_bmfont(const char* filepath, const BmFontDesc* desc, float size, TextureFilter filter,
+                          char* err, size_t err_size) {
+    Font* font = (Font*)calloc(1, sizeof(Font));
+    FontStrike* strike = (FontStrike*)calloc(1, sizeof(FontStrike));
+    if (!font || !strike) {
+        free(font);
+        free(strike);
+        snprintf(err, err_size, "Out of memory");
+        return NULL;
+    }
+    cache_stats.sizes++;
+
+    // Pixel metrics as authored; kerning amounts are pixels too (scale 1)
+    float native = desc->size != 0 ? fabsf((float)desc->size) : (float)desc->line_height;
+    strike->prebaked = 1;
+    strike->size = native;
+    strike->scale = 1.0f;
+    strike->ascent = (float)desc->base;
+    strike->descent = (float)(desc->base - desc->line_height);
+    strike->line_height = (float)desc->line_height;
+    strike->page_size = desc->scale_w;
+    strike->last_used = texture_memory_current_frame();
+
+    font->strikes[font->strike_count++] = strike;
+    font->prebaked_size = native;
+    font->kerning_enabled = 1;
+
+    if (!resize_slots(strike, 256) || !build_bmfont_kerning(&font->kerning, desc)) {
+        snprintf(err, err_size, "Out of memory");
+        font_destroy(font);
+        return NULL;
+    }
+    if (!build_bmfont_glyphs(strike, desc, filepath, filter, err, err_size)) {
+        font_destroy(font);
         return NULL;
     }
 
-    size_t read = fread(font_data, 1, file_size, f);
-    fclose(f);
+    font_set_size(font, size > 0 ? size : native);
+    return font;
+}
 
-    if ((long)read != file_size) {
-        fprintf(stderr, "[Text] Failed to read font file: %s\n", filepath);
-        free(font_data);
+Font* font_load_bmfont(const char* filepath, float size, TextureFilter filter, char* err, size_t err_size) {
+    FileMap map;
+    if (!filemap_open(filepath, &map)) {
+        snprintf(err, err_size, "Failed to open font file: %s", filepath);
         return NULL;
     }
 
     // Ensure text renderer is initialized
     text_renderer_init();
 
-    Font* font = (Font*)calloc(1, sizeof(Font));
-    if (!font) {
-        free(font_data);
+    BmFontDesc desc;
+    Font* font = NULL;
+    if (bmfont_parse(map.data, map.size, &desc, err, err_size)) {
+        font = build_bmfont(filepath, &desc, size, filter, err, err_size);
+    }
+    bmfont_free(&desc);
+    filemap_close(&map);
+
+    if (font) {
+        printf("[Text] Loaded BMFont: %s (size %.0f, %d glyphs)\n", filepath, font->font_size,
+               font->strikes[0]->glyph_count);
+    }
+    return font;
+}
+
+// --- Async loading ---
+
+// The worker does everything that only reads the font (parsing, kerning,
+// rasterizing the ASCII warm-up); packing and uploading stay on the GL thread.
+struct FontLoadJob {
+    char path[1024];
+    FontFile* file;
+    float size;
+    int sdf;
+
+    FontCacheImage cached;  // valid when `warm`: no worker runs
+    int warm;
+
+    // Worker results
+    stbtt_fontinfo* info;
+    int16_t* kerning;
+    GlyphBitmap glyphs[FONT_NUM_CHARS];
+    int ok;
+
+    PlatformThread* thread;
+    atomic_int done;
+    int finished;
+};
+
+static void font_load_worker(void* arg) {
+    FontLoadJob* job = (FontLoadJob*)arg;
+
+    job->info = (stbtt_fontinfo*)malloc(sizeof(stbtt_fontinfo));
+    job->ok = job->info && init_font_info(job->info, job->file) &&
+              build_kerning(job->info, &job->kerning);
+
+    if (job->ok) {
+        float size = job->sdf ? FONT_SDF_SIZE : job->size;
+        float scale = stbtt_ScaleForPixelHeight(job->info, size);
+        for (int i = 0; i < FONT_NUM_CHARS && job->ok; i++) {
+            job->ok = rasterize_glyph(job->info, scale, job->sdf, FONT_FIRST_CHAR + i, &job->glyphs[i]);
+        }
+    }
+    atomic_store(&job->done, 1);
+}
+
+FontLoadJob* font_load_async(const char* filepath, float size, int sdf) {
+    FontLoadJob* job = (FontLoadJob*)calloc(1, sizeof(FontLoadJob));
+    if (!job) return NULL;
+
+    job->file = acquire_font_file(filepath);
+    if (!job->file) {
+        free(job);
         return NULL;
     }
+    snprintf(job->path, sizeof(job->path), "%s", filepath);
+    job->size = size;
+    job->sdf = sdf;
+
+    // Nothing to rasterize for cached fonts: finish uploads the mapped atlas
+    job->warm = font_cache_load(filepath, sdf ? FONT_SDF_SIZE : size, sdf, &job->cached);
+    atomic_init(&job->done, job->warm);
+    if (job->warm) return job;
+
+    job->thread = thread_start(font_load_worker, job);
+    if (!job->thread) {
+        fprintf(stderr, "[Text] Failed to start font loader thread\n");
+        release_font_file(job->file);
+        free(job);
+        return NULL;
+    }
+    return job;
+}
 
-    font->font_data = font_data;
-    font->font_data_size = file_size;
-    font->texture_id = 0;
+int font_load_async_done(const FontLoadJob* job) {
+    return atomic_load((atomic_int*)&job->done);
+}
 
-    if (!rasterize_font(font, size)) {
-        free(font_data);
-        free(font);
+static void wait_font_load(FontLoadJob* job) {
+    if (job->thread) {
+        thread_join(job->thread);
+        job->thread = NULL;
+    }
+}
+
+// Pack the worker's bitmaps into a new strike of `font`
+static int insert_loaded_strike(Font* font, FontLoadJob* job) {
+    FontStrike* strike = new_strike(font, job->sdf ? FONT_SDF_SIZE : job->size);
+    if (!strike) return 0;
+
+    for (int i = 0; i < FONT_NUM_CHARS; i++) {
+        if (insert_glyph(strike, FONT_FIRST_CHAR + i, &job->glyphs[i]) < 0) {
+            destroy_strike(strike);
+            return 0;
+        }
+    }
+    // Warm-up glyphs are not frame misses
+    cache_stats.misses -= FONT_NUM_CHARS;
+    cache_stats.current_misses -= FONT_NUM_CHARS;
+
+    font->strikes[font->strike_count++] = strike;
+    return 1;
+}
+
+Font* font_load_async_finish(FontLoadJob* job) {
+    if (!job || job->finished) return NULL;
+    wait_font_load(job);
+    job->finished = 1;
+
+    if (job->warm) {
+        // Parsing the font is cheap; the cache covers the rest
+        job->info = (stbtt_fontinfo*)malloc(sizeof(stbtt_fontinfo));
+        job->ok = job->info && init_font_info(job->info, job->file);
+        if (job->ok && job->cached.kerning) {
+            job->kerning = cached_kerning(&job->cached);
+            job->ok = job->kerning != NULL;
+        }
+    }
+    if (!job->ok) {
+        fprintf(stderr, "[Text] Failed to init font: %s\n", job->path);
+        return NULL;
+    }
+
+    text_renderer_init();
+    if (job->sdf) init_sdf_program();
+
+    Font* font = new_font(job->file, job->info, job->kerning, job->sdf);
+    if (!font) return NULL;
+    // The font owns these now
+    job->file = NULL;
+    job->info = NULL;
+    job->kerning = NULL;
+
+    // A cache entry that fails to restore falls back to a cold strike, which
+    // font_set_size rasterizes like the sync path does
+    int ok = 1;
+    if (job->warm) {
+        if (!use_cached_strike(font, &job->cached)) job->warm = 0;
+    } else {
+        ok = insert_loaded_strike(font, job);
+    }
+    if (!ok || !font_set_size(font, job->size)) {
+        font_destroy(font);
         return NULL;
     }
+    if (!job->warm) font_cache_store(job->path, font->current, font->kerning.ascii);
 
-    printf("[Text] Loaded font: %s (size %.0f)\n", filepath, size);
+    printf("[Text] Loaded %sfont%s: %s (size %.0f)\n", job->sdf ? "SDF " : "", job->warm ? " from cache" : "",
+           job->path, job->size);
     return font;
 }
 
+void font_load_async_destroy(FontLoadJob* job) {
+    if (!job) return;
+
+    wait_font_load(job);
+    font_cache_release(&job->cached);
+    for (int i = 0; i < FONT_NUM_CHARS; i++) {
+        free(job->glyphs[i].pixels);
+    }
+    free(job->kerning);
+    free(job->info);
+    release_font_file(job->file);
+    free(job);
+}
+
 void font_destroy(Font* font) {
     if (!font) return;
 
-    if (font->texture_id) {
-        glDeleteTextures(1, &font->texture_id);
-    }
-    if (font->font_data) {
-        free(font->font_data);
+    text_layout_forget_font(font);
+    for (int i = 0; i < font->strike_count; i++) {
+        destroy_strike(font->strikes[i]);
     }
+    destroy_kerning(&font->kerning);
+    free(font->info);
+    release_font_file(font->file);
     free(font);
 }
 
 int font_set_size(Font* font, float size) {
-    if (!font || size <= 0) return 0;
-    if (font->font_size == size) return 1;
+    FontStrike* strike = font_get_strike(font, size);
+    if (!strike) return 0;
 
-    return rasterize_font(font, size);
+    // SDF strikes are scaled to the requested size
+    float k = size / strike->size;
+    font->current = strike;
+    font->font_size = size;
+    font->ascent = strike->ascent * k;
+    font->descent = strike->descent * k;
+    font->line_gap = strike->line_gap * k;
+    font->line_height = strike->line_height * k;
+    return 1;
+}
+
+void font_set_effects(Font* font, const TextEffects* effects) {
+    if (!font) return;
+    if (effects) {
+        font->effects = *effects;
+    } else {
+        memset(&font->effects, 0, sizeof(font->effects));
+    }
 }
 
 void render_text(Font* font, const char* text, float x, float y, Color color) {
+    if (!font) return;
+    render_text_sized(font, text, x, y, font->font_size, color);
+}
+
+// Append one glyph quad with its pen position at (pen_x, pen_y)
+static void emit_glyph(FontStrike* strike, const Font* font, const Glyph* glyph,
+                       float pen_x, float pen_y, float k, Color color) {
+    FontAtlasPage* page = &strike->pages[glyph->page];
+    ensure_font_texture(page->texture_id, font);
+    page->last_used = strike->last_used;
+
+    float gx = pen_x + glyph->offset_x * k;
+    float gy = pen_y + glyph->offset_y * k;
+    float gw = glyph->width * k;
+    float gh = glyph->height * k;
+
+    float u0 = glyph->u0;
+    float v0 = glyph->v0;
+    float u1 = glyph->u1;
+    float v1 = glyph->v1;
+
+    // First triangle (top-left, top-right, bottom-right)
+    add_text_vertex(gx, gy, u0, v0, color.r, color.g, color.b, color.a);
+    add_text_vertex(gx + gw, gy, u1, v0, color.r, color.g, color.b, color.a);
+    add_text_vertex(gx + gw, gy + gh, u1, v1, color.r, color.g, color.b, color.a);
+
+    // Second triangle (top-left, bottom-right, bottom-left)
+    add_text_vertex(gx, gy, u0, v0, color.r, color.g, color.b, color.a);
+    add_text_vertex(gx + gw, gy + gh, u1, v1, color.r, color.g, color.b, color.a);
+    add_text_vertex(gx, gy + gh, u0, v1, color.r, color.g, color.b, color.a);
+}
+
+void render_text_sized(Font* font, const char* text, float x, float y, float size, Color color) {
     if (!font || !text || !text_state.initialized) return;
 
+    FontStrike* strike = font_get_strike(font, size);
+    if (!strike) return;
+    if (font->sdf) init_sdf_program();
+
     renderer_switch_batch(BATCH_TEXT);
-    ensure_font_texture(font->texture_id);
+    float k = size / strike->size;  // 1 except for SDF fonts
 
-    float cursor_x = x;
-    float cursor_y = y + font->ascent;
+    float kern_scale = strike->scale * k;
 
-    for (const char* p = text; *p; p++) {
-        unsigned char c = (unsigned char)*p;
+    float cursor_x = x;
+    float cursor_y = y + strike->ascent * k;
 
+    uint32_t cp, prev = 0;
+    while ((cp = utf8_decode(&text)) != 0) {
         // Handle newlines
-        if (c == '\n') {
+        if (cp == '\n') {
             cursor_x = x;
-            cursor_y += font->line_height;
+            cursor_y += strike->line_height * k;
+            prev = 0;
             continue;
         }
 
         // Handle tab as 4 spaces
-        if (c == '\t') {
-            int space_idx = ' ' - FONT_FIRST_CHAR;
-            cursor_x += font->advance_x[space_idx] * 4;
+        if (cp == '\t') {
+            const Glyph* space = font_strike_get_glyph(strike, ' ');
+            if (space) cursor_x += space->advance_x * k * 4;
+            prev = 0;
             continue;
         }
 
-        // Skip characters outside our range
-        if (c < FONT_FIRST_CHAR || c >= FONT_FIRST_CHAR + FONT_NUM_CHARS) {
-            continue;
-        }
+        const Glyph* glyph = font_strike_get_glyph(strike, cp);
+        if (!glyph) continue;
 
-        int idx = c - FONT_FIRST_CHAR;
+        if (prev) cursor_x += font_get_kerning(font, prev, cp) * kern_scale;
+        prev = cp;
 
-        float gx = cursor_x + font->offset_x[idx];
-        float gy = cursor_y + font->offset_y[idx];
-        float gw = font->width[idx];
-        float gh = font->height[idx];
+        if (glyph->page >= 0) {
+            emit_glyph(strike, font, glyph, cursor_x, cursor_y, k, color);
+        }
 
-        float u0 = font->uv_x0[idx];
-        float v0 = font->uv_y0[idx];
-        float u1 = font->uv_x1[idx];
-        float v1 = font->uv_y1[idx];
+        cursor_x += glyph->advance_x * k;
+    }
+}
 
-        // First triangle (top-left, top-right, bottom-right)
-        add_text_vertex(gx, gy, u0, v0, color.r, color.g, color.b, color.a);
-        add_text_vertex(gx + gw, gy, u1, v0, color.r, color.g, color.b, color.a);
-        add_text_vertex(gx + gw, gy + gh, u1, v1, color.r, color.g, color.b, color.a);
+void render_text_layout(Font* font, const char* text, float x, float y,
+                        const TextLayoutOptions* options, Color color) {
+    if (!font || !text || !text_state.initialized) return;
 
-        // Second triangle (top-left, bottom-right, bottom-left)
-        add_text_vertex(gx, gy, u0, v0, color.r, color.g, color.b, color.a);
-        add_text_vertex(gx + gw, gy + gh, u1, v1, color.r, color.g, color.b, color.a);
-        add_text_vertex(gx, gy + gh, u0, v1, color.r, color.g, color.b, color.a);
+    const TextLayout* layout = text_layout_get(font, text, options);
+    if (!layout || layout->glyph_count == 0) return;
+    FontStrike* strike = font_get_strike(font, layout->options.size);
+    if (!strike) return;
+    if (font->sdf) init_sdf_program();
 
-        cursor_x += font->advance_x[idx];
+    renderer_switch_batch(BATCH_TEXT);
+    float k = layout->options.size / strike->size;
+
+    for (int i = 0; i < layout->glyph_count; i++) {
+        const TextLayoutGlyph* placed = &layout->glyphs[i];
+        const Glyph* glyph = font_strike_get_glyph(strike, placed->codepoint);
+        if (glyph && glyph->page >= 0) {
+            emit_glyph(strike, font, glyph, x + placed->x, y + placed->y, k, color);
+        }
     }
 }
 
 void text_measure(Font* font, const char* text, float* out_width, float* out_height) {
-    if (!font || !text) {
-        if (out_width) *out_width = 0;
-        if (out_height) *out_height = 0;
-        return;
+    text_measure_sized(font, text, font ? font->font_size : 0, out_width, out_height);
+}
+
+// Measurements come from the layout cache, so labels measured every frame
+// (UI widgets) are only scanned once
+void text_measure_sized(Font* font, const char* text, float size, float* out_width, float* out_height) {
+    TextLayoutOptions options = {0};
+    options.size = size;
+    const TextLayout* layout = text_layout_get(font, text, &options);
+
+    if (out_width) *out_width = layout ? layout->width : 0;
+    if (out_height) *out_height = layout ? layout->height : 0;
+}
+
+// --- Retained text objects ---
+
+TextObject* text_object_create(Font* font, const char* text, const TextLayoutOptions* layout, int gpu) {
+    if (!font || !text) return NULL;
+
+    TextObject* obj = (TextObject*)calloc(1, sizeof(TextObject));
+    if (!obj) return NULL;
+
+    obj->font = font;
+    if (layout) obj->layout = *layout;
+    if (obj->layout.size <= 0) obj->layout.size = font->font_size;
+    obj->gpu = gpu;
+    if (!text_object_set_text(obj, text)) {
+        free(obj);
+        return NULL;
     }
+    return obj;
+}
 
-    float max_width = 0;
-    float cursor_x = 0;
-    int line_count = 1;
+void text_object_destroy(TextObject* obj) {
+    if (!obj) return;
 
-    for (const char* p = text; *p; p++) {
-        unsigned char c = (unsigned char)*p;
+    if (obj->vbo) {
+        glDeleteVertexArrays(1, &obj->vao);
+        glDeleteBuffers(1, &obj->vbo);
+    }
+    free(obj->text);
+    free(obj->local);
+    free(obj->baked);
+    free(obj);
+}
 
-        if (c == '\n') {
-            if (cursor_x > max_width) max_width = cursor_x;
-            cursor_x = 0;
-            line_count++;
-            continue;
+int text_object_set_text(TextObject* obj, const char* text) {
+    if (!obj || !text) return 0;
+    if (obj->text && strcmp(obj->text, text) == 0) return 1;
+
+    size_t len = strlen(text);
+    char* copy = (char*)malloc(len + 1);
+    if (!copy) return 0;
+    memcpy(copy, text, len + 1);
+
+    free(obj->text);
+    obj->text = copy;
+    obj->generation = 0;
+    return 1;
+}
+
+void text_object_set_font(TextObject* obj, Font* font, float size) {
+    if (!obj || !font) return;
+    if (size <= 0) size = font->font_size;
+    if (obj->font == font && obj->layout.size == size) return;
+
+    obj->font = font;
+    obj->layout.size = size;
+    obj->generation = 0;
+}
+
+void text_object_set_layout(TextObject* obj, const TextLayoutOptions* layout) {
+    if (!obj) return;
+
+    float size = obj->layout.size;
+    memset(&obj->layout, 0, sizeof(obj->layout));
+    if (layout) obj->layout = *layout;
+    if (obj->layout.size <= 0) obj->layout.size = size;
+    obj->generation = 0;
+}
+
+static int reserve_object_vertices(TextObject* obj, int count) {
+    if (count <= obj->vertex_capacity) return 1;
+
+    int capacity = obj->vertex_capacity ? obj->vertex_capacity : 96;
+    while (capacity < count) capacity *= 2;
+
+    size_t bytes = (size_t)capacity * TEXT_VERTEX_SIZE * sizeof(float);
+    float* local = (float*)realloc(obj->local, bytes);
+    if (!local) return 0;
+    obj->local = local;
+    float* baked = (float*)realloc(obj->baked, bytes);
+    if (!baked) return 0;
+    obj->baked = baked;
+    obj->vertex_capacity = capacity;
+    return 1;
+}
+
+static void write_quad(float* v, float x0, float y0, float x1, float y1, const Glyph* glyph) {
+    const float quad[6][4] = {
+        {x0, y0, glyph->u0, glyph->v0}, {x1, y0, glyph->u1, glyph->v0}, {x1, y1, glyph->u1, glyph->v1},
+        {x0, y0, glyph->u0, glyph->v0}, {x1, y1, glyph->u1, glyph->v1}, {x0, y1, glyph->u0, glyph->v1},
+    };
+    for (int i = 0; i < 6; i++, v += TEXT_VERTEX_SIZE) {
+        v[0] = quad[i][0];
+        v[1] = quad[i][1];
+        v[2] = quad[i][2];
+        v[3] = quad[i][3];
+        v[4] = v[5] = v[6] = v[7] = 1.0f;
+    }
+}
+
+// Lay the string out relative to its origin, quads grouped by atlas page so
+// each page is one contiguous run
+static int layout_text_object(TextObject* obj) {
+    Font* font = obj->font;
+    FontStrike* strike = font_get_strike(font, obj->layout.size);
+    if (!strike) return 0;
+
+    // Rasterize every glyph first: misses can grow or evict pages, which
+    // would move glyphs that were already placed
+    unsigned int generation;
+    int attempts = 0;
+    do {
+        generation = atlas_generation;
+        font_preload_strike(strike, obj->text);
+    } while (generation != atlas_generation && ++attempts < 3);
+
+    const TextLayout* layout = text_layout_get(font, obj->text, &obj->layout);
+    if (!layout) return 0;
+
+    // Count quads per page, then give each page a contiguous run
+    int counts[FONT_MAX_PAGES] = {0};
+    for (int i = 0; i < layout->glyph_count; i++) {
+        const Glyph* glyph = font_strike_get_glyph(strike, layout->glyphs[i].codepoint);
+        if (glyph && glyph->page >= 0) counts[glyph->page]++;
+    }
+
+    int start = 0;
+    int fill[FONT_MAX_PAGES];
+    for (int i = 0; i < FONT_MAX_PAGES; i++) {
+        obj->run_start[i] = start;
+        obj->run_count[i] = counts[i] * 6;
+        fill[i] = start;
+        start += counts[i] * 6;
+    }
+    if (!reserve_object_vertices(obj, start)) return 0;
+
+    float k = obj->layout.size / strike->size;
+    for (int i = 0; i < layout->glyph_count; i++) {
+        const TextLayoutGlyph* placed = &layout->glyphs[i];
+        const Glyph* glyph = font_strike_get_glyph(strike, placed->codepoint);
+
+        // The run check only matters if the string alone overflows the cache
+        if (glyph && glyph->page >= 0 && fill[glyph->page] < obj->run_start[glyph->page] + obj->run_count[glyph->page]) {
+            float gx = placed->x + glyph->offset_x * k;
+            float gy = placed->y + glyph->offset_y * k;
+            write_quad(obj->local + (size_t)fill[glyph->page] * TEXT_VERTEX_SIZE,
+                       gx, gy, gx + glyph->width * k, gy + glyph->height * k, glyph);
+            fill[glyph->page] += 6;
         }
+    }
 
-        if (c == '\t') {
-            int space_idx = ' ' - FONT_FIRST_CHAR;
-            cursor_x += font->advance_x[space_idx] * 4;
-            continue;
+    // Runs left short by glyphs that moved mid-layout become empty quads
+    for (int i = 0; i < FONT_MAX_PAGES; i++) {
+        int end = obj->run_start[i] + obj->run_count[i];
+        memset(obj->local + (size_t)fill[i] * TEXT_VERTEX_SIZE, 0,
+               (size_t)(end - fill[i]) * TEXT_VERTEX_SIZE * sizeof(float));
+    }
+
+    obj->strike = strike;
+    obj->vertex_count = start;
+    obj->width = layout->width;
+    obj->height = layout->height;
+    // If glyphs still moved (more distinct glyphs than the cache holds),
+    // lay out again on the next draw
+    obj->generation = generation == atlas_generation ? generation : 0;
+    obj->baked_valid = 0;
+    cache_stats.layouts++;
+
+    if (obj->gpu) {
+        if (!obj->vbo) {
+            glGenVertexArrays(1, &obj->vao);
+            glGenBuffers(1, &obj->vbo);
+            glBindVertexArray(obj->vao);
+            glBindBuffer(GL_ARRAY_BUFFER, obj->vbo);
+            glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, TEXT_VERTEX_SIZE * sizeof(float), (void*)0);
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, TEXT_VERTEX_SIZE * sizeof(float), (void*)(2 * sizeof(float)));
+            glEnableVertexAttribArray(1);
+            glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, TEXT_VERTEX_SIZE * sizeof(float), (void*)(4 * sizeof(float)));
+            glEnableVertexAttribArray(2);
+            glBindVertexArray(0);
         }
+        glBindBuffer(GL_ARRAY_BUFFER, obj->vbo);
+        glBufferData(GL_ARRAY_BUFFER, (size_t)obj->vertex_count * TEXT_VERTEX_SIZE * sizeof(float),
+                     obj->local, GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    return 1;
+}
 
-        if (c < FONT_FIRST_CHAR || c >= FONT_FIRST_CHAR + FONT_NUM_CHARS) {
-            continue;
+static int ensure_object_layout(TextObject* obj) {
+    if (obj->generation == atlas_generation) return 1;
+    return layout_text_object(obj);
+}
+
+void text_object_get_size(TextObject* obj, float* out_width, float* out_height) {
+    int ok = obj && ensure_object_layout(obj);
+    if (out_width) *out_width = ok ? obj->width : 0;
+    if (out_height) *out_height = ok ? obj->height : 0;
+}
+
+// Keep the strike and its pages at the front of the LRUs
+static void touch_object_pages(TextObject* obj) {
+    unsigned int frame = texture_memory_current_frame();
+    obj->strike->last_used = frame;
+    for (int i = 0; i < obj->strike->page_count; i++) {
+        if (obj->run_count[i]) obj->strike->pages[i].last_used = frame;
+    }
+}
+
+static void draw_object_gpu(TextObject* obj, float x, float y, Color color) {
+    Font* font = obj->font;
+
+    renderer_switch_batch(BATCH_NONE);
+    use_text_program(font->sdf, &font->effects, x, y, color);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(obj->vao);
+    for (int i = 0; i < obj->strike->page_count; i++) {
+        if (!obj->run_count[i]) continue;
+        glBindTexture(GL_TEXTURE_2D, obj->strike->pages[i].texture_id);
+        glDrawArrays(GL_TRIANGLES, obj->run_start[i], obj->run_count[i]);
+    }
+    glBindVertexArray(0);
+    glUseProgram(0);
+}
+
+// Copy the quads into the text batch, moved to (x, y) and colored. Drawing
+// again at the same position and color is a plain copy.
+static void draw_object_batched(TextObject* obj, float x, float y, Color color) {
+    if (!obj->baked_valid || obj->baked_x != x || obj->baked_y != y ||
+        memcmp(&obj->baked_color, &color, sizeof(Color)) != 0) {
+        const float* src = obj->local;
+        float* dst = obj->baked;
+        for (int i = 0; i < obj->vertex_count; i++, src += TEXT_VERTEX_SIZE, dst += TEXT_VERTEX_SIZE) {
+            dst[0] = src[0] + x;
+            dst[1] = src[1] + y;
+            dst[2] = src[2];
+            dst[3] = src[3];
+            dst[4] = color.r;
+            dst[5] = color.g;
+            dst[6] = color.b;
+            dst[7] = color.a;
         }
+        obj->baked_x = x;
+        obj->baked_y = y;
+        obj->baked_color = color;
+        obj->baked_valid = 1;
+    }
 
-        int idx = c - FONT_FIRST_CHAR;
-        cursor_x += font->advance_x[idx];
+    renderer_switch_batch(BATCH_TEXT);
+    for (int i = 0; i < obj->strike->page_count; i++) {
+        int remaining = obj->run_count[i];
+        const float* src = obj->baked + (size_t)obj->run_start[i] * TEXT_VERTEX_SIZE;
+        if (!remaining) continue;
+
+        ensure_font_texture(obj->strike->pages[i].texture_id, obj->font);
+        while (remaining > 0) {
+            if (text_state.vertex_count + 6 > TEXT_MAX_VERTICES) text_renderer_flush();
+            int room = (TEXT_MAX_VERTICES - text_state.vertex_count) / 6 * 6;
+            int n = remaining < room ? remaining : room;
+            memcpy(text_state.vertices + (size_t)text_state.vertex_count * TEXT_VERTEX_SIZE,
+                   src, (size_t)n * TEXT_VERTEX_SIZE * sizeof(float));
+            text_state.vertex_count += n;
+            src += (size_t)n * TEXT_VERTEX_SIZE;
+            remaining -= n;
+        }
     }
+}
 
-    if (cursor_x > max_width) max_width = cursor_x;
+void text_object_draw(TextObject* obj, float x, float y, Color color) {
+    if (!obj || !obj->font || !text_state.initialized) return;
+    if (!ensure_object_layout(obj) || obj->vertex_count == 0) return;
+    if (obj->font->sdf) init_sdf_program();
 
-    if (out_width) *out_width = max_width;
-    if (out_height) *out_height = line_count * font->line_height;
+    touch_object_pages(obj);
+    if (obj->gpu) {
+        draw_object_gpu(obj, x, y, color);
+    } else {
+        draw_object_batched(obj, x, y, color);
+    }
 }
@@ -3,56 +3,388 @@
 
 #include <glad/glad.h>
 #include <stddef.h>
+#include <stdint.h>
 #include "renderer.h"
+#include "texture.h"
+
+// Glyphs are rasterized on first use and cached per font and pixel size
+// (a "strike"). Code points are looked up in an open-addressing hash table;
+// bitmaps are shelf-packed into atlas pages that start short, double in
+// height as they fill and are added up to FONT_MAX_PAGES. When every page is
+// full, the least-recently-drawn page is cleared and its glyphs are
+// rasterized again on demand.
+//
+// A font keeps up to FONT_MAX_SIZES strikes, so drawing one font at several
+// sizes (or switching back with font_set_size) reuses the glyphs already
+// rasterized; the least-recently-used strike is dropped to make room.
+//
+// Printable ASCII (32-126) is rasterized when a strike is created so Latin
+// text never misses.
+//
+// Font files are memory-mapped read-only, and Fonts opened on the same file
+// share one mapping. font_load_async() rasterizes the warm-up glyphs on a
+// worker thread; the main thread only packs and uploads them.
+//
+// Kerning pairs are read once per font, in font units so every size shares
+// them: a dense table covers every printable ASCII pair, and other pairs are
+// memoized in a hash table the first time they are drawn or measured.
+//
+// SDF fonts store signed distance fields instead of coverage: a single strike
+// at FONT_SDF_SIZE serves every size and camera zoom, drawn by a dedicated
+// shader that also renders outline, glow and shadow effects.
+//
+// BMFont fonts (font_load_bmfont) are prebaked: their page images become the
+// atlas pages of a single strike at the size they were generated for, which
+// is scaled to every size like SDF fonts. Nothing is rasterized; code points
+// the font lacks draw its "invalid char" glyph, or nothing.
+//
+// Wrapped and aligned text goes through the layout engine (text_layout.c):
+// a layout is the list of positioned code points for one (font, size,
+// string, options) and is memoized, so measuring or drawing the same label
+// every frame lays it out once.
 
-// Maximum number of characters in the font atlas (ASCII 32-126)
 #define FONT_FIRST_CHAR 32
 #define FONT_NUM_CHARS 95
-#define FONT_ATLAS_SIZE 512
+#define FONT_MAX_PAGES 4
+#define FONT_MAX_SIZES 4
+#define FONT_OVERSAMPLE 2   // glyph bitmaps are rasterized at 2x and box-filtered
+#define FONT_SDF_SIZE 32.0f // pixel size of the single SDF strike
+#define FONT_SDF_PADDING 6  // distance field margin in texels (bounds effect width)
+
+struct stbtt_fontinfo;
+
+typedef struct {
+    uint32_t codepoint;
+    float advance_x;
+    float offset_x;
+    float offset_y;
+    float width;
+    float height;
+    float u0, v0, u1, v1;
+    int page;               // -1 for glyphs without pixels (space)
+    int atlas_x, atlas_y;   // texel rect inside the page
+    int atlas_w, atlas_h;
+} Glyph;
+
+typedef struct {
+    GLuint texture_id;
+    unsigned char* pixels;  // CPU copy (width x height, one byte per texel)
+    int width;
+    int height;             // grows up to width
+    int shelf_x, shelf_y, shelf_h;
+    unsigned int last_used; // frame this page was last drawn from
+} FontAtlasPage;
+
+// One font rasterized at one pixel size
+typedef struct {
+    float size;
+    float scale;            // stb_truetype units -> pixels
+    float ascent;
+    float descent;
+    float line_gap;
+    float line_height;
+
+    // Glyph cache
+    Glyph* glyphs;
+    int glyph_count;
+    int glyph_capacity;
+    int32_t* slots;         // hash table of glyph index + 1 (0 = empty)
+    uint32_t slot_mask;
+
+    // Atlas pages
+    FontAtlasPage pages[FONT_MAX_PAGES];
+    int page_count;
+    int page_size;          // page width and maximum height
+
+    const struct stbtt_fontinfo* info;  // NULL for prebaked strikes
+    int sdf;                // pages hold distance fields, not coverage
+    int prebaked;           // BMFont pages: the glyph set is fixed
+    unsigned int last_used; // frame this strike was last drawn or measured
+} FontStrike;
+
+#define FONT_KERN_MAX_PAIRS 65536  // memoized non-ASCII pairs per font
 
+// Kerning adjustments in font units (multiply by the strike scale)
 typedef struct {
-    // Per-character metrics
-    float advance_x[FONT_NUM_CHARS];
-    float offset_x[FONT_NUM_CHARS];
-    float offset_y[FONT_NUM_CHARS];
-    float width[FONT_NUM_CHARS];
-    float height[FONT_NUM_CHARS];
-    float uv_x0[FONT_NUM_CHARS];
-    float uv_y0[FONT_NUM_CHARS];
-    float uv_x1[FONT_NUM_CHARS];
-    float uv_y1[FONT_NUM_CHARS];
-
-    // Font info
+    int16_t* ascii;         // FONT_NUM_CHARS x FONT_NUM_CHARS (NULL = font has no kerning)
+    uint64_t* pair_keys;    // other pairs: left << 32 | right (0 = empty)
+    int16_t* pair_values;
+    uint32_t pair_mask;
+    int pair_count;
+} FontKerning;
+
+// SDF text effects (widths and offsets in screen pixels)
+typedef struct {
+    float outline;
+    Color outline_color;
+    float glow;
+    Color glow_color;
+    float shadow_x, shadow_y;
+    float shadow_softness;
+    Color shadow_color;     // alpha 0 disables the shadow
+} TextEffects;
+
+typedef struct {
+    // Metrics of the current size (font_set_size)
     float font_size;
     float ascent;
     float descent;
     float line_gap;
     float line_height;
 
-    // OpenGL texture atlas
-    GLuint texture_id;
-    int atlas_width;
-    int atlas_height;
+    FontStrike* strikes[FONT_MAX_SIZES];
+    int strike_count;
+    FontStrike* current;
 
-    // Raw font data (kept for re-rasterizing at different sizes)
-    unsigned char* font_data;
+    int sdf;                // one SDF strike scaled to every size
+    float prebaked_size;    // BMFont: size of its only strike (0 for TrueType)
+    TextEffects effects;
+
+    FontKerning kerning;
+    int kerning_enabled;
+
+    // Mapped font file (kept for rasterizing glyphs on demand; NULL for BMFont)
+    struct FontFile* file;
+    const unsigned char* font_data;
     size_t font_data_size;
+    struct stbtt_fontinfo* info;
 } Font;
 
+// Font being prepared on a worker thread
+typedef struct FontLoadJob FontLoadJob;
+
+typedef enum {
+    TEXT_ALIGN_LEFT = 0,
+    TEXT_ALIGN_CENTER,
+    TEXT_ALIGN_RIGHT,
+    TEXT_ALIGN_JUSTIFY      // wrapped lines stretched to max_width, last line left
+} TextAlign;
+
+typedef enum {
+    TEXT_WRAP_WORD = 0,     // break at spaces; longer words break anywhere
+    TEXT_WRAP_CHAR,         // break before the character that overflows
+    TEXT_WRAP_NONE          // break only at '\n'
+} TextWrap;
+
+// Zero-initialized options lay out exactly like render_text
+typedef struct {
+    float size;             // pixel size (0 = the font's current size)
+    float max_width;        // wrap and align width in pixels (0 = none)
+    TextWrap wrap;          // only used with max_width
+    TextAlign align;        // inside max_width, or the widest line without it
+    float line_spacing;     // multiple of the line height (0 = 1)
+} TextLayoutOptions;
+
+typedef struct {
+    uint32_t codepoint;
+    float x, y;             // pen position from the top-left corner (y = baseline)
+} TextLayoutGlyph;
+
+typedef struct {
+    // Key (options with the size and defaults resolved)
+    const Font* font;
+    TextLayoutOptions options;
+    uint32_t hash;
+    const char* text;
+    size_t length;
+
+    // Drawable glyphs (spaces and missing glyphs are left out)
+    TextLayoutGlyph* glyphs;
+    int glyph_count;
+    int line_count;
+    float width;            // widest line
+    float height;
+    unsigned long long last_used;
+} TextLayout;
+
+typedef struct {
+    int frame_misses;           // glyphs rasterized during the last finished frame
+    int current_misses;         // glyphs rasterized so far this frame
+    unsigned long long hits;
+    unsigned long long misses;
+    int evictions;              // atlas pages cleared to make room
+    int glyphs;                 // cached glyphs across all fonts
+    int pages;                  // atlas pages across all fonts
+    int sizes;                  // rasterized sizes (strikes) across all fonts
+    int layouts;                // retained text layouts built
+    int layout_frame_hits;      // layout cache hits during the last finished frame
+    int layout_frame_misses;    // layouts computed during the last finished frame
+    int layout_entries;         // layouts currently memoized
+} TextCacheStats;
+
+// Retained text: laid out once into quads relative to its origin (grouped by
+// atlas page) and redrawn by copying them into the text batch, or from a
+// static vertex buffer with `gpu`. The layout is rebuilt only when the text,
+// font or size changes, or when the glyph cache moved glyphs it uses.
+typedef struct {
+    Font* font;
+    char* text;
+    TextLayoutOptions layout;   // size always set
+    int gpu;
+
+    unsigned int generation;    // glyph cache generation of the layout (0 = stale)
+    FontStrike* strike;
+    float width, height;
+    float* local;               // vertices relative to the origin, white
+    float* baked;               // `local` moved and colored for the last draw
+    int vertex_count;
+    int vertex_capacity;
+    int run_start[FONT_MAX_PAGES];
+    int run_count[FONT_MAX_PAGES];
+    float baked_x, baked_y;
+    Color baked_color;
+    int baked_valid;
+
+    GLuint vao, vbo;            // gpu only
+} TextObject;
+
+// Character grid for consoles and log views (text_grid.c): a code point and
+// foreground/background colors per cell, drawn with one instanced call from
+// a per-cell GPU buffer. Only rows that changed are rebuilt and uploaded;
+// scrolling rotates the rows on the GPU instead of moving cells.
+typedef struct {
+    uint32_t codepoint;         // 0 = empty
+    uint32_t fg;                // RGBA8, red in the low byte
+    uint32_t bg;                // 0 = transparent
+} TextGridCell;
+
+typedef struct {
+    Font* font;
+    int cols, rows;
+    int top;                    // storage row shown as row 0
+    TextGridCell* cells;        // rows x cols in storage order
+    uint8_t* dirty;             // per storage row
+    int dirty_count;
+    uint8_t* row_pages;         // per storage row: mask of atlas pages drawn from
+
+    // State the GPU data was built with (a change rebuilds every row)
+    FontStrike* strike;
+    float size;
+    unsigned int generation;
+    float cell_w, cell_h;
+    float baseline;
+
+    GLuint vao, vbo;
+    void* scratch;              // one row of GPU instances
+} TextGrid;
+
 // Load a TrueType font from file at a given pixel size
 Font* font_load(const char* filepath, float size);
 
+// Load a TrueType font rendered from signed distance fields
+Font* font_load_sdf(const char* filepath, float size);
+
+// Load an AngelCode BMFont (.fnt, text or binary) and its page images. `size`
+// <= 0 uses the size the font was generated at. Returns NULL on failure with a
+// message in `err`.
+Font* font_load_bmfont(const char* filepath, float size, TextureFilter filter, char* err, size_t err_size);
+
+// Start loading a font on a worker thread (sdf selects font_load_sdf).
+// Returns NULL if the file cannot be opened or the thread cannot start.
+FontLoadJob* font_load_async(const char* filepath, float size, int sdf);
+
+// 1 once the worker has finished (successfully or not), 0 while it runs
+int font_load_async_done(const FontLoadJob* job);
+
+// Wait for the worker if needed, then create the font and upload its atlas
+// on the calling (GL) thread. The font belongs to the caller; later calls
+// return NULL. Returns NULL on failure.
+Font* font_load_async_finish(FontLoadJob* job);
+
+// Free the job, waiting for its worker first
+void font_load_async_destroy(FontLoadJob* job);
+
 // Destroy font and free all resources
 void font_destroy(Font* font);
 
-// Change the font size (re-rasterizes the atlas)
+// Change the current font size (reuses a cached strike when there is one)
 int font_set_size(Font* font, float size);
 
-// Render text at position with color
+// Strike for `size`, created (and the least-recently-used one dropped) when
+// it is not cached. SDF fonts always return their single strike; scale its
+// metrics by size / strike->size. Returns NULL on failure.
+FontStrike* font_get_strike(Font* font, float size);
+
+// Effects used when drawing an SDF font (ignored for bitmap fonts)
+void font_set_effects(Font* font, const TextEffects* effects);
+
+// Look up a glyph, rasterizing it on a cache miss. Returns NULL for code
+// points that are never drawn (controls). The pointer is valid until the next
+// lookup on this strike.
+const Glyph* font_strike_get_glyph(FontStrike* strike, uint32_t codepoint);
+
+// Rasterize every code point of a UTF-8 string ahead of time at `size`
+// (0 = current size), e.g. on a loading screen. Returns the number of glyphs
+// that were missing.
+int font_preload(Font* font, const char* text, float size);
+
+// Cached glyphs over every strike of the font
+int font_get_glyph_count(const Font* font);
+
+// Kerning between two code points in font units (0 when disabled or absent)
+int font_get_kerning(Font* font, uint32_t left, uint32_t right);
+
+// Turn kerning on or off (on by default); cached layouts are rebuilt
+void font_set_kerning(Font* font, int enabled);
+
+// Render UTF-8 text at position with color
 void render_text(Font* font, const char* text, float x, float y, Color color);
 
+// Render at another pixel size without changing the current one
+void render_text_sized(Font* font, const char* text, float x, float y, float size, Color color);
+
 // Measure text dimensions without drawing
 void text_measure(Font* font, const char* text, float* out_width, float* out_height);
+void text_measure_sized(Font* font, const char* text, float size, float* out_width, float* out_height);
+
+// Lay out UTF-8 text with wrapping and alignment (options may be NULL).
+// Results are memoized; the pointer is valid until the next call. Returns
+// NULL on failure.
+const TextLayout* text_layout_get(Font* font, const char* text, const TextLayoutOptions* options);
+
+// Draw a layout with its top-left corner at (x, y)
+void render_text_layout(Font* font, const char* text, float x, float y,
+                        const TextLayoutOptions* options, Color color);
+
+// Layout cache hooks used by the text renderer
+void text_layout_forget_font(const Font* font);
+void text_layout_begin_frame(void);
+void text_layout_get_stats(TextCacheStats* out);
+void text_layout_clear(void);
+
+// Retained text (options may be NULL; size <= 0 = the font's current size)
+TextObject* text_object_create(Font* font, const char* text, const TextLayoutOptions* layout, int gpu);
+void text_object_destroy(TextObject* obj);
+int text_object_set_text(TextObject* obj, const char* text);
+void text_object_set_font(TextObject* obj, Font* font, float size);
+void text_object_set_layout(TextObject* obj, const TextLayoutOptions* layout);
+void text_object_get_size(TextObject* obj, float* out_width, float* out_height);
+void text_object_draw(TextObject* obj, float x, float y, Color color);
+
+// Character grids (rows and columns are 0-based)
+uint32_t text_grid_color(Color color);
+TextGrid* text_grid_create(Font* font, int cols, int rows);
+void text_grid_destroy(TextGrid* grid);
+void text_grid_set_font(TextGrid* grid, Font* font);
+void text_grid_set(TextGrid* grid, int col, int row, uint32_t codepoint, uint32_t fg, uint32_t bg);
+const TextGridCell* text_grid_get(const TextGrid* grid, int col, int row);
+// Write UTF-8 text from (col, row), clipped to the row; '\n' continues on the
+// next row at `col`. Returns the number of cells written.
+int text_grid_print(TextGrid* grid, int col, int row, const char* text, uint32_t fg, uint32_t bg);
+void text_grid_fill(TextGrid* grid, int col, int row, int w, int h, uint32_t codepoint, uint32_t fg, uint32_t bg);
+// Scroll the contents up by `lines` (down when negative); rows scrolled in
+// are cleared to `bg`
+void text_grid_scroll(TextGrid* grid, int lines, uint32_t bg);
+// Cell size in pixels for the font's current size
+void text_grid_get_cell_size(TextGrid* grid, float* out_w, float* out_h);
+// Draw with the top-left corner at (x, y). Returns the rows rebuilt.
+int text_grid_draw(TextGrid* grid, float x, float y);
+
+// Grid hooks: the renderer frees the grid shader on shutdown, and grids
+// rebuild their rows when the atlas generation (bumped whenever cached
+// glyphs move) changes
+void text_grid_shutdown(void);
+unsigned int text_atlas_generation(void);
 
 // Initialize text rendering system (called lazily)
 void text_renderer_init(void);
@@ -66,4 +398,9 @@ void text_renderer_flush(void);
 // Called by renderer_begin to update screen dimensions
 void text_renderer_set_screen_size(int width, int height);
 
+// Called by renderer_begin: closes the per-frame glyph miss count
+void text_renderer_begin_frame(void);
+
+void text_get_cache_stats(TextCacheStats* out);
+
 #endif // TEXT_H
@@ -0,0 +1,493 @@
+// Character grid renderer for terminal-style views.
+//
+// Each cell becomes one instance of a 12-vertex draw: six vertices for the
+// background quad and six for the glyph quad. Instances live in one GPU
+// buffer in storage order, so a changed row is rebuilt and uploaded on its
+// own, and the whole grid is a single glDrawArraysInstanced call. Scrolling
+// moves the `top` row offset the shader maps storage rows through instead of
+// moving cells.
+
+#include "text.h"
+#include "camera.h"
+#include "renderer.h"
+#include "texture_memory.h"
+#include "../util/utf8.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    float rect[4];          // glyph quad inside the cell: x, y, w, h
+    float uv[4];            // u0, v0, u1, v1
+    float page;             // -1 = no glyph
+    uint8_t fg[4];
+    uint8_t bg[4];
+} GridInstance;
+
+static const char* grid_vertex_shader_source =
+    "#version 330 core\n"
+    "layout (location = 0) in vec4 aRect;\n"
+    "layout (location = 1) in vec4 aTexRect;\n"
+    "layout (location = 2) in float aPage;\n"
+    "layout (location = 3) in vec4 aFg;\n"
+    "layout (location = 4) in vec4 aBg;\n"
+    "out vec2 TexCoord;\n"
+    "out vec4 Color;\n"
+    "flat out int Page;\n"
+    "uniform mat4 projection;\n"
+    "uniform vec2 origin;\n"
+    "uniform vec2 cellSize;\n"
+    "uniform int cols;\n"
+    "uniform int rows;\n"
+    "uniform int top;\n"
+    "const vec2 corners[6] = vec2[6](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0),\n"
+    "                                vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0));\n"
+    "void main() {\n"
+    "    vec2 corner = corners[gl_VertexID % 6];\n"
+    "    int row = (gl_InstanceID / cols - top + rows) % rows;\n"
+    "    vec2 cell = origin + vec2(float(gl_InstanceID % cols), float(row)) * cellSize;\n"
+    "    vec2 pos;\n"
+    // Hidden quads collapse to a point and produce no fragments
+    "    if (gl_VertexID < 6) {\n"
+    "        pos = cell + corner * cellSize * (aBg.a > 0.0 ? 1.0 : 0.0);\n"
+    "        Color = aBg;\n"
+    "        Page = -1;\n"
+    "    } else {\n"
+    "        pos = cell + aRect.xy + corner * aRect.zw * (aPage >= 0.0 ? 1.0 : 0.0);\n"
+    "        Color = aFg;\n"
+    "        Page = int(aPage);\n"
+    "    }\n"
+    "    TexCoord = mix(aTexRect.xy, aTexRect.zw, corner);\n"
+    "    gl_Position = projection * vec4(pos, 0.0, 1.0);\n"
+    "}\n";
+
+// Samplers can only be indexed with constants, hence the branches. Atlas
+// pages have no mipmaps, so sampling level 0 explicitly is exact and safe in
+// non-uniform control flow. SDF pages use the text shader's distance
+// mapping, without effects.
+static const char* grid_fragment_shader_source =
+    "#version 330 core\n"
+    "in vec2 TexCoord;\n"
+    "in vec4 Color;\n"
+    "flat in int Page;\n"
+    "out vec4 FragColor;\n"
+    "uniform sampler2D pages[4];\n"
+    "uniform vec2 pageSize[4];\n"
+    "uniform bool sdf;\n"
+    "uniform float distRange;\n"
+    "uniform bool premultiplied;\n"
+    "void main() {\n"
+    "    vec2 dx = dFdx(TexCoord), dy = dFdy(TexCoord);\n"
+    "    float coverage = 1.0;\n"
+    "    if (Page >= 0) {\n"
+    "        if (Page == 0) coverage = textureLod(pages[0], TexCoord, 0.0).r;\n"
+    "        else if (Page == 1) coverage = textureLod(pages[1], TexCoord, 0.0).r;\n"
+    "        else if (Page == 2) coverage = textureLod(pages[2], TexCoord, 0.0).r;\n"
+    "        else coverage = textureLod(pages[3], TexCoord, 0.0).r;\n"
+    "        if (sdf) {\n"
+    "            vec2 texels = pageSize[Page];\n"
+    "            float texelsPerPixel = max(0.5 * (length(dx * texels) + length(dy * texels)), 1e-4);\n"
+    "            coverage = clamp((coverage - 0.5) * distRange / texelsPerPixel + 0.5, 0.0, 1.0);\n"
+    "        }\n"
+    "    }\n"
+    "    FragColor = vec4(Color.rgb, Color.a * coverage);\n"
+    "    if (FragColor.a < 0.01) discard;\n"
+    "    if (premultiplied) FragColor.rgb *= FragColor.a;\n"
+    "}\n";
+
+// Shared by every grid; created on the first draw
+typedef struct {
+    GLuint shader;
+    GLint projection_loc;
+    GLint origin_loc;
+    GLint cell_size_loc;
+    GLint cols_loc;
+    GLint rows_loc;
+    GLint top_loc;
+    GLint pages_loc;
+    GLint page_size_loc;
+    GLint sdf_loc;
+    GLint dist_range_loc;
+    GLint premultiplied_loc;
+    int initialized;
+} GridRendererState;
+
+static GridRendererState grid_state = {0};
+
+static GLuint compile_stage(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char info_log[512];
+        glGetShaderInfoLog(shader, 512, NULL, info_log);
+        fprintf(stderr, "[Text] Grid shader compile error: %s\n", info_log);
+    }
+    return shader;
+}
+
+static void ensure_renderer(void) {
+    if (grid_state.initialized) return;
+
+    GLuint vs = compile_stage(GL_VERTEX_SHADER, grid_vertex_shader_source);
+    GLuint fs = compile_stage(GL_FRAGMENT_SHADER, grid_fragment_shader_source);
+    grid_state.shader = glCreateProgram();
+    glAttachShader(grid_state.shader, vs);
+    glAttachShader(grid_state.shader, fs);
+    glLinkProgram(grid_state.shader);
+
+    GLint success;
+    glGetProgramiv(grid_state.shader, GL_LINK_STATUS, &success);
+    if (!success) {
+        char info_log[512];
+        glGetProgramInfoLog(grid_state.shader, 512, NULL, info_log);
+        fprintf(stderr, "[Text] Grid shader linking error: %s\n", info_log);
+    }
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLuint p = grid_state.shader;
+    grid_state.projection_loc = glGetUniformLocation(p, "projection");
+    grid_state.origin_loc = glGetUniformLocation(p, "origin");
+    grid_state.cell_size_loc = glGetUniformLocation(p, "cellSize");
+    grid_state.cols_loc = glGetUniformLocation(p, "cols");
+    grid_state.rows_loc = glGetUniformLocation(p, "rows");
+    grid_state.top_loc = glGetUniformLocation(p, "top");
+    grid_state.pages_loc = glGetUniformLocation(p, "pages");
+    grid_state.page_size_loc = glGetUniformLocation(p, "pageSize");
+    grid_state.sdf_loc = glGetUniformLocation(p, "sdf");
+    grid_state.dist_range_loc = glGetUniformLocation(p, "distRange");
+    grid_state.premultiplied_loc = glGetUniformLocation(p, "premultiplied");
+    grid_state.initialized = 1;
+}
+
+void text_grid_shutdown(void) {
+    if (!grid_state.initialized) return;
+    glDeleteProgram(grid_state.shader);
+    memset(&grid_state, 0, sizeof(grid_state));
+}
+
+// --- Grid lifetime ---
+
+static uint8_t color_byte(float v) {
+    if (v <= 0.0f) return 0;
+    if (v >= 1.0f) return 255;
+    return (uint8_t)(v * 255.0f + 0.5f);
+}
+
+uint32_t text_grid_color(Color color) {
+    return (uint32_t)color_byte(color.r) | (uint32_t)color_byte(color.g) << 8 |
+           (uint32_t)color_byte(color.b) << 16 | (uint32_t)color_byte(color.a) << 24;
+}
+
+static void mark_all_dirty(TextGrid* grid) {
+    memset(grid->dirty, 1, (size_t)grid->rows);
+    grid->dirty_count = grid->rows;
+}
+
+TextGrid* text_grid_create(Font* font, int cols, int rows) {
+    if (!font || cols <= 0 || rows <= 0 || cols > 4096 || rows > 4096) return NULL;
+
+    TextGrid* grid = (TextGrid*)calloc(1, sizeof(TextGrid));
+    if (!grid) return NULL;
+    grid->font = font;
+    grid->cols = cols;
+    grid->rows = rows;
+    grid->cells = (TextGridCell*)calloc((size_t)cols * rows, sizeof(TextGridCell));
+    grid->dirty = (uint8_t*)malloc((size_t)rows);
+    grid->row_pages = (uint8_t*)calloc((size_t)rows, 1);
+    grid->scratch = malloc((size_t)cols * sizeof(GridInstance));
+    if (!grid->cells || !grid->dirty || !grid->row_pages || !grid->scratch) {
+        text_grid_destroy(grid);
+        return NULL;
+    }
+    mark_all_dirty(grid);
+    return grid;
+}
+
+void text_grid_destroy(TextGrid* grid) {
+    if (!grid) return;
+    if (grid->vbo) glDeleteBuffers(1, &grid->vbo);
+    if (grid->vao) glDeleteVertexArrays(1, &grid->vao);
+    free(grid->cells);
+    free(grid->dirty);
+    free(grid->row_pages);
+    free(grid->scratch);
+    free(grid);
+}
+
+void text_grid_set_font(TextGrid* grid, Font* font) {
+    if (!grid || !font || font == grid->font) return;
+    grid->font = font;
+    grid->strike = NULL;    // rebuilds every row on the next draw
+}
+
+// --- Cell access ---
+
+static int storage_row(const TextGrid* grid, int row) {
+    return (grid->top + row) % grid->rows;
+}
+
+void text_grid_set(TextGrid* grid, int col, int row, uint32_t codepoint, uint32_t fg, uint32_t bg) {
+    if (col < 0 || row < 0 || col >= grid->cols || row >= grid->rows) return;
+    int srow = storage_row(grid, row);
+    TextGridCell* cell = &grid->cells[(size_t)srow * grid->cols + col];
+    if (cell->codepoint == codepoint && cell->fg == fg && cell->bg == bg) return;
+    cell->codepoint = codepoint;
+    cell->fg = fg;
+    cell->bg = bg;
+    if (!grid->dirty[srow]) {
+        grid->dirty[srow] = 1;
+        grid->dirty_count++;
+    }
+}
+
+const TextGridCell* text_grid_get(const TextGrid* grid, int col, int row) {
+    if (col < 0 || row < 0 || col >= grid->cols || row >= grid->rows) return NULL;
+    return &grid->cells[(size_t)storage_row(grid, row) * grid->cols + col];
+}
+
+int text_grid_print(TextGrid* grid, int col, int row, const char* text, uint32_t fg, uint32_t bg) {
+    if (!text) return 0;
+    int written = 0;
+    int x = col;
+    uint32_t cp;
+    while ((cp = utf8_decode(&text)) != 0) {
+        if (cp == '\n') {
+            x = col;
+            row++;
+            continue;
+        }
+        if (row >= grid->rows) break;
+        if (x >= 0 && x < grid->cols && row >= 0) {
+            text_grid_set(grid, x, row, cp, fg, bg);
+            written++;
+        }
+        x++;
+    }
+    return written;
+}
+
+void text_grid_fill(TextGrid* grid, int col, int row, int w, int h, uint32_t codepoint, uint32_t fg, uint32_t bg) {
+    int x0 = col < 0 ? 0 : col;
+    int y0 = row < 0 ? 0 : row;
+    int x1 = col + w > grid->cols ? grid->cols : col + w;
+    int y1 = row + h > grid->rows ? grid->rows : row + h;
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
+            text_grid_set(grid, x, y, codepoint, fg, bg);
+        }
+    }
+}
+
+void text_grid_scroll(TextGrid* grid, int lines, uint32_t bg) {
+    if (lines == 0) return;
+    if (lines >= grid->rows || lines <= -grid->rows) {
+        text_grid_fill(grid, 0, 0, grid->cols, grid->rows, 0, 0, bg);
+        return;
+    }
+
+    // Rotate the ring, then clear the rows that came in at the other edge
+    int count = lines > 0 ? lines : -lines;
+    grid->top = ((grid->top + lines) % grid->rows + grid->rows) % grid->rows;
+    int first = lines > 0 ? grid->rows - count : 0;
+    for (int row = first; row < first + count; row++) {
+        int srow = storage_row(grid, row);
+        TextGridCell* cells = &grid->cells[(size_t)srow * grid->cols];
+        for (int x = 0; x < grid->cols; x++) {
+            cells[x].codepoint = 0;
+            cells[x].fg = 0;
+            cells[x].bg = bg;
+        }
+        if (!grid->dirty[srow]) {
+            grid->dirty[srow] = 1;
+            grid->dirty_count++;
+        }
+    }
+}
+
+// --- Rendering ---
+
+// Cell size from the font's current size; a new strike, size or atlas
+// layout invalidates every row
+static FontStrike* update_metrics(TextGrid* grid) {
+    Font* font = grid->font;
+    FontStrike* strike = font_get_strike(font, font->font_size);
+    if (!strike) return NULL;
+    if (strike == grid->strike && font->font_size == grid->size &&
+        grid->generation == text_atlas_generation()) {
+        return strike;
+    }
+
+    float k = font->font_size / strike->size;
+    const Glyph* m = font_strike_get_glyph(strike, 'M');
+    float advance = m ? m->advance_x : strike->size * 0.5f;
+    grid->cell_w = fmaxf(ceilf(advance * k), 1.0f);
+    grid->cell_h = fmaxf(ceilf(strike->line_height * k), 1.0f);
+    grid->baseline = roundf(strike->ascent * k);
+    grid->strike = strike;
+    grid->size = font->font_size;
+    mark_all_dirty(grid);
+    return strike;
+}
+
+void text_grid_get_cell_size(TextGrid* grid, float* out_w, float* out_h) {
+    int ok = grid && grid->font && update_metrics(grid);
+    if (out_w) *out_w = ok ? grid->cell_w : 0;
+    if (out_h) *out_h = ok ? grid->cell_h : 0;
+}
+
+static void ensure_buffers(TextGrid* grid) {
+    if (grid->vbo) return;
+
+    glGenVertexArrays(1, &grid->vao);
+    glGenBuffers(1, &grid->vbo);
+    glBindVertexArray(grid->vao);
+    glBindBuffer(GL_ARRAY_BUFFER, grid->vbo);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)grid->cols * grid->rows * sizeof(GridInstance), NULL, GL_DYNAMIC_DRAW);
+
+    GLsizei stride = sizeof(GridInstance);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(GridInstance, rect));
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(GridInstance, uv));
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(GridInstance, page));
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)offsetof(GridInstance, fg));
+    glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)offsetof(GridInstance, bg));
+    for (GLuint i = 0; i < 5; i++) {
+        glEnableVertexAttribArray(i);
+        glVertexAttribDivisor(i, 1);
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // The buffer starts undefined
+    mark_all_dirty(grid);
+}
+
+static void unpack_color(uint32_t color, uint8_t* out) {
+    out[0] = (uint8_t)(color & 0xFF);
+    out[1] = (uint8_t)(color >> 8 & 0xFF);
+    out[2] = (uint8_t)(color >> 16 & 0xFF);
+    out[3] = (uint8_t)(color >> 24);
+}
+
+// Rebuild the instances of one storage row and upload them
+static void rebuild_row(TextGrid* grid, FontStrike* strike, int srow) {
+    float k = grid->size / strike->size;
+    const TextGridCell* cells = &grid->cells[(size_t)srow * grid->cols];
+    GridInstance* out = (GridInstance*)grid->scratch;
+    uint8_t pages = 0;
+
+    for (int x = 0; x < grid->cols; x++) {
+        const TextGridCell* cell = &cells[x];
+        GridInstance* inst = &out[x];
+        memset(inst, 0, sizeof(*inst));
+        inst->page = -1.0f;
+        unpack_color(cell->fg, inst->fg);
+        unpack_color(cell->bg, inst->bg);
+        if (cell->codepoint <= ' ' || (cell->fg >> 24) == 0) continue;
+
+        const Glyph* glyph = font_strike_get_glyph(strike, cell->codepoint);
+        if (!glyph || glyph->page < 0) continue;
+        inst->rect[0] = glyph->offset_x * k;
+        inst->rect[1] = grid->baseline + glyph->offset_y * k;
+        inst->rect[2] = glyph->width * k;
+        inst->rect[3] = glyph->height * k;
+        inst->uv[0] = glyph->u0;
+        inst->uv[1] = glyph->v0;
+        inst->uv[2] = glyph->u1;
+        inst->uv[3] = glyph->v1;
+        inst->page = (float)glyph->page;
+        pages |= (uint8_t)(1u << glyph->page);
+    }
+
+    glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)srow * grid->cols * sizeof(GridInstance),
+                    (GLsizeiptr)grid->cols * sizeof(GridInstance), out);
+    grid->row_pages[srow] = pages;
+    grid->dirty[srow] = 0;
+    grid->dirty_count--;
+}
+
+static int rebuild_dirty_rows(TextGrid* grid, FontStrike* strike) {
+    int rebuilt = 0;
+    glBindBuffer(GL_ARRAY_BUFFER, grid->vbo);
+    // Looking glyphs up can move others (a page grows or is evicted); rows
+    // built before that are built again, once per draw at most
+    for (int pass = 0; pass < 2 && grid->dirty_count > 0; pass++) {
+        unsigned int generation = text_atlas_generation();
+        for (int srow = 0; srow < grid->rows; srow++) {
+            if (!grid->dirty[srow]) continue;
+            rebuild_row(grid, strike, srow);
+            rebuilt++;
+        }
+        grid->generation = generation;
+        if (text_atlas_generation() != generation) mark_all_dirty(grid);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return rebuilt;
+}
+
+int text_grid_draw(TextGrid* grid, float x, float y) {
+    if (!grid || !grid->font) return 0;
+    ensure_renderer();
+
+    // Keep painter's order: everything batched so far goes first
+    renderer_switch_batch(BATCH_NONE);
+
+    ensure_buffers(grid);
+    FontStrike* strike = update_metrics(grid);
+    if (!strike) return 0;
+    int rebuilt = rebuild_dirty_rows(grid, strike);
+
+    // Keep the pages the grid samples at the front of the LRU
+    unsigned int frame = texture_memory_current_frame();
+    uint8_t used = 0;
+    for (int i = 0; i < grid->rows; i++) used |= grid->row_pages[i];
+    for (int i = 0; i < strike->page_count; i++) {
+        if (used & (1u << i)) strike->pages[i].last_used = frame;
+    }
+
+    int sw, sh;
+    renderer_get_screen_size(&sw, &sh);
+    float projection[16];
+    if (renderer_is_ui_mode()) {
+        renderer_get_ui_projection(projection, sw, sh);
+    } else {
+        camera_get_matrix(projection, sw, sh);
+    }
+
+    GLint units[FONT_MAX_PAGES];
+    float page_sizes[FONT_MAX_PAGES * 2];
+    for (int i = 0; i < FONT_MAX_PAGES; i++) {
+        const FontAtlasPage* page = strike->page_count ? &strike->pages[i < strike->page_count ? i : 0] : NULL;
+        units[i] = i;
+        page_sizes[i * 2 + 0] = page ? (float)page->width : 1.0f;
+        page_sizes[i * 2 + 1] = page ? (float)page->height : 1.0f;
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, page ? page->texture_id : 0);
+    }
+
+    renderer_apply_blend();
+    glUseProgram(grid_state.shader);
+    glUniformMatrix4fv(grid_state.projection_loc, 1, GL_FALSE, projection);
+    glUniform2f(grid_state.origin_loc, x, y);
+    glUniform2f(grid_state.cell_size_loc, grid->cell_w, grid->cell_h);
+    glUniform1i(grid_state.cols_loc, grid->cols);
+    glUniform1i(grid_state.rows_loc, grid->rows);
+    glUniform1i(grid_state.top_loc, grid->top);
+    glUniform1iv(grid_state.pages_loc, FONT_MAX_PAGES, units);
+    glUniform2fv(grid_state.page_size_loc, FONT_MAX_PAGES, page_sizes);
+    glUniform1i(grid_state.sdf_loc, strike->sdf);
+    glUniform1f(grid_state.dist_range_loc, FONT_SDF_PADDING * 255.0f / 128.0f);
+    glUniform1i(grid_state.premultiplied_loc, renderer_get_premultiplied_alpha());
+
+    glBindVertexArray(grid->vao);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 12, grid->cols * grid->rows);
+    glBindVertexArray(0);
+    glUseProgram(0);
+    glActiveTexture(GL_TEXTURE0);
+    return rebuilt;
+}
@@ -0,0 +1,396 @@
+// Text layout — line breaking, alignment and a memo cache of the results.
+//
+// A layout stores positioned code points rather than quads: drawing looks
+// each one up in the glyph cache, so a layout depends only on the font, size,
+// string and options and survives atlas pages growing or being evicted.
+//
+// Layouts live in a fixed pool indexed by an open-addressing hash table keyed
+// by (font, options, string). When the pool is full the least-recently-used
+// layout is replaced.
+
+#include "text.h"
+#include "../util/utf8.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define LAYOUT_CACHE_SIZE 256
+#define LAYOUT_SLOT_COUNT 512   // power of two, at most half full
+
+// One decoded code point of the string being laid out
+typedef struct {
+    uint32_t codepoint;
+    float kern;             // adjustment after the previous item (dropped at line starts)
+    float advance;
+    int drawable;           // has pixels in the glyph cache
+} LayoutItem;
+
+typedef struct {
+    int start, end;         // items on the line (end excludes trailing spaces of soft breaks)
+    int next;               // first item of the following line
+    float width;
+    int soft;               // broken by wrapping rather than '\n'
+} LayoutLine;
+
+static TextLayout layouts[LAYOUT_CACHE_SIZE];
+static int layout_count = 0;
+static int32_t slots[LAYOUT_SLOT_COUNT];  // layout index + 1 (0 = empty)
+static unsigned long long use_clock = 0;
+
+static int frame_hits = 0, frame_misses = 0;
+static int current_hits = 0, current_misses = 0;
+
+// Scratch buffers reused by every layout
+static LayoutItem* items = NULL;
+static int item_capacity = 0;
+static LayoutLine* lines = NULL;
+static int line_capacity = 0;
+
+static int reserve(void** array, int* capacity, int count, size_t elem_size) {
+    if (count <= *capacity) return 1;
+
+    int new_capacity = *capacity ? *capacity : 64;
+    while (new_capacity < count) new_capacity *= 2;
+    void* grown = realloc(*array, (size_t)new_capacity * elem_size);
+    if (!grown) return 0;
+    *array = grown;
+    *capacity = new_capacity;
+    return 1;
+}
+
+// --- Hash table ---
+
+static uint32_t mix(uint32_t hash, uint32_t value) {
+    hash = (hash ^ value) * 0x9E3779B1u;
+    return hash ^ (hash >> 15);
+}
+
+static uint32_t float_bits(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+// FNV-1a over the string, then the font and options mixed in a word at a time
+static uint32_t hash_key(const Font* font, const char* text, size_t length, const TextLayoutOptions* o) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)text[i];
+        hash *= 16777619u;
+    }
+    uintptr_t font_bits = (uintptr_t)font;
+    hash = mix(hash, (uint32_t)font_bits ^ (uint32_t)(font_bits >> 16 >> 16));
+    hash = mix(hash, float_bits(o->size));
+    hash = mix(hash, float_bits(o->max_width));
+    hash = mix(hash, (uint32_t)o->wrap | (uint32_t)o->align << 8);
+    return mix(hash, float_bits(o->line_spacing));
+}
+
+static int same_key(const TextLayout* layout, const Font* font, const char* text, size_t length,
+                    const TextLayoutOptions* o) {
+    const TextLayoutOptions* k = &layout->options;
+    return layout->font == font && layout->length == length &&
+           k->size == o->size && k->max_width == o->max_width && k->wrap == o->wrap &&
+           k->align == o->align && k->line_spacing == o->line_spacing &&
+           memcmp(layout->text, text, length) == 0;
+}
+
+// Slot holding the key, or the empty slot where it would be inserted
+static uint32_t find_layout_slot(uint32_t hash, const Font* font, const char* text, size_t length,
+                          const TextLayoutOptions* options) {
+    uint32_t i = hash & (LAYOUT_SLOT_COUNT - 1);
+    for (;;) {
+        int32_t e = slots[i];
+        if (e == 0) return i;
+        const TextLayout* layout = &layouts[e - 1];
+        if (layout->hash == hash && same_key(layout, font, text, length, options)) return i;
+        i = (i + 1) & (LAYOUT_SLOT_COUNT - 1);
+    }
+}
+
+static uint32_t slot_of(const TextLayout* layout) {
+    return find_layout_slot(layout->hash, layout->font, layout->text, layout->length, &layout->options);
+}
+
+// Same backward-shift delete as the glyph table in text.c
+static void remove_layout_slot(uint32_t hole) {
+    uint32_t mask = LAYOUT_SLOT_COUNT - 1;
+    uint32_t j = hole;
+    for (;;) {
+        j = (j + 1) & mask;
+        int32_t e = slots[j];
+        if (e == 0) break;
+
+        uint32_t home = layouts[e - 1].hash & mask;
+        int stays = (hole <= j) ? (home > hole && home <= j)
+                                : (home > hole || home <= j);
+        if (!stays) {
+            slots[hole] = e;
+            hole = j;
+        }
+    }
+    slots[hole] = 0;
+}
+
+// Drop layout `e` (swap-remove, fixing the moved entry's slot)
+static void remove_layout(int e) {
+    remove_layout_slot(slot_of(&layouts[e]));
+    free(layouts[e].glyphs);  // one block with the text
+
+    int last = layout_count - 1;
+    if (e != last) {
+        slots[slot_of(&layouts[last])] = e + 1;
+        layouts[e] = layouts[last];
+    }
+    layout_count--;
+}
+
+static void evict_oldest(void) {
+    int oldest = 0;
+    for (int i = 1; i < layout_count; i++) {
+        if (layouts[i].last_used < layouts[oldest].last_used) oldest = i;
+    }
+    remove_layout(oldest);
+}
+
+// --- Layout ---
+
+static int is_space(uint32_t cp) {
+    return cp == ' ' || cp == '\t';
+}
+
+// Decode the string into items with their advances and kerning at the
+// layout size
+static int decode_items(Font* font, FontStrike* strike, const char* text, float k) {
+    float kern_scale = strike->scale * k;
+    int n = 0;
+    uint32_t cp, prev = 0;
+    while ((cp = utf8_decode(&text)) != 0) {
+        LayoutItem item = {cp, 0.0f, 0.0f, 0};
+        if (cp == '\t') {
+            // Tab is 4 spaces
+            const Glyph* space = font_strike_get_glyph(strike, ' ');
+            if (space) item.advance = space->advance_x * k * 4;
+            prev = 0;
+        } else if (cp != '\n') {
+            const Glyph* glyph = font_strike_get_glyph(strike, cp);
+            if (!glyph) continue;
+            item.advance = glyph->advance_x * k;
+            item.drawable = glyph->page >= 0;
+            if (prev) item.kern = font_get_kerning(font, prev, cp) * kern_scale;
+            prev = cp;
+        } else {
+            prev = 0;
+        }
+
+        if (!reserve((void**)&items, &item_capacity, n + 1, sizeof(LayoutItem))) return -1;
+        items[n++] = item;
+    }
+    return n;
+}
+
+// Split items into lines. Returns the line count, or -1 on allocation failure.
+static int break_lines(int n, const TextLayoutOptions* o) {
+    TextWrap wrap = o->max_width > 0 ? o->wrap : TEXT_WRAP_NONE;
+    int count = 0;
+    int i = 0;
+
+    while (i <= n) {
+        LayoutLine line = {i, i, i + 1, 0.0f, 0};
+        int space_start = -1;   // first space of the latest run on this line
+        int word_start = -1;    // first item after that run
+        float space_x = 0;
+        float x = 0;
+
+        for (;; i++) {
+            if (i == n || items[i].codepoint == '\n') {
+                line.end = i;
+                line.next = i + 1;
+                line.width = x;
+                break;
+            }
+            float kern = i > line.start ? items[i].kern : 0.0f;
+
+            if (is_space(items[i].codepoint)) {
+                // Spaces may hang past the edge; lines break before words
+                if (i == line.start || !is_space(items[i - 1].codepoint)) {
+                    space_start = i;
+                    space_x = x;
+                }
+            } else {
+                if (i > line.start && is_space(items[i - 1].codepoint)) word_start = i;
+
+                if (wrap != TEXT_WRAP_NONE && i > line.start && x + kern + items[i].advance > o->max_width) {
+                    line.soft = 1;
+                    if (wrap == TEXT_WRAP_WORD && space_start > line.start && word_start > space_start) {
+                        line.end = space_start;
+                        line.next = word_start;
+                        line.width = space_x;
+                    } else if (word_start == i && space_start > line.start) {
+                        // Character wrap at a word start: drop the hanging spaces
+                        line.end = space_start;
+                        line.next = i;
+                        line.width = space_x;
+                    } else {
+                        line.end = i;
+                        line.next = i;
+                        line.width = x;
+                    }
+                    break;
+                }
+            }
+            x += kern;
+            x += items[i].advance;
+        }
+
+        if (!reserve((void**)&lines, &line_capacity, count + 1, sizeof(LayoutLine))) return -1;
+        lines[count++] = line;
+        i = line.next;
+    }
+    return count;
+}
+
+static int build_layout(TextLayout* out, Font* font, const char* text, size_t length,
+                        const TextLayoutOptions* o) {
+    FontStrike* strike = font_get_strike(font, o->size);
+    if (!strike) return 0;
+    float k = o->size / strike->size;  // 1 except for SDF fonts
+
+    int n = decode_items(font, strike, text, k);
+    if (n < 0) return 0;
+    int line_count = break_lines(n, o);
+    if (line_count < 0) return 0;
+
+    float widest = 0;
+    int drawable = 0;
+    for (int l = 0; l < line_count; l++) {
+        if (lines[l].width > widest) widest = lines[l].width;
+        for (int i = lines[l].start; i < lines[l].end; i++) drawable += items[i].drawable;
+    }
+
+    // Glyphs and a copy of the key string share one allocation
+    TextLayoutGlyph* glyphs = (TextLayoutGlyph*)malloc((size_t)drawable * sizeof(TextLayoutGlyph) + length + 1);
+    if (!glyphs) return 0;
+    char* text_copy = (char*)(glyphs + drawable);
+    memcpy(text_copy, text, length + 1);
+
+    float area = o->max_width > 0 ? o->max_width : widest;
+    float line_advance = strike->line_height * k * o->line_spacing;
+    int g = 0;
+
+    for (int l = 0; l < line_count; l++) {
+        const LayoutLine* line = &lines[l];
+        float x = 0;
+        float gap = 0;  // extra advance per space when justifying
+
+        switch (o->align) {
+            case TEXT_ALIGN_CENTER: x = (area - line->width) * 0.5f; break;
+            case TEXT_ALIGN_RIGHT:  x = area - line->width; break;
+            case TEXT_ALIGN_JUSTIFY:
+                if (line->soft && o->max_width > 0) {
+                    int spaces = 0;
+                    for (int i = line->start; i < line->end; i++) spaces += is_space(items[i].codepoint);
+                    if (spaces > 0) gap = (o->max_width - line->width) / spaces;
+                }
+                break;
+            default: break;
+        }
+
+        float y = strike->ascent * k + l * line_advance;
+        for (int i = line->start; i < line->end; i++) {
+            if (i > line->start) x += items[i].kern;
+            if (items[i].drawable) {
+                glyphs[g].codepoint = items[i].codepoint;
+                glyphs[g].x = x;
+                glyphs[g].y = y;
+                g++;
+            }
+            x += items[i].advance;
+            if (is_space(items[i].codepoint)) x += gap;
+        }
+    }
+
+    out->font = font;
+    out->options = *o;
+    out->text = text_copy;
+    out->length = length;
+    out->glyphs = glyphs;
+    out->glyph_count = drawable;
+    out->line_count = line_count;
+    out->width = widest;
+    out->height = (line_count - 1) * line_advance + strike->line_height * k;
+    return 1;
+}
+
+// --- Public API ---
+
+const TextLayout* text_layout_get(Font* font, const char* text, const TextLayoutOptions* options) {
+    if (!font || !text) return NULL;
+
+    // Resolve defaults so equivalent requests share one entry
+    TextLayoutOptions o = {0};
+    if (options) o = *options;
+    if (o.size <= 0) o.size = font->font_size;
+    if (o.max_width <= 0) {
+        o.max_width = 0;
+        o.wrap = TEXT_WRAP_NONE;
+        if (o.align == TEXT_ALIGN_JUSTIFY) o.align = TEXT_ALIGN_LEFT;
+    }
+    if (o.line_spacing <= 0) o.line_spacing = 1.0f;
+
+    size_t length = strlen(text);
+    uint32_t hash = hash_key(font, text, length, &o);
+    uint32_t slot = find_layout_slot(hash, font, text, length, &o);
+    if (slots[slot]) {
+        TextLayout* layout = &layouts[slots[slot] - 1];
+        layout->last_used = ++use_clock;
+        current_hits++;
+        return layout;
+    }
+
+    current_misses++;
+    TextLayout built = {0};
+    if (!build_layout(&built, font, text, length, &o)) return NULL;
+    built.hash = hash;
+    built.last_used = ++use_clock;
+
+    if (layout_count == LAYOUT_CACHE_SIZE) {
+        evict_oldest();
+        slot = find_layout_slot(hash, font, text, length, &o);
+    }
+    layouts[layout_count] = built;
+    slots[slot] = ++layout_count;
+    return &layouts[layout_count - 1];
+}
+
+void text_layout_forget_font(const Font* font) {
+    for (int i = layout_count - 1; i >= 0; i--) {
+        if (layouts[i].font == font) remove_layout(i);
+    }
+}
+
+void text_layout_begin_frame(void) {
+    frame_hits = current_hits;
+    frame_misses = current_misses;
+    current_hits = 0;
+    current_misses = 0;
+}
+
+void text_layout_get_stats(TextCacheStats* out) {
+    if (!out) return;
+    out->layout_frame_hits = frame_hits;
+    out->layout_frame_misses = frame_misses;
+    out->layout_entries = layout_count;
+}
+
+void text_layout_clear(void) {
+    for (int i = 0; i < layout_count; i++) free(layouts[i].glyphs);
+    layout_count = 0;
+    memset(slots, 0, sizeof(slots));
+
+    free(items);
+    free(lines);
+    items = NULL;
+    lines = NULL;
+    item_capacity = 0;
+    line_capacity = 0;
+}
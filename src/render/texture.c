@@ -2,8 +2,15 @@
 #include "stb/stb_image.h"
 
 #include "texture.h"
+#include "texture_cache.h"
+#include "texture_registry.h"
+#include "texture_memory.h"
 #include "camera.h"
 #include "renderer.h"
+#include "pixel_ops.h"
+#include "../platform/filemap.h"
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -30,9 +37,18 @@ static const char* texture_fragment_shader_source =
     "in vec4 Color;\n"
     "out vec4 FragColor;\n"
     "uniform sampler2D textureSampler;\n"
+    "uniform bool premultiplied;\n"
+    "uniform bool texturePremultiplied;\n"
     "void main() {\n"
     "    vec4 texColor = texture(textureSampler, TexCoord);\n"
-    "    FragColor = texColor * Color;\n"
+    "    vec4 tint = Color;\n"
+    "    if (premultiplied) {\n"
+    "        if (!texturePremultiplied) texColor.rgb *= texColor.a;\n"
+    "        tint.rgb *= tint.a;\n"
+    "    } else if (texturePremultiplied && texColor.a > 0.0) {\n"
+    "        texColor.rgb /= texColor.a;\n"
+    "    }\n"
+    "    FragColor = texColor * tint;\n"
     "    if (FragColor.a < 0.001) discard;\n"
     "}\n";
 
@@ -46,9 +62,12 @@ typedef struct {
     GLuint shader;
     GLint projection_loc;
     GLint texture_loc;
+    GLint premultiplied_loc;
+    GLint texture_premultiplied_loc;
     float vertices[TEXTURE_MAX_VERTICES * TEXTURE_VERTEX_SIZE];
     int vertex_count;
     GLuint current_texture;
+    int current_premultiplied;
     int screen_width;
     int screen_height;
     int initialized;
@@ -102,6 +121,8 @@ void texture_renderer_init(void) {
     tex_state.shader = create_texture_shader();
     tex_state.projection_loc = glGetUniformLocation(tex_state.shader, "projection");
     tex_state.texture_loc = glGetUniformLocation(tex_state.shader, "textureSampler");
+    tex_state.premultiplied_loc = glGetUniformLocation(tex_state.shader, "premultiplied");
+    tex_state.texture_premultiplied_loc = glGetUniformLocation(tex_state.shader, "texturePremultiplied");
     
     glGenVertexArrays(1, &tex_state.vao);
     glGenBuffers(1, &tex_state.vbo);
@@ -145,8 +166,7 @@ void texture_renderer_flush(void) {
     if (tex_state.vertex_count == 0 || !tex_state.initialized) return;
     
     // Enable alpha blending for transparent textures (PNG, etc.)
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    renderer_apply_blend();
     
     // Get the correct projection matrix (UI mode = plain ortho, otherwise camera)
     float projection[16];
@@ -159,6 +179,8 @@ void texture_renderer_flush(void) {
     glUseProgram(tex_state.shader);
     glUniformMatrix4fv(tex_state.projection_loc, 1, GL_FALSE, projection);
     glUniform1i(tex_state.texture_loc, 0);
+    glUniform1i(tex_state.premultiplied_loc, renderer_get_premultiplied_alpha());
+    glUniform1i(tex_state.texture_premultiplied_loc, tex_state.current_premultiplied);
     
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, tex_state.current_texture);
@@ -194,39 +216,319 @@ static void add_texture_vertex(float x, float y, float u, float v, float r, floa
     tex_state.vertex_count++;
 }
 
-static void ensure_texture(GLuint texture_id) {
-    if (tex_state.current_texture != texture_id) {
+// Flush first if `count` more vertices would not fit, so a multi-quad draw
+// that fits in one batch does not straddle a flush
+static void reserve_texture_vertices(int count) {
+    if (tex_state.vertex_count + count > TEXTURE_MAX_VERTICES) {
         texture_renderer_flush();
-        tex_state.current_texture = texture_id;
     }
 }
 
+static void add_texture_quad(float x0, float y0, float x1, float y1,
+                             float u0, float v0, float u1, float v1,
+                             float r, float g, float b, float a) {
+    reserve_texture_vertices(6);
+    add_texture_vertex(x0, y0, u0, v0, r, g, b, a);
+    add_texture_vertex(x1, y0, u1, v0, r, g, b, a);
+    add_texture_vertex(x1, y1, u1, v1, r, g, b, a);
+    
+    add_texture_vertex(x0, y0, u0, v0, r, g, b, a);
+    add_texture_vertex(x1, y1, u1, v1, r, g, b, a);
+    add_texture_vertex(x0, y1, u0, v1, r, g, b, a);
+}
+
+static int ensure_texture(Texture* texture) {
+    if (!texture_ensure_resident(texture)) return 0;
+    if (tex_state.current_texture != texture->id) {
+        texture_renderer_flush();
+        tex_state.current_texture = texture->id;
+        tex_state.current_premultiplied = texture->premultiplied;
+    }
+    return 1;
+}
+
 // --- Texture Loading ---
 
-Texture* texture_load(const char* filepath) {
-    stbi_set_flip_vertically_on_load(0); // Don't flip - we handle Y in projection
-    
-    int width, height, channels;
-    unsigned char* data = stbi_load(filepath, &width, &height, &channels, 4); // Force RGBA
-    
-    if (!data) {
-        fprintf(stderr, "[Texture] Failed to load: %s - %s\n", filepath, stbi_failure_reason());
-        return NULL;
+void texture_load_options_init(TextureLoadOptions* options) {
+    memset(options, 0, sizeof(*options));
+    options->premultiply_alpha = renderer_get_premultiplied_alpha();
+}
+
+uint64_t texture_load_options_hash(const TextureLoadOptions* options) {
+    TextureLoadOptions defaults;
+    if (!options) {
+        texture_load_options_init(&defaults);
+        options = &defaults;
     }
-    
-    Texture* texture = texture_create(width, height, data);
-    stbi_image_free(data);
-    
-    if (texture) {
-        texture->channels = channels;
-        printf("[Texture] Loaded: %s (%dx%d, %d channels)\n", filepath, width, height, channels);
+
+    // Hash field by field so struct padding never leaks into the key
+    unsigned char key[7];
+    key[0] = options->use_colorkey ? 1 : 0;
+    key[1] = options->use_colorkey ? options->colorkey_r : 0;
+    key[2] = options->use_colorkey ? options->colorkey_g : 0;
+    key[3] = options->use_colorkey ? options->colorkey_b : 0;
+    key[4] = options->premultiply_alpha ? 1 : 0;
+    key[5] = options->mipmaps ? 1 : 0;
+    key[6] = (unsigned char)(options->format + 1);
+    return fnv1a64(key, sizeof(key), FNV64_SEED);
+}
+
+uint64_t texture_load_options_key(const TextureLoadOptions* options) {
+    TextureLoadOptions defaults;
+    if (!options) {
+        texture_load_options_init(&defaults);
+        options = &defaults;
     }
-    
+
+    uint32_t sampler[3];
+    float bias = options->lod_bias == 0.0f ? 0.0f : options->lod_bias;  // fold -0
+    sampler[0] = (uint32_t)options->filter;
+    sampler[1] = (uint32_t)options->wrap;
+    memcpy(&sampler[2], &bias, sizeof(float));
+    return fnv1a64(sampler, sizeof(sampler), texture_load_options_hash(options));
+}
+
+// --- Sampler state / mip levels ---
+
+static GLint wrap_to_gl(TextureWrap wrap) {
+    switch (wrap) {
+        case TEXTURE_WRAP_REPEAT: return GL_REPEAT;
+        case TEXTURE_WRAP_MIRROR: return GL_MIRRORED_REPEAT;
+        default:                  return GL_CLAMP_TO_EDGE;
+    }
+}
+
+// --- Storage formats ---
+
+typedef struct {
+    GLint internal_format;
+    GLenum format;
+    GLenum type;
+    int bytes_per_pixel;
+} FormatInfo;
+
+static FormatInfo format_info(TextureFormat format) {
+    switch (format) {
+        case TEXTURE_FORMAT_R8:     return (FormatInfo){GL_R8, GL_RED, GL_UNSIGNED_BYTE, 1};
+        case TEXTURE_FORMAT_RG8:    return (FormatInfo){GL_RG8, GL_RG, GL_UNSIGNED_BYTE, 2};
+        case TEXTURE_FORMAT_RGB565: return (FormatInfo){GL_RGB565, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, 2};
+        case TEXTURE_FORMAT_RGBA4:  return (FormatInfo){GL_RGBA4, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, 2};
+        default:                    return (FormatInfo){GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4};
+    }
+}
+
+int texture_format_bytes_per_pixel(TextureFormat format) {
+    return format_info(format).bytes_per_pixel;
+}
+
+// Pick a storage format for "auto": smallest one that keeps what the source has
+static TextureFormat resolve_format(const TextureLoadOptions* options, int channels) {
+    if (options->format != TEXTURE_FORMAT_AUTO) return options->format;
+
+    switch (channels) {
+        case 1:  return options->use_colorkey ? TEXTURE_FORMAT_RG8 : TEXTURE_FORMAT_R8;
+        case 2:  return TEXTURE_FORMAT_RG8;
+        case 3:  return options->use_colorkey ? TEXTURE_FORMAT_RGBA8 : TEXTURE_FORMAT_RGB565;
+        default: return TEXTURE_FORMAT_RGBA8;
+    }
+}
+
+// Whether a decoded image carries transparency (after the colorkey)
+static int source_has_alpha(int channels, const TextureLoadOptions* options) {
+    return channels == 2 || channels == 4 || options->use_colorkey;
+}
+
+// Pack `pixel_count` RGBA8 pixels into `format`. `has_alpha` selects the R8
+// source (alpha for images with transparency, otherwise the gray level).
+static void pack_pixels(const unsigned char* rgba, size_t pixel_count, TextureFormat format,
+                        int has_alpha, void* dst) {
+    switch (format) {
+        case TEXTURE_FORMAT_R8:     pixels_pack_r8(rgba, pixel_count, (unsigned char*)dst, has_alpha); break;
+        case TEXTURE_FORMAT_RG8:    pixels_pack_rg8(rgba, pixel_count, (unsigned char*)dst); break;
+        case TEXTURE_FORMAT_RGB565: pixels_pack_rgb565(rgba, pixel_count, (uint16_t*)dst); break;
+        case TEXTURE_FORMAT_RGBA4:  pixels_pack_rgba4(rgba, pixel_count, (uint16_t*)dst); break;
+        default:                    memcpy(dst, rgba, pixel_count * 4); break;
+    }
+}
+
+// Match the R8 swizzle to what was packed: an opaque gray level samples as
+// (R, R, R, 1); an alpha mask as white with alpha R, premultiplied when the
+// texture is.
+static void apply_r8_swizzle(Texture* texture, int has_alpha) {
+    if (texture->format != TEXTURE_FORMAT_R8) return;
+
+    texture->gray = !has_alpha;
+    GLint swizzle[4] = {GL_RED, GL_RED, GL_RED, GL_ONE};
+    if (has_alpha) {
+        GLint rgb = texture->premultiplied ? GL_RED : GL_ONE;
+        swizzle[0] = swizzle[1] = swizzle[2] = rgb;
+        swizzle[3] = GL_RED;
+    }
+    glBindTexture(GL_TEXTURE_2D, texture->id);
+    glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// Push the texture's filter/wrap/LOD settings to GL
+static void apply_sampler_state(Texture* texture) {
+    GLint mag = texture->filter == TEXTURE_FILTER_LINEAR ? GL_LINEAR : GL_NEAREST;
+    GLint min = mag;
+    if (texture->mip_count > 1) {
+        min = texture->filter == TEXTURE_FILTER_LINEAR ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture->id);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap_to_gl(texture->wrap_s));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap_to_gl(texture->wrap_t));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, texture->mip_count - 1);
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_LOD_BIAS, texture->lod_bias);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+int texture_mip_levels_for_size(int width, int height) {
+    int size = width > height ? width : height;
+    int levels = 1;
+    while (size > 1 && levels < TEXTURE_CACHE_MAX_MIPS) {
+        size >>= 1;
+        levels++;
+    }
+    return levels;
+}
+
+static size_t mip_chain_bytes(int width, int height, int first, int count, int bytes_per_pixel) {
+    size_t bytes = 0;
+    for (int level = first; level < count; level++) {
+        int w = width >> level;
+        int h = height >> level;
+        bytes += (size_t)(w > 0 ? w : 1) * (size_t)(h > 0 ? h : 1) * (size_t)bytes_per_pixel;
+    }
+    return bytes;
+}
+
+// Upload levels 1..count-1 of a CPU-built mip chain in the texture's format
+// (level 0 is already uploaded)
+static void upload_mip_levels(Texture* texture, const unsigned char* const* levels, int count) {
+    if (count <= 1) return;
+
+    FormatInfo info = format_info(texture->format);
+    glBindTexture(GL_TEXTURE_2D, texture->id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (int level = 1; level < count; level++) {
+        int w = texture->width >> level;
+        int h = texture->height >> level;
+        glTexImage2D(GL_TEXTURE_2D, level, info.internal_format, w > 0 ? w : 1, h > 0 ? h : 1, 0,
+                     info.format, info.type, levels[level]);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    size_t mip_bytes = mip_chain_bytes(texture->width, texture->height, 1, count, info.bytes_per_pixel);
+    texture->gpu_bytes += mip_bytes;
+    texture_memory_track_texture((long long)mip_bytes, 0);
+    texture->mip_count = count;
+    apply_sampler_state(texture);
+}
+
+// Build a full mip chain below `base` with the gamma-correct box filter.
+// levels[0] = base; returns the level count and a single allocation holding
+// levels 1.. in *storage (NULL if there are none).
+static int build_mip_chain(const unsigned char* base, int width, int height, int premultiplied,
+                           const unsigned char** levels, unsigned char** storage) {
+    int count = texture_mip_levels_for_size(width, height);
+    levels[0] = base;
+    *storage = NULL;
+    if (count <= 1) return 1;
+
+    unsigned char* chain = (unsigned char*)malloc(mip_chain_bytes(width, height, 1, count, 4));
+    if (!chain) return 1;
+
+    unsigned char* dst = chain;
+    for (int level = 1; level < count; level++) {
+        int pw = width >> (level - 1);
+        int ph = height >> (level - 1);
+        pixels_downsample_box(levels[level - 1], pw > 0 ? pw : 1, ph > 0 ? ph : 1, dst, premultiplied);
+        levels[level] = dst;
+        int w = width >> level;
+        int h = height >> level;
+        dst += (size_t)(w > 0 ? w : 1) * (size_t)(h > 0 ? h : 1) * 4;
+    }
+
+    *storage = chain;
+    return count;
+}
+
+// Convert every RGBA8 level in `levels` to `format` in place (pointers are
+// redirected into one new allocation returned in *storage)
+static int pack_mip_chain(const unsigned char** levels, int count, int width, int height,
+                          TextureFormat format, int has_alpha, unsigned char** storage) {
+    *storage = NULL;
+    if (format == TEXTURE_FORMAT_RGBA8) return 1;
+
+    int bpp = texture_format_bytes_per_pixel(format);
+    unsigned char* packed = (unsigned char*)malloc(mip_chain_bytes(width, height, 0, count, bpp));
+    if (!packed) return 0;
+
+    unsigned char* dst = packed;
+    for (int level = 0; level < count; level++) {
+        int w = width >> level;
+        int h = height >> level;
+        size_t pixels = (size_t)(w > 0 ? w : 1) * (size_t)(h > 0 ? h : 1);
+        pack_pixels(levels[level], pixels, format, has_alpha, dst);
+        levels[level] = dst;
+        dst += pixels * (size_t)bpp;
+    }
+
+    *storage = packed;
+    return 1;
+}
+
+// Upload a pre-decoded image straight from the cache mapping
+static Texture* texture_from_cache_image(const TextureCacheImage* image, const TextureLoadOptions* options) {
+    Texture* texture = texture_create_format(image->width, image->height, (TextureFormat)image->format,
+                                             image->levels[0]);
+    if (!texture) return NULL;
+
+    upload_mip_levels(texture, image->levels, image->mip_count);
+
+    texture->channels = image->channels;
+    texture->premultiplied = options->premultiply_alpha ? 1 : 0;
+    apply_r8_swizzle(texture, source_has_alpha(image->channels, options));
     return texture;
 }
 
+Texture* texture_load(const char* filepath) {
+    return texture_load_ex(filepath, NULL);
+}
+
 Texture* texture_load_with_colorkey(const char* filepath, unsigned char r, unsigned char g, unsigned char b) {
-    stbi_set_flip_vertically_on_load(0);
+    TextureLoadOptions options;
+    texture_load_options_init(&options);
+    options.use_colorkey = 1;
+    options.colorkey_r = r;
+    options.colorkey_g = g;
+    options.colorkey_b = b;
+    return texture_load_ex(filepath, &options);
+}
+
+// Decode (or map from the disk cache) and upload; sampling is set by the caller
+static Texture* load_pixels(const char* filepath, const TextureLoadOptions* options) {
+    double start = glfwGetTime();
+
+    // Warm path: mapped pre-decoded pixels, no stb_image work at all
+    TextureCacheImage cached;
+    if (texture_cache_load(filepath, options, &cached)) {
+        Texture* texture = texture_from_cache_image(&cached, options);
+        texture_cache_release(&cached);
+        if (texture) {
+            texture_cache_record_load(1, glfwGetTime() - start);
+            printf("[Texture] Loaded from cache: %s (%dx%d)\n", filepath, texture->width, texture->height);
+            return texture;
+        }
+    }
+
+    stbi_set_flip_vertically_on_load(0); // Don't flip - we handle Y in projection
     
     int width, height, channels;
     unsigned char* data = stbi_load(filepath, &width, &height, &channels, 4); // Force RGBA
@@ -236,56 +538,303 @@ Texture* texture_load_with_colorkey(const char* filepath, unsigned char r, unsig
         return NULL;
     }
     
-    // Apply chroma key (make matching pixels fully transparent)
-    for (int i = 0; i < width * height * 4; i += 4) {
-        if (data[i] == r && data[i+1] == g && data[i+2] == b) {
-            data[i+3] = 0;
-        }
+    size_t pixel_count = (size_t)width * (size_t)height;
+    if (options->use_colorkey) {
+        // Apply chroma key (make matching pixels fully transparent)
+        pixels_colorkey(data, pixel_count, options->colorkey_r, options->colorkey_g, options->colorkey_b);
+    }
+    if (options->premultiply_alpha) {
+        pixels_premultiply(data, pixel_count);
     }
     
-    Texture* texture = texture_create(width, height, data);
-    stbi_image_free(data);
+    const unsigned char* levels[TEXTURE_CACHE_MAX_MIPS];
+    unsigned char* mip_storage = NULL;
+    unsigned char* packed_storage = NULL;
+    int level_count = 1;
+    levels[0] = data;
+    if (options->mipmaps) {
+        level_count = build_mip_chain(data, width, height, options->premultiply_alpha, levels, &mip_storage);
+    }
+    
+    // Reduced-precision formats are packed on the CPU before upload
+    TextureFormat format = resolve_format(options, channels);
+    int has_alpha = source_has_alpha(channels, options);
+    if (!pack_mip_chain(levels, level_count, width, height, format, has_alpha, &packed_storage)) {
+        format = TEXTURE_FORMAT_RGBA8;
+        levels[0] = data;
+        level_count = 1;
+    }
+    
+    Texture* texture = texture_create_format(width, height, format, levels[0]);
     
     if (texture) {
         texture->channels = channels;
-        printf("[Texture] Loaded with colorkey: %s (%dx%d)\n", filepath, width, height);
+        texture->premultiplied = options->premultiply_alpha ? 1 : 0;
+        apply_r8_swizzle(texture, has_alpha);
+        upload_mip_levels(texture, levels, level_count);
+        texture_cache_store(filepath, options, width, height, channels, format, levels, level_count);
+        texture_cache_record_load(0, glfwGetTime() - start);
+        if (options->use_colorkey) {
+            printf("[Texture] Loaded with colorkey: %s (%dx%d)\n", filepath, width, height);
+        } else {
+            printf("[Texture] Loaded: %s (%dx%d, %d channels)\n", filepath, width, height, channels);
+        }
     }
     
+    free(packed_storage);
+    free(mip_storage);
+    stbi_image_free(data);
+    return texture;
+}
+
+Texture* texture_load_ex(const char* filepath, const TextureLoadOptions* options) {
+    TextureLoadOptions defaults;
+    if (!options) {
+        texture_load_options_init(&defaults);
+        options = &defaults;
+    }
+
+    Texture* texture = load_pixels(filepath, options);
+    if (texture) {
+        texture->filter = options->filter;
+        texture->wrap_s = options->wrap;
+        texture->wrap_t = options->wrap;
+        texture->lod_bias = options->lod_bias;
+        apply_sampler_state(texture);
+    }
     return texture;
 }
 
-Texture* texture_create(int width, int height, unsigned char* data) {
+Texture* texture_create(int width, int height, const unsigned char* data) {
+    return texture_create_format(width, height, TEXTURE_FORMAT_RGBA8, data);
+}
+
+Texture* texture_create_format(int width, int height, TextureFormat format, const void* data) {
+    if (format == TEXTURE_FORMAT_AUTO) format = TEXTURE_FORMAT_RGBA8;
+    FormatInfo info = format_info(format);
+
     Texture* texture = (Texture*)malloc(sizeof(Texture));
     if (!texture) return NULL;
     
     texture->width = width;
     texture->height = height;
     texture->channels = 4;
+    texture->refcount = 1;
+    texture->registered = 0;
+    texture->premultiplied = 0;
+    texture->gpu_bytes = (size_t)width * (size_t)height * (size_t)info.bytes_per_pixel;
+    texture->last_used_frame = texture_memory_current_frame();
+    texture->evicted = 0;
+    texture->mip_count = 1;
+    texture->filter = TEXTURE_FILTER_NEAREST;
+    texture->wrap_s = TEXTURE_WRAP_CLAMP;
+    texture->wrap_t = TEXTURE_WRAP_CLAMP;
+    texture->lod_bias = 0.0f;
+    texture->format = format;
+    texture->gray = 0;
+    texture_memory_track_texture((long long)texture->gpu_bytes, 1);
     
     glGenTextures(1, &texture->id);
     glBindTexture(GL_TEXTURE_2D, texture->id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);  // 1- and 2-byte rows need not be 4-aligned
+    glTexImage2D(GL_TEXTURE_2D, 0, info.internal_format, width, height, 0, info.format, info.type, data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     
-    // Set texture parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-    
+    // Single-channel formats sample as white-with-alpha / gray-with-alpha
+    // (loaded gray images switch R8 to opaque gray, see apply_r8_swizzle)
+    if (format == TEXTURE_FORMAT_R8) {
+        GLint swizzle[4] = {GL_ONE, GL_ONE, GL_ONE, GL_RED};
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    } else if (format == TEXTURE_FORMAT_RG8) {
+        GLint swizzle[4] = {GL_RED, GL_RED, GL_RED, GL_GREEN};
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    }
     glBindTexture(GL_TEXTURE_2D, 0);
     
+    apply_sampler_state(texture);
+    
     return texture;
 }
 
+int texture_update(Texture* texture, int x, int y, int width, int height, const unsigned char* data) {
+    if (!texture || !data || width <= 0 || height <= 0) return 0;
+    if (x < 0 || y < 0 || x + width > texture->width || y + height > texture->height) return 0;
+    if (!texture_ensure_resident(texture)) return 0;
+
+    // Quads already batched with this texture must draw with the old pixels
+    if (tex_state.current_texture == texture->id) {
+        texture_renderer_flush();
+    }
+
+    size_t pixel_count = (size_t)width * (size_t)height;
+    const void* upload = data;
+
+    // Incoming pixels are straight alpha; match a premultiplied texture
+    unsigned char* premultiplied = NULL;
+    if (texture->premultiplied) {
+        premultiplied = (unsigned char*)malloc(pixel_count * 4);
+        if (!premultiplied) return 0;
+        memcpy(premultiplied, data, pixel_count * 4);
+        pixels_premultiply(premultiplied, pixel_count);
+        data = premultiplied;
+        upload = premultiplied;
+    }
+
+    // ...and its storage format
+    unsigned char* packed = NULL;
+    FormatInfo info = format_info(texture->format);
+    if (texture->format != TEXTURE_FORMAT_RGBA8) {
+        packed = (unsigned char*)malloc(pixel_count * (size_t)info.bytes_per_pixel);
+        if (!packed) {
+            free(premultiplied);
+            return 0;
+        }
+        pack_pixels(data, pixel_count, texture->format, !texture->gray, packed);
+        upload = packed;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture->id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, info.format, info.type, upload);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    if (texture->mip_count > 1) {
+        glGenerateMipmap(GL_TEXTURE_2D);  // keep smaller levels in sync
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    free(packed);
+    free(premultiplied);
+    return 1;
+}
+
 void texture_destroy(Texture* texture) {
     if (texture) {
-        glDeleteTextures(1, &texture->id);
+        if (texture->registered) {
+            texture_registry_remove(texture);
+        }
+        if (texture->evicted) {
+            texture_memory_forget_evicted();
+        } else {
+            glDeleteTextures(1, &texture->id);
+            texture_memory_track_texture(-(long long)texture->gpu_bytes, -1);
+        }
+        if (tex_state.current_texture == texture->id) {
+            tex_state.current_texture = 0;
+        }
         free(texture);
     }
 }
 
+void texture_evict(Texture* texture) {
+    if (!texture || texture->evicted) return;
+
+    // Never leave a batch pointing at deleted storage
+    if (tex_state.current_texture == texture->id) {
+        texture_renderer_flush();
+        tex_state.current_texture = 0;
+    }
+
+    glDeleteTextures(1, &texture->id);
+    texture->id = 0;
+    texture->evicted = 1;
+    texture_memory_track_texture(-(long long)texture->gpu_bytes, -1);
+    texture_memory_record_eviction();
+}
+
+int texture_reload(Texture* texture, const char* filepath, const TextureLoadOptions* options) {
+    if (!texture || !texture->evicted) return texture != NULL;
+
+    Texture* fresh = texture_load_ex(filepath, options);
+    if (!fresh) return 0;
+    int had_mips = texture->mip_count;
+
+    // Take over the new GL storage (already counted by texture_create)
+    texture->id = fresh->id;
+    texture->width = fresh->width;
+    texture->height = fresh->height;
+    texture->channels = fresh->channels;
+    texture->premultiplied = fresh->premultiplied;
+    texture->gpu_bytes = fresh->gpu_bytes;
+    texture->mip_count = fresh->mip_count;
+    texture->format = fresh->format;
+    texture->gray = fresh->gray;
+    texture->evicted = 0;
+    free(fresh);
+
+    // Keep the handle's sampler settings, not the fresh defaults
+    if (had_mips > texture->mip_count) {
+        texture_generate_mipmaps(texture);
+    } else {
+        apply_sampler_state(texture);
+    }
+
+    texture_memory_record_reload();
+    return 1;
+}
+
+int texture_ensure_resident(Texture* texture) {
+    if (!texture) return 0;
+    if (texture->evicted && !texture_registry_reload(texture)) {
+        return 0;
+    }
+    texture->last_used_frame = texture_memory_current_frame();
+    return 1;
+}
+
+void texture_set_filter(Texture* texture, TextureFilter filter) {
+    if (!texture) return;
+    texture->filter = filter;
+    if (!texture->evicted) apply_sampler_state(texture);
+}
+
+void texture_set_wrap(Texture* texture, TextureWrap wrap_s, TextureWrap wrap_t) {
+    if (!texture) return;
+    texture->wrap_s = wrap_s;
+    texture->wrap_t = wrap_t;
+    if (!texture->evicted) apply_sampler_state(texture);
+}
+
+void texture_set_lod_bias(Texture* texture, float bias) {
+    if (!texture) return;
+    texture->lod_bias = bias;
+    if (!texture->evicted) apply_sampler_state(texture);
+}
+
+int texture_generate_mipmaps(Texture* texture) {
+    if (!texture_ensure_resident(texture)) return 0;
+
+    int count = texture_mip_levels_for_size(texture->width, texture->height);
+    if (count > texture->mip_count) {
+        size_t added = mip_chain_bytes(texture->width, texture->height, texture->mip_count, count,
+                                       texture_format_bytes_per_pixel(texture->format));
+        texture->gpu_bytes += added;
+        texture_memory_track_texture((long long)added, 0);
+    }
+    texture->mip_count = count;
+
+    glBindTexture(GL_TEXTURE_2D, texture->id);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, count - 1);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    apply_sampler_state(texture);
+    return count;
+}
+
+void texture_retain(Texture* texture) {
+    if (texture) texture->refcount++;
+}
+
+void texture_release(Texture* texture) {
+    if (!texture || texture->refcount <= 0) return;
+    texture->refcount--;
+    if (texture->refcount == 0 && !texture->registered) {
+        texture_destroy(texture);
+    }
+}
+
 void texture_bind(Texture* texture, unsigned int slot) {
+    if (texture) texture_ensure_resident(texture);
     glActiveTexture(GL_TEXTURE0 + slot);
     glBindTexture(GL_TEXTURE_2D, texture ? texture->id : 0);
 }
@@ -305,7 +854,7 @@ void render_texture_tinted(Texture* texture, int x, int y, int width, int height
     if (!texture || !tex_state.initialized) return;
     
     renderer_switch_batch(BATCH_TEXTURES);
-    ensure_texture(texture->id);
+    if (!ensure_texture(texture)) return;
     
     float fx = (float)x;
     float fy = (float)y;
@@ -337,7 +886,7 @@ void render_texture_ex(Texture* texture, int x, int y, int width, int height,
     if (!texture || !tex_state.initialized) return;
     
     renderer_switch_batch(BATCH_TEXTURES);
-    ensure_texture(texture->id);
+    if (!ensure_texture(texture)) return;
     
     float fw = (float)width;
     float fh = (float)height;
@@ -393,13 +942,7 @@ void render_texture_region_ex(Texture* texture,
                               int src_x, int src_y, int src_width, int src_height,
                               float angle, float origin_x, float origin_y,
                               float r, float g, float b, float a) {
-    if (!texture || !tex_state.initialized) return;
-    
-    renderer_switch_batch(BATCH_TEXTURES);
-    ensure_texture(texture->id);
-    
-    float fw = (float)width;
-    float fh = (float)height;
+    if (!texture) return;
     
     // Calculate UV coordinates from source rect
     float u0 = (float)src_x / texture->width;
@@ -407,10 +950,27 @@ void render_texture_region_ex(Texture* texture,
     float u1 = (float)(src_x + src_width) / texture->width;
     float v1 = (float)(src_y + src_height) / texture->height;
     
+    render_texture_uv_ex(texture, (float)x, (float)y, (float)width, (float)height,
+                         u0, v0, u1, v1, angle, origin_x, origin_y, r, g, b, a);
+}
+
+void render_texture_uv_ex(Texture* texture,
+                          float x, float y, float width, float height,
+                          float u0, float v0, float u1, float v1,
+                          float angle, float origin_x, float origin_y,
+                          float r, float g, float b, float a) {
+    if (!texture || !tex_state.initialized) return;
+    
+    renderer_switch_batch(BATCH_TEXTURES);
+    if (!ensure_texture(texture)) return;
+    
+    float fw = width;
+    float fh = height;
+    
     if (angle == 0.0f) {
         // No rotation - simple quad
-        float fx = (float)x;
-        float fy = (float)y;
+        float fx = x;
+        float fy = y;
         
         add_texture_vertex(fx, fy, u0, v0, r, g, b, a);
         add_texture_vertex(fx + fw, fy, u1, v0, r, g, b, a);
@@ -450,6 +1010,108 @@ void render_texture_region_ex(Texture* texture,
     }
 }
 
+// Fill [x0,x1]x[y0,y1] with repeats of the source cell (src_w x src_h screen
+// pixels), cropping the last row/column
+static void add_tiled_quads(float x0, float y0, float x1, float y1, float src_w, float src_h,
+                            float u0, float v0, float u1, float v1,
+                            float r, float g, float b, float a) {
+    if (src_w <= 0.0f || src_h <= 0.0f) return;
+    for (float ty = y0; ty < y1; ty += src_h) {
+        float th = (y1 - ty < src_h) ? y1 - ty : src_h;
+        float tv1 = v0 + (v1 - v0) * (th / src_h);
+        for (float tx = x0; tx < x1; tx += src_w) {
+            float tw = (x1 - tx < src_w) ? x1 - tx : src_w;
+            float tu1 = u0 + (u1 - u0) * (tw / src_w);
+            add_texture_quad(tx, ty, tx + tw, ty + th, u0, v0, tu1, tv1, r, g, b, a);
+        }
+    }
+}
+
+// Quads add_tiled_quads emits along one axis of a cell
+static double tiled_quad_count(float length, float cell, int tiled) {
+    if (!tiled) return 1.0;
+    return cell > 0.0f ? ceil((double)length / cell) : 0.0;
+}
+
+void render_texture_nine_slice(Texture* texture, int x, int y, int width, int height,
+                               int left, int right, int top, int bottom,
+                               float r, float g, float b, float a, int tile_center) {
+    if (!texture) return;
+    render_texture_nine_slice_region(texture, x, y, width, height,
+                                     0, 0, texture->width, texture->height,
+                                     left, right, top, bottom, r, g, b, a, tile_center);
+}
+
+void render_texture_nine_slice_region(Texture* texture, int x, int y, int width, int height,
+                                      int src_x, int src_y, int src_width, int src_height,
+                                      int left, int right, int top, int bottom,
+                                      float r, float g, float b, float a, int tile_center) {
+    if (!texture || !tex_state.initialized || width <= 0 || height <= 0) return;
+    if (left < 0 || right < 0 || top < 0 || bottom < 0 ||
+        left + right > src_width || top + bottom > src_height) return;
+    
+    renderer_switch_batch(BATCH_TEXTURES);
+    if (!ensure_texture(texture)) return;
+    
+    // Source column/row edges in UV space
+    float iw = 1.0f / (float)texture->width;
+    float ih = 1.0f / (float)texture->height;
+    float us[4] = {
+        src_x * iw, (src_x + left) * iw, (src_x + src_width - right) * iw, (src_x + src_width) * iw
+    };
+    float vs[4] = {
+        src_y * ih, (src_y + top) * ih, (src_y + src_height - bottom) * ih, (src_y + src_height) * ih
+    };
+    
+    // Destination edges; borders shrink proportionally when the quad is
+    // smaller than the two borders combined
+    float bl = (float)left, br = (float)right, bt = (float)top, bb = (float)bottom;
+    if (bl + br > width) {
+        float k = (float)width / (bl + br);
+        bl *= k;
+        br *= k;
+    }
+    if (bt + bb > height) {
+        float k = (float)height / (bt + bb);
+        bt *= k;
+        bb *= k;
+    }
+    float xs[4] = {(float)x, x + bl, (float)(x + width) - br, (float)(x + width)};
+    float ys[4] = {(float)y, y + bt, (float)(y + height) - bb, (float)(y + height)};
+    float cell_w[3] = {(float)left, (float)(src_width - left - right), (float)right};
+    float cell_h[3] = {(float)top, (float)(src_height - top - bottom), (float)bottom};
+    
+    // Keep the panel in one batch when it fits one; a tiled center may need
+    // more quads than a batch holds, and then simply spans a flush
+    double quads = 0.0;
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+            if (ys[row + 1] <= ys[row] || xs[col + 1] <= xs[col]) continue;
+            quads += tiled_quad_count(xs[col + 1] - xs[col], cell_w[col], tile_center && col == 1) *
+                     tiled_quad_count(ys[row + 1] - ys[row], cell_h[row], tile_center && row == 1);
+        }
+    }
+    if (quads * 6 <= TEXTURE_MAX_VERTICES) reserve_texture_vertices((int)quads * 6);
+    for (int row = 0; row < 3; row++) {
+        if (ys[row + 1] <= ys[row]) continue;
+        for (int col = 0; col < 3; col++) {
+            if (xs[col + 1] <= xs[col]) continue;
+            // Edges tile along their stretched axis, the center along both
+            int tile_x = tile_center && col == 1;
+            int tile_y = tile_center && row == 1;
+            if (tile_x || tile_y) {
+                add_tiled_quads(xs[col], ys[row], xs[col + 1], ys[row + 1],
+                                tile_x ? cell_w[col] : xs[col + 1] - xs[col],
+                                tile_y ? cell_h[row] : ys[row + 1] - ys[row],
+                                us[col], vs[row], us[col + 1], vs[row + 1], r, g, b, a);
+            } else {
+                add_texture_quad(xs[col], ys[row], xs[col + 1], ys[row + 1],
+                                 us[col], vs[row], us[col + 1], vs[row + 1], r, g, b, a);
+            }
+        }
+    }
+}
+
 // Called by renderer_begin to update screen dimensions
 void texture_renderer_set_screen_size(int width, int height) {
     tex_state.screen_width = width;
@@ -2,26 +2,142 @@
 #define TEXTURE_H
 
 #include <glad/glad.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Sampling filter. With mipmaps, NEAREST picks the nearest level and LINEAR
+// blends texels and levels (trilinear).
+typedef enum {
+    TEXTURE_FILTER_NEAREST = 0,
+    TEXTURE_FILTER_LINEAR
+} TextureFilter;
+
+typedef enum {
+    TEXTURE_WRAP_CLAMP = 0,
+    TEXTURE_WRAP_REPEAT,
+    TEXTURE_WRAP_MIRROR
+} TextureWrap;
+
+// GPU storage format. Values are stored in the disk cache header.
+// R8 samples as white with alpha = R (or as opaque gray (R, R, R, 1) when
+// loaded from an image without alpha); RG8 samples as (R, R, R, G).
+typedef enum {
+    TEXTURE_FORMAT_AUTO = -1,   // load option only: pick from the source channels
+    TEXTURE_FORMAT_RGBA8 = 0,
+    TEXTURE_FORMAT_R8,
+    TEXTURE_FORMAT_RG8,
+    TEXTURE_FORMAT_RGB565,
+    TEXTURE_FORMAT_RGBA4
+} TextureFormat;
 
 typedef struct {
     GLuint id;
     int width;
     int height;
     int channels;
+    int refcount;       // owners sharing this texture (see texture_retain/release)
+    int registered;     // 1 while owned by the path registry
+    int premultiplied;  // 1 if RGB is already multiplied by alpha
+    size_t gpu_bytes;   // storage size including mip levels (see texture_memory.h)
+    unsigned int last_used_frame;
+    int evicted;        // 1 while GL storage is freed by the memory budget
+    int mip_count;      // levels uploaded (1 = no mipmaps)
+    TextureFormat format;
+    int gray;           // R8 holds an opaque gray level rather than alpha
+    TextureFilter filter;
+    TextureWrap wrap_s;
+    TextureWrap wrap_t;
+    float lod_bias;     // > 0 samples smaller mip levels
 } Texture;
 
+// Options applied while loading an image file
+typedef struct {
+    int use_colorkey;               // make pixels matching the key transparent
+    unsigned char colorkey_r;
+    unsigned char colorkey_g;
+    unsigned char colorkey_b;
+    int premultiply_alpha;          // store RGB premultiplied by alpha
+    int mipmaps;                    // build a gamma-correct mip chain on the CPU
+    TextureFormat format;           // storage format (default RGBA8)
+
+    // Sampling of the new texture. Not part of the disk cache key (pixels do
+    // not depend on it), but part of the registry key, so loads asking for
+    // different sampling never change each other's texture.
+    TextureFilter filter;           // default NEAREST
+    TextureWrap wrap;               // both axes, default CLAMP
+    float lod_bias;
+} TextureLoadOptions;
+
+// Fill options with defaults (no colorkey; premultiplied when the renderer
+// is in premultiplied-alpha mode)
+void texture_load_options_init(TextureLoadOptions* options);
+
+// Stable hash of the load options that affect pixels (NULL = defaults), used
+// for disk cache keys
+uint64_t texture_load_options_hash(const TextureLoadOptions* options);
+
+// texture_load_options_hash plus the sampling options, used for registry keys
+uint64_t texture_load_options_key(const TextureLoadOptions* options);
+
 // Load texture from file (PNG, JPG, BMP, etc.)
 Texture* texture_load(const char* filepath);
 
+// Load texture from file with options (NULL = defaults).
+// Served from the pre-decoded disk cache when one is configured.
+Texture* texture_load_ex(const char* filepath, const TextureLoadOptions* options);
+
 // Load texture with a specific color key (chroma key) set to transparent
 Texture* texture_load_with_colorkey(const char* filepath, unsigned char r, unsigned char g, unsigned char b);
 
-// Create texture from raw RGBA data
-Texture* texture_create(int width, int height, unsigned char* data);
+// Create texture from raw RGBA data (NULL = uninitialized). The data is
+// uploaded directly and not retained.
+Texture* texture_create(int width, int height, const unsigned char* data);
+
+// Create a texture in a specific storage format from data already packed in
+// that format (NULL = uninitialized)
+Texture* texture_create_format(int width, int height, TextureFormat format, const void* data);
+
+// Bytes per pixel of a storage format
+int texture_format_bytes_per_pixel(TextureFormat format);
+
+// Replace a region of an existing texture with tightly packed RGBA data
+// (width * height * 4 bytes), converted to the texture's storage format.
+// Returns 0 if the region is out of bounds.
+int texture_update(Texture* texture, int x, int y, int width, int height, const unsigned char* data);
 
 // Destroy texture and free resources
 void texture_destroy(Texture* texture);
 
+// Free the GL storage of a file-loaded texture to save memory. The handle stays
+// valid and is reloaded by texture_ensure_resident() on next use.
+void texture_evict(Texture* texture);
+
+// Reload an evicted texture's pixels from `filepath` + `options`. Returns 1 on success.
+int texture_reload(Texture* texture, const char* filepath, const TextureLoadOptions* options);
+
+// Reload the texture if it was evicted and mark it used this frame.
+// Returns 0 if the texture has no GL storage.
+int texture_ensure_resident(Texture* texture);
+
+// Sampler settings (kept across eviction/reload)
+void texture_set_filter(Texture* texture, TextureFilter filter);
+void texture_set_wrap(Texture* texture, TextureWrap wrap_s, TextureWrap wrap_t);
+void texture_set_lod_bias(Texture* texture, float bias);
+
+// Build mip levels on the GPU from level 0 (for created/streamed textures).
+// Returns the resulting level count.
+int texture_generate_mipmaps(Texture* texture);
+
+// Number of levels in a full mip chain for the given size
+int texture_mip_levels_for_size(int width, int height);
+
+// Add an owner to a texture
+void texture_retain(Texture* texture);
+
+// Drop an owner. Unregistered textures are destroyed when the last owner goes;
+// registry textures stay cached until texture_registry_purge().
+void texture_release(Texture* texture);
+
 // Bind texture for rendering
 void texture_bind(Texture* texture, unsigned int slot);
 
@@ -56,6 +172,27 @@ void render_texture_region_ex(Texture* texture,
                               float angle, float origin_x, float origin_y,
                               float r, float g, float b, float a);
 
+// Draw a texture as a nine-slice panel: the corners keep their size, the edges
+// stretch along one axis and the center along both (or repeat when
+// `tile_center` is set). Borders are in source pixels.
+void render_texture_nine_slice(Texture* texture, int x, int y, int width, int height,
+                               int left, int right, int top, int bottom,
+                               float r, float g, float b, float a, int tile_center);
+
+// Nine-slice from a sub-rectangle of the texture (UI skins in an atlas)
+void render_texture_nine_slice_region(Texture* texture, int x, int y, int width, int height,
+                                      int src_x, int src_y, int src_width, int src_height,
+                                      int left, int right, int top, int bottom,
+                                      float r, float g, float b, float a, int tile_center);
+
+// Draw a quad with explicit UVs (0..1; u0 > u1 or v0 > v1 flips). Used by
+// sprite sheets and other callers that precompute their texture coordinates.
+void render_texture_uv_ex(Texture* texture,
+                          float x, float y, float width, float height,
+                          float u0, float v0, float u1, float v1,
+                          float angle, float origin_x, float origin_y,
+                          float r, float g, float b, float a);
+
 // Initialize texture rendering system (called after renderer_init)
 void texture_renderer_init(void);
 
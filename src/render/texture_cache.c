@@ -0,0 +1,265 @@
+#include "texture_cache.h"
+#include "../util/lz4.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static char g_cache_dir[1024] = {0};
+static int g_cache_enabled = 0;
+static int g_cache_compress = 0;
+static TextureCacheStats g_stats = {0};
+
+// --- Helpers ---
+
+static int mip_dim(int size, int level) {
+    int d = size >> level;
+    return d > 0 ? d : 1;
+}
+
+static size_t level_bytes(int width, int height, int level, int bpp) {
+    return (size_t)mip_dim(width, level) * (size_t)mip_dim(height, level) * (size_t)bpp;
+}
+
+static size_t chain_bytes(int width, int height, int mip_count, int bpp) {
+    size_t total = 0;
+    for (int i = 0; i < mip_count; i++) {
+        total += level_bytes(width, height, i, bpp);
+    }
+    return total;
+}
+
+// Cache file path: <dir>/<hash of canonical source path + options>.pbtex
+static void build_cache_path(const char* filepath, const TextureLoadOptions* options,
+                             char* out, size_t out_size) {
+    char canonical[1024];
+    file_canonical_path(filepath, canonical, sizeof(canonical));
+
+    uint64_t key = fnv1a64(canonical, strlen(canonical), FNV64_SEED);
+    uint64_t opt = texture_load_options_hash(options);
+    key = fnv1a64(&opt, sizeof(opt), key);
+
+    snprintf(out, out_size, "%s/%016llx.pbtex", g_cache_dir, (unsigned long long)key);
+}
+
+// --- Configuration ---
+
+int texture_cache_set_dir(const char* dir) {
+    if (!dir || !*dir) {
+        g_cache_dir[0] = '\0';
+        g_cache_enabled = 0;
+        return 1;
+    }
+
+    if (strlen(dir) >= sizeof(g_cache_dir) - 32) {
+        fprintf(stderr, "[Texture] Cache directory path too long: %s\n", dir);
+        return 0;
+    }
+
+    if (!file_make_dirs(dir)) {
+        fprintf(stderr, "[Texture] Failed to create cache directory: %s\n", dir);
+        return 0;
+    }
+
+    snprintf(g_cache_dir, sizeof(g_cache_dir), "%s", dir);
+    // Strip a trailing separator so built paths stay clean
+    size_t len = strlen(g_cache_dir);
+    if (len > 1 && (g_cache_dir[len - 1] == '/' || g_cache_dir[len - 1] == '\\')) {
+        g_cache_dir[len - 1] = '\0';
+    }
+    g_cache_enabled = 1;
+    return 1;
+}
+
+const char* texture_cache_get_dir(void) {
+    return g_cache_enabled ? g_cache_dir : NULL;
+}
+
+void texture_cache_set_compression(int enabled) {
+    g_cache_compress = enabled ? 1 : 0;
+}
+
+int texture_cache_get_compression(void) {
+    return g_cache_compress;
+}
+
+// --- Lookup ---
+
+int texture_cache_load(const char* filepath, const TextureLoadOptions* options, TextureCacheImage* out) {
+    memset(out, 0, sizeof(*out));
+    if (!g_cache_enabled || !filepath) return 0;
+
+    int64_t src_mtime, src_size;
+    if (!file_get_info(filepath, &src_mtime, &src_size)) return 0;
+
+    char cache_path[1100];
+    build_cache_path(filepath, options, cache_path, sizeof(cache_path));
+
+    if (!filemap_open(cache_path, &out->map)) {
+        g_stats.misses++;
+        return 0;
+    }
+
+    TextureCacheHeader header;
+    if (out->map.size < sizeof(header)) goto stale;
+    memcpy(&header, out->map.data, sizeof(header));
+
+    if (memcmp(header.magic, TEXTURE_CACHE_MAGIC, 4) != 0 ||
+        header.version != TEXTURE_CACHE_VERSION ||
+        header.source_mtime != src_mtime ||
+        header.source_size != src_size ||
+        header.options_hash != texture_load_options_hash(options) ||
+        header.format > TEXTURE_FORMAT_RGBA4 ||
+        header.width == 0 || header.height == 0 ||
+        header.width > 16384 || header.height > 16384 ||
+        header.mip_count == 0 || header.mip_count > TEXTURE_CACHE_MAX_MIPS ||
+        header.payload_size > out->map.size - sizeof(header)) {
+        goto stale;
+    }
+
+    int w = (int)header.width;
+    int h = (int)header.height;
+    int mips = (int)header.mip_count;
+    int bpp = texture_format_bytes_per_pixel((TextureFormat)header.format);
+    size_t total = chain_bytes(w, h, mips, bpp);
+    const unsigned char* payload = out->map.data + sizeof(header);
+    const unsigned char* pixels = payload;
+
+    if (header.compression == TEXTURE_CACHE_COMPRESSION_LZ4) {
+        out->decoded = (unsigned char*)malloc(total);
+        if (!out->decoded ||
+            !lz4_decompress(payload, (size_t)header.payload_size, out->decoded, total)) {
+            goto stale;
+        }
+        pixels = out->decoded;
+    } else if (header.compression != TEXTURE_CACHE_COMPRESSION_NONE || header.payload_size != total) {
+        goto stale;
+    }
+
+    out->width = w;
+    out->height = h;
+    out->channels = (int)header.channels;
+    out->format = (int)header.format;
+    out->mip_count = mips;
+    size_t offset = 0;
+    for (int i = 0; i < mips; i++) {
+        out->levels[i] = pixels + offset;
+        offset += level_bytes(w, h, i, bpp);
+    }
+
+    g_stats.hits++;
+    return 1;
+
+stale:
+    texture_cache_release(out);
+    g_stats.misses++;
+    return 0;
+}
+
+void texture_cache_release(TextureCacheImage* image) {
+    if (!image) return;
+    filemap_close(&image->map);
+    free(image->decoded);
+    memset(image, 0, sizeof(*image));
+}
+
+// --- Store ---
+
+int texture_cache_store(const char* filepath, const TextureLoadOptions* options,
+                        int width, int height, int channels, int format,
+                        const unsigned char* const* levels, int mip_count) {
+    if (!g_cache_enabled || !filepath || !levels || width <= 0 || height <= 0) return 0;
+    if (mip_count < 1 || mip_count > TEXTURE_CACHE_MAX_MIPS) return 0;
+    if (format < TEXTURE_FORMAT_RGBA8 || format > TEXTURE_FORMAT_RGBA4) return 0;
+    int bpp = texture_format_bytes_per_pixel((TextureFormat)format);
+
+    int64_t src_mtime, src_size;
+    if (!file_get_info(filepath, &src_mtime, &src_size)) return 0;
+
+    TextureCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TEXTURE_CACHE_MAGIC, 4);
+    header.version = TEXTURE_CACHE_VERSION;
+    header.source_mtime = src_mtime;
+    header.source_size = src_size;
+    header.options_hash = texture_load_options_hash(options);
+    header.width = (uint32_t)width;
+    header.height = (uint32_t)height;
+    header.format = (uint32_t)format;
+    header.channels = (uint32_t)channels;
+    header.mip_count = (uint32_t)mip_count;
+    header.compression = TEXTURE_CACHE_COMPRESSION_NONE;
+
+    const void* chunks[1 + TEXTURE_CACHE_MAX_MIPS];
+    size_t sizes[1 + TEXTURE_CACHE_MAX_MIPS];
+    int count = 0;
+    unsigned char* packed = NULL;
+    unsigned char* compressed = NULL;
+    size_t total = chain_bytes(width, height, mip_count, bpp);
+
+    chunks[count] = &header;
+    sizes[count++] = sizeof(header);
+
+    if (g_cache_compress) {
+        // LZ4 works on one contiguous block: gather the chain first
+        packed = (unsigned char*)malloc(total);
+        compressed = (unsigned char*)malloc(lz4_compress_bound(total));
+        size_t csize = 0;
+        if (packed && compressed) {
+            size_t offset = 0;
+            for (int i = 0; i < mip_count; i++) {
+                size_t n = level_bytes(width, height, i, bpp);
+                memcpy(packed + offset, levels[i], n);
+                offset += n;
+            }
+            csize = lz4_compress(packed, total, compressed, lz4_compress_bound(total));
+        }
+        if (csize > 0 && csize < total) {
+            header.compression = TEXTURE_CACHE_COMPRESSION_LZ4;
+            header.payload_size = csize;
+            chunks[count] = compressed;
+            sizes[count++] = csize;
+        }
+    }
+
+    if (header.compression == TEXTURE_CACHE_COMPRESSION_NONE) {
+        header.payload_size = total;
+        for (int i = 0; i < mip_count; i++) {
+            chunks[count] = levels[i];
+            sizes[count++] = level_bytes(width, height, i, bpp);
+        }
+    }
+
+    char cache_path[1100];
+    build_cache_path(filepath, options, cache_path, sizeof(cache_path));
+    int ok = file_write_atomic(cache_path, chunks, sizes, count);
+
+    free(packed);
+    free(compressed);
+
+    if (ok) {
+        g_stats.writes++;
+    } else {
+        fprintf(stderr, "[Texture] Failed to write cache file: %s\n", cache_path);
+    }
+    return ok;
+}
+
+// --- Stats ---
+
+void texture_cache_record_load(int warm, double seconds) {
+    if (warm) {
+        g_stats.warm_loads++;
+        g_stats.warm_seconds += seconds;
+    } else {
+        g_stats.cold_loads++;
+        g_stats.cold_seconds += seconds;
+    }
+}
+
+void texture_cache_get_stats(TextureCacheStats* out) {
+    *out = g_stats;
+}
+
+void texture_cache_reset_stats(void) {
+    memset(&g_stats, 0, sizeof(g_stats));
+}
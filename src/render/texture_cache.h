@@ -0,0 +1,101 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "texture.h"
+#include "../platform/filemap.h"
+
+// Pre-decoded texture cache.
+//
+// The first time an image is loaded with a cache directory configured, its
+// decoded (and colorkeyed) pixels are written to `<dir>/<key>.pbtex`. The key
+// hashes the canonical source path and the load options; the header stores the
+// source mtime and size so edited images are re-decoded automatically.
+// Later loads map the file read-only and upload straight from the mapping.
+//
+// File layout (little-endian):
+//   TextureCacheHeader (64 bytes)
+//   payload: mip levels 0..mip_count-1 back to back, each level tightly packed
+//            in the header's format — or one LZ4 block expanding to that when
+//            compressed.
+
+#define TEXTURE_CACHE_MAGIC   "PBTX"
+#define TEXTURE_CACHE_VERSION 1
+
+
+#define TEXTURE_CACHE_COMPRESSION_NONE 0
+#define TEXTURE_CACHE_COMPRESSION_LZ4  1
+
+#define TEXTURE_CACHE_MAX_MIPS 16
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    int64_t source_mtime;
+    int64_t source_size;
+    uint64_t options_hash;
+    uint32_t width;
+    uint32_t height;
+    uint32_t format;         // TextureFormat of the stored levels
+    uint32_t channels;       // channel count of the source image
+    uint32_t mip_count;
+    uint32_t compression;
+    uint64_t payload_size;   // bytes stored after the header
+} TextureCacheHeader;
+
+// A cached image ready for upload. Level pointers reference either the file
+// mapping (uncompressed) or a decompression buffer owned by the image.
+typedef struct {
+    int width;
+    int height;
+    int channels;
+    int format;              // TextureFormat of the stored levels
+    int mip_count;
+    const unsigned char* levels[TEXTURE_CACHE_MAX_MIPS];
+    FileMap map;
+    unsigned char* decoded;
+} TextureCacheImage;
+
+typedef struct {
+    int hits;
+    int misses;
+    int writes;
+    int cold_loads;         // loads that decoded the source image
+    double cold_seconds;
+    int warm_loads;         // loads served from the cache
+    double warm_seconds;
+} TextureCacheStats;
+
+// Set the cache directory (created if missing). NULL or "" disables the cache.
+// Returns 1 on success.
+int texture_cache_set_dir(const char* dir);
+
+// Current cache directory, or NULL when disabled
+const char* texture_cache_get_dir(void);
+
+// Enable LZ4 compression for newly written cache files
+void texture_cache_set_compression(int enabled);
+int texture_cache_get_compression(void);
+
+// Look up a valid cache entry for `filepath` + `options`. Returns 1 on hit;
+// release the image with texture_cache_release when done.
+int texture_cache_load(const char* filepath, const TextureLoadOptions* options, TextureCacheImage* out);
+
+// Release mapping/buffers held by a cache image
+void texture_cache_release(TextureCacheImage* image);
+
+// Write a cache entry. `levels` holds `mip_count` levels packed in `format`
+// (a TextureFormat), each half the size of the previous one (rounded down,
+// minimum 1). Returns 1 on success.
+int texture_cache_store(const char* filepath, const TextureLoadOptions* options,
+                        int width, int height, int channels, int format,
+                        const unsigned char* const* levels, int mip_count);
+
+// Record the time spent on a cold (decode) or warm (cache) load
+void texture_cache_record_load(int warm, double seconds);
+
+void texture_cache_get_stats(TextureCacheStats* out);
+void texture_cache_reset_stats(void);
+
+#endif // TEXTURE_CACHE_H
@@ -0,0 +1,86 @@
+#include "texture_memory.h"
+#include "texture_registry.h"
+#include <stdio.h>
+#include <string.h>
+
+static size_t g_texture_bytes = 0;
+static size_t g_font_bytes = 0;
+static size_t g_budget = 0;
+static int g_texture_count = 0;
+static int g_font_atlas_count = 0;
+static int g_evicted = 0;
+static int g_evictions = 0;
+static int g_reloads = 0;
+static unsigned int g_frame = 1;
+
+static void apply_delta(size_t* total, long long delta) {
+    if (delta < 0 && (size_t)(-delta) > *total) *total = 0;
+    else *total = (size_t)((long long)*total + delta);
+}
+
+void texture_memory_track_texture(long long delta_bytes, int delta_count) {
+    apply_delta(&g_texture_bytes, delta_bytes);
+    g_texture_count += delta_count;
+}
+
+void texture_memory_track_font_atlas(long long delta_bytes, int delta_count) {
+    apply_delta(&g_font_bytes, delta_bytes);
+    g_font_atlas_count += delta_count;
+}
+
+void texture_memory_record_eviction(void) {
+    g_evicted++;
+    g_evictions++;
+}
+
+void texture_memory_record_reload(void) {
+    if (g_evicted > 0) g_evicted--;
+    g_reloads++;
+}
+
+void texture_memory_forget_evicted(void) {
+    if (g_evicted > 0) g_evicted--;
+}
+
+void texture_memory_set_budget(size_t bytes) {
+    g_budget = bytes;
+    texture_memory_enforce();
+}
+
+size_t texture_memory_get_budget(void) {
+    return g_budget;
+}
+
+void texture_memory_begin_frame(void) {
+    g_frame++;
+    texture_memory_enforce();
+}
+
+unsigned int texture_memory_current_frame(void) {
+    return g_frame;
+}
+
+void texture_memory_enforce(void) {
+    if (g_budget == 0) return;
+
+    size_t total = g_texture_bytes + g_font_bytes;
+    if (total <= g_budget) return;
+
+    size_t freed = texture_registry_evict(total - g_budget, g_frame);
+    if (freed > 0) {
+        printf("[Texture] Evicted %zu KB to stay under the %zu KB budget\n",
+               freed / 1024, g_budget / 1024);
+    }
+}
+
+void texture_memory_get_stats(TextureMemoryStats* out) {
+    memset(out, 0, sizeof(*out));
+    out->texture_bytes = g_texture_bytes;
+    out->font_bytes = g_font_bytes;
+    out->budget = g_budget;
+    out->textures = g_texture_count;
+    out->font_atlases = g_font_atlas_count;
+    out->evicted = g_evicted;
+    out->evictions = g_evictions;
+    out->reloads = g_reloads;
+}
@@ -0,0 +1,46 @@
+#ifndef TEXTURE_MEMORY_H
+#define TEXTURE_MEMORY_H
+
+#include <stddef.h>
+
+// GPU memory accounting and budget for textures and font atlases.
+//
+// Every Texture and font atlas reports its byte size here. When a budget is
+// set and the total goes over it, the least-recently-drawn file-loaded
+// textures (the ones in the path registry) are evicted: their GL storage is
+// freed but the Texture handle stays valid, and the pixels are reloaded from
+// the disk cache or the source file the next time the texture is drawn.
+
+typedef struct {
+    size_t texture_bytes;   // resident texture storage
+    size_t font_bytes;      // font atlas storage
+    size_t budget;          // 0 = unlimited
+    int textures;           // resident textures
+    int font_atlases;
+    int evicted;            // textures currently evicted
+    int evictions;          // total evictions
+    int reloads;            // total reloads after eviction
+} TextureMemoryStats;
+
+// Record allocation changes (negative deltas for frees)
+void texture_memory_track_texture(long long delta_bytes, int delta_count);
+void texture_memory_track_font_atlas(long long delta_bytes, int delta_count);
+void texture_memory_record_eviction(void);
+void texture_memory_record_reload(void);
+void texture_memory_forget_evicted(void);   // an evicted texture was destroyed
+
+// Budget in bytes for textures + font atlases (0 disables eviction)
+void texture_memory_set_budget(size_t bytes);
+size_t texture_memory_get_budget(void);
+
+// Frame counter used as the LRU clock (advanced by renderer_begin)
+void texture_memory_begin_frame(void);
+unsigned int texture_memory_current_frame(void);
+
+// Evict textures until under budget. Textures drawn in the current frame are
+// never evicted.
+void texture_memory_enforce(void);
+
+void texture_memory_get_stats(TextureMemoryStats* out);
+
+#endif // TEXTURE_MEMORY_H
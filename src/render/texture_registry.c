@@ -0,0 +1,233 @@
+#include "texture_registry.h"
+#include "texture_memory.h"
+#include "../platform/filemap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct RegistryEntry {
+    char* path;                 // canonical source path
+    TextureLoadOptions options; // kept to reload after eviction
+    uint64_t options_hash;
+    uint64_t hash;              // combined key hash
+    Texture* texture;
+    struct RegistryEntry* next;
+} RegistryEntry;
+
+static RegistryEntry** g_buckets = NULL;
+static int g_bucket_count = 0;
+static int g_entry_count = 0;
+static int g_hits = 0;
+static int g_misses = 0;
+
+#define REGISTRY_INITIAL_BUCKETS 64
+
+// Grow the bucket array so chains stay short (load factor <= 1)
+static int registry_grow(void) {
+    int new_count = g_bucket_count ? g_bucket_count * 2 : REGISTRY_INITIAL_BUCKETS;
+    RegistryEntry** buckets = (RegistryEntry**)calloc((size_t)new_count, sizeof(RegistryEntry*));
+    if (!buckets) return 0;
+
+    for (int i = 0; i < g_bucket_count; i++) {
+        RegistryEntry* e = g_buckets[i];
+        while (e) {
+            RegistryEntry* next = e->next;
+            int b = (int)(e->hash & (uint64_t)(new_count - 1));
+            e->next = buckets[b];
+            buckets[b] = e;
+            e = next;
+        }
+    }
+
+    free(g_buckets);
+    g_buckets = buckets;
+    g_bucket_count = new_count;
+    return 1;
+}
+
+static RegistryEntry* registry_find(const char* path, uint64_t options_hash, uint64_t hash) {
+    if (!g_buckets) return NULL;
+    RegistryEntry* e = g_buckets[hash & (uint64_t)(g_bucket_count - 1)];
+    for (; e; e = e->next) {
+        if (e->hash == hash && e->options_hash == options_hash && strcmp(e->path, path) == 0) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+Texture* texture_registry_acquire(const char* filepath, const TextureLoadOptions* options) {
+    if (!filepath) return NULL;
+
+    TextureLoadOptions defaults;
+    if (!options) {
+        texture_load_options_init(&defaults);
+        options = &defaults;
+    }
+
+    char canonical[1024];
+    file_canonical_path(filepath, canonical, sizeof(canonical));
+    uint64_t options_hash = texture_load_options_key(options);
+    uint64_t hash = fnv1a64(&options_hash, sizeof(options_hash),
+                            fnv1a64(canonical, strlen(canonical), FNV64_SEED));
+
+    RegistryEntry* existing = registry_find(canonical, options_hash, hash);
+    if (existing) {
+        g_hits++;
+        texture_retain(existing->texture);
+        return existing->texture;
+    }
+
+    g_misses++;
+    Texture* texture = texture_load_ex(filepath, options);
+    if (!texture) return NULL;
+
+    if (g_entry_count >= g_bucket_count && !registry_grow()) {
+        return texture;  // still usable, just not shared
+    }
+
+    RegistryEntry* e = (RegistryEntry*)calloc(1, sizeof(RegistryEntry));
+    size_t path_len = strlen(canonical);
+    char* path = e ? (char*)malloc(path_len + 1) : NULL;
+    if (!e || !path) {
+        free(e);
+        return texture;
+    }
+    memcpy(path, canonical, path_len + 1);
+
+    e->path = path;
+    e->options = *options;
+    e->options_hash = options_hash;
+    e->hash = hash;
+    e->texture = texture;
+
+    int b = (int)(hash & (uint64_t)(g_bucket_count - 1));
+    e->next = g_buckets[b];
+    g_buckets[b] = e;
+    g_entry_count++;
+
+    texture->registered = 1;
+
+    // A fresh load may push usage over the memory budget
+    texture_memory_enforce();
+    return texture;
+}
+
+static void free_entry(RegistryEntry* e) {
+    free(e->path);
+    free(e);
+}
+
+void texture_registry_remove(Texture* texture) {
+    if (!texture || !g_buckets) return;
+
+    for (int i = 0; i < g_bucket_count; i++) {
+        RegistryEntry** link = &g_buckets[i];
+        while (*link) {
+            RegistryEntry* e = *link;
+            if (e->texture == texture) {
+                *link = e->next;
+                texture->registered = 0;
+                free_entry(e);
+                g_entry_count--;
+                return;
+            }
+            link = &e->next;
+        }
+    }
+}
+
+int texture_registry_purge(void) {
+    int purged = 0;
+
+    for (int i = 0; i < g_bucket_count; i++) {
+        RegistryEntry** link = &g_buckets[i];
+        while (*link) {
+            RegistryEntry* e = *link;
+            if (e->texture->refcount > 0) {
+                link = &e->next;
+                continue;
+            }
+            *link = e->next;
+            e->texture->registered = 0;
+            texture_destroy(e->texture);
+            free_entry(e);
+            g_entry_count--;
+            purged++;
+        }
+    }
+
+    if (purged > 0) {
+        printf("[Texture] Purged %d unused cached texture(s)\n", purged);
+    }
+    return purged;
+}
+
+static RegistryEntry* registry_find_texture(const Texture* texture) {
+    for (int i = 0; i < g_bucket_count; i++) {
+        for (RegistryEntry* e = g_buckets[i]; e; e = e->next) {
+            if (e->texture == texture) return e;
+        }
+    }
+    return NULL;
+}
+
+int texture_registry_reload(Texture* texture) {
+    RegistryEntry* e = registry_find_texture(texture);
+    if (!e) return 0;
+
+    if (!texture_reload(texture, e->path, &e->options)) {
+        fprintf(stderr, "[Texture] Failed to reload evicted texture: %s\n", e->path);
+        return 0;
+    }
+    return 1;
+}
+
+static int compare_last_used(const void* a, const void* b) {
+    const Texture* ta = *(const Texture* const*)a;
+    const Texture* tb = *(const Texture* const*)b;
+    if (ta->last_used_frame < tb->last_used_frame) return -1;
+    if (ta->last_used_frame > tb->last_used_frame) return 1;
+    return 0;
+}
+
+size_t texture_registry_evict(size_t bytes_needed, unsigned int current_frame) {
+    if (g_entry_count == 0) return 0;
+
+    Texture** candidates = (Texture**)malloc((size_t)g_entry_count * sizeof(Texture*));
+    if (!candidates) return 0;
+
+    int count = 0;
+    for (int i = 0; i < g_bucket_count; i++) {
+        for (RegistryEntry* e = g_buckets[i]; e; e = e->next) {
+            if (!e->texture->evicted && e->texture->last_used_frame < current_frame) {
+                candidates[count++] = e->texture;
+            }
+        }
+    }
+
+    // Least recently drawn first
+    qsort(candidates, (size_t)count, sizeof(Texture*), compare_last_used);
+
+    size_t freed = 0;
+    for (int i = 0; i < count && freed < bytes_needed; i++) {
+        freed += candidates[i]->gpu_bytes;
+        texture_evict(candidates[i]);
+    }
+
+    free(candidates);
+    return freed;
+}
+
+void texture_registry_get_stats(TextureRegistryStats* out) {
+    memset(out, 0, sizeof(*out));
+    for (int i = 0; i < g_bucket_count; i++) {
+        for (RegistryEntry* e = g_buckets[i]; e; e = e->next) {
+            out->entries++;
+            if (e->texture->refcount > 0) out->referenced++;
+            else out->unreferenced++;
+        }
+    }
+    out->hits = g_hits;
+    out->misses = g_misses;
+}
@@ -0,0 +1,41 @@
+#ifndef TEXTURE_REGISTRY_H
+#define TEXTURE_REGISTRY_H
+
+#include "texture.h"
+
+// Path-keyed texture registry.
+//
+// Textures loaded through the registry are shared: loading the same canonical
+// path with the same options returns the existing Texture with its reference
+// count bumped instead of decoding the file and creating a new GL texture.
+// Entries whose reference count drops to zero stay cached (so a respawned
+// entity reuses the texture) until texture_registry_purge() is called.
+
+typedef struct {
+    int entries;        // textures currently held by the registry
+    int referenced;     // entries with at least one owner
+    int unreferenced;   // entries kept alive only by the registry
+    int hits;           // loads served by an existing entry
+    int misses;         // loads that had to create a texture
+} TextureRegistryStats;
+
+// Load (or share) the texture for `filepath` + `options` (NULL = defaults).
+// The caller owns one reference and must drop it with texture_release().
+Texture* texture_registry_acquire(const char* filepath, const TextureLoadOptions* options);
+
+// Destroy every entry with no remaining owners. Returns the number destroyed.
+int texture_registry_purge(void);
+
+// Forget a texture (called by texture_destroy for registered textures)
+void texture_registry_remove(Texture* texture);
+
+// Reload an evicted registry texture from its source path. Returns 1 on success.
+int texture_registry_reload(Texture* texture);
+
+// Evict least-recently-drawn textures not used in `current_frame` until at
+// least `bytes_needed` bytes are freed. Returns the bytes freed.
+size_t texture_registry_evict(size_t bytes_needed, unsigned int current_frame);
+
+void texture_registry_get_stats(TextureRegistryStats* out);
+
+#endif // TEXTURE_REGISTRY_H
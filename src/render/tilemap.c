@@ -0,0 +1,674 @@
+#include "tilemap.h"
+#include "texture_registry.h"
+#include "camera.h"
+#include "renderer.h"
+#include "../util/json.h"
+#include "../platform/filemap.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TILEMAP_VERTEX_SIZE 5  // x, y, u, v, animation slot
+#define TILEMAP_CHUNK_VERTICES (TILEMAP_CHUNK_SIZE * TILEMAP_CHUNK_SIZE * 6)
+
+// Tiled stores flip/rotation flags in the top bits of each gid
+#define TILED_FLAG_MASK 0xF0000000u
+
+static const char* tilemap_vertex_shader_source =
+    "#version 330 core\n"
+    "layout (location = 0) in vec2 aPos;\n"
+    "layout (location = 1) in vec2 aTexCoord;\n"
+    "layout (location = 2) in float aSlot;\n"
+    "out vec2 TexCoord;\n"
+    "uniform mat4 projection;\n"
+    "uniform vec2 offset;\n"
+    "uniform vec2 uvOffsets[65];\n"
+    "void main() {\n"
+    "    gl_Position = projection * vec4(aPos + offset, 0.0, 1.0);\n"
+    "    TexCoord = aTexCoord + uvOffsets[int(aSlot)];\n"
+    "}\n";
+
+static const char* tilemap_fragment_shader_source =
+    "#version 330 core\n"
+    "in vec2 TexCoord;\n"
+    "out vec4 FragColor;\n"
+    "uniform sampler2D textureSampler;\n"
+    "uniform vec4 tint;\n"
+    "uniform bool premultiplied;\n"
+    "uniform bool texturePremultiplied;\n"
+    "void main() {\n"
+    "    vec4 texColor = texture(textureSampler, TexCoord);\n"
+    "    vec4 color = tint;\n"
+    "    if (premultiplied) {\n"
+    "        if (!texturePremultiplied) texColor.rgb *= texColor.a;\n"
+    "        color.rgb *= color.a;\n"
+    "    } else if (texturePremultiplied && texColor.a > 0.0) {\n"
+    "        texColor.rgb /= texColor.a;\n"
+    "    }\n"
+    "    FragColor = texColor * color;\n"
+    "    if (FragColor.a < 0.001) discard;\n"
+    "}\n";
+
+// Shared by every map; created on the first draw
+typedef struct {
+    GLuint shader;
+    GLint projection_loc;
+    GLint offset_loc;
+    GLint uv_offsets_loc;
+    GLint texture_loc;
+    GLint tint_loc;
+    GLint premultiplied_loc;
+    GLint texture_premultiplied_loc;
+    float scratch[TILEMAP_CHUNK_VERTICES * TILEMAP_VERTEX_SIZE];
+    int initialized;
+} TilemapRendererState;
+
+static TilemapRendererState tm_state = {0};
+
+static GLuint compile_stage(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char info_log[512];
+        glGetShaderInfoLog(shader, 512, NULL, info_log);
+        fprintf(stderr, "[Tilemap] Shader compile error: %s\n", info_log);
+    }
+    return shader;
+}
+
+static void ensure_renderer(void) {
+    if (tm_state.initialized) return;
+
+    GLuint vs = compile_stage(GL_VERTEX_SHADER, tilemap_vertex_shader_source);
+    GLuint fs = compile_stage(GL_FRAGMENT_SHADER, tilemap_fragment_shader_source);
+    tm_state.shader = glCreateProgram();
+    glAttachShader(tm_state.shader, vs);
+    glAttachShader(tm_state.shader, fs);
+    glLinkProgram(tm_state.shader);
+
+    GLint success;
+    glGetProgramiv(tm_state.shader, GL_LINK_STATUS, &success);
+    if (!success) {
+        char info_log[512];
+        glGetProgramInfoLog(tm_state.shader, 512, NULL, info_log);
+        fprintf(stderr, "[Tilemap] Shader linking error: %s\n", info_log);
+    }
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    tm_state.projection_loc = glGetUniformLocation(tm_state.shader, "projection");
+    tm_state.offset_loc = glGetUniformLocation(tm_state.shader, "offset");
+    tm_state.uv_offsets_loc = glGetUniformLocation(tm_state.shader, "uvOffsets");
+    tm_state.texture_loc = glGetUniformLocation(tm_state.shader, "textureSampler");
+    tm_state.tint_loc = glGetUniformLocation(tm_state.shader, "tint");
+    tm_state.premultiplied_loc = glGetUniformLocation(tm_state.shader, "premultiplied");
+    tm_state.texture_premultiplied_loc = glGetUniformLocation(tm_state.shader, "texturePremultiplied");
+    tm_state.initialized = 1;
+}
+
+// --- Map lifetime ---
+
+Tilemap* tilemap_create(int width, int height, int tile_width, int tile_height,
+                        Texture* texture, int margin, int spacing, int layer_count) {
+    if (width <= 0 || height <= 0 || tile_width <= 0 || tile_height <= 0 || !texture) return NULL;
+    if (margin < 0 || spacing < 0) return NULL;
+
+    int columns = (texture->width - 2 * margin + spacing) / (tile_width + spacing);
+    int rows = (texture->height - 2 * margin + spacing) / (tile_height + spacing);
+    if (columns <= 0 || rows <= 0) return NULL;
+
+    Tilemap* map = (Tilemap*)calloc(1, sizeof(Tilemap));
+    if (!map) return NULL;
+    map->width = width;
+    map->height = height;
+    map->tile_width = tile_width;
+    map->tile_height = tile_height;
+    map->tex_tile_width = tile_width;
+    map->tex_tile_height = tile_height;
+    map->chunks_x = (width + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE;
+    map->chunks_y = (height + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE;
+    map->texture = texture;
+    map->columns = columns;
+    map->tile_count = columns * rows;
+    if (map->tile_count > 65535) map->tile_count = 65535;
+    map->margin = margin;
+    map->spacing = spacing;
+    texture_retain(texture);
+
+    for (int i = 0; i < layer_count; i++) {
+        if (tilemap_add_layer(map, NULL) < 0) {
+            tilemap_destroy(map);
+            return NULL;
+        }
+    }
+    return map;
+}
+
+void tilemap_destroy(Tilemap* map) {
+    if (!map) return;
+    int chunk_count = map->chunks_x * map->chunks_y;
+    for (int l = 0; l < map->layer_count; l++) {
+        TilemapLayer* layer = &map->layers[l];
+        for (int c = 0; c < chunk_count; c++) {
+            if (layer->chunks[c].vbo) glDeleteBuffers(1, &layer->chunks[c].vbo);
+            if (layer->chunks[c].vao) glDeleteVertexArrays(1, &layer->chunks[c].vao);
+        }
+        free(layer->chunks);
+        free(layer->tiles);
+    }
+    free(map->layers);
+    texture_release(map->texture);
+    free(map);
+}
+
+int tilemap_add_layer(Tilemap* map, const char* name) {
+    TilemapLayer* layers = (TilemapLayer*)realloc(map->layers, (size_t)(map->layer_count + 1) * sizeof(TilemapLayer));
+    if (!layers) return -1;
+    map->layers = layers;
+
+    TilemapLayer* layer = &layers[map->layer_count];
+    memset(layer, 0, sizeof(*layer));
+    layer->tiles = (uint16_t*)calloc((size_t)map->width * (size_t)map->height, sizeof(uint16_t));
+    layer->chunks = (TilemapChunk*)calloc((size_t)(map->chunks_x * map->chunks_y), sizeof(TilemapChunk));
+    if (!layer->tiles || !layer->chunks) {
+        free(layer->tiles);
+        free(layer->chunks);
+        return -1;
+    }
+    if (name) {
+        snprintf(layer->name, sizeof(layer->name), "%s", name);
+    } else {
+        snprintf(layer->name, sizeof(layer->name), "layer%d", map->layer_count + 1);
+    }
+    layer->visible = 1;
+    layer->opacity = 1.0f;
+    return map->layer_count++;
+}
+
+int tilemap_find_layer(const Tilemap* map, const char* name) {
+    for (int i = 0; i < map->layer_count; i++) {
+        if (strcmp(map->layers[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+// --- Tile access ---
+
+static void mark_dirty(Tilemap* map, int layer, int x, int y) {
+    int cx = x / TILEMAP_CHUNK_SIZE;
+    int cy = y / TILEMAP_CHUNK_SIZE;
+    map->layers[layer].chunks[cy * map->chunks_x + cx].dirty = 1;
+}
+
+void tilemap_set(Tilemap* map, int layer, int x, int y, uint16_t tile) {
+    if (layer < 0 || layer >= map->layer_count) return;
+    if (x < 0 || y < 0 || x >= map->width || y >= map->height) return;
+    uint16_t* cell = &map->layers[layer].tiles[(size_t)y * map->width + x];
+    if (*cell == tile) return;
+    *cell = tile;
+    mark_dirty(map, layer, x, y);
+}
+
+uint16_t tilemap_get(const Tilemap* map, int layer, int x, int y) {
+    if (layer < 0 || layer >= map->layer_count) return 0;
+    if (x < 0 || y < 0 || x >= map->width || y >= map->height) return 0;
+    return map->layers[layer].tiles[(size_t)y * map->width + x];
+}
+
+void tilemap_fill(Tilemap* map, int layer, int x, int y, int w, int h, uint16_t tile) {
+    if (layer < 0 || layer >= map->layer_count) return;
+    int x0 = x < 0 ? 0 : x;
+    int y0 = y < 0 ? 0 : y;
+    int x1 = x + w > map->width ? map->width : x + w;
+    int y1 = y + h > map->height ? map->height : y + h;
+    for (int ty = y0; ty < y1; ty++) {
+        for (int tx = x0; tx < x1; tx++) {
+            tilemap_set(map, layer, tx, ty, tile);
+        }
+    }
+}
+
+int tilemap_set_animation(Tilemap* map, uint16_t tile, const uint16_t* frames,
+                          const float* durations, int frame_count) {
+    if (tile == 0 || tile > map->tile_count) return 0;
+    if (frame_count <= 0 || frame_count > TILEMAP_MAX_ANIM_FRAMES) return 0;
+    for (int i = 0; i < frame_count; i++) {
+        if (frames[i] == 0 || frames[i] > map->tile_count) return 0;
+    }
+
+    int index = map->anim_slot[tile] - 1;
+    if (index < 0) {
+        if (map->animation_count >= TILEMAP_MAX_ANIMATIONS) return 0;
+        index = map->animation_count++;
+        map->anim_slot[tile] = (uint8_t)(index + 1);
+        // Existing vertices of this tile need the new slot
+        for (int l = 0; l < map->layer_count; l++) {
+            int chunk_count = map->chunks_x * map->chunks_y;
+            for (int c = 0; c < chunk_count; c++) map->layers[l].chunks[c].dirty = 1;
+        }
+    }
+
+    TilemapAnimation* anim = &map->animations[index];
+    anim->tile = tile;
+    anim->frame_count = frame_count;
+    anim->total = 0.0f;
+    for (int i = 0; i < frame_count; i++) {
+        anim->frames[i] = frames[i];
+        anim->durations[i] = durations[i] > 0.0f ? durations[i] : 0.1f;
+        anim->total += anim->durations[i];
+    }
+    return 1;
+}
+
+// --- Rendering ---
+
+// Top-left UV of a tile id (1-based)
+static void tile_uv(const Tilemap* map, uint16_t tile, float* u, float* v) {
+    int index = tile - 1;
+    int col = index % map->columns;
+    int row = index / map->columns;
+    *u = (float)(map->margin + col * (map->tex_tile_width + map->spacing)) / map->texture->width;
+    *v = (float)(map->margin + row * (map->tex_tile_height + map->spacing)) / map->texture->height;
+}
+
+static void rebuild_chunk(Tilemap* map, TilemapLayer* layer, int cx, int cy) {
+    TilemapChunk* chunk = &layer->chunks[cy * map->chunks_x + cx];
+    float du = (float)map->tex_tile_width / map->texture->width;
+    float dv = (float)map->tex_tile_height / map->texture->height;
+    float* out = tm_state.scratch;
+    int count = 0;
+
+    int x0 = cx * TILEMAP_CHUNK_SIZE;
+    int y0 = cy * TILEMAP_CHUNK_SIZE;
+    int x1 = x0 + TILEMAP_CHUNK_SIZE < map->width ? x0 + TILEMAP_CHUNK_SIZE : map->width;
+    int y1 = y0 + TILEMAP_CHUNK_SIZE < map->height ? y0 + TILEMAP_CHUNK_SIZE : map->height;
+
+    for (int ty = y0; ty < y1; ty++) {
+        const uint16_t* row = &layer->tiles[(size_t)ty * map->width];
+        for (int tx = x0; tx < x1; tx++) {
+            uint16_t tile = row[tx];
+            if (tile == 0 || tile > map->tile_count) continue;
+
+            float u0, v0;
+            tile_uv(map, tile, &u0, &v0);
+            float u1 = u0 + du, v1 = v0 + dv;
+            float px0 = (float)(tx * map->tile_width), py0 = (float)(ty * map->tile_height);
+            float px1 = px0 + map->tile_width, py1 = py0 + map->tile_height;
+            float slot = (float)map->anim_slot[tile];
+
+            const float quad[6][4] = {
+                {px0, py0, u0, v0}, {px1, py0, u1, v0}, {px1, py1, u1, v1},
+                {px0, py0, u0, v0}, {px1, py1, u1, v1}, {px0, py1, u0, v1}
+            };
+            for (int i = 0; i < 6; i++) {
+                memcpy(out, quad[i], 4 * sizeof(float));
+                out[4] = slot;
+                out += TILEMAP_VERTEX_SIZE;
+            }
+            count += 6;
+        }
+    }
+
+    if (!chunk->vao) {
+        glGenVertexArrays(1, &chunk->vao);
+        glGenBuffers(1, &chunk->vbo);
+        glBindVertexArray(chunk->vao);
+        glBindBuffer(GL_ARRAY_BUFFER, chunk->vbo);
+        GLsizei stride = TILEMAP_VERTEX_SIZE * sizeof(float);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)(2 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride, (void*)(4 * sizeof(float)));
+        glEnableVertexAttribArray(2);
+    } else {
+        glBindVertexArray(chunk->vao);
+        glBindBuffer(GL_ARRAY_BUFFER, chunk->vbo);
+    }
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)count * TILEMAP_VERTEX_SIZE * sizeof(float),
+                 count > 0 ? tm_state.scratch : NULL, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    chunk->vertex_count = count;
+    chunk->dirty = 0;
+    map->chunk_rebuilds++;
+}
+
+// World-space bounds of the current view, from the inverse of the 2D part of
+// the projection matrix
+static void view_bounds(const float* m, float* min_x, float* min_y, float* max_x, float* max_y) {
+    float det = m[0] * m[5] - m[4] * m[1];
+    if (fabsf(det) < 1e-12f) {
+        *min_x = *min_y = -1e30f;
+        *max_x = *max_y = 1e30f;
+        return;
+    }
+    *min_x = *min_y = 1e30f;
+    *max_x = *max_y = -1e30f;
+    static const float corners[4][2] = {{-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+    for (int i = 0; i < 4; i++) {
+        float nx = corners[i][0] - m[12];
+        float ny = corners[i][1] - m[13];
+        float wx = ( m[5] * nx - m[4] * ny) / det;
+        float wy = (-m[1] * nx + m[0] * ny) / det;
+        if (wx < *min_x) *min_x = wx;
+        if (wx > *max_x) *max_x = wx;
+        if (wy < *min_y) *min_y = wy;
+        if (wy > *max_y) *max_y = wy;
+    }
+}
+
+static int clampi(int v, int lo, int hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+// floor(v / size) as a chunk index, clamped to [-1, count] while still a float
+// so the unbounded view of a degenerate projection never overflows the int
+static int chunk_floor(float v, float size, int count) {
+    float f = floorf(v / size);
+    if (!(f > -1.0f)) return -1;  // also NaN
+    return f < (float)count ? (int)f : count;
+}
+
+int tilemap_draw(Tilemap* map, int layer_index, float x, float y, double time) {
+    map->chunks_drawn = 0;
+    if (!map->texture || !texture_ensure_resident(map->texture)) return 0;
+    ensure_renderer();
+
+    // Keep painter's order: everything batched so far goes first
+    renderer_switch_batch(BATCH_NONE);
+
+    int sw, sh;
+    renderer_get_screen_size(&sw, &sh);
+    float projection[16];
+    if (renderer_is_ui_mode()) {
+        renderer_get_ui_projection(projection, sw, sh);
+    } else {
+        camera_get_matrix(projection, sw, sh);
+    }
+
+    // Visible chunk range
+    float min_x, min_y, max_x, max_y;
+    view_bounds(projection, &min_x, &min_y, &max_x, &max_y);
+    float chunk_w = (float)(TILEMAP_CHUNK_SIZE * map->tile_width);
+    float chunk_h = (float)(TILEMAP_CHUNK_SIZE * map->tile_height);
+    int cx0 = clampi(chunk_floor(min_x - x, chunk_w, map->chunks_x), 0, map->chunks_x);
+    int cy0 = clampi(chunk_floor(min_y - y, chunk_h, map->chunks_y), 0, map->chunks_y);
+    int cx1 = clampi(chunk_floor(max_x - x, chunk_w, map->chunks_x) + 1, 0, map->chunks_x);
+    int cy1 = clampi(chunk_floor(max_y - y, chunk_h, map->chunks_y) + 1, 0, map->chunks_y);
+    if (cx0 >= cx1 || cy0 >= cy1) return 0;
+
+    // Animated tiles: offset from the base tile's UV to the current frame's
+    float uv_offsets[(TILEMAP_MAX_ANIMATIONS + 1) * 2] = {0};
+    for (int i = 0; i < map->animation_count; i++) {
+        const TilemapAnimation* anim = &map->animations[i];
+        float t = (float)fmod(time, (double)anim->total);
+        int frame = 0;
+        while (frame < anim->frame_count - 1 && t >= anim->durations[frame]) {
+            t -= anim->durations[frame];
+            frame++;
+        }
+        float bu, bv, fu, fv;
+        tile_uv(map, anim->tile, &bu, &bv);
+        tile_uv(map, anim->frames[frame], &fu, &fv);
+        uv_offsets[(i + 1) * 2 + 0] = fu - bu;
+        uv_offsets[(i + 1) * 2 + 1] = fv - bv;
+    }
+
+    renderer_apply_blend();
+    glUseProgram(tm_state.shader);
+    glUniformMatrix4fv(tm_state.projection_loc, 1, GL_FALSE, projection);
+    glUniform2f(tm_state.offset_loc, x, y);
+    glUniform2fv(tm_state.uv_offsets_loc, TILEMAP_MAX_ANIMATIONS + 1, uv_offsets);
+    glUniform1i(tm_state.texture_loc, 0);
+    glUniform1i(tm_state.premultiplied_loc, renderer_get_premultiplied_alpha());
+    glUniform1i(tm_state.texture_premultiplied_loc, map->texture->premultiplied);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, map->texture->id);
+
+    int first = layer_index < 0 ? 0 : layer_index;
+    int last = layer_index < 0 ? map->layer_count - 1 : layer_index;
+    for (int l = first; l <= last && l < map->layer_count; l++) {
+        TilemapLayer* layer = &map->layers[l];
+        if (layer_index < 0 && !layer->visible) continue;
+        glUniform4f(tm_state.tint_loc, 1.0f, 1.0f, 1.0f, layer->opacity);
+
+        for (int cy = cy0; cy < cy1; cy++) {
+            for (int cx = cx0; cx < cx1; cx++) {
+                TilemapChunk* chunk = &layer->chunks[cy * map->chunks_x + cx];
+                if (chunk->dirty || !chunk->vao) rebuild_chunk(map, layer, cx, cy);
+                if (chunk->vertex_count == 0) continue;
+                glBindVertexArray(chunk->vao);
+                glDrawArrays(GL_TRIANGLES, 0, chunk->vertex_count);
+                map->chunks_drawn++;
+            }
+        }
+    }
+
+    glBindVertexArray(0);
+    glUseProgram(0);
+    return map->chunks_drawn;
+}
+
+// --- Tiled JSON import ---
+
+// Load the tileset image next to the file that references it
+static Texture* load_tileset_image(const char* base_path, const char* image) {
+    char path[1024];
+    file_resolve_relative(base_path, image, path, sizeof(path));
+    return texture_registry_acquire(path, NULL);
+}
+
+static void import_animations(Tilemap* map, const JsonValue* tileset) {
+    const JsonValue* tiles = json_get(tileset, "tiles");
+    for (size_t i = 0; tiles && i < tiles->count; i++) {
+        const JsonValue* tile = &tiles->items[i];
+        const JsonValue* frames = json_get(tile, "animation");
+        if (!frames || frames->type != JSON_ARRAY || frames->count == 0) continue;
+
+        uint16_t ids[TILEMAP_MAX_ANIM_FRAMES];
+        float durations[TILEMAP_MAX_ANIM_FRAMES];
+        int n = 0;
+        for (size_t f = 0; f < frames->count && n < TILEMAP_MAX_ANIM_FRAMES; f++) {
+            ids[n] = (uint16_t)(json_get_number(&frames->items[f], "tileid", 0) + 1);
+            durations[n] = (float)json_get_number(&frames->items[f], "duration", 100) / 1000.0f;
+            n++;
+        }
+        uint16_t id = (uint16_t)(json_get_number(tile, "id", -1) + 1);
+        if (id > 0 && !tilemap_set_animation(map, id, ids, durations, n)) {
+            fprintf(stderr, "[Tilemap] Too many animated tiles, ignoring tile %d\n", id - 1);
+        }
+    }
+}
+
+Tilemap* tilemap_load_tiled(const char* json_path, Texture* texture, char* err, size_t err_size) {
+    JsonValue* root = json_parse_file(json_path, err, err_size);
+    if (!root) return NULL;
+
+    Tilemap* map = NULL;
+    JsonValue* external = NULL;
+    char tileset_path[1024];
+    snprintf(tileset_path, sizeof(tileset_path), "%s", json_path);
+
+    int width = (int)json_get_number(root, "width", 0);
+    int height = (int)json_get_number(root, "height", 0);
+    int tile_w = (int)json_get_number(root, "tilewidth", 0);
+    int tile_h = (int)json_get_number(root, "tileheight", 0);
+    const JsonValue* layers = json_get(root, "layers");
+    const JsonValue* tileset = json_at(json_get(root, "tilesets"), 0);
+
+    if (json_bool(json_get(root, "infinite"), 0)) {
+        snprintf(err, err_size, "Infinite Tiled maps are not supported");
+        goto done;
+    }
+    if (width <= 0 || height <= 0 || tile_w <= 0 || tile_h <= 0 || !layers || layers->type != JSON_ARRAY || !tileset) {
+        snprintf(err, err_size, "Not a Tiled map (missing size, layers or tilesets)");
+        goto done;
+    }
+    int first_gid = (int)json_get_number(tileset, "firstgid", 1);
+
+    // External tileset (.tsj / .json)
+    const char* source = json_get_string(tileset, "source", NULL);
+    if (source) {
+        file_resolve_relative(json_path, source, tileset_path, sizeof(tileset_path));
+        external = json_parse_file(tileset_path, err, err_size);
+        if (!external) goto done;
+        tileset = external;
+    }
+
+    int owns_texture = 0;
+    if (!texture) {
+        const char* image = json_get_string(tileset, "image", NULL);
+        texture = image ? load_tileset_image(tileset_path, image) : NULL;
+        if (!texture) {
+            snprintf(err, err_size, "Failed to load tileset image: %s", image ? image : "(none)");
+            goto done;
+        }
+        owns_texture = 1;
+    }
+
+    map = tilemap_create(width, height, (int)json_get_number(tileset, "tilewidth", tile_w),
+                         (int)json_get_number(tileset, "tileheight", tile_h), texture,
+                         (int)json_get_number(tileset, "margin", 0),
+                         (int)json_get_number(tileset, "spacing", 0), 0);
+    if (owns_texture) texture_release(texture);  // the map holds its own reference
+    if (!map) {
+        snprintf(err, err_size, "Tileset does not fit the tile size");
+        goto done;
+    }
+    // Map cells can differ from tileset tiles; cells follow the map grid while
+    // UVs keep the tileset's tile size
+    map->tile_width = tile_w;
+    map->tile_height = tile_h;
+
+    int warned_tilesets = 0;
+    for (size_t i = 0; i < layers->count; i++) {
+        const JsonValue* src = &layers->items[i];
+        if (strcmp(json_get_string(src, "type", ""), "tilelayer") != 0) continue;
+
+        const JsonValue* data = json_get(src, "data");
+        if (!data || data->type != JSON_ARRAY) {
+            snprintf(err, err_size, "Layer '%s': only CSV (array) layer data is supported",
+                     json_get_string(src, "name", "?"));
+            tilemap_destroy(map);
+            map = NULL;
+            goto done;
+        }
+
+        int l = tilemap_add_layer(map, json_get_string(src, "name", NULL));
+        if (l < 0) continue;
+        map->layers[l].visible = json_bool(json_get(src, "visible"), 1);
+        map->layers[l].opacity = (float)json_get_number(src, "opacity", 1.0);
+
+        size_t cells = (size_t)width * (size_t)height;
+        for (size_t c = 0; c < data->count && c < cells; c++) {
+            uint32_t gid = (uint32_t)json_number(&data->items[c], 0) & ~TILED_FLAG_MASK;
+            if (gid == 0) continue;
+            long id = (long)gid - first_gid + 1;
+            if (id <= 0 || id > map->tile_count) {
+                if (!warned_tilesets) {
+                    fprintf(stderr, "[Tilemap] %s: only the first tileset is used\n", json_path);
+                    warned_tilesets = 1;
+                }
+                continue;
+            }
+            map->layers[l].tiles[c] = (uint16_t)id;
+        }
+    }
+    for (int l = 0; l < map->layer_count; l++) {
+        int chunk_count = map->chunks_x * map->chunks_y;
+        for (int c = 0; c < chunk_count; c++) map->layers[l].chunks[c].dirty = 1;
+    }
+    import_animations(map, tileset);
+    printf("[Tilemap] Loaded Tiled map: %s (%dx%d, %d layers)\n", json_path, width, height, map->layer_count);
+
+done:
+    json_free(external);
+    json_free(root);
+    return map;
+}
+
+// --- CSV import ---
+
+Tilemap* tilemap_load_csv(const char* csv_path, Texture* texture, int tile_width, int tile_height,
+                          int one_based, char* err, size_t err_size) {
+    FileMap file;
+    if (!filemap_open(csv_path, &file)) {
+        snprintf(err, err_size, "Cannot open %s", csv_path);
+        return NULL;
+    }
+
+    // First pass: size
+    const char* p = (const char*)file.data;
+    const char* end = p + file.size;
+    int width = 0, height = 0, cols = 0, in_value = 0;
+    for (const char* q = p; q <= end; q++) {
+        char c = q < end ? *q : '\n';
+        if (c == ',' || c == '\n') {
+            if (in_value || c == ',') cols++;
+            in_value = 0;
+            if (c == '\n') {
+                if (cols > 0) height++;
+                if (cols > width) width = cols;
+                cols = 0;
+            }
+        } else if (c != '\r' && c != ' ' && c != '\t') {
+            in_value = 1;
+        }
+    }
+
+    Tilemap* map = width > 0 ? tilemap_create(width, height, tile_width, tile_height, texture, 0, 0, 1) : NULL;
+    if (!map) {
+        snprintf(err, err_size, width > 0 ? "Tileset does not fit the tile size" : "CSV file is empty");
+        filemap_close(&file);
+        return NULL;
+    }
+
+    // Second pass: values (the mapping is not NUL-terminated, so no strtol)
+    int x = 0, y = 0, row_used = 0;
+    while (p < end && y < height) {
+        char c = *p;
+        if (c == '-' || (c >= '0' && c <= '9')) {
+            int negative = (c == '-');
+            if (negative) p++;
+            // Consume every digit, so a long value is not split in two; values
+            // past 32 bits are empty, and Tiled's flip flags are ignored
+            unsigned long long value = 0;
+            while (p < end && *p >= '0' && *p <= '9') {
+                if (value <= 0xFFFFFFFFull) value = value * 10 + (unsigned)(*p - '0');
+                p++;
+            }
+            long id = 0;
+            if (!negative && value <= 0xFFFFFFFFull) {
+                long tile = (long)((uint32_t)value & ~TILED_FLAG_MASK);
+                id = one_based ? tile : tile + 1;
+            }
+            if (id > 0 && id <= map->tile_count && x < width) {
+                map->layers[0].tiles[(size_t)y * width + x] = (uint16_t)id;
+            }
+            row_used = 1;
+            continue;
+        }
+        if (c == '\n') {
+            if (row_used) y++;
+            x = 0;
+            row_used = 0;
+        } else if (c == ',') {
+            x++;
+            row_used = 1;
+        }
+        p++;
+    }
+    filemap_close(&file);
+
+    int chunk_count = map->chunks_x * map->chunks_y;
+    for (int c = 0; c < chunk_count; c++) map->layers[0].chunks[c].dirty = 1;
+    printf("[Tilemap] Loaded CSV map: %s (%dx%d)\n", csv_path, width, height);
+    return map;
+}
@@ -0,0 +1,104 @@
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+#include <glad/glad.h>
+#include <stdint.h>
+#include "texture.h"
+
+// Chunked tilemap renderer.
+//
+// Tiles are stored as 16-bit ids per layer (0 = empty, n = tileset tile n,
+// counted from 1 row by row). Each layer is split into TILEMAP_CHUNK_SIZE²
+// chunks with their own static vertex buffer, rebuilt only when a tile in the
+// chunk changes. Drawing culls chunks against the camera view and issues one
+// draw call per visible non-empty chunk.
+//
+// Animated tiles do not touch the vertex buffers: their vertices carry a slot
+// into a small UV offset table that is updated once per draw.
+
+#define TILEMAP_CHUNK_SIZE 32
+#define TILEMAP_MAX_ANIMATIONS 64
+#define TILEMAP_MAX_ANIM_FRAMES 32
+#define TILEMAP_LAYER_NAME_MAX 64
+
+typedef struct {
+    GLuint vao;
+    GLuint vbo;
+    int vertex_count;
+    int dirty;
+} TilemapChunk;
+
+typedef struct {
+    char name[TILEMAP_LAYER_NAME_MAX];
+    uint16_t* tiles;          // width * height ids, row-major
+    TilemapChunk* chunks;     // chunks_x * chunks_y
+    int visible;
+    float opacity;
+} TilemapLayer;
+
+typedef struct {
+    uint16_t tile;            // animated tile id
+    int frame_count;
+    uint16_t frames[TILEMAP_MAX_ANIM_FRAMES];
+    float durations[TILEMAP_MAX_ANIM_FRAMES];   // seconds
+    float total;
+} TilemapAnimation;
+
+typedef struct {
+    int width, height;        // in tiles
+    int tile_width, tile_height;  // map cell size in pixels
+    int chunks_x, chunks_y;
+
+    // Tileset
+    Texture* texture;         // retained
+    int tex_tile_width, tex_tile_height;  // tile size in the texture (cells may differ, see Tiled)
+    int columns;
+    int tile_count;
+    int margin, spacing;
+
+    TilemapLayer* layers;
+    int layer_count;
+
+    TilemapAnimation animations[TILEMAP_MAX_ANIMATIONS];
+    int animation_count;
+    uint8_t anim_slot[65536]; // tile id -> animation index + 1 (0 = static)
+
+    int chunks_drawn;         // last draw
+    int chunk_rebuilds;       // total
+} Tilemap;
+
+// Create an empty map using `texture` as a grid tileset of tile_w x tile_h cells
+Tilemap* tilemap_create(int width, int height, int tile_width, int tile_height,
+                        Texture* texture, int margin, int spacing, int layer_count);
+void tilemap_destroy(Tilemap* map);
+
+// Add an empty layer. Returns its index, or -1.
+int tilemap_add_layer(Tilemap* map, const char* name);
+int tilemap_find_layer(const Tilemap* map, const char* name);
+
+// Tile access (coordinates in tiles; out-of-range reads return 0)
+void tilemap_set(Tilemap* map, int layer, int x, int y, uint16_t tile);
+uint16_t tilemap_get(const Tilemap* map, int layer, int x, int y);
+void tilemap_fill(Tilemap* map, int layer, int x, int y, int w, int h, uint16_t tile);
+
+// Animate `tile` through `frames` (tile ids) with per-frame durations in
+// seconds. Returns 0 if the table is full or the input is invalid.
+int tilemap_set_animation(Tilemap* map, uint16_t tile, const uint16_t* frames,
+                          const float* durations, int frame_count);
+
+// Draw one layer (or every visible layer when `layer` < 0) with the map's
+// top-left at (x, y). `time` drives tile animations. Returns chunks drawn.
+int tilemap_draw(Tilemap* map, int layer, float x, float y, double time);
+
+// Load a Tiled JSON map (.tmj/.json): tile layers in CSV-style arrays, the
+// first tileset (embedded or external .tsj) and its tile animations.
+// `texture` overrides the tileset image. Returns NULL and fills `err` on failure.
+Tilemap* tilemap_load_tiled(const char* json_path, Texture* texture, char* err, size_t err_size);
+
+// Load one layer from a CSV file. Values are 0-based tileset indices with
+// negatives as empty (Tiled CSV export), or tile ids with 0 as empty when
+// `one_based` is set.
+Tilemap* tilemap_load_csv(const char* csv_path, Texture* texture, int tile_width, int tile_height,
+                          int one_based, char* err, size_t err_size);
+
+#endif // TILEMAP_H
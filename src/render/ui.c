@@ -1,15 +1,19 @@
 // UI — Immediate Mode GUI system for PudimBasicsGl
-// Provides panels, buttons, sliders and labels drawn with the engine's
-// primitive and text renderers, reading mouse input via GLFW.
+// Provides panels, buttons, sliders, labels and virtualized lists collected
+// in a draw list of their own, reading mouse and keyboard input via GLFW.
 
 #include "ui.h"
+#include "ui_state.h"
 #include "renderer.h"
+#include "camera.h"
 #include "text.h"
 #include "../platform/window.h"
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <math.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -28,23 +32,152 @@ static int    g_mouse_down = 0;
 static int    g_mouse_pressed = 0;  // just pressed this frame
 static int    g_last_mouse_down = 0;
 
-// Widget identity — simple FNV-1a hash of the string id
+// Widget identity — FNV-1a hash of the string id (see ui_state.h)
 static unsigned int g_active_id = 0;
 static unsigned int g_hot_id = 0;
 
+// Keyboard focus — the list clicked last
+static unsigned int g_focus_id = 0;
+static int g_focus_claimed = 0;     // a list was clicked this frame
+
+// Wheel and frame time, for scrolling lists
+static float  g_wheel = 0.0f;       // notches this frame, until a list consumes them
+static double g_time = 0.0;
+static float  g_dt = 0.0f;
+
+// Navigation keys, pressed this frame or auto-repeating while held
+#define UI_KEY_REPEAT_DELAY 0.4
+#define UI_KEY_REPEAT_RATE 0.05
+enum { NAV_UP, NAV_DOWN, NAV_PAGE_UP, NAV_PAGE_DOWN, NAV_HOME, NAV_END, NAV_KEY_COUNT };
+static const int g_nav_glfw_keys[NAV_KEY_COUNT] = {
+    GLFW_KEY_UP, GLFW_KEY_DOWN, GLFW_KEY_PAGE_UP, GLFW_KEY_PAGE_DOWN, GLFW_KEY_HOME, GLFW_KEY_END
+};
+static int    g_nav_held[NAV_KEY_COUNT];
+static double g_nav_repeat_at[NAV_KEY_COUNT];
+static int    g_nav_fired[NAV_KEY_COUNT];
+
+// Rectangle drawn quads are cut to (lists and table cells)
+typedef struct {
+    int enabled;
+    float x0, y0, x1, y1;
+} UiClip;
+
+static UiClip g_clip = {0};
+
+// GL scissor for what other renderers draw inside the clip (list draw
+// callbacks, SDF effect text), in window pixels from the bottom-left
+typedef struct {
+    int enabled;
+    GLint box[4];
+} UiScissor;
+
+static UiScissor g_scissor = {0};
+
 static int g_initialized = 0;
 
+// ---------------------------------------------------------------------------
+// Draw list
+// ---------------------------------------------------------------------------
+
+#define UI_MAX_VERTICES 16384
+#define UI_VERTEX_SIZE 9        // x, y, u, v, r, g, b, a, slot
+#define UI_MAX_COMMANDS 64
+#define UI_TEXTURE_SLOTS 4
+
+// Slot -1 is a solid fragment; 0-3 sample the command's texture in that unit
+// as glyph coverage, 4-7 as a signed distance field
+static const char* ui_vertex_shader_source =
+    "#version 330 core\n"
+    "layout (location = 0) in vec2 aPos;\n"
+    "layout (location = 1) in vec2 aTexCoord;\n"
+    "layout (location = 2) in vec4 aColor;\n"
+    "layout (location = 3) in float aSlot;\n"
+    "out vec2 TexCoord;\n"
+    "out vec4 Color;\n"
+    "flat out int Slot;\n"
+    "uniform mat4 projection;\n"
+    "void main() {\n"
+    "    gl_Position = projection * vec4(aPos, 0.0, 1.0);\n"
+    "    TexCoord = aTexCoord;\n"
+    "    Color = aColor;\n"
+    "    Slot = int(aSlot);\n"
+    "}\n";
+
+// Samplers can only be indexed with constants, hence the branches; atlas
+// pages have no mipmaps, so level 0 is sampled explicitly
+static const char* ui_fragment_shader_source =
+    "#version 330 core\n"
+    "in vec2 TexCoord;\n"
+    "in vec4 Color;\n"
+    "flat in int Slot;\n"
+    "out vec4 FragColor;\n"
+    "uniform sampler2D textures[4];\n"
+    "uniform float distRange;\n"
+    "uniform bool premultiplied;\n"
+    "float sampleUnit(int unit) {\n"
+    "    if (unit == 0) return textureLod(textures[0], TexCoord, 0.0).r;\n"
+    "    if (unit == 1) return textureLod(textures[1], TexCoord, 0.0).r;\n"
+    "    if (unit == 2) return textureLod(textures[2], TexCoord, 0.0).r;\n"
+    "    return textureLod(textures[3], TexCoord, 0.0).r;\n"
+    "}\n"
+    "vec2 unitSize(int unit) {\n"
+    "    if (unit == 0) return vec2(textureSize(textures[0], 0));\n"
+    "    if (unit == 1) return vec2(textureSize(textures[1], 0));\n"
+    "    if (unit == 2) return vec2(textureSize(textures[2], 0));\n"
+    "    return vec2(textureSize(textures[3], 0));\n"
+    "}\n"
+    "void main() {\n"
+    "    vec2 dx = dFdx(TexCoord), dy = dFdy(TexCoord);\n"
+    "    float coverage = 1.0;\n"
+    "    if (Slot >= 0) {\n"
+    "        int unit = Slot % 4;\n"
+    "        coverage = sampleUnit(unit);\n"
+    "        if (Slot >= 4) {\n"
+    "            vec2 texels = unitSize(unit);\n"
+    "            float texelsPerPixel = max(0.5 * (length(dx * texels) + length(dy * texels)), 1e-4);\n"
+    "            coverage = clamp((coverage - 0.5) * distRange / texelsPerPixel + 0.5, 0.0, 1.0);\n"
+    "        }\n"
+    "    }\n"
+    "    FragColor = vec4(Color.rgb, Color.a * coverage);\n"
+    "    if (FragColor.a < 0.01) discard;\n"
+    "    if (premultiplied) FragColor.rgb *= FragColor.a;\n"
+    "}\n";
+
+// A run of vertices drawn with one set of bound textures
+typedef struct {
+    int first;
+    int count;
+    GLuint textures[UI_TEXTURE_SLOTS];
+    int texture_count;
+} UiDrawCommand;
+
+typedef struct {
+    GLuint program;
+    GLint projection_loc;
+    GLint textures_loc;
+    GLint dist_range_loc;
+    GLint premultiplied_loc;
+    GLuint vao;
+    GLuint vbo;
+    float vertices[UI_MAX_VERTICES * UI_VERTEX_SIZE];
+    int vertex_count;
+    UiDrawCommand commands[UI_MAX_COMMANDS];
+    int command_count;
+    UiStats stats;
+    int initialized;
+} UiDrawList;
+
+static UiDrawList g_draw = {0};
+
 // ---------------------------------------------------------------------------
 // Helpers
 // ---------------------------------------------------------------------------
 
-static unsigned int hash_id(const char* str) {
-    unsigned int hash = 2166136261u;
-    while (*str) {
-        hash ^= (unsigned char)*str++;
-        hash *= 16777619u;
-    }
-    return hash;
+// Hash of a widget id, registering the widget in the state store so it is
+// kept alive (and checked for collisions) while it is drawn
+static unsigned int widget_id(const char* id) {
+    UiState* state = ui_state_get(id, NULL);
+    return state ? state->id : ui_state_hash(id);
 }
 
 static int point_in_rect(double px, double py, float rx, float ry, float rw, float rh) {
@@ -57,6 +190,343 @@ static float clampf(float v, float lo, float hi) {
     return v;
 }
 
+// ---------------------------------------------------------------------------
+// Draw list
+// ---------------------------------------------------------------------------
+
+static GLuint compile_stage(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char info_log[512];
+        glGetShaderInfoLog(shader, 512, NULL, info_log);
+        fprintf(stderr, "[UI] Shader compile error: %s\n", info_log);
+    }
+    return shader;
+}
+
+static void ensure_draw_list(void) {
+    if (g_draw.initialized) return;
+
+    GLuint vs = compile_stage(GL_VERTEX_SHADER, ui_vertex_shader_source);
+    GLuint fs = compile_stage(GL_FRAGMENT_SHADER, ui_fragment_shader_source);
+    g_draw.program = glCreateProgram();
+    glAttachShader(g_draw.program, vs);
+    glAttachShader(g_draw.program, fs);
+    glLinkProgram(g_draw.program);
+
+    GLint success;
+    glGetProgramiv(g_draw.program, GL_LINK_STATUS, &success);
+    if (!success) {
+        char info_log[512];
+        glGetProgramInfoLog(g_draw.program, 512, NULL, info_log);
+        fprintf(stderr, "[UI] Shader linking error: %s\n", info_log);
+    }
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    g_draw.projection_loc = glGetUniformLocation(g_draw.program, "projection");
+    g_draw.textures_loc = glGetUniformLocation(g_draw.program, "textures");
+    g_draw.dist_range_loc = glGetUniformLocation(g_draw.program, "distRange");
+    g_draw.premultiplied_loc = glGetUniformLocation(g_draw.program, "premultiplied");
+
+    glGenVertexArrays(1, &g_draw.vao);
+    glGenBuffers(1, &g_draw.vbo);
+    glBindVertexArray(g_draw.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, g_draw.vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(g_draw.vertices), NULL, GL_DYNAMIC_DRAW);
+    GLsizei stride = UI_VERTEX_SIZE * sizeof(float);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void*)(8 * sizeof(float)));
+    glEnableVertexAttribArray(3);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    g_draw.initialized = 1;
+}
+
+// Projection the draw list is drawn with (same as the other renderers)
+static void current_projection(float* projection) {
+    int sw, sh;
+    renderer_get_screen_size(&sw, &sh);
+    if (renderer_is_ui_mode()) {
+        renderer_get_ui_projection(projection, sw, sh);
+    } else {
+        camera_get_matrix(projection, sw, sh);
+    }
+}
+
+void ui_flush(void) {
+    if (g_draw.vertex_count == 0) {
+        g_draw.command_count = 0;
+        return;
+    }
+    ensure_draw_list();
+
+    float projection[16];
+    current_projection(projection);
+
+    static const GLint units[UI_TEXTURE_SLOTS] = {0, 1, 2, 3};
+    renderer_apply_blend();
+    glUseProgram(g_draw.program);
+    glUniformMatrix4fv(g_draw.projection_loc, 1, GL_FALSE, projection);
+    glUniform1iv(g_draw.textures_loc, UI_TEXTURE_SLOTS, units);
+    glUniform1f(g_draw.dist_range_loc, FONT_SDF_PADDING * 255.0f / 128.0f);
+    glUniform1i(g_draw.premultiplied_loc, renderer_get_premultiplied_alpha());
+
+    glBindVertexArray(g_draw.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, g_draw.vbo);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)g_draw.vertex_count * UI_VERTEX_SIZE * sizeof(float),
+                    g_draw.vertices);
+
+    for (int i = 0; i < g_draw.command_count; i++) {
+        const UiDrawCommand* cmd = &g_draw.commands[i];
+        if (cmd->count == 0) continue;
+        for (int t = 0; t < cmd->texture_count; t++) {
+            glActiveTexture(GL_TEXTURE0 + t);
+            glBindTexture(GL_TEXTURE_2D, cmd->textures[t]);
+        }
+        glDrawArrays(GL_TRIANGLES, cmd->first, cmd->count);
+        g_draw.stats.draw_calls++;
+    }
+    glActiveTexture(GL_TEXTURE0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    glUseProgram(0);
+
+    g_draw.stats.vertices += g_draw.vertex_count;
+    g_draw.vertex_count = 0;
+    g_draw.command_count = 0;
+}
+
+void ui_flush_if_uses(GLuint texture_id) {
+    for (int i = 0; i < g_draw.command_count; i++) {
+        const UiDrawCommand* cmd = &g_draw.commands[i];
+        for (int t = 0; t < cmd->texture_count; t++) {
+            if (cmd->textures[t] == texture_id) {
+                ui_flush();
+                return;
+            }
+        }
+    }
+}
+
+void ui_get_stats(UiStats* out) {
+    *out = g_draw.stats;
+}
+
+static UiDrawCommand* start_command(void) {
+    if (g_draw.command_count == UI_MAX_COMMANDS) ui_flush();
+    UiDrawCommand* cmd = &g_draw.commands[g_draw.command_count++];
+    cmd->first = g_draw.vertex_count;
+    cmd->count = 0;
+    cmd->texture_count = 0;
+    return cmd;
+}
+
+// Make room for `count` vertices, keeping painter's order with the other
+// renderers
+static void reserve_vertices(int count) {
+    renderer_switch_batch(BATCH_UI);
+    if (g_draw.vertex_count + count > UI_MAX_VERTICES) ui_flush();
+    if (g_draw.command_count == 0) start_command();
+}
+
+// Texture unit of `texture` in the current command, starting a new command
+// when all units are taken
+static int texture_slot(GLuint texture) {
+    UiDrawCommand* cmd = &g_draw.commands[g_draw.command_count - 1];
+    for (int t = 0; t < cmd->texture_count; t++) {
+        if (cmd->textures[t] == texture) return t;
+    }
+    if (cmd->texture_count == UI_TEXTURE_SLOTS) cmd = start_command();
+    cmd->textures[cmd->texture_count] = texture;
+    return cmd->texture_count++;
+}
+
+static void push_vertex(float x, float y, float u, float v, Color c, float slot) {
+    float* out = &g_draw.vertices[g_draw.vertex_count * UI_VERTEX_SIZE];
+    out[0] = x;
+    out[1] = y;
+    out[2] = u;
+    out[3] = v;
+    out[4] = c.r;
+    out[5] = c.g;
+    out[6] = c.b;
+    out[7] = c.a;
+    out[8] = slot;
+    g_draw.vertex_count++;
+    g_draw.commands[g_draw.command_count - 1].count++;
+}
+
+static void push_quad(float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1,
+                      Color c, float slot) {
+    if (g_clip.enabled) {
+        if (x0 >= g_clip.x1 || x1 <= g_clip.x0 || y0 >= g_clip.y1 || y1 <= g_clip.y0) return;
+        // Cut to the clip rectangle, moving the texture coordinates along
+        if (x0 < g_clip.x0) { u0 += (u1 - u0) * (g_clip.x0 - x0) / (x1 - x0); x0 = g_clip.x0; }
+        if (x1 > g_clip.x1) { u1 -= (u1 - u0) * (x1 - g_clip.x1) / (x1 - x0); x1 = g_clip.x1; }
+        if (y0 < g_clip.y0) { v0 += (v1 - v0) * (g_clip.y0 - y0) / (y1 - y0); y0 = g_clip.y0; }
+        if (y1 > g_clip.y1) { v1 -= (v1 - v0) * (y1 - g_clip.y1) / (y1 - y0); y1 = g_clip.y1; }
+    }
+    push_vertex(x0, y0, u0, v0, c, slot);
+    push_vertex(x1, y0, u1, v0, c, slot);
+    push_vertex(x1, y1, u1, v1, c, slot);
+    push_vertex(x0, y0, u0, v0, c, slot);
+    push_vertex(x1, y1, u1, v1, c, slot);
+    push_vertex(x0, y1, u0, v1, c, slot);
+}
+
+// Solid rectangle on whole pixels, like render_rect_filled
+static void push_rect(float x, float y, float w, float h, Color c) {
+    float x0 = (float)(int)x, y0 = (float)(int)y;
+    float x1 = x0 + (float)(int)w, y1 = y0 + (float)(int)h;
+    if (x1 <= x0 || y1 <= y0) return;
+    reserve_vertices(6);
+    push_quad(x0, y0, x1, y1, 0.0f, 0.0f, 0.0f, 0.0f, c, -1.0f);
+}
+
+// One-pixel border inside the rectangle
+static void push_rect_outline(float x, float y, float w, float h, Color c) {
+    float x0 = (float)(int)x, y0 = (float)(int)y;
+    float iw = (float)(int)w, ih = (float)(int)h;
+    push_rect(x0, y0, iw, 1, c);
+    push_rect(x0, y0 + ih - 1, iw, 1, c);
+    push_rect(x0, y0 + 1, 1, ih - 2, c);
+    push_rect(x0 + iw - 1, y0 + 1, 1, ih - 2, c);
+}
+
+static int outside_clip(float x0, float y0, float x1, float y1) {
+    return g_clip.enabled &&
+           (x0 >= g_clip.x1 || x1 <= g_clip.x0 || y0 >= g_clip.y1 || y1 <= g_clip.y0);
+}
+
+// Narrow the clip rectangle to (x, y, w, h) on whole pixels; returns the
+// previous one for restore_clip
+static UiClip push_clip(float x, float y, float w, float h) {
+    UiClip saved = g_clip;
+    float x0 = (float)(int)x, y0 = (float)(int)y;
+    float x1 = x0 + (float)(int)w, y1 = y0 + (float)(int)h;
+    if (g_clip.enabled) {
+        x0 = fmaxf(x0, g_clip.x0);
+        y0 = fmaxf(y0, g_clip.y0);
+        x1 = fminf(x1, g_clip.x1);
+        y1 = fminf(y1, g_clip.y1);
+    }
+    g_clip = (UiClip){1, x0, y0, fmaxf(x0, x1), fmaxf(y0, y1)};
+    return saved;
+}
+
+static void restore_clip(UiClip saved) {
+    g_clip = saved;
+}
+
+static void apply_scissor(void) {
+    if (g_scissor.enabled) {
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(g_scissor.box[0], g_scissor.box[1], g_scissor.box[2], g_scissor.box[3]);
+    } else {
+        glDisable(GL_SCISSOR_TEST);
+    }
+}
+
+// Clip whatever any renderer draws until pop_scissor to the clip rectangle.
+// Queued geometry is flushed first (it must not be cut), and again on pop.
+static UiScissor push_scissor(void) {
+    UiScissor saved = g_scissor;
+    renderer_switch_batch(BATCH_NONE);
+    if (!g_clip.enabled) return saved;
+
+    float m[16];
+    GLint viewport[4];
+    current_projection(m);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    // Window-pixel bounds of the clip corners
+    float px0 = 1e30f, py0 = 1e30f, px1 = -1e30f, py1 = -1e30f;
+    const float xs[2] = {g_clip.x0, g_clip.x1}, ys[2] = {g_clip.y0, g_clip.y1};
+    for (int i = 0; i < 4; i++) {
+        float cx = xs[i & 1], cy = ys[i >> 1];
+        float px = viewport[0] + (m[0] * cx + m[4] * cy + m[12] + 1.0f) * 0.5f * viewport[2];
+        float py = viewport[1] + (m[1] * cx + m[5] * cy + m[13] + 1.0f) * 0.5f * viewport[3];
+        px0 = fminf(px0, px); px1 = fmaxf(px1, px);
+        py0 = fminf(py0, py); py1 = fmaxf(py1, py);
+    }
+    GLint x0 = (GLint)lroundf(px0), y0 = (GLint)lroundf(py0);
+    g_scissor.enabled = 1;
+    g_scissor.box[0] = x0;
+    g_scissor.box[1] = y0;
+    g_scissor.box[2] = (GLint)lroundf(px1) - x0;
+    g_scissor.box[3] = (GLint)lroundf(py1) - y0;
+    apply_scissor();
+    return saved;
+}
+
+static void pop_scissor(UiScissor saved) {
+    renderer_switch_batch(BATCH_NONE);
+    g_scissor = saved;
+    apply_scissor();
+}
+
+static int has_sdf_effects(const Font* font) {
+    const TextEffects* fx = &font->effects;
+    return font->sdf && (fx->outline > 0.0f || fx->glow > 0.0f || fx->shadow_color.a > 0.0f);
+}
+
+// Glyph quads of a string laid out like render_text
+static void push_text(Font* font, const char* text, float x, float y, Color c) {
+    const TextLayout* layout = text_layout_get(font, text, NULL);
+    if (!layout || layout->glyph_count == 0) return;
+
+    // Outlines, glows and shadows need the text renderer's SDF shader; text
+    // that crosses the clip edge is cut with the scissor instead
+    if (has_sdf_effects(font)) {
+        int fits = !g_clip.enabled ||
+                   (x >= g_clip.x0 && y >= g_clip.y0 &&
+                    x + layout->width <= g_clip.x1 && y + layout->height <= g_clip.y1);
+        if (fits) {
+            render_text(font, text, x, y, c);
+        } else if (!outside_clip(x, y, x + layout->width, y + layout->height)) {
+            UiScissor saved = push_scissor();
+            render_text(font, text, x, y, c);
+            pop_scissor(saved);
+        }
+        return;
+    }
+
+    FontStrike* strike = font_get_strike(font, layout->options.size);
+    if (!strike) return;
+    float k = layout->options.size / strike->size;  // 1 except for scaled strikes
+    float sdf = strike->sdf ? (float)UI_TEXTURE_SLOTS : 0.0f;
+
+    for (int i = 0; i < layout->glyph_count; i++) {
+        const TextLayoutGlyph* placed = &layout->glyphs[i];
+        const Glyph* glyph = font_strike_get_glyph(strike, placed->codepoint);
+        if (!glyph || glyph->page < 0) continue;
+
+        float gx = x + placed->x + glyph->offset_x * k;
+        float gy = y + placed->y + glyph->offset_y * k;
+        float gw = glyph->width * k, gh = glyph->height * k;
+        if (outside_clip(gx, gy, gx + gw, gy + gh)) continue;
+
+        FontAtlasPage* page = &strike->pages[glyph->page];
+        page->last_used = strike->last_used;
+        reserve_vertices(6);
+        float slot = (float)texture_slot(page->texture_id) + sdf;
+        push_quad(gx, gy, gx + gw, gy + gh, glyph->u0, glyph->v0, glyph->u1, glyph->v1, c, slot);
+    }
+}
+
 // ---------------------------------------------------------------------------
 // Public API
 // ---------------------------------------------------------------------------
@@ -71,12 +541,23 @@ void ui_init(void) {
     g_mouse_down = 0;
     g_mouse_pressed = 0;
     g_last_mouse_down = 0;
+    g_focus_id = 0;
+    g_time = glfwGetTime();
+    memset(g_nav_held, 0, sizeof(g_nav_held));
     g_initialized = 1;
 }
 
 void ui_shutdown(void) {
     g_ui_font = NULL;
     g_initialized = 0;
+    ui_state_clear();
+
+    if (g_draw.initialized) {
+        glDeleteVertexArrays(1, &g_draw.vao);
+        glDeleteBuffers(1, &g_draw.vbo);
+        glDeleteProgram(g_draw.program);
+    }
+    memset(&g_draw, 0, sizeof(g_draw));
 }
 
 void ui_set_font(Font* font) {
@@ -86,57 +567,83 @@ void ui_set_font(Font* font) {
 void ui_begin_frame(void) {
     if (!g_initialized) ui_init();
 
+    double now = glfwGetTime();
+    g_dt = (float)clampf((float)(now - g_time), 0.0f, 0.1f);
+    g_time = now;
+
     Window* win = pudim_get_active_window();
     if (win && win->handle) {
         glfwGetCursorPos(win->handle, &g_mouse_x, &g_mouse_y);
         int btn = glfwGetMouseButton(win->handle, GLFW_MOUSE_BUTTON_LEFT);
         g_mouse_down = (btn == GLFW_PRESS);
+
+        double wheel_x, wheel_y;
+        window_take_scroll(win, &wheel_x, &wheel_y);
+        g_wheel = (float)wheel_y;
     } else {
         g_mouse_x = 0;
         g_mouse_y = 0;
         g_mouse_down = 0;
+        g_wheel = 0.0f;
+    }
+
+    for (int k = 0; k < NAV_KEY_COUNT; k++) {
+        int down = win && win->handle && glfwGetKey(win->handle, g_nav_glfw_keys[k]) == GLFW_PRESS;
+        g_nav_fired[k] = 0;
+        if (!down) {
+            g_nav_held[k] = 0;
+        } else if (!g_nav_held[k]) {
+            g_nav_held[k] = 1;
+            g_nav_fired[k] = 1;
+            g_nav_repeat_at[k] = now + UI_KEY_REPEAT_DELAY;
+        } else if (now >= g_nav_repeat_at[k]) {
+            g_nav_fired[k] = 1;
+            g_nav_repeat_at[k] = fmax(g_nav_repeat_at[k] + UI_KEY_REPEAT_RATE, now);
+        }
     }
 
     g_mouse_pressed = g_mouse_down && !g_last_mouse_down;
     g_hot_id = 0;
+    g_focus_claimed = 0;
+    // A Lua error inside a list callback may have skipped the restores
+    g_clip.enabled = 0;
+    if (g_scissor.enabled) {
+        g_scissor.enabled = 0;
+        glDisable(GL_SCISSOR_TEST);
+    }
+    memset(&g_draw.stats, 0, sizeof(g_draw.stats));
+    ui_state_begin_frame();
 }
 
 void ui_end_frame(void) {
     if (!g_mouse_down) {
         g_active_id = 0;
     }
+    // Clicking outside every list drops the keyboard focus
+    if (g_mouse_pressed && !g_focus_claimed) {
+        g_focus_id = 0;
+    }
     g_last_mouse_down = g_mouse_down;
+    ui_state_end_frame();
 
-    // Flush all pending draws so the UI layer is fully committed
-    renderer_flush();
-    text_renderer_flush();
+    // Draw the queued widgets so the UI layer is fully committed
+    renderer_switch_batch(BATCH_NONE);
 }
 
 // pudim.ui.label(text, x, y, r, g, b, a)
 void ui_label(const char* text, float x, float y, float r, float g, float b, float a) {
-    if (!g_ui_font) return;
-
-    // Flush primitives first so they sit behind the text
-    renderer_flush();
-
-    Color c = {r, g, b, a};
-    render_text(g_ui_font, text, x, y, c);
-
-    // Flush text immediately so it respects draw order with later primitives
-    text_renderer_flush();
+    if (!g_ui_font || !text) return;
+    push_text(g_ui_font, text, x, y, (Color){r, g, b, a});
 }
 
 // pudim.ui.panel(title, x, y, w, h)
 void ui_panel(const char* title, float x, float y, float w, float h) {
     // Background
-    render_rect_filled((int)x, (int)y, (int)w, (int)h,
-                       (Color){0.16f, 0.17f, 0.20f, 1.0f});
+    push_rect(x, y, w, h, (Color){0.16f, 0.17f, 0.20f, 1.0f});
     // Header bar
-    render_rect_filled((int)x, (int)y, (int)w, 30,
-                       (Color){0.10f, 0.11f, 0.14f, 1.0f});
+    push_rect(x, y, w, 30, (Color){0.10f, 0.11f, 0.14f, 1.0f});
     // Border
-    render_rect((int)x, (int)y, (int)w, (int)h,
-                (Color){0.30f, 0.30f, 0.35f, 1.0f});
+    push_rect_outline(x, y, w, h, (Color){0.30f, 0.30f, 0.35f, 1.0f});
 
     if (title) {
         ui_label(title, x + 10, y + 8, 0.8f, 0.8f, 0.8f, 1.0f);
@@ -145,7 +652,7 @@ void ui_panel(const char* title, float x, float y, float w, float h) {
 
 // pudim.ui.button(id, label, x, y, w, h, r, g, b) -> clicked
 int ui_button(const char* id, const char* label, float x, float y, float w, float h, float r, float g, float b) {
-    unsigned int wid = hash_id(id);
+    unsigned int wid = widget_id(id);
     int hover = point_in_rect(g_mouse_x, g_mouse_y, x, y, w, h);
 
     if (hover) {
@@ -167,10 +674,8 @@ int ui_button(const char* id, const char* label, float x, float y, float w, floa
     float cg = clampf(g * mult, 0.0f, 1.0f);
     float cb = clampf(b * mult, 0.0f, 1.0f);
 
-    render_rect_filled((int)x, (int)y, (int)w, (int)h,
-                       (Color){cr, cg, cb, 1.0f});
-    render_rect((int)x, (int)y, (int)w, (int)h,
-                (Color){0.4f, 0.4f, 0.4f, 1.0f});
+    push_rect(x, y, w, h, (Color){cr, cg, cb, 1.0f});
+    push_rect_outline(x, y, w, h, (Color){0.4f, 0.4f, 0.4f, 1.0f});
 
     if (g_ui_font && label) {
         float tw = 0, th = 0;
@@ -189,7 +694,7 @@ int ui_button(const char* id, const char* label, float x, float y, float w, floa
 
 // pudim.ui.slider(id, label, x, y, w, h, value, min, max) -> value
 float ui_slider(const char* id, const char* label, float x, float y, float w, float h, float value, float min_val, float max_val) {
-    unsigned int wid = hash_id(id);
+    unsigned int wid = widget_id(id);
     int hover = point_in_rect(g_mouse_x, g_mouse_y, x, y, w, h);
 
     if (hover) {
@@ -207,18 +712,15 @@ float ui_slider(const char* id, const char* label, float x, float y, float w, fl
     }
 
     // Background
-    render_rect_filled((int)x, (int)y, (int)w, (int)h,
-                       (Color){0.10f, 0.10f, 0.10f, 1.0f});
+    push_rect(x, y, w, h, (Color){0.10f, 0.10f, 0.10f, 1.0f});
 
     // Fill bar
     float fill_w = ((value - min_val) / (max_val - min_val)) * w;
     float bar_c = (g_active_id == wid) ? 0.8f : 0.5f;
-    render_rect_filled((int)x, (int)y, (int)fill_w, (int)h,
-                       (Color){bar_c, bar_c, 0.9f, 1.0f});
+    push_rect(x, y, fill_w, h, (Color){bar_c, bar_c, 0.9f, 1.0f});
 
     // Border
-    render_rect((int)x, (int)y, (int)w, (int)h,
-                (Color){0.3f, 0.3f, 0.3f, 1.0f});
+    push_rect_outline(x, y, w, h, (Color){0.3f, 0.3f, 0.3f, 1.0f});
 
     // Label with current value
     if (g_ui_font && label) {
@@ -231,3 +733,418 @@ float ui_slider(const char* id, const char* label, float x, float y, float w, fl
 
     return value;
 }
+
+// ---------------------------------------------------------------------------
+// Lists and tables
+// ---------------------------------------------------------------------------
+
+#define UI_SCROLL_FRICTION 10.0f    // wheel velocity decay rate, per second
+#define UI_WHEEL_ROWS 3.0f          // rows travelled per wheel notch
+#define UI_SCROLLBAR_WIDTH 8.0f
+#define UI_MIN_THUMB 16.0f
+#define UI_CELL_PADDING 6.0f
+
+// Widget state slots of a list
+enum { LIST_SCROLL, LIST_VELOCITY, LIST_SELECTED, LIST_GRAB };
+
+#define UI_MEASURE_MARGIN 8         // rows measured past each edge of the view
+
+// Row heights of height_fn lists, measured lazily: only rows that come into
+// view (plus a margin) are measured, the others count as `estimate` tall, so
+// showing a 100 000 row list costs a screenful of callbacks. A Fenwick tree
+// of (height - estimate) over the measured rows gives row tops and the row at
+// an offset in O(log n).
+typedef struct {
+    unsigned int revision;
+    int capacity;
+    float estimate;
+    float* heights;         // measured height of each row, < 0 = not measured yet
+    double* deltas;         // Fenwick tree (1-based) of height - estimate
+} UiRowCache;
+
+typedef struct {
+    UiRowCache* cache;      // NULL = every row is row_height tall
+    float row_height;       // or the estimate for rows not measured yet
+    int row_count;
+} RowGeometry;
+
+static void free_row_cache(void* data) {
+    UiRowCache* cache = (UiRowCache*)data;
+    if (!cache) return;
+    free(cache->heights);
+    free(cache->deltas);
+    free(cache);
+}
+
+// Rebuild the tree from the measured heights in O(n)
+static void rebuild_row_deltas(UiRowCache* cache) {
+    memset(cache->deltas, 0, (size_t)(cache->capacity + 1) * sizeof(double));
+    for (int i = 1; i <= cache->capacity; i++) {
+        if (cache->heights[i - 1] >= 0.0f) cache->deltas[i] += cache->heights[i - 1] - cache->estimate;
+        int parent = i + (i & -i);
+        if (parent <= cache->capacity) cache->deltas[parent] += cache->deltas[i];
+    }
+}
+
+static void forget_rows(UiRowCache* cache) {
+    for (int i = 0; i < cache->capacity; i++) cache->heights[i] = -1.0f;
+    if (cache->deltas) memset(cache->deltas, 0, (size_t)(cache->capacity + 1) * sizeof(double));
+}
+
+// Size the cache for `row_count` rows; returns 0 when out of memory
+static int prepare_rows(UiRowCache* cache, const UiListDesc* desc, int row_count, float estimate) {
+    if (row_count > cache->capacity) {
+        int capacity = cache->capacity ? cache->capacity : 256;
+        while (capacity < row_count) capacity *= 2;
+        float* heights = (float*)realloc(cache->heights, (size_t)capacity * sizeof(float));
+        if (!heights) return 0;
+        cache->heights = heights;
+        double* deltas = (double*)realloc(cache->deltas, (size_t)(capacity + 1) * sizeof(double));
+        if (!deltas) return 0;
+        cache->deltas = deltas;
+        for (int i = cache->capacity; i < capacity; i++) cache->heights[i] = -1.0f;
+        cache->capacity = capacity;
+        cache->estimate = estimate;
+        rebuild_row_deltas(cache);  // the tree's shape depends on its size
+    }
+    if (cache->revision != desc->revision) {
+        cache->revision = desc->revision;
+        forget_rows(cache);
+    }
+    if (cache->estimate != estimate) {
+        cache->estimate = estimate;
+        rebuild_row_deltas(cache);
+    }
+    return 1;
+}
+
+static float measure_row(UiRowCache* cache, const UiListDesc* desc, int row) {
+    if (cache->heights[row] < 0.0f) {
+        float height = desc->height_fn(row, desc->user_data);
+        height = height > 0.0f ? height : 0.0f;
+        cache->heights[row] = height;
+        for (int i = row + 1; i <= cache->capacity; i += i & -i) {
+            cache->deltas[i] += height - cache->estimate;
+        }
+    }
+    return cache->heights[row];
+}
+
+static double row_top(const RowGeometry* g, int row) {
+    double top = (double)row * g->row_height;
+    if (g->cache) {
+        for (int i = row; i > 0; i -= i & -i) top += g->cache->deltas[i];
+    }
+    return top;
+}
+
+// Row containing offset `y` from the top of the first row (clamped)
+static int row_at(const RowGeometry* g, double y) {
+    if (g->row_count == 0 || y <= 0.0) return 0;
+    if (!g->cache) {
+        int row = (int)(y / g->row_height);
+        return row < g->row_count ? row : g->row_count - 1;
+    }
+    // Walk down the tree for the most rows whose total height is <= y
+    int rows = 0;
+    double delta = 0.0;
+    for (int step = g->cache->capacity; step > 0; step >>= 1) {
+        int next = rows + step;
+        if (next <= g->row_count && (double)next * g->row_height + delta + g->cache->deltas[next] <= y) {
+            rows = next;
+            delta += g->cache->deltas[next];
+        }
+    }
+    return rows < g->row_count ? rows : g->row_count - 1;
+}
+
+// Measure the rows in view plus a margin. The first visible row keeps its
+// place on screen when rows above it turn out taller or shorter than the
+// estimate; returns the scroll offset that does so.
+static float measure_view(const RowGeometry* g, const UiListDesc* desc, float scroll, float view_h) {
+    if (!g->cache || g->row_count == 0) return scroll;
+    int anchor = row_at(g, scroll);
+    double within = scroll - row_top(g, anchor);
+
+    int row = anchor > UI_MEASURE_MARGIN ? anchor - UI_MEASURE_MARGIN : 0;
+    for (; row < anchor; row++) measure_row(g->cache, desc, row);
+    double y = -within;
+    for (int extra = 0; row < g->row_count && extra < UI_MEASURE_MARGIN; row++) {
+        if (y >= view_h) extra++;
+        y += measure_row(g->cache, desc, row);
+    }
+    return (float)(row_top(g, anchor) + within);
+}
+
+// Measure up to a view's height of rows above `row`, so bringing it into
+// view from above places it exactly at the bottom edge
+static void measure_above(const RowGeometry* g, const UiListDesc* desc, int row, float view_h) {
+    if (!g->cache) return;
+    for (double y = 0.0; row >= 0 && y < view_h; row--) y += measure_row(g->cache, desc, row);
+}
+
+static float thumb_height(float view_h, double total, float max_scroll) {
+    if (max_scroll <= 0.0f) return view_h;
+    return fminf(fmaxf(view_h * view_h / (float)total, UI_MIN_THUMB), view_h);
+}
+
+static float default_row_height(void) {
+    return g_ui_font ? ceilf(g_ui_font->line_height) + 6.0f : 20.0f;
+}
+
+static void draw_cell_text(const char* text, float x, float y, float w, float h, Color c) {
+    if (!g_ui_font || !text || !*text) return;
+    UiClip saved = push_clip(x, y, w, h);
+    float ty = (float)(int)(y + (h - g_ui_font->line_height) / 2.0f);
+    push_text(g_ui_font, text, x + UI_CELL_PADDING, ty, c);
+    restore_clip(saved);
+}
+
+// Shared by ui_list (no header, one column) and ui_table
+static int list_widget(const char* id, float x, float y, float w, float h, const UiColumn* columns,
+                       int column_count, const UiListDesc* desc, UiListResult* out) {
+    UiState* state = ui_state_get(id, NULL);
+    if (!state) return -1;
+
+    // Copy the state out: callbacks may look up other widgets, moving slots
+    unsigned int wid = state->id;
+    float scroll = state->values[LIST_SCROLL];
+    float velocity = state->values[LIST_VELOCITY];
+    int selected = (int)state->values[LIST_SELECTED] - 1;
+    float grab = state->values[LIST_GRAB];
+
+    int row_count = desc->row_count > 0 ? desc->row_count : 0;
+    float base_height = desc->row_height > 0.0f ? desc->row_height : default_row_height();
+    RowGeometry rows = {NULL, base_height, row_count};
+    if (desc->height_fn) {
+        if (!state->data) {
+            state->data = calloc(1, sizeof(UiRowCache));
+            if (state->data) state->free_data = free_row_cache;
+        }
+        UiRowCache* cache = (UiRowCache*)state->data;
+        if (cache && prepare_rows(cache, desc, row_count, base_height)) rows.cache = cache;
+    }
+
+    // View below the header, with a scrollbar when the rows overflow it
+    float header_h = columns ? base_height : 0.0f;
+    float view_y = y + header_h;
+    float view_h = fmaxf(h - header_h, 0.0f);
+    scroll = measure_view(&rows, desc, scroll, view_h);
+    double total = row_top(&rows, row_count);
+    float max_scroll = (float)fmax(total - view_h, 0.0);
+    float bar_w = max_scroll > 0.0f ? UI_SCROLLBAR_WIDTH : 0.0f;
+    float content_w = fmaxf(w - bar_w, 0.0f);
+    float avg_height = row_count > 0 ? (float)(total / row_count) : base_height;
+
+    float thumb_h = thumb_height(view_h, total, max_scroll);
+    float thumb_track = view_h - thumb_h;
+    float thumb_y = view_y + (max_scroll > 0.0f ? scroll / max_scroll * thumb_track : 0.0f);
+
+    // --- Input ---
+    int hover = point_in_rect(g_mouse_x, g_mouse_y, x, view_y, w, view_h);
+    int over_bar = hover && bar_w > 0.0f && g_mouse_x >= x + content_w;
+    int clicked = -1;
+
+    if (point_in_rect(g_mouse_x, g_mouse_y, x, y, w, h)) {
+        g_hot_id = wid;
+        if (g_mouse_pressed) {
+            g_focus_id = wid;
+            g_focus_claimed = 1;
+        }
+    }
+
+    if (hover && g_wheel != 0.0f) {
+        // Exponential decay travels velocity / friction in total
+        velocity -= g_wheel * UI_WHEEL_ROWS * avg_height * UI_SCROLL_FRICTION;
+        g_wheel = 0.0f;
+    }
+
+    if (g_mouse_pressed && over_bar) {
+        if (g_mouse_y >= thumb_y && g_mouse_y <= thumb_y + thumb_h) {
+            g_active_id = wid;
+            grab = (float)g_mouse_y - thumb_y;
+        } else {
+            scroll += g_mouse_y < thumb_y ? -view_h : view_h;
+        }
+        velocity = 0.0f;
+    } else if (g_mouse_pressed && hover && row_count > 0) {
+        double offset = scroll + (g_mouse_y - view_y);
+        if (offset < total) {
+            selected = clicked = row_at(&rows, offset);
+        }
+    }
+
+    if (g_active_id == wid && g_mouse_down && thumb_track > 0.0f) {
+        scroll = ((float)g_mouse_y - grab - view_y) / thumb_track * max_scroll;
+        velocity = 0.0f;
+    }
+
+    if (g_focus_id == wid && row_count > 0) {
+        int page = (int)(view_h / avg_height);
+        if (page < 1) page = 1;
+        int target = selected;
+        if (g_nav_fired[NAV_UP])        target = selected < 0 ? 0 : selected - 1;
+        if (g_nav_fired[NAV_DOWN])      target = selected + 1;
+        if (g_nav_fired[NAV_PAGE_UP])   target = (selected < 0 ? 0 : selected) - page;
+        if (g_nav_fired[NAV_PAGE_DOWN]) target = selected + page;
+        if (g_nav_fired[NAV_HOME])      target = 0;
+        if (g_nav_fired[NAV_END])       target = row_count - 1;
+        if (target != selected) {
+            selected = target < 0 ? 0 : (target >= row_count ? row_count - 1 : target);
+            // Bring the selection into view
+            measure_above(&rows, desc, selected, view_h);
+            float top = (float)row_top(&rows, selected);
+            float bottom = (float)row_top(&rows, selected + 1);
+            if (top < scroll) scroll = top;
+            else if (bottom > scroll + view_h) scroll = bottom - view_h;
+            velocity = 0.0f;
+        }
+    }
+
+    // Integrate the decaying velocity exactly, so travel is frame-rate independent
+    float decay = expf(-UI_SCROLL_FRICTION * g_dt);
+    scroll += velocity * (1.0f - decay) / UI_SCROLL_FRICTION;
+    velocity *= decay;
+    if (fabsf(velocity) < 1.0f) velocity = 0.0f;
+    if (rows.cache) {
+        // Measure the rows scrolled into view; the estimate may have been off
+        scroll = measure_view(&rows, desc, scroll, view_h);
+        total = row_top(&rows, row_count);
+        max_scroll = (float)fmax(total - view_h, 0.0);
+        thumb_h = thumb_height(view_h, total, max_scroll);
+        thumb_track = view_h - thumb_h;
+    }
+    if (scroll <= 0.0f || scroll >= max_scroll) {
+        scroll = clampf(scroll, 0.0f, max_scroll);
+        velocity = 0.0f;
+    }
+    if (selected >= row_count) selected = row_count - 1;
+
+    // --- Columns ---
+    UiColumn single = {NULL, 0.0f};
+    if (!columns) {
+        columns = &single;
+        column_count = 1;
+    }
+    float fixed_w = 0.0f;
+    int flexible = 0;
+    for (int c = 0; c < column_count; c++) {
+        if (columns[c].width > 0.0f) fixed_w += columns[c].width;
+        else flexible++;
+    }
+    float flex_w = flexible ? fmaxf((content_w - fixed_w) / (float)flexible, 0.0f) : 0.0f;
+
+    // --- Drawing ---
+    push_rect(x, y, w, h, (Color){0.10f, 0.10f, 0.12f, 1.0f});
+
+    if (header_h > 0.0f) {
+        push_rect(x, y, w, header_h, (Color){0.10f, 0.11f, 0.14f, 1.0f});
+        float cx = x;
+        for (int c = 0; c < column_count; c++) {
+            float cw = columns[c].width > 0.0f ? columns[c].width : flex_w;
+            draw_cell_text(columns[c].title, cx, y, cw, header_h, (Color){0.8f, 0.8f, 0.8f, 1.0f});
+            cx += cw;
+        }
+    }
+
+    // Whole pixels keep glyphs sharp while the list glides
+    float draw_scroll = floorf(scroll + 0.5f);
+    int first = row_at(&rows, draw_scroll);
+    int last = first;
+    double hover_offset = draw_scroll + (g_mouse_y - view_y);
+    int hovered = (hover && !over_bar && g_active_id == 0 && hover_offset < total) ? row_at(&rows, hover_offset) : -1;
+
+    UiClip saved = push_clip(x, view_y, content_w, view_h);
+    // Draw callbacks may use any renderer: scissor the rows once rather than
+    // per cell, so their batches carry across cells (UI quads still clip per cell)
+    UiScissor scissor = g_scissor;
+    if (desc->draw_fn) scissor = push_scissor();
+    for (; last < row_count; last++) {
+        double top = row_top(&rows, last);
+        if (top - draw_scroll >= view_h) break;
+        float ry = view_y + (float)(top - draw_scroll);
+        float rh = (float)(row_top(&rows, last + 1) - top);
+
+        if (last == selected) {
+            push_rect(x, ry, content_w, rh, (Color){0.30f, 0.40f, 0.60f, 1.0f});
+        } else if (last == hovered) {
+            push_rect(x, ry, content_w, rh, (Color){0.18f, 0.19f, 0.23f, 1.0f});
+        }
+
+        float cx = x;
+        for (int c = 0; c < column_count; c++) {
+            float cw = columns[c].width > 0.0f ? columns[c].width : flex_w;
+            if (desc->draw_fn) {
+                UiClip cell = push_clip(cx, ry, cw, rh);
+                desc->draw_fn(last, c, cx, ry, cw, rh, last == selected, desc->user_data);
+                restore_clip(cell);
+            } else {
+                const char* text = NULL;
+                if (desc->text_fn) text = desc->text_fn(last, c, desc->user_data);
+                else if (desc->items) text = desc->items[(size_t)last * column_count + c];
+                draw_cell_text(text, cx, ry, cw, rh, (Color){1.0f, 1.0f, 1.0f, 1.0f});
+            }
+            cx += cw;
+        }
+        g_draw.stats.rows++;
+    }
+    if (desc->draw_fn) pop_scissor(scissor);
+    restore_clip(saved);
+
+    if (header_h > 0.0f) {
+        // Column separators over the rows, and the header's bottom edge
+        saved = push_clip(x, y, content_w, h);
+        float cx = x;
+        for (int c = 0; c + 1 < column_count; c++) {
+            cx += columns[c].width > 0.0f ? columns[c].width : flex_w;
+            push_rect(cx - 1, y, 1, h, (Color){0.20f, 0.20f, 0.24f, 1.0f});
+        }
+        restore_clip(saved);
+        push_rect(x, view_y - 1, w, 1, (Color){0.30f, 0.30f, 0.35f, 1.0f});
+    }
+
+    if (bar_w > 0.0f) {
+        float bar_x = x + content_w;
+        float thumb_c = (g_active_id == wid) ? 0.8f : 0.5f;
+        float shown_y = view_y + (max_scroll > 0.0f ? scroll / max_scroll * thumb_track : 0.0f);
+        push_rect(bar_x, view_y, bar_w, view_h, (Color){0.14f, 0.14f, 0.16f, 1.0f});
+        push_rect(bar_x + 1, shown_y, bar_w - 2, thumb_h, (Color){thumb_c, thumb_c, 0.9f, 1.0f});
+    }
+
+    push_rect_outline(x, y, w, h, (Color){0.30f, 0.30f, 0.35f, 1.0f});
+
+    // Store the state back (the slot may have moved during callbacks)
+    state = ui_state_find(id);
+    if (state) {
+        state->values[LIST_SCROLL] = scroll;
+        state->values[LIST_VELOCITY] = velocity;
+        state->values[LIST_SELECTED] = (float)(selected + 1);
+        state->values[LIST_GRAB] = grab;
+    }
+
+    if (out) {
+        out->selected = selected;
+        out->clicked = clicked;
+        out->first = first;
+        out->last = last;
+        out->scroll = scroll;
+    }
+    return selected;
+}
+
+void ui_list_remeasure(const char* id) {
+    UiState* state = ui_state_find(id);
+    if (state && state->data) forget_rows((UiRowCache*)state->data);
+}
+
+// pudim.ui.list(id, x, y, w, h, rows, options) -> selected
+int ui_list(const char* id, float x, float y, float w, float h, const UiListDesc* desc, UiListResult* out) {
+    return list_widget(id, x, y, w, h, NULL, 1, desc, out);
+}
+
+// pudim.ui.table(id, x, y, w, h, columns, rows, options) -> selected
+int ui_table(const char* id, float x, float y, float w, float h, const UiColumn* columns, int column_count,
+             const UiListDesc* desc, UiListResult* out) {
+    if (!columns || column_count <= 0) return list_widget(id, x, y, w, h, NULL, 1, desc, out);
+    return list_widget(id, x, y, w, h, columns, column_count, desc, out);
+}
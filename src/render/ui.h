@@ -3,6 +3,52 @@
 
 #include "text.h"
 
+// Widgets queue their shapes and glyphs into one draw list, in submission
+// order, drawn by a single shader that handles solid and glyph fragments. A
+// frame of UI is one draw call per group of four atlas textures (usually
+// one), flushed when another renderer draws, at ui_end_frame, or before an
+// atlas page it samples is resized or cleared.
+
+typedef struct {
+    int draw_calls;         // since ui_begin_frame
+    int vertices;
+    int rows;               // list and table rows drawn
+} UiStats;
+
+// Virtualized lists and tables: only the rows inside the scrolled view are
+// measured, drawn or handed to callbacks, so the cost of a frame does not
+// depend on the row count. Rows and columns are 0-based.
+typedef float (*UiRowHeightFn)(int row, void* user_data);
+typedef const char* (*UiCellTextFn)(int row, int column, void* user_data);
+typedef void (*UiDrawCellFn)(int row, int column, float x, float y, float w, float h, int selected,
+                             void* user_data);
+
+typedef struct {
+    int row_count;
+    float row_height;           // fixed row height (0 = from the UI font)
+    UiRowHeightFn height_fn;    // or per-row heights, measured as rows come into view
+    unsigned int revision;      // change to re-measure rows with height_fn
+
+    // Row contents, first match wins: custom drawing, text from a callback,
+    // or a row-major array of row_count * columns strings
+    UiDrawCellFn draw_fn;
+    UiCellTextFn text_fn;
+    const char* const* items;
+    void* user_data;
+} UiListDesc;
+
+typedef struct {
+    const char* title;
+    float width;                // 0 = share the space left by sized columns
+} UiColumn;
+
+typedef struct {
+    int selected;               // -1 = none
+    int clicked;                // row clicked this frame, -1 = none
+    int first, last;            // visible rows [first, last)
+    float scroll;               // offset of the view from the top, in pixels
+} UiListResult;
+
 // Initialize UI system (called lazily on first begin_frame)
 void ui_init(void);
 
@@ -18,6 +64,14 @@ void ui_begin_frame(void);
 // End the current UI frame — flushes all pending draws
 void ui_end_frame(void);
 
+// Draw the queued widgets (the UI batch of renderer_switch_batch)
+void ui_flush(void);
+
+// Called by the text renderer before an atlas page texture changes
+void ui_flush_if_uses(GLuint texture_id);
+
+void ui_get_stats(UiStats* out);
+
 // Draw a text label at (x, y) with the given color
 void ui_label(const char* text, float x, float y, float r, float g, float b, float a);
 
@@ -30,4 +84,18 @@ int ui_button(const char* id, const char* label, float x, float y, float w, floa
 // Draw an interactive slider. Returns the (possibly updated) value.
 float ui_slider(const char* id, const char* label, float x, float y, float w, float h, float value, float min_val, float max_val);
 
+// Draw a scrolling list of rows. Click a row to select it; the wheel scrolls
+// with momentum, and the arrow, Page Up/Down, Home and End keys move the
+// selection of the list clicked last. Returns the selected row (-1 = none).
+int ui_list(const char* id, float x, float y, float w, float h, const UiListDesc* desc, UiListResult* out);
+
+// Same as ui_list with a header row and `column_count` columns, each cell
+// clipped to its column
+int ui_table(const char* id, float x, float y, float w, float h, const UiColumn* columns, int column_count,
+             const UiListDesc* desc, UiListResult* out);
+
+// Forget the row heights measured for list `id`, so height_fn runs again next
+// frame (e.g. after a callback failed part way through)
+void ui_list_remeasure(const char* id);
+
 #endif // UI_H
@@ -0,0 +1,205 @@
+// UI widget state store — see ui_state.h.
+//
+// Same layout as the glyph cache in text.c: a dense array of slots plus a
+// power-of-two table of slot index + 1 (0 = empty), linear probing, kept at
+// most half full, with backward-shift deletes so no tombstones build up.
+
+#include "ui_state.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define UI_STATE_MIN_TABLE 64
+
+static UiState* states = NULL;
+static int state_count = 0;
+static int state_capacity = 0;
+static int32_t* table = NULL;
+static uint32_t table_mask = 0;
+
+static uint32_t generation = 0;
+static int seen_count = 0;          // distinct slots looked up this frame
+static int last_collected = 0;
+static int collision_count = 0;
+
+uint32_t ui_state_hash(const char* id) {
+    uint32_t hash = 2166136261u;
+    while (*id) {
+        hash ^= (unsigned char)*id++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// FNV-1a leaves the low bits poorly mixed for short ids
+static uint32_t home_of(uint32_t id) {
+    id ^= id >> 16;
+    id *= 0x7FEB352Du;
+    return id ^ (id >> 15);
+}
+
+// Slot holding `id`, or the empty slot where it would be inserted
+static uint32_t find_slot(uint32_t id) {
+    uint32_t i = home_of(id) & table_mask;
+    for (;;) {
+        int32_t e = table[i];
+        if (e == 0 || states[e - 1].id == id) return i;
+        i = (i + 1) & table_mask;
+    }
+}
+
+static int resize_table(uint32_t count) {
+    int32_t* grown = (int32_t*)calloc(count, sizeof(int32_t));
+    if (!grown) return 0;
+
+    free(table);
+    table = grown;
+    table_mask = count - 1;
+    for (int e = 0; e < state_count; e++) {
+        table[find_slot(states[e].id)] = e + 1;
+    }
+    return 1;
+}
+
+// Backward-shift delete, as remove_slot in text.c
+static void remove_slot(uint32_t hole) {
+    uint32_t j = hole;
+    for (;;) {
+        j = (j + 1) & table_mask;
+        int32_t e = table[j];
+        if (e == 0) break;
+
+        uint32_t home = home_of(states[e - 1].id) & table_mask;
+        int stays = (hole <= j) ? (home > hole && home <= j)
+                                : (home > hole || home <= j);
+        if (!stays) {
+            table[hole] = e;
+            hole = j;
+        }
+    }
+    table[hole] = 0;
+}
+
+static void release_state(UiState* state) {
+    if (state->free_data) state->free_data(state->data);
+#ifndef NDEBUG
+    free(state->name);
+#endif
+}
+
+// Drop slot `e` (swap-remove, fixing the moved slot's table entry)
+static void remove_state(int e) {
+    remove_slot(find_slot(states[e].id));
+    release_state(&states[e]);
+
+    int last = state_count - 1;
+    if (e != last) {
+        table[find_slot(states[last].id)] = e + 1;
+        states[e] = states[last];
+    }
+    state_count--;
+}
+
+#ifndef NDEBUG
+static void check_collision(UiState* state, const char* id) {
+    if (!state->name || strcmp(state->name, id) == 0 || state->collided) return;
+    state->collided = 1;
+    collision_count++;
+    fprintf(stderr, "[UI] Widget ids \"%s\" and \"%s\" have the same hash (0x%08x) and share state\n",
+            state->name, id, state->id);
+}
+#endif
+
+// --- Frame ---
+
+void ui_state_begin_frame(void) {
+    generation++;
+    seen_count = 0;
+}
+
+void ui_state_end_frame(void) {
+    last_collected = 0;
+    if (seen_count == state_count) return;  // every widget was drawn
+
+    for (int e = state_count - 1; e >= 0; e--) {
+        if (states[e].generation != generation) {
+            remove_state(e);
+            last_collected++;
+        }
+    }
+}
+
+// --- Lookup ---
+
+UiState* ui_state_get(const char* id, int* created) {
+    if (created) *created = 0;
+
+    if ((uint32_t)(state_count + 1) * 2 > table_mask + 1 || !table) {
+        uint32_t count = table ? (table_mask + 1) * 2 : UI_STATE_MIN_TABLE;
+        if (!resize_table(count)) return NULL;
+    }
+
+    uint32_t hash = ui_state_hash(id);
+    uint32_t slot = find_slot(hash);
+    if (table[slot]) {
+        UiState* state = &states[table[slot] - 1];
+#ifndef NDEBUG
+        check_collision(state, id);
+#endif
+        if (state->generation != generation) {
+            state->generation = generation;
+            seen_count++;
+        }
+        return state;
+    }
+
+    if (state_count == state_capacity) {
+        int capacity = state_capacity ? state_capacity * 2 : UI_STATE_MIN_TABLE / 2;
+        UiState* grown = (UiState*)realloc(states, (size_t)capacity * sizeof(UiState));
+        if (!grown) return NULL;
+        states = grown;
+        state_capacity = capacity;
+    }
+
+    UiState* state = &states[state_count];
+    memset(state, 0, sizeof(*state));
+    state->id = hash;
+    state->generation = generation;
+#ifndef NDEBUG
+    size_t length = strlen(id);
+    state->name = (char*)malloc(length + 1);
+    if (state->name) memcpy(state->name, id, length + 1);
+#endif
+    table[slot] = ++state_count;
+    seen_count++;
+
+    if (created) *created = 1;
+    return state;
+}
+
+UiState* ui_state_find(const char* id) {
+    if (!table) return NULL;
+    int32_t e = table[find_slot(ui_state_hash(id))];
+    return e ? &states[e - 1] : NULL;
+}
+
+void ui_state_clear(void) {
+    for (int e = 0; e < state_count; e++) release_state(&states[e]);
+    free(states);
+    free(table);
+    states = NULL;
+    table = NULL;
+    state_count = 0;
+    state_capacity = 0;
+    table_mask = 0;
+    seen_count = 0;
+    last_collected = 0;
+    collision_count = 0;
+}
+
+void ui_state_get_stats(UiStateStats* out) {
+    out->widgets = state_count;
+    out->capacity = table ? (int)table_mask + 1 : 0;
+    out->collected = last_collected;
+    out->collisions = collision_count;
+}
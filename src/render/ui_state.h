@@ -0,0 +1,58 @@
+#ifndef UI_STATE_H
+#define UI_STATE_H
+
+#include <stdint.h>
+
+// Persistent per-widget state, keyed by the hash of the widget's id string.
+//
+// Slots live in a dense array indexed by an open-addressing hash table. Each
+// slot records the UI frame (generation) it was last looked up in; at the end
+// of a frame, slots of widgets that were not drawn are collected.
+//
+// Two ids with the same hash share a slot. Unless NDEBUG is defined the id
+// string is kept alongside the slot so such collisions are reported.
+
+#define UI_STATE_VALUES 8
+
+typedef struct {
+    uint32_t id;                        // hash of the widget id string
+    uint32_t generation;                // frame the widget was last seen
+    float values[UI_STATE_VALUES];      // owned by the widget (scroll, cursor, animation...)
+    void* data;                         // widget allocation, released with the slot
+    void (*free_data)(void* data);
+#ifndef NDEBUG
+    char* name;                         // id string, to detect hash collisions
+    int collided;                       // already reported
+#endif
+} UiState;
+
+typedef struct {
+    int widgets;            // live slots
+    int capacity;           // hash table size
+    int collected;          // slots freed at the end of the last frame
+    int collisions;         // distinct ids found sharing a hash (debug builds only)
+} UiStateStats;
+
+// FNV-1a hash of a widget id string
+uint32_t ui_state_hash(const char* id);
+
+// Start a new generation; called by ui_begin_frame
+void ui_state_begin_frame(void);
+
+// Collect slots not seen since ui_state_begin_frame; called by ui_end_frame
+void ui_state_end_frame(void);
+
+// Find or create the slot of `id` and mark it seen this frame. New slots start
+// zeroed and set *created (may be NULL). The pointer is valid until the next
+// ui_state_get or the end of the frame. Returns NULL only when out of memory.
+UiState* ui_state_get(const char* id, int* created);
+
+// Look up a slot without creating it or marking it seen (NULL if absent)
+UiState* ui_state_find(const char* id);
+
+// Drop every slot and free the table
+void ui_state_clear(void);
+
+void ui_state_get_stats(UiStateStats* out);
+
+#endif // UI_STATE_H
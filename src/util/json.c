@@ -0,0 +1,389 @@
+#include "json.h"
+#include "../platform/filemap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define JSON_MAX_DEPTH 64
+
+typedef struct {
+    const char* p;
+    const char* start;
+    const char* end;
+    char* err;
+    size_t err_size;
+    int failed;
+} JsonParser;
+
+static void fail(JsonParser* ps, const char* message) {
+    if (ps->failed) return;
+    ps->failed = 1;
+    if (ps->err && ps->err_size > 0) {
+        snprintf(ps->err, ps->err_size, "%s at byte %zu", message, (size_t)(ps->p - ps->start));
+    }
+}
+
+static void skip_ws(JsonParser* ps) {
+    while (ps->p < ps->end && (*ps->p == ' ' || *ps->p == '\t' || *ps->p == '\n' || *ps->p == '\r')) {
+        ps->p++;
+    }
+}
+
+static int match(JsonParser* ps, const char* literal) {
+    size_t len = strlen(literal);
+    if ((size_t)(ps->end - ps->p) < len || memcmp(ps->p, literal, len) != 0) return 0;
+    ps->p += len;
+    return 1;
+}
+
+static void free_children(JsonValue* v) {
+    for (size_t i = 0; i < v->count; i++) {
+        free_children(&v->items[i]);
+        if (v->keys) free(v->keys[i]);
+    }
+    free(v->items);
+    free(v->keys);
+    free(v->string);
+}
+
+// --- Strings ---
+
+static int hex4(JsonParser* ps, unsigned* out) {
+    if (ps->end - ps->p < 4) return 0;
+    unsigned v = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = ps->p[i];
+        v <<= 4;
+        if (c >= '0' && c <= '9') v |= (unsigned)(c - '0');
+        else if (c >= 'a' && c <= 'f') v |= (unsigned)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') v |= (unsigned)(c - 'A' + 10);
+        else return 0;
+    }
+    ps->p += 4;
+    *out = v;
+    return 1;
+}
+
+static size_t put_utf8(char* out, unsigned cp) {
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        return 1;
+    } else if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        return 2;
+    } else if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | (cp >> 18));
+    out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+// Parse a string starting at the opening quote. Escapes never expand, so the
+// raw length bounds the decoded size.
+static char* parse_string(JsonParser* ps) {
+    ps->p++;  // opening quote
+    const char* q = ps->p;
+    while (q < ps->end && *q != '"') {
+        if (*q == '\\') q++;
+        q++;
+    }
+    if (q >= ps->end) {
+        fail(ps, "Unterminated string");
+        return NULL;
+    }
+
+    char* out = (char*)malloc((size_t)(q - ps->p) + 1);
+    if (!out) {
+        fail(ps, "Out of memory");
+        return NULL;
+    }
+
+    size_t n = 0;
+    while (*ps->p != '"') {
+        unsigned char c = (unsigned char)*ps->p++;
+        if (c < 0x20) {
+            fail(ps, "Control character in string");
+            free(out);
+            return NULL;
+        }
+        if (c != '\\') {
+            out[n++] = (char)c;
+            continue;
+        }
+        char e = *ps->p++;
+        switch (e) {
+            case '"': out[n++] = '"'; break;
+            case '\\': out[n++] = '\\'; break;
+            case '/': out[n++] = '/'; break;
+            case 'b': out[n++] = '\b'; break;
+            case 'f': out[n++] = '\f'; break;
+            case 'n': out[n++] = '\n'; break;
+            case 'r': out[n++] = '\r'; break;
+            case 't': out[n++] = '\t'; break;
+            case 'u': {
+                unsigned cp;
+                if (!hex4(ps, &cp)) {
+                    fail(ps, "Bad \\u escape");
+                    free(out);
+                    return NULL;
+                }
+                // Combine UTF-16 surrogate pairs
+                if (cp >= 0xD800 && cp < 0xDC00 && ps->end - ps->p >= 6 &&
+                    ps->p[0] == '\\' && ps->p[1] == 'u') {
+                    const char* save = ps->p;
+                    unsigned lo;
+                    ps->p += 2;
+                    if (hex4(ps, &lo) && lo >= 0xDC00 && lo < 0xE000) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    } else {
+                        ps->p = save;
+                    }
+                }
+                n += put_utf8(out + n, cp);
+                break;
+            }
+            default:
+                fail(ps, "Bad escape");
+                free(out);
+                return NULL;
+        }
+    }
+    ps->p++;  // closing quote
+    out[n] = '\0';
+    return out;
+}
+
+// --- Values ---
+
+static int parse_value(JsonParser* ps, JsonValue* out, int depth);
+
+static int push_child(JsonParser* ps, JsonValue* parent, size_t* capacity, int with_keys) {
+    if (parent->count < *capacity) return 1;
+    size_t cap = *capacity ? *capacity * 2 : 4;
+    JsonValue* items = (JsonValue*)realloc(parent->items, cap * sizeof(JsonValue));
+    if (!items) {
+        fail(ps, "Out of memory");
+        return 0;
+    }
+    parent->items = items;
+    if (with_keys) {
+        char** keys = (char**)realloc(parent->keys, cap * sizeof(char*));
+        if (!keys) {
+            fail(ps, "Out of memory");
+            return 0;
+        }
+        parent->keys = keys;
+    }
+    *capacity = cap;
+    return 1;
+}
+
+static int parse_array(JsonParser* ps, JsonValue* out, int depth) {
+    size_t capacity = 0;
+    out->type = JSON_ARRAY;
+    ps->p++;
+    skip_ws(ps);
+    if (ps->p < ps->end && *ps->p == ']') {
+        ps->p++;
+        return 1;
+    }
+    for (;;) {
+        if (!push_child(ps, out, &capacity, 0)) return 0;
+        JsonValue* item = &out->items[out->count];
+        memset(item, 0, sizeof(*item));
+        out->count++;
+        if (!parse_value(ps, item, depth + 1)) return 0;
+        skip_ws(ps);
+        if (ps->p < ps->end && *ps->p == ',') {
+            ps->p++;
+            continue;
+        }
+        if (ps->p < ps->end && *ps->p == ']') {
+            ps->p++;
+            return 1;
+        }
+        fail(ps, "Expected ',' or ']'");
+        return 0;
+    }
+}
+
+static int parse_object(JsonParser* ps, JsonValue* out, int depth) {
+    size_t capacity = 0;
+    out->type = JSON_OBJECT;
+    ps->p++;
+    skip_ws(ps);
+    if (ps->p < ps->end && *ps->p == '}') {
+        ps->p++;
+        return 1;
+    }
+    for (;;) {
+        skip_ws(ps);
+        if (ps->p >= ps->end || *ps->p != '"') {
+            fail(ps, "Expected member name");
+            return 0;
+        }
+        if (!push_child(ps, out, &capacity, 1)) return 0;
+        JsonValue* item = &out->items[out->count];
+        memset(item, 0, sizeof(*item));
+        out->keys[out->count] = parse_string(ps);
+        out->count++;
+        if (!out->keys[out->count - 1]) return 0;
+
+        skip_ws(ps);
+        if (ps->p >= ps->end || *ps->p != ':') {
+            fail(ps, "Expected ':'");
+            return 0;
+        }
+        ps->p++;
+        if (!parse_value(ps, item, depth + 1)) return 0;
+        skip_ws(ps);
+        if (ps->p < ps->end && *ps->p == ',') {
+            ps->p++;
+            continue;
+        }
+        if (ps->p < ps->end && *ps->p == '}') {
+            ps->p++;
+            return 1;
+        }
+        fail(ps, "Expected ',' or '}'");
+        return 0;
+    }
+}
+
+static int parse_number(JsonParser* ps, JsonValue* out) {
+    // strtod needs a terminated buffer; numbers are short
+    char buf[64];
+    size_t n = 0;
+    while (ps->p + n < ps->end && n < sizeof(buf) - 1 &&
+           strchr("+-0123456789.eE", ps->p[n]) != NULL) {
+        buf[n] = ps->p[n];
+        n++;
+    }
+    buf[n] = '\0';
+    char* endp;
+    out->number = strtod(buf, &endp);
+    if (n == 0 || endp != buf + n) {
+        fail(ps, n == 0 ? "Unexpected token" : "Bad number");
+        return 0;
+    }
+    out->type = JSON_NUMBER;
+    ps->p += n;
+    return 1;
+}
+
+static int parse_value(JsonParser* ps, JsonValue* out, int depth) {
+    if (depth > JSON_MAX_DEPTH) {
+        fail(ps, "Nesting too deep");
+        return 0;
+    }
+    skip_ws(ps);
+    if (ps->p >= ps->end) {
+        fail(ps, "Unexpected end of input");
+        return 0;
+    }
+
+    switch (*ps->p) {
+        case '{': return parse_object(ps, out, depth);
+        case '[': return parse_array(ps, out, depth);
+        case '"':
+            out->type = JSON_STRING;
+            out->string = parse_string(ps);
+            return out->string != NULL;
+        case 't':
+            if (!match(ps, "true")) break;
+            out->type = JSON_BOOL;
+            out->number = 1;
+            return 1;
+        case 'f':
+            if (!match(ps, "false")) break;
+            out->type = JSON_BOOL;
+            return 1;
+        case 'n':
+            if (!match(ps, "null")) break;
+            out->type = JSON_NULL;
+            return 1;
+        default:
+            return parse_number(ps, out);
+    }
+    fail(ps, "Unexpected token");
+    return 0;
+}
+
+// --- Public API ---
+
+JsonValue* json_parse(const char* text, size_t size, char* err, size_t err_size) {
+    if (err && err_size > 0) err[0] = '\0';
+    JsonValue* root = (JsonValue*)calloc(1, sizeof(JsonValue));
+    if (!root) return NULL;
+
+    JsonParser ps = {text, text, text + size, err, err_size, 0};
+    // Skip a UTF-8 byte order mark (some editors write one)
+    if (size >= 3 && memcmp(text, "\xEF\xBB\xBF", 3) == 0) ps.p += 3;
+
+    if (parse_value(&ps, root, 0)) {
+        skip_ws(&ps);
+        if (ps.p != ps.end) fail(&ps, "Trailing characters");
+    }
+    if (ps.failed) {
+        json_free(root);
+        return NULL;
+    }
+    return root;
+}
+
+JsonValue* json_parse_file(const char* filepath, char* err, size_t err_size) {
+    FileMap map;
+    if (!filemap_open(filepath, &map)) {
+        if (err && err_size > 0) snprintf(err, err_size, "Cannot open %s", filepath);
+        return NULL;
+    }
+    JsonValue* root = json_parse((const char*)map.data, map.size, err, err_size);
+    filemap_close(&map);
+    return root;
+}
+
+void json_free(JsonValue* value) {
+    if (!value) return;
+    free_children(value);
+    free(value);
+}
+
+const JsonValue* json_get(const JsonValue* object, const char* key) {
+    if (!object || object->type != JSON_OBJECT) return NULL;
+    for (size_t i = 0; i < object->count; i++) {
+        if (strcmp(object->keys[i], key) == 0) return &object->items[i];
+    }
+    return NULL;
+}
+
+const JsonValue* json_at(const JsonValue* array, size_t index) {
+    if (!array || array->type != JSON_ARRAY || index >= array->count) return NULL;
+    return &array->items[index];
+}
+
+double json_number(const JsonValue* value, double fallback) {
+    return (value && (value->type == JSON_NUMBER || value->type == JSON_BOOL)) ? value->number : fallback;
+}
+
+const char* json_string(const JsonValue* value, const char* fallback) {
+    return (value && value->type == JSON_STRING) ? value->string : fallback;
+}
+
+int json_bool(const JsonValue* value, int fallback) {
+    return (value && value->type == JSON_BOOL) ? (value->number != 0) : fallback;
+}
+
+double json_get_number(const JsonValue* object, const char* key, double fallback) {
+    return json_number(json_get(object, key), fallback);
+}
+
+const char* json_get_string(const JsonValue* object, const char* key, const char* fallback) {
+    return json_string(json_get(object, key), fallback);
+}
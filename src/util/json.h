@@ -0,0 +1,51 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <stddef.h>
+
+// Minimal JSON reader (RFC 8259) for asset metadata: sprite atlases, tilemaps.
+// Parses a whole document into a tree; not meant for large or streaming data.
+
+typedef enum {
+    JSON_NULL = 0,
+    JSON_BOOL,
+    JSON_NUMBER,
+    JSON_STRING,
+    JSON_ARRAY,
+    JSON_OBJECT
+} JsonType;
+
+typedef struct JsonValue {
+    JsonType type;
+    double number;              // JSON_NUMBER, and 0/1 for JSON_BOOL
+    char* string;               // JSON_STRING (UTF-8, NUL-terminated)
+    size_t count;               // children of arrays / objects
+    struct JsonValue* items;    // children, in document order
+    char** keys;                // object member names (parallel to items)
+} JsonValue;
+
+// Parse `size` bytes of JSON. Returns NULL on error and writes a message with
+// the byte offset into `err` (may be NULL). Free the result with json_free().
+JsonValue* json_parse(const char* text, size_t size, char* err, size_t err_size);
+
+// Read and parse a file
+JsonValue* json_parse_file(const char* filepath, char* err, size_t err_size);
+
+void json_free(JsonValue* value);
+
+// Object member by name (NULL if missing or `object` is not an object)
+const JsonValue* json_get(const JsonValue* object, const char* key);
+
+// Array element (NULL if out of range or `array` is not an array)
+const JsonValue* json_at(const JsonValue* array, size_t index);
+
+// Typed accessors returning `fallback` when the value is missing or mistyped
+double json_number(const JsonValue* value, double fallback);
+const char* json_string(const JsonValue* value, const char* fallback);
+int json_bool(const JsonValue* value, int fallback);
+
+// Shorthand for json_number(json_get(object, key), fallback) etc.
+double json_get_number(const JsonValue* object, const char* key, double fallback);
+const char* json_get_string(const JsonValue* object, const char* key, const char* fallback);
+
+#endif // JSON_H
@@ -0,0 +1,172 @@
+#include "lz4.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LZ4_MIN_MATCH     4
+#define LZ4_LAST_LITERALS 5   // last 5 bytes of a block are always literals
+#define LZ4_MF_LIMIT      12  // last match must start at least 12 bytes before end
+#define LZ4_MAX_OFFSET    65535
+#define LZ4_HASH_LOG      14
+
+static uint32_t read32(const unsigned char* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint32_t hash32(uint32_t seq) {
+    return (seq * 2654435761u) >> (32 - LZ4_HASH_LOG);
+}
+
+// Write an LZ4 length extension (runs of 255 terminated by a smaller byte)
+static unsigned char* write_length(unsigned char* op, size_t len) {
+    while (len >= 255) {
+        *op++ = 255;
+        len -= 255;
+    }
+    *op++ = (unsigned char)len;
+    return op;
+}
+
+size_t lz4_compress_bound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+size_t lz4_compress(const unsigned char* src, size_t src_size,
+                    unsigned char* dst, size_t dst_capacity) {
+    uint32_t* table = (uint32_t*)calloc((size_t)1 << LZ4_HASH_LOG, sizeof(uint32_t));
+    if (!table) return 0;
+
+    const unsigned char* ip = src;
+    const unsigned char* anchor = src;
+    const unsigned char* iend = src + src_size;
+    unsigned char* op = dst;
+    unsigned char* oend = dst + dst_capacity;
+
+    if (src_size > LZ4_MF_LIMIT) {
+        const unsigned char* mflimit = iend - LZ4_MF_LIMIT;
+        const unsigned char* matchlimit = iend - LZ4_LAST_LITERALS;
+        ip++;
+
+        while (ip < mflimit) {
+            uint32_t seq = read32(ip);
+            uint32_t h = hash32(seq);
+            const unsigned char* ref = src + table[h];
+            table[h] = (uint32_t)(ip - src);
+
+            if (ref >= ip || ip - ref > LZ4_MAX_OFFSET || read32(ref) != seq) {
+                ip++;
+                continue;
+            }
+
+            // Extend the match backwards over pending literals, then forwards
+            while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+                ip--;
+                ref--;
+            }
+            const unsigned char* mp = ip + LZ4_MIN_MATCH;
+            const unsigned char* rp = ref + LZ4_MIN_MATCH;
+            while (mp < matchlimit && *mp == *rp) {
+                mp++;
+                rp++;
+            }
+
+            size_t lit_len = (size_t)(ip - anchor);
+            size_t match_len = (size_t)(mp - ip) - LZ4_MIN_MATCH;
+            size_t worst = 1 + lit_len / 255 + 1 + lit_len + 2 + match_len / 255 + 1;
+            if ((size_t)(oend - op) < worst) {
+                free(table);
+                return 0;
+            }
+
+            unsigned char* token = op++;
+            *token = (unsigned char)((lit_len >= 15 ? 15 : lit_len) << 4);
+            if (lit_len >= 15) op = write_length(op, lit_len - 15);
+            memcpy(op, anchor, lit_len);
+            op += lit_len;
+
+            uint16_t offset = (uint16_t)(ip - ref);
+            *op++ = (unsigned char)(offset & 0xFF);
+            *op++ = (unsigned char)(offset >> 8);
+
+            *token |= (unsigned char)(match_len >= 15 ? 15 : match_len);
+            if (match_len >= 15) op = write_length(op, match_len - 15);
+
+            ip = mp;
+            anchor = ip;
+        }
+    }
+
+    // Final literal-only sequence
+    size_t lit_len = (size_t)(iend - anchor);
+    if ((size_t)(oend - op) < 1 + lit_len / 255 + 1 + lit_len) {
+        free(table);
+        return 0;
+    }
+    unsigned char* token = op++;
+    *token = (unsigned char)((lit_len >= 15 ? 15 : lit_len) << 4);
+    if (lit_len >= 15) op = write_length(op, lit_len - 15);
+    memcpy(op, anchor, lit_len);
+    op += lit_len;
+
+    free(table);
+    return (size_t)(op - dst);
+}
+
+int lz4_decompress(const unsigned char* src, size_t src_size,
+                   unsigned char* dst, size_t dst_size) {
+    const unsigned char* ip = src;
+    const unsigned char* iend = src + src_size;
+    unsigned char* op = dst;
+    unsigned char* oend = dst + dst_size;
+
+    while (ip < iend) {
+        unsigned int token = *ip++;
+
+        // Literals
+        size_t lit_len = token >> 4;
+        if (lit_len == 15) {
+            unsigned char b;
+            do {
+                if (ip >= iend) return 0;
+                b = *ip++;
+                lit_len += b;
+            } while (b == 255);
+        }
+        if (lit_len > (size_t)(iend - ip) || lit_len > (size_t)(oend - op)) return 0;
+        memcpy(op, ip, lit_len);
+        op += lit_len;
+        ip += lit_len;
+
+        // The last sequence carries literals only
+        if (ip >= iend) break;
+
+        // Match
+        if (iend - ip < 2) return 0;
+        size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - dst)) return 0;
+
+        size_t match_len = token & 15;
+        if (match_len == 15) {
+            unsigned char b;
+            do {
+                if (ip >= iend) return 0;
+                b = *ip++;
+                match_len += b;
+            } while (b == 255);
+        }
+        match_len += LZ4_MIN_MATCH;
+        if (match_len > (size_t)(oend - op)) return 0;
+
+        // Byte copy: source and destination may overlap (run-length matches)
+        const unsigned char* match = op - offset;
+        for (size_t i = 0; i < match_len; i++) {
+            op[i] = match[i];
+        }
+        op += match_len;
+    }
+
+    return op == oend;
+}
@@ -0,0 +1,23 @@
+#ifndef LZ4_H
+#define LZ4_H
+
+#include <stddef.h>
+
+// Minimal LZ4 block-format codec (no frame format, no dictionary).
+// Output is compatible with the reference LZ4_compress_default /
+// LZ4_decompress_safe block functions.
+
+// Worst-case compressed size for `size` input bytes
+size_t lz4_compress_bound(size_t size);
+
+// Compress `src` into `dst` (capacity `dst_capacity`).
+// Returns the compressed size, or 0 if the output did not fit.
+size_t lz4_compress(const unsigned char* src, size_t src_size,
+                    unsigned char* dst, size_t dst_capacity);
+
+// Decompress a block that must expand to exactly `dst_size` bytes.
+// Bounds-checked against malformed input. Returns 1 on success, 0 on error.
+int lz4_decompress(const unsigned char* src, size_t src_size,
+                   unsigned char* dst, size_t dst_size);
+
+#endif // LZ4_H
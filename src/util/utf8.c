@@ -0,0 +1,42 @@
+#include "utf8.h"
+
+uint32_t utf8_decode(const char** p) {
+    const unsigned char* s = (const unsigned char*)*p;
+    unsigned char c = s[0];
+
+    if (c < 0x80) {
+        if (c) (*p)++;
+        return c;
+    }
+
+    uint32_t cp;
+    uint32_t min;
+    int extra;
+    if ((c & 0xE0) == 0xC0) {
+        cp = c & 0x1F; extra = 1; min = 0x80;
+    } else if ((c & 0xF0) == 0xE0) {
+        cp = c & 0x0F; extra = 2; min = 0x800;
+    } else if ((c & 0xF8) == 0xF0) {
+        cp = c & 0x07; extra = 3; min = 0x10000;
+    } else {
+        (*p)++;
+        return UTF8_REPLACEMENT;
+    }
+
+    // A NUL fails the continuation test, so we never read past the end
+    for (int i = 1; i <= extra; i++) {
+        if ((s[i] & 0xC0) != 0x80) {
+            (*p)++;
+            return UTF8_REPLACEMENT;
+        }
+        cp = (cp << 6) | (s[i] & 0x3F);
+    }
+
+    if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+        (*p)++;
+        return UTF8_REPLACEMENT;
+    }
+
+    *p += extra + 1;
+    return cp;
+}
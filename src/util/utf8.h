@@ -0,0 +1,16 @@
+#ifndef UTF8_H
+#define UTF8_H
+
+#include <stdint.h>
+
+// UTF-8 decoding for text rendering.
+
+#define UTF8_REPLACEMENT 0xFFFD
+
+// Decode the code point at *p and advance *p past it. Malformed sequences
+// (stray continuation bytes, overlong forms, surrogates, values above
+// U+10FFFF, truncation by the terminating NUL) yield U+FFFD and consume a
+// single byte, so decoding always makes progress. Returns 0 at the NUL.
+uint32_t utf8_decode(const char** p);
+
+#endif // UTF8_H